@@ -0,0 +1,117 @@
+/**
+ ******************************************************************************
+ * @file           : anim.c
+ * @brief          : Compressed frame sequences, decoded one frame at a time
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 31, 2026
+ ******************************************************************************
+ */
+
+#include "anim.h"
+
+// 0 = ran off the end of the stream or longer than 32 bits
+static uint8_t read_varint(AnimStream *s, uint32_t *value) {
+    uint32_t v = 0;
+
+    for (uint8_t shift = 0; shift < 32; shift += 7) {
+        if (s->pos >= s->size) {
+            return 0;
+        }
+        uint8_t byte = s->data[s->pos++];
+        v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = v;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t anim_open(AnimStream *s, const uint8_t *data, uint32_t size) {
+    if (size < ANIM_HEADER_SIZE || data[0] != 'A' || data[1] != 'N' || data[2] != ANIM_VERSION) {
+        return 0;
+    }
+    s->data = data;
+    s->size = size;
+    s->width = (uint16_t)(data[4] | (data[5] << 8));
+    s->frames = (uint16_t)(data[6] | (data[7] << 8));
+    anim_rewind(s);
+    return s->width != 0;
+}
+
+void anim_rewind(AnimStream *s) {
+    s->pos = ANIM_HEADER_SIZE;
+    s->repeat_left = 0;
+    s->repeat_ms = 0;
+}
+
+uint32_t anim_next(AnimStream *s, uint8_t *bits) {
+    uint16_t bytes = LED_FRAME_BYTES(s->width);
+    uint8_t looped = 0;
+    uint32_t header, duration;
+
+    if (s->repeat_left) {
+        s->repeat_left--;
+        return s->repeat_ms;                    // Frame unchanged
+    }
+
+    for (;;) {
+        if (!read_varint(s, &header)) {
+            return 0;
+        }
+        if ((header & 3) == ANIM_END) {
+            if (looped) {
+                return 0;                       // No frame in the whole loop
+            }
+            looped = 1;
+            anim_rewind(s);
+            continue;
+        }
+        if (!read_varint(s, &duration) || duration == 0) {
+            return 0;
+        }
+        break;
+    }
+
+    uint32_t arg = header >> 2;
+    switch (header & 3) {
+        case ANIM_KEY:
+            if (s->size - s->pos < bytes) {
+                return 0;
+            }
+            for (uint16_t i = 0; i < bytes; i++) {
+                bits[i] = s->data[s->pos + i];
+            }
+            s->pos += bytes;
+            break;
+
+        case ANIM_DELTA: {
+            uint32_t offset = 0;
+            for (uint32_t span = 0; span < arg; span++) {
+                uint32_t skip, length;
+                if (!read_varint(s, &skip) || !read_varint(s, &length) ||
+                    skip > bytes - offset || length > bytes - offset - skip ||
+                    length > s->size - s->pos) {
+                    return 0;
+                }
+                offset += skip;
+                const uint8_t *src = &s->data[s->pos];
+                for (uint32_t i = 0; i < length; i++) {
+                    bits[offset + i] ^= src[i];
+                }
+                offset += length;
+                s->pos += length;
+            }
+            break;
+        }
+
+        case ANIM_REPEAT:
+            if (arg == 0 || arg > 0xFFFF) {
+                return 0;
+            }
+            s->repeat_left = (uint16_t)(arg - 1);
+            s->repeat_ms = duration;
+            break;
+    }
+    return duration;
+}
@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file           : anim.h
+ * @brief          : Compressed frame sequences, decoded one frame at a time
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 31, 2026
+ ******************************************************************************
+ * A raw frame table costs (width / 8 + 2) bytes per frame, however little
+ * changes between frames - a 30 s animation on a 256-output panel at
+ * 50 ms per frame is 20 KB. Stored as a stream of records instead:
+ *
+ *   header:  'A' 'N' version 0 | width (u16 LE) | frames per loop (u16 LE)
+ *   record:  varint (arg << 2 | type), varint duration_ms, payload
+ *
+ *   ANIM_KEY     full frame follows (LED_FRAME_BYTES(width) bytes)
+ *   ANIM_DELTA   'arg' spans of changed bytes, each
+ *                  varint skip, varint length, 'length' bytes to XOR in
+ *                (0 spans = same frame, new duration)
+ *   ANIM_REPEAT  the previous frame 'arg' more times, 'duration' each
+ *   ANIM_END     back to the first record (which is always a KEY)
+ *
+ * Varints are 7 bits per byte, low bits first, bit 7 = more follows, so
+ * durations up to 127 ms take one byte and longer ones only what they
+ * need.
+ *
+ * The decoder reads the stream in place (const, in Flash) and keeps a
+ * few words of state: where the next record starts and how much of a
+ * REPEAT run is left. The caller owns the frame buffer, which must still
+ * hold the previous frame - deltas are XORed into it:
+ *
+ *   anim_open(&s, anim_demo, sizeof anim_demo);
+ *   duration = anim_next(&s, bits);        // Show bits for 'duration' ms
+ *
+ * A broken stream never reads or writes out of bounds: anim_next()
+ * returns 0 instead.
+ *
+ * anim_encode.c (host) turns a frame list into this format as a C array
+ * and reports the compression ratio and the worst-case decode work per
+ * frame.
+ ******************************************************************************
+ */
+
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdint.h>
+#include "led_frame.h"
+
+#define ANIM_VERSION        1
+#define ANIM_HEADER_SIZE    8
+
+typedef enum {
+    ANIM_KEY,
+    ANIM_DELTA,
+    ANIM_REPEAT,
+    ANIM_END
+} AnimRecord;
+
+typedef struct {
+    const uint8_t *data;            // Whole stream, header included
+    uint32_t size;
+    uint32_t pos;                   // Next record
+    uint16_t width;                 // Outputs per frame
+    uint16_t frames;                // Frames per loop (from the header)
+    uint16_t repeat_left;           // Frames still due from a REPEAT
+    uint32_t repeat_ms;
+} AnimStream;
+
+// 1 = valid header
+uint8_t anim_open(AnimStream *s, const uint8_t *data, uint32_t size);
+
+// Next frame into 'bits' (LED_FRAME_BYTES(width), holding the previous
+// frame); returns how long to show it in ms, 0 = broken stream
+uint32_t anim_next(AnimStream *s, uint8_t *bits);
+
+// Back to the first frame
+void anim_rewind(AnimStream *s);
+
+#endif // ANIM_H
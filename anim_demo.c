@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file           : anim_demo.c
+ * @brief          : Animation stream (anim.h) - generated, do not edit
+ ******************************************************************************
+ * ./anim_encode anim_demo.txt anim_demo > anim_demo.c
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+
+const uint8_t anim_demo[182] = {
+    0x41, 0x4E, 0x01, 0x00, 0x08, 0x00, 0x3B, 0x00, 0x00, 0x50, 0xFF, 0x00,
+    0x78, 0x00, 0x00, 0x50, 0xFF, 0x00, 0xD8, 0x04, 0x00, 0x00, 0x50, 0xFF,
+    0x00, 0x78, 0x00, 0x00, 0x50, 0xFF, 0x00, 0xD8, 0x04, 0x00, 0x00, 0x50,
+    0xFF, 0x00, 0x78, 0x00, 0x00, 0x50, 0xFF, 0x00, 0xD8, 0x04, 0x00, 0x00,
+    0x3C, 0x01, 0x00, 0x3C, 0x03, 0x00, 0x3C, 0x07, 0x00, 0x3C, 0x0F, 0x00,
+    0x3C, 0x1F, 0x00, 0x3C, 0x3F, 0x00, 0x3C, 0x7F, 0x00, 0x3C, 0xFF, 0x1A,
+    0x64, 0x00, 0x3C, 0xFE, 0x00, 0x3C, 0xFC, 0x00, 0x3C, 0xF8, 0x00, 0x3C,
+    0xF0, 0x00, 0x3C, 0xE0, 0x00, 0x3C, 0xC0, 0x00, 0x3C, 0x80, 0x00, 0x3C,
+    0x00, 0x00, 0x5A, 0x01, 0x00, 0x5A, 0x82, 0x00, 0x5A, 0x44, 0x00, 0x5A,
+    0x28, 0x00, 0x5A, 0x10, 0x00, 0x5A, 0x28, 0x00, 0x5A, 0x44, 0x00, 0x5A,
+    0x82, 0x00, 0x5A, 0x01, 0x00, 0x5A, 0x82, 0x00, 0x5A, 0x44, 0x00, 0x5A,
+    0x28, 0x00, 0x5A, 0x10, 0x00, 0x5A, 0x28, 0x00, 0x5A, 0x44, 0x00, 0x5A,
+    0x82, 0x00, 0x96, 0x01, 0x55, 0x00, 0x96, 0x01, 0xAA, 0x00, 0x96, 0x01,
+    0x55, 0x00, 0x96, 0x01, 0xAA, 0x00, 0x96, 0x01, 0x55, 0x00, 0x96, 0x01,
+    0xAA, 0x00, 0x96, 0x01, 0x55, 0x00, 0x96, 0x01, 0xAA, 0x00, 0x90, 0x03,
+    0x00, 0x03,
+};
+
+const uint32_t anim_demo_size = sizeof anim_demo;
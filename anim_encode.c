@@ -0,0 +1,416 @@
+/**
+ ******************************************************************************
+ * @file           : anim_encode.c
+ * @brief          : Host tool - frame list -> compressed animation (anim.h)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 31, 2026
+ ******************************************************************************
+ *   gcc -O2 -o anim_encode anim_encode.c anim.c
+ *   ./anim_encode anim_demo.txt anim_demo > anim_demo.c
+ *   ./anim_encode --bench
+ *
+ * Input: "width N", then one frame per line - N characters ('#'/'1' on,
+ * '.'/'0' off, character i = ring position i) and a duration in ms.
+ * '%' starts a comment. Output: the stream as a C array on stdout, the
+ * statistics on stderr.
+ *
+ * Encoding, per frame: the same frame again (and the same duration) is
+ * folded into a REPEAT run; otherwise the changed bytes are sent as XOR
+ * spans (gaps of up to SPAN_GAP_MAX unchanged bytes are cheaper to send
+ * than to skip) or, if that is not shorter, a KEY frame.
+ *
+ * Every stream is decoded again with the firmware's anim.c over two
+ * loops and must give back the input exactly. Reported: size against a
+ * raw table (frame bytes + a 16-bit duration per frame), and the most
+ * stream bytes any single anim_next() call reads - decode time is
+ * linear in that, estimated at CYCLES_PER_CALL + CYCLES_PER_BYTE each
+ * (byte loop from Flash on the M4; measure on the target for the
+ * exact figure).
+ *
+ * --bench encodes synthetic animations at 8, 64 and 256 outputs.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "anim.h"
+
+#define MAX_WIDTH           1024
+#define MAX_FRAMES          20000
+#define MAX_STREAM          (4u << 20)
+#define SPAN_GAP_MAX        2
+#define CYCLES_PER_CALL     40
+#define CYCLES_PER_BYTE     8
+
+typedef struct {
+    uint16_t width;
+    uint32_t count;
+    uint8_t *bits;                  // count * LED_FRAME_BYTES(width)
+    uint32_t *duration_ms;
+} FrameList;
+
+static uint8_t stream[MAX_STREAM];
+static uint32_t stream_len;
+
+static uint8_t *frame_bits(const FrameList *fl, uint32_t n) {
+    return fl->bits + (size_t)n * LED_FRAME_BYTES(fl->width);
+}
+
+static void frames_alloc(FrameList *fl, uint16_t width, uint32_t count) {
+    fl->width = width;
+    fl->count = count;
+    fl->bits = calloc((size_t)count, LED_FRAME_BYTES(width));
+    fl->duration_ms = calloc(count, sizeof(uint32_t));
+    if (!fl->bits || !fl->duration_ms) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+static void put(uint8_t byte) {
+    if (stream_len >= MAX_STREAM) {
+        fprintf(stderr, "stream too long\n");
+        exit(1);
+    }
+    stream[stream_len++] = byte;
+}
+
+static void put_varint(uint32_t v) {
+    while (v >= 0x80) {
+        put((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    put((uint8_t)v);
+}
+
+static uint32_t varint_size(uint32_t v) {
+    uint32_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+// XOR spans from prev to cur: returns the count and the encoded size;
+// emit = 1 writes them
+static uint32_t delta_spans(const uint8_t *prev, const uint8_t *cur, uint16_t bytes,
+                            uint8_t emit, uint32_t *size) {
+    uint32_t spans = 0;
+    uint32_t end = 0;                           // End of the previous span
+    uint32_t i = 0;
+
+    *size = 0;
+    while (i < bytes) {
+        if (prev[i] == cur[i]) {
+            i++;
+            continue;
+        }
+        // Span: changed bytes, bridging short unchanged gaps
+        uint32_t start = i, last = i;
+        for (uint32_t j = i + 1; j < bytes && j <= last + SPAN_GAP_MAX + 1; j++) {
+            if (prev[j] != cur[j]) {
+                last = j;
+            }
+        }
+        uint32_t length = last - start + 1;
+        *size += varint_size(start - end) + varint_size(length) + length;
+        if (emit) {
+            put_varint(start - end);
+            put_varint(length);
+            for (uint32_t k = start; k <= last; k++) {
+                put(prev[k] ^ cur[k]);
+            }
+        }
+        spans++;
+        end = last + 1;
+        i = last + 1;
+    }
+    return spans;
+}
+
+static void encode(const FrameList *fl) {
+    uint16_t bytes = LED_FRAME_BYTES(fl->width);
+
+    stream_len = 0;
+    put('A');
+    put('N');
+    put(ANIM_VERSION);
+    put(0);
+    put((uint8_t)fl->width);
+    put((uint8_t)(fl->width >> 8));
+    put((uint8_t)fl->count);
+    put((uint8_t)(fl->count >> 8));
+
+    for (uint32_t n = 0; n < fl->count; ) {
+        const uint8_t *cur = frame_bits(fl, n);
+        uint32_t duration = fl->duration_ms[n] ? fl->duration_ms[n] : 1;
+
+        if (n > 0 && memcmp(cur, frame_bits(fl, n - 1), bytes) == 0) {
+            // Run of the same frame with the same duration
+            uint32_t run = 1;
+            while (n + run < fl->count && run < 0xFFFF &&
+                   fl->duration_ms[n + run] == fl->duration_ms[n] &&
+                   memcmp(frame_bits(fl, n + run), cur, bytes) == 0) {
+                run++;
+            }
+            put_varint(run << 2 | ANIM_REPEAT);
+            put_varint(duration);
+            n += run;
+            continue;
+        }
+
+        uint32_t delta_size = 0, spans = 0;
+        if (n > 0) {
+            spans = delta_spans(frame_bits(fl, n - 1), cur, bytes, 0, &delta_size);
+            delta_size += varint_size(spans << 2);
+        }
+        if (n > 0 && delta_size < 1u + bytes) {
+            put_varint(spans << 2 | ANIM_DELTA);
+            put_varint(duration);
+            delta_spans(frame_bits(fl, n - 1), cur, bytes, 1, &delta_size);
+        } else {
+            put_varint(ANIM_KEY);
+            put_varint(duration);
+            for (uint16_t i = 0; i < bytes; i++) {
+                put(cur[i]);
+            }
+        }
+        n++;
+    }
+    put_varint(ANIM_END);
+}
+
+// ============================================================================
+// Check with the firmware decoder, measure
+// ============================================================================
+typedef struct {
+    uint32_t raw_size;
+    uint32_t worst_bytes;           // Most stream bytes read by one anim_next()
+    double ns_per_frame;
+    uint8_t ok;
+} EncodeStats;
+
+static EncodeStats verify(const FrameList *fl) {
+    EncodeStats st = { 0 };
+    AnimStream s;
+    uint16_t bytes = LED_FRAME_BYTES(fl->width);
+    uint8_t bits[LED_FRAME_BYTES(MAX_WIDTH)] = { 0 };
+    struct timespec t0, t1;
+
+    st.raw_size = fl->count * (bytes + 2u);
+    st.ok = anim_open(&s, stream, stream_len) && s.width == fl->width && s.frames == (fl->count & 0xFFFF);
+
+    for (uint32_t n = 0; st.ok && n < 2 * fl->count; n++) {
+        uint32_t before = s.pos;
+        uint32_t duration = anim_next(&s, bits);
+        uint32_t read = (s.pos >= before) ? s.pos - before : s.pos - ANIM_HEADER_SIZE + (stream_len - before);
+        uint32_t want = fl->duration_ms[n % fl->count] ? fl->duration_ms[n % fl->count] : 1;
+
+        if (duration != want || memcmp(bits, frame_bits(fl, n % fl->count), bytes) != 0) {
+            fprintf(stderr, "frame %u decodes wrong\n", n % fl->count);
+            st.ok = 0;
+        }
+        if (read > st.worst_bytes) {
+            st.worst_bytes = read;
+        }
+    }
+
+    // Host speed, for comparison only
+    uint32_t rounds = 1 + 2000000 / (fl->count * (bytes + 1u));
+    anim_rewind(&s);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t n = 0; n < rounds * fl->count; n++) {
+        anim_next(&s, bits);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    st.ns_per_frame = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / (rounds * fl->count);
+    return st;
+}
+
+static void report(FILE *out, const char *name, const FrameList *fl, const EncodeStats *st) {
+    fprintf(out, "%-24s %4u outputs %6u frames  raw %7u B  packed %6u B  %5.1f : 1  "
+                 "worst %4u B/frame (~%u cycles)  host %5.0f ns/frame  %s\n",
+            name, fl->width, fl->count, st->raw_size, stream_len,
+            (double)st->raw_size / stream_len, st->worst_bytes,
+            CYCLES_PER_CALL + CYCLES_PER_BYTE * st->worst_bytes, st->ns_per_frame,
+            st->ok ? "ok" : "FAIL");
+}
+
+// ============================================================================
+// Frame list file
+// ============================================================================
+static int load(const char *path, FrameList *fl) {
+    FILE *in = fopen(path, "r");
+    char line[MAX_WIDTH + 64];
+    uint32_t lineno = 0;
+
+    if (!in) {
+        perror(path);
+        return 0;
+    }
+    fl->width = 0;
+    fl->count = 0;
+
+    while (fgets(line, sizeof line, in)) {
+        char *p = line;
+        lineno++;
+        char *comment = strchr(p, '%');
+        if (comment) *comment = 0;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == 0 || *p == '\n' || *p == '\r') continue;
+
+        if (strncmp(p, "width", 5) == 0) {
+            unsigned width = (unsigned)strtoul(p + 5, 0, 10);
+            if (fl->width || width == 0 || width > MAX_WIDTH) {
+                fprintf(stderr, "%s:%u: bad width\n", path, lineno);
+                return 0;
+            }
+            frames_alloc(fl, (uint16_t)width, MAX_FRAMES);
+            fl->count = 0;
+            continue;
+        }
+        if (!fl->width || fl->count >= MAX_FRAMES) {
+            fprintf(stderr, "%s:%u: 'width' first, at most %u frames\n", path, lineno, MAX_FRAMES);
+            return 0;
+        }
+
+        uint8_t *bits = frame_bits(fl, fl->count);
+        for (uint16_t i = 0; i < fl->width; i++, p++) {
+            if (*p == '#' || *p == '1') {
+                bits[i >> 3] |= (uint8_t)(1 << (i & 7));
+            } else if (*p != '.' && *p != '0') {
+                fprintf(stderr, "%s:%u: need %u characters of # . 1 0\n", path, lineno, fl->width);
+                return 0;
+            }
+        }
+        fl->duration_ms[fl->count++] = (uint32_t)strtoul(p, 0, 10);
+    }
+    fclose(in);
+    return fl->count > 0;
+}
+
+static void write_c(const char *name, const char *source) {
+    printf("/**\n");
+    printf(" ******************************************************************************\n");
+    printf(" * @file           : %s.c\n", name);
+    printf(" * @brief          : Animation stream (anim.h) - generated, do not edit\n");
+    printf(" ******************************************************************************\n");
+    printf(" * ./anim_encode %s %s > %s.c\n", source, name, name);
+    printf(" ******************************************************************************\n");
+    printf(" */\n\n");
+    printf("#include <stdint.h>\n\n");
+    printf("const uint8_t %s[%u] = {", name, stream_len);
+    for (uint32_t i = 0; i < stream_len; i++) {
+        printf("%s0x%02X,", (i % 12) ? " " : "\n    ", stream[i]);
+    }
+    printf("\n};\n\n");
+    printf("const uint32_t %s_size = sizeof %s;\n", name, name);
+}
+
+// ============================================================================
+// Synthetic animations for --bench
+// ============================================================================
+static void set_bit(FrameList *fl, uint32_t n, uint32_t i) {
+    frame_bits(fl, n)[i >> 3] |= (uint8_t)(1 << (i & 7));
+}
+
+// Comet with a 4-output tail, going round
+static void gen_comet(FrameList *fl, uint16_t width) {
+    frames_alloc(fl, width, width * 4u);
+    for (uint32_t n = 0; n < fl->count; n++) {
+        for (uint32_t t = 0; t < 4; t++) {
+            set_bit(fl, n, (n + width - t) % width);
+        }
+        fl->duration_ms[n] = 40;
+    }
+}
+
+// Bar graph that fills, holds (repeats) and empties
+static void gen_bargraph(FrameList *fl, uint16_t width) {
+    frames_alloc(fl, width, width * 2u + 40);
+    uint32_t n = 0;
+    for (uint32_t level = 0; level < width; level++, n++) {
+        for (uint32_t i = 0; i < level; i++) set_bit(fl, n, i);
+        fl->duration_ms[n] = 20;
+    }
+    for (uint32_t hold = 0; hold < 40; hold++, n++) {
+        for (uint32_t i = 0; i < width; i++) set_bit(fl, n, i);
+        fl->duration_ms[n] = 50;
+    }
+    for (uint32_t level = width; level > 0; level--, n++) {
+        for (uint32_t i = 0; i < level; i++) set_bit(fl, n, i);
+        fl->duration_ms[n] = 20;
+    }
+}
+
+// Random sparkle - the worst case: nothing repeats
+static void gen_sparkle(FrameList *fl, uint16_t width) {
+    uint32_t seed = 12345;
+    frames_alloc(fl, width, 500);
+    for (uint32_t n = 0; n < fl->count; n++) {
+        for (uint32_t i = 0; i < width; i++) {
+            seed = seed * 1103515245 + 12345;
+            if ((seed >> 24) < 40) set_bit(fl, n, i);
+        }
+        fl->duration_ms[n] = 30 + (seed >> 28) * 20;
+    }
+}
+
+static int bench(void) {
+    static const uint16_t widths[] = { 8, 64, 256 };
+    static const struct {
+        const char *name;
+        void (*gen)(FrameList *, uint16_t);
+    } gens[] = {
+        { "comet", gen_comet },
+        { "bar graph", gen_bargraph },
+        { "sparkle (random)", gen_sparkle },
+    };
+    int failures = 0;
+
+    printf("Animation streams (anim.h), decoded back with anim.c\n\n");
+    for (uint32_t g = 0; g < sizeof gens / sizeof gens[0]; g++) {
+        for (uint32_t w = 0; w < sizeof widths / sizeof widths[0]; w++) {
+            FrameList fl;
+            gens[g].gen(&fl, widths[w]);
+            encode(&fl);
+            EncodeStats st = verify(&fl);
+            report(stdout, gens[g].name, &fl, &st);
+            failures += !st.ok;
+            free(fl.bits);
+            free(fl.duration_ms);
+        }
+    }
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    FrameList fl;
+
+    if (argc == 2 && strcmp(argv[1], "--bench") == 0) {
+        return bench();
+    }
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s frames.txt name > name.c\n       %s --bench\n", argv[0], argv[0]);
+        return 2;
+    }
+    if (!load(argv[1], &fl)) {
+        return 1;
+    }
+
+    encode(&fl);
+    EncodeStats st = verify(&fl);
+    report(stderr, argv[2], &fl, &st);
+    if (!st.ok) {
+        return 1;
+    }
+    write_c(argv[2], argv[1]);
+    return 0;
+}
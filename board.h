@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @file           : board.h
+ * @brief          : STM32F303 Discovery pin mapping (button + 8 LEDs)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ * Same mapping as Day3_Final_7_Patterns.c.
+ *
+ * An LED "frame" is one byte with bit i = PE(8 + i), so a whole frame
+ * goes to the port with a single BSRR write (see leds_write()).
+ ******************************************************************************
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+// Pin Definitions
+#define BUTTON_PIN          0          // PA0 = USER button
+
+// LED Pins (all 8 LEDs)
+#define LED_NORTH           9          // PE9  = LD3 (North - Red)
+#define LED_NE              8          // PE8  = LD4 (North-East - Blue)
+#define LED_EAST            10         // PE10 = LD5 (East - Orange)
+#define LED_SE              15         // PE15 = LD6 (South-East - Green)
+#define LED_SOUTH           11         // PE11 = LD7 (South - Green)
+#define LED_SW              14         // PE14 = LD8 (South-West - Orange)
+#define LED_WEST            12         // PE12 = LD9 (West - Blue)
+#define LED_NW              13         // PE13 = LD10 (North-West - Red)
+
+#define LED_FIRST_PIN       8          // PE8..PE15
+#define LED_COUNT           8
+
+// Frame bit for an LED pin
+#define LED_BIT(pin)        (1 << ((pin) - LED_FIRST_PIN))
+
+// Frame outputs in compass order, clockwise from North (LedFrame.ring)
+#define LED_COMPASS_RING { \
+    LED_NORTH - LED_FIRST_PIN, LED_NE - LED_FIRST_PIN, \
+    LED_EAST  - LED_FIRST_PIN, LED_SE - LED_FIRST_PIN, \
+    LED_SOUTH - LED_FIRST_PIN, LED_SW - LED_FIRST_PIN, \
+    LED_WEST  - LED_FIRST_PIN, LED_NW - LED_FIRST_PIN }
+
+// On-board LEDs dimmed by soft PWM (led_pwm.h): 1 = brightness patterns
+// are shown with a smooth curve, 0 = plain on/off via one BSRR write
+#define LED_PWM             1
+
+// Optional 74HC595 panel on SPI2 (hc595.h): number of outputs, 0 = none.
+// When set, the patterns drive the panel instead of the on-board LEDs.
+#define PANEL_WIDTH         0
+
+// Optional WS2812 strip on PB4 (ws2812.h): number of pixels, 0 = none.
+// Used when there is no panel; lit outputs show STRIP_COLOR.
+#define STRIP_PIXELS        0
+#define STRIP_COLOR         WS2812_RGB(0, 48, 96)
+
+// LSM303DLHC accelerometer / magnetometer (lsm303.h) on I2C1, its
+// data-ready lines on port E
+#define LSM303_DRDY_MAG_PIN 2          // PE2 = DRDY (magnetometer)
+#define LSM303_DRDY_ACC_PIN 4          // PE4 = INT1 (accelerometer data ready)
+
+// Sensor axes as board directions: +X toward the North LED, +Y toward
+// West, +Z up out of the board (same for both sensors of the LSM303)
+#define LSM303_NORTH(v)     ((int32_t)(v)[0])
+#define LSM303_EAST(v)      (-(int32_t)(v)[1])
+#define LSM303_UP(v)        ((int32_t)(v)[2])
+
+// L3GD20 gyroscope (l3gd20.h) on SPI1: chip select and the FIFO
+// watermark line (INT2). Its SPI transmit DMA channel is the WS2812
+// strip's, so it is only read without a strip.
+#define L3GD20_CS_PIN       3          // PE3 = CS_I2C/SPI
+#define L3GD20_INT2_PIN     1          // PE1 = INT2 (FIFO watermark)
+#define GYRO_ENABLED        (STRIP_PIXELS == 0)
+
+// bxCAN (can.h) on PB8 = RX / PB9 = TX. The Discovery has no transceiver:
+// 1 = silent loopback (sent frames come back through the filters, the
+// pins stay idle), 0 = on a real bus through an external transceiver
+#define CAN_LOOPBACK        1
+#define CAN_BITRATE         500000
+
+// Interrupt priorities (0 = highest). The LED engine and the button run
+// in SysTick; the PWM plane timer sits above it so dimming never jitters,
+// and CAN receive too: its FIFOs hold only three frames.
+#define IRQ_PRIO_PWM        0
+#define IRQ_PRIO_CAN        1          // ~300 us of frames per FIFO, short ISR
+#define IRQ_PRIO_ENGINE     2
+#define IRQ_PRIO_SENSOR     3          // Sensor buses: below the engine
+
+// Kernel idle task (kernel.h): 1 = stretch SysTick up to the next
+// software timer while no task is ready. Leave 0 while the LED engine
+// runs on the tick - it would only step when something else wakes us.
+#define KERNEL_TICKLESS     0
+
+// One BSRR write: set the frame's 1-bits, reset its 0-bits (PE8-PE15 only)
+#define LED_FRAME_BSRR(frame) \
+    (((uint32_t)(uint8_t)(frame) << LED_FIRST_PIN) | \
+     ((uint32_t)(uint8_t)~(frame) << (LED_FIRST_PIN + 16)))
+
+#endif // BOARD_H
@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @file           : boot_stats.c
+ * @brief          : Reset-to-main() boot time, kept across resets
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 20, 2026
+ ******************************************************************************
+ */
+
+#include "boot_stats.h"
+
+NOINIT BootStats boot_stats;
+
+// ============================================================================
+// Called from Reset_Handler with the DWT cycle count just before main()
+// ============================================================================
+void boot_stats_record(uint32_t cycles) {
+    // After power-on .noinit holds random data - start a fresh history
+    if (boot_stats.magic != BOOT_STATS_MAGIC) {
+        boot_stats.magic = BOOT_STATS_MAGIC;
+        boot_stats.boot_count = 0;
+        boot_stats.min_cycles = 0xFFFFFFFF;
+        boot_stats.max_cycles = 0;
+    }
+
+    boot_stats.boot_count++;
+    boot_stats.last_cycles = cycles;
+    if (cycles < boot_stats.min_cycles) boot_stats.min_cycles = cycles;
+    if (cycles > boot_stats.max_cycles) boot_stats.max_cycles = cycles;
+}
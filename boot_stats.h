@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @file           : boot_stats.h
+ * @brief          : Reset-to-main() boot time, kept across resets
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 20, 2026
+ ******************************************************************************
+ * Reset_Handler (startup_stm32f303.s) starts the DWT cycle counter as its
+ * very first instruction and calls boot_stats_record() right before
+ * main(). The result lives in .noinit, so it can be read with the
+ * debugger (or printed) and the min/max history survives warm resets.
+ *
+ * Boot runs on HSI 8 MHz, so 8 cycles = 1 us.
+ *
+ * NOINIT can be used for any other buffer that does not need zeroing
+ * (large frame/trace buffers) - it also makes the .bss loop shorter:
+ *   NOINIT static uint8_t trace_buffer[4096];
+ ******************************************************************************
+ */
+
+#ifndef BOOT_STATS_H
+#define BOOT_STATS_H
+
+#include <stdint.h>
+
+#define NOINIT              __attribute__((section(".noinit")))
+
+#define BOOT_STATS_MAGIC    0xB007C0DE
+
+typedef struct {
+    uint32_t magic;                 // BOOT_STATS_MAGIC once initialised
+    uint32_t boot_count;            // Resets since power-on
+    uint32_t last_cycles;           // Reset -> main() of this boot
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+} BootStats;
+
+extern BootStats boot_stats;
+
+void boot_stats_record(uint32_t cycles);
+
+#endif // BOOT_STATS_H
@@ -0,0 +1,87 @@
+/**
+ ******************************************************************************
+ * @file           : brightness.h
+ * @brief          : Perceptual brightness: gamma LUT and quarter-wave sine
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * A linear duty ramp looks like "fast up, then flat" to the eye. Levels
+ * in this project are perceptual (0..255); gamma_apply() turns one into
+ * a PWM duty with a single table lookup.
+ *
+ * Both tables are generated by the C++ compiler (brightness_lut.cpp,
+ * constexpr) into flash - nothing is computed at run time or at boot,
+ * and changing the settings below only needs a rebuild:
+ *
+ *   GAMMA_X100        curve exponent x 100 (220 = gamma 2.2)
+ *   GAMMA_IN_BITS     table entries = 2^GAMMA_IN_BITS (<= 8)
+ *   GAMMA_OUT_BITS    duty resolution (= BAM bit planes in led_pwm.c)
+ *   SINE_QUARTER_BITS quarter-wave entries = 2^SINE_QUARTER_BITS (+ 1)
+ *
+ * sine_q15() covers the full circle from the quarter table by symmetry
+ * and interpolates linearly between entries: one multiply, no floats.
+ ******************************************************************************
+ */
+
+#ifndef BRIGHTNESS_H
+#define BRIGHTNESS_H
+
+#include <stdint.h>
+
+#define GAMMA_X100          220
+#define GAMMA_IN_BITS       8
+#define GAMMA_OUT_BITS      8
+#define SINE_QUARTER_BITS   6
+
+#define GAMMA_LEVELS        (1 << GAMMA_IN_BITS)
+#define GAMMA_MAX           ((1 << GAMMA_OUT_BITS) - 1)
+#define SINE_QUARTER        (1 << SINE_QUARTER_BITS)
+#define SINE_FRAC_BITS      (14 - SINE_QUARTER_BITS)   // Phase bits below an entry
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint16_t duty[GAMMA_LEVELS];
+} GammaLut;
+
+typedef struct {
+    int16_t q15[SINE_QUARTER + 1];  // sin(0 .. pi/2), last entry = 32767
+} SineQuarter;
+
+extern const GammaLut gamma_lut;
+extern const SineQuarter sine_quarter;
+
+// Perceptual level 0..255 -> duty 0..GAMMA_MAX
+static inline uint16_t gamma_apply(uint8_t level) {
+    return gamma_lut.duty[level >> (8 - GAMMA_IN_BITS)];
+}
+
+// phase: 0..65535 = one full turn. Result: sin() in Q15
+static inline int16_t sine_q15(uint16_t phase) {
+    uint16_t pos = phase & 0x3FFF;                      // Position in the quadrant
+
+    if (phase & 0x4000) {
+        pos = 0x4000 - pos;                             // 2nd / 4th quadrant: mirror
+    }
+    uint16_t index = pos >> SINE_FRAC_BITS;
+    uint16_t frac = pos & ((1 << SINE_FRAC_BITS) - 1);
+    int32_t value = sine_quarter.q15[index];
+
+    if (frac) {
+        value += ((sine_quarter.q15[index + 1] - value) * (int32_t)frac) >> SINE_FRAC_BITS;
+    }
+    return (int16_t)((phase & 0x8000) ? -value : value);  // 3rd / 4th: negative
+}
+
+// Breathing curve: phase -> perceptual level 0..255 (dark at phase 0)
+static inline uint8_t breathe_level(uint16_t phase) {
+    return (uint8_t)((sine_q15((uint16_t)(phase - 0x4000)) + 32768) >> 8);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BRIGHTNESS_H
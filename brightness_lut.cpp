@@ -0,0 +1,102 @@
+/**
+ ******************************************************************************
+ * @file           : brightness_lut.cpp
+ * @brief          : Gamma and sine tables, generated at compile time
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * C++17 only for constexpr: the tables are constant-initialised objects
+ * with C linkage, so they land in .rodata (flash) exactly like a
+ * hand-typed C array, and brightness.h reads them from C. The small math
+ * routines below run inside the compiler, never on the target.
+ ******************************************************************************
+ */
+
+#include "brightness.h"
+
+namespace {
+
+constexpr double LN2 = 0.69314718055994530942;
+constexpr double PI = 3.14159265358979323846;
+
+// ln(x), x > 0: scale into [1, 2), then 2 * atanh((x - 1) / (x + 1))
+constexpr double ct_ln(double x) {
+    int k = 0;
+    while (x >= 2.0) { x /= 2.0; k++; }
+    while (x < 1.0)  { x *= 2.0; k--; }
+
+    double y = (x - 1.0) / (x + 1.0);
+    double term = y, sum = 0.0;
+    for (int n = 1; n < 41; n += 2) {
+        sum += term / n;
+        term *= y * y;
+    }
+    return 2.0 * sum + k * LN2;
+}
+
+// e^x: halve x until small, Taylor series, square back up
+constexpr double ct_exp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) { x /= 2.0; halvings++; }
+
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 20; n++) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings--) sum *= sum;
+    return sum;
+}
+
+constexpr double ct_pow(double base, double exponent) {
+    return (base <= 0.0) ? 0.0 : ct_exp(exponent * ct_ln(base));
+}
+
+// sin(x) for 0 <= x <= pi/2
+constexpr double ct_sin(double x) {
+    double term = x, sum = 0.0;
+    for (int n = 1; n < 30; n += 2) {
+        sum += term;
+        term *= -x * x / ((n + 1) * (n + 2));
+    }
+    return sum;
+}
+
+constexpr GammaLut make_gamma() {
+    GammaLut lut{};
+    for (int i = 0; i < GAMMA_LEVELS; i++) {
+        double x = (double)i / (GAMMA_LEVELS - 1);
+        lut.duty[i] = (uint16_t)(GAMMA_MAX * ct_pow(x, GAMMA_X100 / 100.0) + 0.5);
+    }
+    return lut;
+}
+
+constexpr SineQuarter make_sine() {
+    SineQuarter table{};
+    for (int i = 0; i <= SINE_QUARTER; i++) {
+        double v = 32767.0 * ct_sin(PI / 2.0 * i / SINE_QUARTER) + 0.5;
+        table.q15[i] = (int16_t)(v > 32767.0 ? 32767.0 : v);
+    }
+    return table;
+}
+
+constexpr GammaLut gamma_ct = make_gamma();
+constexpr SineQuarter sine_ct = make_sine();
+
+static_assert(gamma_ct.duty[0] == 0 && gamma_ct.duty[GAMMA_LEVELS - 1] == GAMMA_MAX,
+              "Gamma table must span 0..GAMMA_MAX");
+static_assert(sine_ct.q15[0] == 0 && sine_ct.q15[SINE_QUARTER] == 32767,
+              "Sine table must span 0..32767");
+
+constexpr bool gamma_monotonic() {
+    for (int i = 1; i < GAMMA_LEVELS; i++) {
+        if (gamma_ct.duty[i] < gamma_ct.duty[i - 1]) return false;
+    }
+    return true;
+}
+static_assert(gamma_monotonic(), "Gamma table must never decrease");
+
+} // namespace
+
+extern "C" const GammaLut gamma_lut = gamma_ct;
+extern "C" const SineQuarter sine_quarter = sine_ct;
@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @file           : button.c
+ * @brief          : USER button (PA0), sampled every tick and debounced
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ */
+
+#include "button.h"
+#include "board.h"
+#include "systick.h"
+#include "debounce.h"
+#include "stm32f303_regs.h"
+#include "profiler.h"
+#include "pin_config.h"
+
+static GestureRecognizer *button_target;
+static Debouncer button_db;
+static uint32_t button_since;          // Tick the pin first moved off the debounced level
+
+static const DebounceConfig button_debounce = {
+    DEBOUNCE_INTEGRATOR, BUTTON_DEBOUNCE_MS * 1000, 1000
+};
+
+// PA0 as INPUT (Discovery board has an external pull-down)
+static const PinConfig button_pins[] = {
+    PIN_INPUT(GPIO_PORT_A, BUTTON_PIN, PIN_PULL_NONE),
+};
+
+// SysTick hook: one sample per tick
+static void button_tick(uint32_t now) {
+    PROF_ENTER(PROF_BUTTON_TICK);
+    uint8_t raw = button_read();
+    uint8_t level = button_db.level;
+    uint32_t rest = level ? button_db.count_max : 0;
+
+    if (button_db.count == rest && raw != level) {
+        button_since = now;             // Leaving the rest value: maybe the first contact
+    }
+    debounce_sample(&button_db, raw, now * 1000);
+    if (button_db.level != level) {
+        gesture_push_edge(button_target, button_db.level, now, button_since);
+    }
+    PROF_EXIT(PROF_BUTTON_TICK);
+}
+
+void button_init(GestureRecognizer *target) {
+    button_target = target;
+    debounce_init(&button_db, &button_debounce);
+
+    pin_config_apply(button_pins, PIN_TABLE_SIZE(button_pins));
+    systick_add_hook(button_tick);
+}
+
+uint8_t button_read(void) {
+    return (GPIOA_IDR & (1 << BUTTON_PIN)) ? 1 : 0;
+}
@@ -0,0 +1,441 @@
+/**
+ ******************************************************************************
+ * @file           : can.c
+ * @brief          : bxCAN receive: hardware filter banks, zero-copy RX ring
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 5, 2026
+ ******************************************************************************
+ */
+
+#include "can.h"
+#include "board.h"
+#include "clock_config.h"
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+#include "systick.h"
+#include "timer.h"
+#include "uart.h"
+#include "fmt.h"
+
+#define CAN_RX_PIN          8           // PB8
+#define CAN_TX_PIN          9           // PB9
+#define CAN_AF              9           // AF9 = CAN
+
+#define FMI_MAX             (CAN_FILTER_BANKS * 4)  // Filter numbers per FIFO
+#define STATS_PERIOD_MS     1000
+
+#if CAN_FILTERS_MAX > 255 || (CAN_RX_RING_SIZE & (CAN_RX_RING_SIZE - 1))
+#error "CAN_FILTERS_MAX must fit a byte, CAN_RX_RING_SIZE be a power of 2"
+#endif
+
+// RX pulled up: recessive while no transceiver drives it
+static const PinConfig can_pins[] = {
+    { GPIO_PORT_B, CAN_RX_PIN, PIN_MODE_AF, PIN_PUSH_PULL, PIN_SPEED_HIGH, PIN_PULL_UP, CAN_AF },
+    PIN_ALT(GPIO_PORT_B, CAN_TX_PIN, CAN_AF, PIN_SPEED_HIGH),
+};
+
+static CanFrame ring[CAN_RX_RING_SIZE];
+static volatile uint8_t head;           // Written by the RX interrupts
+static volatile uint8_t tail;           // Written by the reader
+static uint8_t fmi_filter[2][FMI_MAX];  // Filter match index -> filter
+static uint8_t filter_count;
+static uint8_t on_bus;
+static uint8_t listening;
+
+static CanStats stats;
+static CanCounts second_start;          // stats.total when the second began
+static Timer stats_timer;
+static uint8_t stats_started;
+
+// The timer wheel is also advanced from SysTick
+static inline uint32_t irq_save(void) {
+#ifdef HOST_SIM
+    return 0;
+#else
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    return primask;
+#endif
+}
+
+static inline void irq_restore(uint32_t primask) {
+#ifdef HOST_SIM
+    (void)primask;
+#else
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+#endif
+}
+
+// ============================================================================
+// Filter banks
+// ============================================================================
+typedef enum {
+    LAYOUT_EXT_MASK,                // 32-bit mask: 1 filter per bank
+    LAYOUT_EXT_LIST,                // 32-bit list: 2
+    LAYOUT_STD_MASK,                // 2 x 16-bit mask: 2
+    LAYOUT_STD_LIST,                // 4 x 16-bit list: 4
+    LAYOUT_COUNT
+} Layout;
+
+static const uint8_t layout_slots[LAYOUT_COUNT] = { 1, 2, 2, 4 };
+
+static Layout layout_of(const CanFilter *f) {
+    if (f->ext) {
+        return (f->mask & CAN_EXT_EXACT) == CAN_EXT_EXACT ? LAYOUT_EXT_LIST : LAYOUT_EXT_MASK;
+    }
+    return (f->mask & CAN_STD_EXACT) == CAN_STD_EXACT ? LAYOUT_STD_LIST : LAYOUT_STD_MASK;
+}
+
+uint8_t can_filter_banks(const CanFilter *filters, uint8_t count) {
+    uint8_t n[2][LAYOUT_COUNT] = { { 0 } };
+    uint8_t banks = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        n[filters[i].fifo & 1][layout_of(&filters[i])]++;
+    }
+    for (uint8_t fifo = 0; fifo < 2; fifo++) {
+        for (uint8_t l = 0; l < LAYOUT_COUNT; l++) {
+            banks += (n[fifo][l] + layout_slots[l] - 1) / layout_slots[l];
+        }
+    }
+    return banks;
+}
+
+// 32-bit layout (as RIR). Lists compare every bit, so RTR stays 0: data frames
+static uint32_t word32(uint32_t id, uint8_t ext) {
+    return ext ? ((id & CAN_EXT_EXACT) << CAN_IR_EXID_Pos) | CAN_IR_IDE
+               : (id & CAN_STD_EXACT) << CAN_IR_STID_Pos;
+}
+
+// A mask always checks IDE and RTR too
+static uint32_t mask32(const CanFilter *f) {
+    return word32(f->mask, 1) | CAN_IR_IDE | CAN_IR_RTR;
+}
+
+static uint32_t word16(uint32_t id) {
+    return (id & CAN_STD_EXACT) << CAN_F16_STID_Pos;
+}
+
+static uint32_t mask16(const CanFilter *f) {
+    return word16(f->mask) | CAN_F16_IDE | CAN_F16_RTR;
+}
+
+// One bank; 'idx' holds layout_slots[layout] filters (a short bank
+// repeats its last). Their filter match indexes follow 'fmi'.
+static void bank_load(uint8_t bank, Layout layout, const CanFilter *filters,
+                      const uint8_t idx[4], uint8_t fifo, uint8_t *fmi) {
+    const CanFilter *f0 = &filters[idx[0]], *f1 = &filters[idx[1]];
+    uint32_t bit = 1u << bank;
+    uint32_t r1, r2;
+
+    switch (layout) {
+    case LAYOUT_EXT_MASK:
+        r1 = word32(f0->id, 1);
+        r2 = mask32(f0);
+        break;
+    case LAYOUT_EXT_LIST:
+        r1 = word32(f0->id, 1);
+        r2 = word32(f1->id, 1);
+        break;
+    case LAYOUT_STD_MASK:
+        r1 = word16(f0->id) | (mask16(f0) << 16);
+        r2 = word16(f1->id) | (mask16(f1) << 16);
+        break;
+    default:
+        r1 = word16(f0->id) | (word16(f1->id) << 16);
+        r2 = word16(filters[idx[2]].id) | (word16(filters[idx[3]].id) << 16);
+        break;
+    }
+
+    if (layout == LAYOUT_EXT_MASK || layout == LAYOUT_EXT_LIST) {
+        CAN_FS1R |= bit;
+    }
+    if (layout == LAYOUT_EXT_LIST || layout == LAYOUT_STD_LIST) {
+        CAN_FM1R |= bit;
+    }
+    if (fifo) {
+        CAN_FFA1R |= bit;
+    }
+    CAN_FR1(bank) = r1;
+    CAN_FR2(bank) = r2;
+    CAN_FA1R |= bit;
+
+    // Numbered per FIFO in bank order: FR1 (low half first), then FR2
+    for (uint8_t s = 0; s < layout_slots[layout]; s++) {
+        fmi_filter[fifo][(*fmi)++] = idx[s];
+    }
+}
+
+// Banks in order: FIFO 0's, then FIFO 1's, then the unused ones (FIFO 0,
+// inactive) - those come after every number in use
+static void filters_load(const CanFilter *filters, uint8_t count) {
+    uint8_t bank = 0;
+
+    CAN_FMR |= CAN_FMR_FINIT;
+    CAN_FA1R = 0;
+    CAN_FM1R = 0;
+    CAN_FS1R = 0;
+    CAN_FFA1R = 0;
+
+    for (uint8_t fifo = 0; fifo < 2; fifo++) {
+        uint8_t fmi = 0;
+
+        for (uint8_t l = 0; l < LAYOUT_COUNT; l++) {
+            uint8_t idx[4];
+            uint8_t used = 0;
+
+            for (uint8_t i = 0; i < count; i++) {
+                if ((filters[i].fifo & 1) != fifo || layout_of(&filters[i]) != l) {
+                    continue;
+                }
+                idx[used++] = i;
+                if (used == layout_slots[l]) {
+                    bank_load(bank++, (Layout)l, filters, idx, fifo, &fmi);
+                    used = 0;
+                }
+            }
+            if (used) {
+                for (uint8_t s = used; s < layout_slots[l]; s++) {
+                    idx[s] = idx[used - 1];
+                }
+                bank_load(bank++, (Layout)l, filters, idx, fifo, &fmi);
+            }
+        }
+    }
+    CAN_FMR &= ~CAN_FMR_FINIT;
+}
+
+// ============================================================================
+// Init mode and bit timing
+// ============================================================================
+static uint8_t init_mode(uint8_t on) {
+    if (on) {
+        CAN_MCR |= CAN_MCR_INRQ;
+    } else {
+        CAN_MCR &= ~CAN_MCR_INRQ;               // Joins after 11 recessive bits
+    }
+    for (uint32_t i = 0; i < CAN_INIT_POLL_LIMIT; i++) {
+        if (((CAN_MSR & CAN_MSR_INAK) != 0) == on) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// The most time quanta per bit that divide the clock exactly, sample
+// point nearest CAN_SAMPLE_PERMILLE; 0 = CAN_BITRATE is out of reach
+static uint32_t bit_timing(uint32_t pclk1_hz) {
+    for (uint32_t tq = 25; tq >= 8; tq--) {
+        uint32_t per_bit = CAN_BITRATE * tq;
+        if (pclk1_hz % per_bit) {
+            continue;
+        }
+        uint32_t brp = pclk1_hz / per_bit;
+        uint32_t ts1 = (tq * CAN_SAMPLE_PERMILLE + 500) / 1000 - 1;     // After the sync quantum
+        uint32_t ts2 = tq - 1 - ts1;
+        if (brp > 1024 || ts1 < 1 || ts1 > 16 || ts2 < 1 || ts2 > 8) {
+            continue;
+        }
+        uint32_t sjw = ts2 < 4 ? ts2 : 4;
+        return ((brp - 1) << CAN_BTR_BRP_Pos) | ((ts1 - 1) << CAN_BTR_TS1_Pos) |
+               ((ts2 - 1) << CAN_BTR_TS2_Pos) | ((sjw - 1) << CAN_BTR_SJW_Pos);
+    }
+    return 0;
+}
+
+// A wrong bit rate would disturb the bus: without one, stay off it
+static void can_on_clock_change(const ClockFreqs *freqs) {
+    uint32_t btr = bit_timing(freqs->pclk1_hz);
+
+    on_bus = 0;
+    if (!init_mode(1) || !btr) {
+        return;
+    }
+    CAN_BTR = (CAN_BTR & (CAN_BTR_LBKM | CAN_BTR_SILM)) | btr;
+    on_bus = init_mode(0);
+}
+
+// ============================================================================
+// Receive: each interrupt empties its FIFO into the ring
+// ============================================================================
+static void rx_drain(uint8_t fifo) {
+    uint32_t rfr;
+
+    while ((rfr = CAN_RFR(fifo)) & CAN_RFR_FMP_Msk) {
+        uint32_t rdtr = CAN_RDTR(fifo);
+        uint8_t filter = fmi_filter[fifo][((rdtr >> CAN_RDTR_FMI_Pos) & 0xFF) % FMI_MAX];
+        uint8_t next = (head + 1) & (CAN_RX_RING_SIZE - 1);
+
+        stats.total.frames++;
+        stats.total.hits[filter]++;
+        if (next == tail) {
+            stats.total.ring_drops++;
+        } else {
+            CanFrame *f = &ring[head];
+            uint32_t rir = CAN_RIR(fifo);
+
+            f->ext = (rir & CAN_IR_IDE) != 0;
+            f->id = f->ext ? rir >> CAN_IR_EXID_Pos : rir >> CAN_IR_STID_Pos;
+            f->rtr = (rir & CAN_IR_RTR) != 0;
+            f->dlc = (uint8_t)(rdtr & CAN_RDTR_DLC_Msk);
+            f->filter = filter;
+            f->word[0] = CAN_RDLR(fifo);
+            f->word[1] = CAN_RDHR(fifo);
+            f->ms = get_time_ms();
+            __asm volatile ("" ::: "memory");   // The frame before the index
+            head = next;
+        }
+        CAN_RFR(fifo) = CAN_RFR_RFOM;           // Next frame into the mailbox
+    }
+
+    if (rfr & CAN_RFR_FOVR) {
+        CAN_RFR(fifo) = CAN_RFR_FOVR;
+        stats.total.overruns++;
+    }
+}
+
+void USB_LP_CAN_RX0_IRQHandler(void) {
+    rx_drain(0);
+}
+
+void CAN_RX1_IRQHandler(void) {
+    rx_drain(1);
+}
+
+// ============================================================================
+// Statistics: one second's worth, from the running totals
+// ============================================================================
+static uint32_t delta(uint32_t *start, uint32_t now) {
+    uint32_t d = now - *start;
+    *start = now;
+    return d;
+}
+
+static void stats_second(Timer *t, uint32_t now_ms) {
+    (void)t;
+    (void)now_ms;
+    stats.last_second.frames = delta(&second_start.frames, stats.total.frames);
+    stats.last_second.overruns = delta(&second_start.overruns, stats.total.overruns);
+    stats.last_second.ring_drops = delta(&second_start.ring_drops, stats.total.ring_drops);
+    for (uint8_t i = 0; i < filter_count; i++) {
+        stats.last_second.hits[i] = delta(&second_start.hits[i], stats.total.hits[i]);
+    }
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+uint8_t can_init(const CanFilter *filters, uint8_t count, CanMode mode) {
+    if (count > CAN_FILTERS_MAX || can_filter_banks(filters, count) > CAN_FILTER_BANKS) {
+        return 0;
+    }
+    filter_count = count;
+
+    RCC_APB1ENR |= RCC_APB1ENR_CANEN;
+    pin_config_apply(can_pins, PIN_TABLE_SIZE(can_pins));
+
+    CAN_MCR &= ~CAN_MCR_SLEEP;                  // Out of reset asleep
+    if (!init_mode(1)) {
+        return 0;
+    }
+    CAN_MCR |= CAN_MCR_ABOM | CAN_MCR_TXFP | CAN_MCR_RFLM;
+    CAN_BTR = mode == CAN_MODE_SILENT_LOOPBACK ? CAN_BTR_LBKM | CAN_BTR_SILM : 0;
+    filters_load(filters, count);
+
+    CAN_IER = CAN_IER_FMPIE(0) | CAN_IER_FOVIE(0) | CAN_IER_FMPIE(1) | CAN_IER_FOVIE(1);
+    NVIC_SET_PRIORITY(USB_LP_CAN_RX0_IRQn, IRQ_PRIO_CAN);
+    NVIC_SET_PRIORITY(CAN_RX1_IRQn, IRQ_PRIO_CAN);
+    NVIC_ENABLE_IRQ(USB_LP_CAN_RX0_IRQn);
+    NVIC_ENABLE_IRQ(CAN_RX1_IRQn);
+
+    // Called again (new list or mode): the timer and the listener stay
+    if (!stats_started) {
+        uint32_t primask = irq_save();
+        timer_init(&stats_timer, stats_second, 0);
+        timer_start(&system_timers, &stats_timer, STATS_PERIOD_MS, STATS_PERIOD_MS);
+        irq_restore(primask);
+        stats_started = 1;
+    }
+    if (!listening) {
+        listening = clock_add_listener(can_on_clock_change);    // Bit timing, then onto the bus
+    } else {
+        can_on_clock_change(clock_get_freqs());
+    }
+    return on_bus;
+}
+
+// ============================================================================
+// Application side
+// ============================================================================
+const CanFrame *can_rx_peek(void) {
+    uint8_t t = tail;
+    return t == head ? 0 : &ring[t];
+}
+
+void can_rx_release(void) {
+    uint8_t t = tail;
+
+    if (t != head) {
+        __asm volatile ("" ::: "memory");       // Done with the frame first
+        tail = (t + 1) & (CAN_RX_RING_SIZE - 1);
+    }
+}
+
+uint8_t can_send(const CanFrame *frame) {
+    uint32_t tsr = CAN_TSR;
+
+    if (!(tsr & CAN_TSR_TME_ALL)) {
+        return 0;
+    }
+    uint8_t mb = (tsr >> CAN_TSR_CODE_Pos) & 3;
+    uint32_t tir = word32(frame->id, frame->ext) | (frame->rtr ? CAN_IR_RTR : 0);
+
+    CAN_TDTR(mb) = frame->dlc;
+    CAN_TDLR(mb) = frame->word[0];
+    CAN_TDHR(mb) = frame->word[1];
+    CAN_TIR(mb) = tir | CAN_TIR_TXRQ;
+    return 1;
+}
+
+const CanStats *can_stats(void) {
+    return &stats;
+}
+
+// "can: 1843 frames/s, 0 overruns/s, 0 dropped/s (total 18430, 1, 12), tec 0 rec 0"
+// "can filter 0: 120/s (1200)"
+void can_dump_uart(void) {
+    char line[128];
+    char *p = line;
+    uint32_t esr = CAN_ESR;
+
+    p += fmt_str(p, "can: ", 0);
+    p += fmt_dec(p, stats.last_second.frames);
+    p += fmt_str(p, " frames/s, ", 0);
+    p += fmt_dec(p, stats.last_second.overruns);
+    p += fmt_str(p, " overruns/s, ", 0);
+    p += fmt_dec(p, stats.last_second.ring_drops);
+    p += fmt_str(p, " dropped/s (total ", 0);
+    p += fmt_dec(p, stats.total.frames);
+    p += fmt_str(p, ", ", 0);
+    p += fmt_dec(p, stats.total.overruns);
+    p += fmt_str(p, ", ", 0);
+    p += fmt_dec(p, stats.total.ring_drops);
+    p += fmt_str(p, "), tec ", 0);
+    p += fmt_dec(p, (esr >> CAN_ESR_TEC_Pos) & 0xFF);
+    p += fmt_str(p, " rec ", 0);
+    p += fmt_dec(p, (esr >> CAN_ESR_REC_Pos) & 0xFF);
+    p += fmt_str(p, on_bus ? (esr & CAN_ESR_BOFF ? ", bus-off\r\n" : "\r\n") : ", off the bus\r\n", 0);
+    uart_write(line, (uint32_t)(p - line));
+
+    for (uint8_t i = 0; i < filter_count; i++) {
+        p = line;
+        p += fmt_str(p, "can filter ", 0);
+        p += fmt_dec(p, i);
+        p += fmt_str(p, ": ", 0);
+        p += fmt_dec(p, stats.last_second.hits[i]);
+        p += fmt_str(p, "/s (", 0);
+        p += fmt_dec(p, stats.total.hits[i]);
+        p += fmt_str(p, ")\r\n", 0);
+        uart_write(line, (uint32_t)(p - line));
+    }
+}
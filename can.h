@@ -0,0 +1,117 @@
+/**
+ ******************************************************************************
+ * @file           : can.h
+ * @brief          : bxCAN receive: hardware filter banks, zero-copy RX ring
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 5, 2026
+ ******************************************************************************
+ * CAN_BITRATE on PB8 / PB9 (board.h). can_init() turns a list of ID /
+ * mask filters into the 14 filter banks, so frames nobody asked for are
+ * dropped by the hardware and never cost an interrupt:
+ *
+ *   static const CanFilter filters[] = {
+ *       { 0x0C0, 0x7F0, 0, 0 },                 // 0x0C0-0x0CF -> FIFO 0
+ *       { 0x18FEF100, CAN_EXT_EXACT, 1, 1 },    // One 29-bit ID -> FIFO 1
+ *   };
+ *   can_init(filters, 2, CAN_MODE_NORMAL);
+ *
+ * A filter matches data frames (not remote frames) whose ID equals 'id'
+ * in every bit set in 'mask'. Each goes into the densest bank layout
+ * that holds it: exact 11-bit IDs 4 to a bank (16-bit list), masked
+ * 11-bit 2 (16-bit mask), exact 29-bit 2 (32-bit list), masked 29-bit
+ * 1 (32-bit mask). can_filter_banks() tells how many banks a list needs.
+ *
+ * Both FIFOs interrupt on a pending frame; the interrupt drains the
+ * whole FIFO straight into a ring of CanFrame. The application reads
+ * the frames where they are and hands each slot back:
+ *
+ *   const CanFrame *f;
+ *   while ((f = can_rx_peek()) != 0) {
+ *       use(f->id, f->data, f->dlc);
+ *       can_rx_release();
+ *   }
+ *
+ * One interrupt, one reader; no locks. The ring holds
+ * CAN_RX_RING_SIZE - 1 frames, more are dropped (counted).
+ *
+ * Statistics (can_stats()): running totals and the same counters for
+ * the last whole second, rolled over by a software timer (timer.h).
+ * A hardware FIFO overrun loses one frame or more before the interrupt
+ * gets to it; it is counted once per overrun flag.
+ *
+ * CAN_MODE_SILENT_LOOPBACK sends every transmitted frame back to our own
+ * receiver only: the whole path, filters included, without a bus (console
+ * 'c'). can_sim.c runs this driver against a simulated bxCAN.
+ ******************************************************************************
+ */
+
+#ifndef CAN_H
+#define CAN_H
+
+#include <stdint.h>
+
+#define CAN_FILTER_BANKS    14
+#define CAN_FILTERS_MAX     32
+#define CAN_RX_RING_SIZE    32          // Frames (power of 2)
+#define CAN_SAMPLE_PERMILLE 875         // Sample point, as close as the clock allows
+#define CAN_INIT_POLL_LIMIT 100000      // Status polls for init mode
+
+#define CAN_STD_EXACT       0x7FFu
+#define CAN_EXT_EXACT       0x1FFFFFFFu
+
+typedef enum {
+    CAN_MODE_NORMAL,
+    CAN_MODE_SILENT_LOOPBACK,
+} CanMode;
+
+typedef struct {
+    uint32_t id;
+    uint32_t mask;                  // 1 = this ID bit must match
+    uint8_t ext;                    // 29-bit IDs (else 11-bit)
+    uint8_t fifo;                   // 0 or 1
+} CanFilter;
+
+typedef struct {
+    uint32_t id;                    // 11 or 29 bits
+    uint8_t ext;
+    uint8_t rtr;                    // Remote frame (send only)
+    uint8_t dlc;                    // 0..8
+    uint8_t filter;                 // Index into can_init()'s list
+    union {
+        uint8_t data[8];
+        uint32_t word[2];
+    };
+    uint32_t ms;                    // Taken from the FIFO (get_time_ms())
+} CanFrame;
+
+typedef struct {
+    uint32_t frames;                // Taken from the hardware FIFOs
+    uint32_t overruns;              // Hardware FIFO overflowed
+    uint32_t ring_drops;            // Taken, but the ring was full
+    uint32_t hits[CAN_FILTERS_MAX]; // Frames per filter
+} CanCounts;
+
+typedef struct {
+    CanCounts total;
+    CanCounts last_second;
+} CanStats;
+
+// Bit timing from the clock (clock_config.h), filters, interrupts; again
+// to change the list or the mode. 0 = the list needs more than
+// CAN_FILTER_BANKS banks (nothing changed), or the controller is not on
+// the bus (no init mode, or no exact bit timing for CAN_BITRATE).
+uint8_t can_init(const CanFilter *filters, uint8_t count, CanMode mode);
+
+uint8_t can_filter_banks(const CanFilter *filters, uint8_t count);
+
+// Oldest received frame, in the ring; 0 = none
+const CanFrame *can_rx_peek(void);
+void can_rx_release(void);
+
+// Queue a frame in a free TX mailbox; 0 = all three busy
+uint8_t can_send(const CanFrame *frame);
+
+const CanStats *can_stats(void);
+void can_dump_uart(void);
+
+#endif // CAN_H
@@ -0,0 +1,801 @@
+/**
+ ******************************************************************************
+ * @file           : can_sim.c
+ * @brief          : Host tool - can.c against a simulated bxCAN on a busy bus
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 5, 2026
+ ******************************************************************************
+ * Runs the unchanged driver and software timers (HOST_SIM register space,
+ * host_sim.h) against a model of the bxCAN: init / sleep handshake, bit
+ * timing, the 14 filter banks matched from their registers with the
+ * reference manual's priority and filter numbering, two 3-frame receive
+ * FIFOs in locked mode (FMP, FULL, FOVR, RFOM), three TX mailboxes and
+ * silent loopback. Frames take their time on the wire at CAN_BITRATE
+ * without stuff bits (the densest the bus gets); interrupts are taken
+ * between bus events.
+ *
+ *   gcc -DHOST_SIM -O2 -o can_sim can_sim.c can.c timer.c pin_config.c \
+ *       fmt.c host_sim.c
+ *   ./can_sim [seconds]
+ *
+ * The bus is full: random 11 / 29-bit data and remote frames back to
+ * back, most of them near one of the filters. The application reads the
+ * ring every ms. Checked:
+ *   - setup: bit rate exact at PCLK1, sample point 80-90 %, BTR and the
+ *     filter registers only written in init mode
+ *   - for every frame, the banks accept it exactly when the filter list
+ *     says so, and the filter it is reported under matches it and feeds
+ *     its FIFO
+ *   - every frame the driver takes arrives in FIFO order, unchanged,
+ *     unless the ring was full; the counts balance: hardware overruns,
+ *     ring drops and received add up to what the banks accepted
+ *   - interrupts held off from IRQ_HOLD_AT_MS until a hardware FIFO
+ *     overruns (each overrun flag counted once), and the reader stalled
+ *     for READER_STALL_MS (the ring drops, counted)
+ *   - the per-second counters against the model's own count per second
+ *   - a filter list too big for the banks is refused
+ *   - silent loopback: of frames sent with can_send(), the filtered ones
+ *     come back, in order
+ * Exit code 1 on any failure.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "can.h"
+#include "clock_config.h"
+#include "systick.h"
+#include "timer.h"
+#include "board.h"
+#include "host_sim.h"
+#include "stm32f303_regs.h"
+
+#define DEFAULT_SECONDS     10
+#define PCLK1_HZ            36000000
+#define BIT_NS              (1000000000u / CAN_BITRATE)
+#define FIFO_DEPTH          3
+#define IRQ_HOLD_AT_MS      2000
+#define READER_STALL_AT_MS  4000
+#define READER_STALL_MS     50
+#define STORM_LIMIT         64
+
+#define RFR_MODEL           (1u << 31)  // RF0R / RF1R written by the model, not the driver
+
+#define REG(addr)           (*host_sim_peek(addr))
+#define A(reg)              (CAN_BASE + (reg))
+#define RFR_ADDR(fifo)      A(0x00C + 4 * (fifo))
+#define TIR_ADDR(mb)        A(0x180 + 0x10 * (mb))
+#define RIR_ADDR(fifo)      A(0x1B0 + 0x10 * (fifo))
+#define FR1_ADDR(bank)      A(0x240 + 8 * (bank))
+
+static uint64_t now_ns;
+static uint32_t errors;
+
+static void fail(const char *what) {
+    if (errors++ < 10) {
+        printf("  FAIL at %.3f ms: %s\n", now_ns / 1e6, what);
+    }
+}
+
+static uint32_t rnd(void) {
+    static uint32_t x = 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// ============================================================================
+// Board stubs: APB1 at 36 MHz, the SysTick hook is called by hand
+// ============================================================================
+static const ClockFreqs freqs = { 2 * PCLK1_HZ, 2 * PCLK1_HZ, PCLK1_HZ, 2 * PCLK1_HZ };
+static SysTickHook tick_hook;
+
+uint8_t clock_add_listener(ClockListener listener) {
+    listener(&freqs);
+    return 1;
+}
+
+const ClockFreqs *clock_get_freqs(void) {
+    return &freqs;
+}
+
+uint8_t systick_add_hook(SysTickHook hook) {
+    tick_hook = hook;
+    return 1;
+}
+
+uint32_t get_time_ms(void) {
+    return (uint32_t)(now_ns / 1000000);
+}
+
+void uart_write(const char *data, uint32_t len) {
+    fwrite(data, 1, len, stdout);
+}
+
+// ============================================================================
+// The filter list: every bank layout, both FIFOs, part-filled banks, and
+// 0x0C5 both in a FIFO 0 range and exact on FIFO 1 (the list wins)
+// ============================================================================
+static const CanFilter filters[] = {
+    { 0x0C0, 0x7F0, 0, 0 },
+    { 0x100, 0x700, 0, 0 },
+    { 0x3A0, 0x7F8, 0, 0 },
+    { 0x244, CAN_STD_EXACT, 0, 0 },
+    { 0x245, CAN_STD_EXACT, 0, 0 },
+    { 0x300, CAN_STD_EXACT, 0, 0 },
+    { 0x301, CAN_STD_EXACT, 0, 0 },
+    { 0x7FF, CAN_STD_EXACT, 0, 0 },
+    { 0x18FEF100, CAN_EXT_EXACT, 1, 0 },
+    { 0x0CF00400, 0x1FFFFF00, 1, 1 },
+    { 0x18FF0000, 0x1FFF0000, 1, 1 },
+    { 0x18FEF117, CAN_EXT_EXACT, 1, 1 },
+    { 0x18FEEE00, CAN_EXT_EXACT, 1, 1 },
+    { 0x1FFFFFFF, CAN_EXT_EXACT, 1, 1 },
+    { 0x123, CAN_STD_EXACT, 0, 1 },
+    { 0x0C5, CAN_STD_EXACT, 0, 1 },
+    { 0x600, 0x700, 0, 1 },
+};
+
+#define FILTER_COUNT        ((uint8_t)(sizeof(filters) / sizeof(filters[0])))
+#define FILTER_BANKS        11
+
+static uint8_t filter_matches(const CanFilter *flt, uint32_t id, uint8_t ext, uint8_t rtr) {
+    uint32_t all = ext ? CAN_EXT_EXACT : CAN_STD_EXACT;
+    return !rtr && flt->ext == ext && ((id ^ flt->id) & flt->mask & all) == 0;
+}
+
+static uint8_t list_accepts(uint32_t id, uint8_t ext, uint8_t rtr) {
+    for (uint8_t i = 0; i < FILTER_COUNT; i++) {
+        if (filter_matches(&filters[i], id, ext, rtr)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// bxCAN model
+// ============================================================================
+typedef struct {
+    uint32_t id;
+    uint8_t ext, rtr, dlc;
+    uint8_t data[8];
+    uint8_t fmi;
+} BusFrame;
+
+typedef struct {
+    BusFrame *frames;
+    uint32_t n, cap;
+    uint32_t cursor;                    // Next one the application should see
+} FrameLog;
+
+static struct {
+    BusFrame fifo[2][FIFO_DEPTH];
+    uint8_t level[2];
+    uint8_t fovr[2], full[2];
+    BusFrame tx[3];
+    uint8_t tx_pending[3];
+    uint32_t tx_order[3];               // Request order (TXFP)
+    uint32_t tx_requests;
+    uint8_t expect_loopback;
+    uint32_t btr_checked;
+    double sample_point;
+    uint32_t brp, tq;
+    // Tallies
+    uint32_t on_bus_frames, list_accepted;
+    uint32_t accepted[2], lost[2], popped[2];
+    uint32_t fovr_sets, fovr_clears;
+    FrameLog log[2];                    // Frames popped, per FIFO
+} can;
+
+static struct {
+    uint32_t frames, overruns;
+} window;                               // The model's count since the last stats second
+
+static uint32_t irq_enabled;
+
+static void log_push(FrameLog *l, const BusFrame *f) {
+    if (l->n == l->cap) {
+        l->cap = l->cap ? 2 * l->cap : 4096;
+        l->frames = realloc(l->frames, l->cap * sizeof *l->frames);
+        if (!l->frames) {
+            exit(2);
+        }
+    }
+    l->frames[l->n++] = *f;
+}
+
+static uint32_t rir_word(const BusFrame *f) {
+    return (f->ext ? (f->id << CAN_IR_EXID_Pos) | CAN_IR_IDE : f->id << CAN_IR_STID_Pos) |
+           (f->rtr ? CAN_IR_RTR : 0);
+}
+
+static uint32_t data_word(const BusFrame *f, uint8_t half) {
+    const uint8_t *d = &f->data[4 * half];
+    return d[0] | (uint32_t)d[1] << 8 | (uint32_t)d[2] << 16 | (uint32_t)d[3] << 24;
+}
+
+static void rfr_update(uint8_t fifo) {
+    REG(RFR_ADDR(fifo)) = can.level[fifo] | (can.full[fifo] ? CAN_RFR_FULL : 0) |
+                          (can.fovr[fifo] ? CAN_RFR_FOVR : 0) | RFR_MODEL;
+    if (can.level[fifo]) {
+        const BusFrame *f = &can.fifo[fifo][0];
+        REG(RIR_ADDR(fifo)) = rir_word(f);
+        REG(RIR_ADDR(fifo) + 4) = f->dlc | (uint32_t)f->fmi << 8 | (uint32_t)(now_ns / BIT_NS) << 16;
+        REG(RIR_ADDR(fifo) + 8) = data_word(f, 0);
+        REG(RIR_ADDR(fifo) + 12) = data_word(f, 1);
+    }
+}
+
+static void tsr_update(void) {
+    uint32_t tsr = 0;
+    int8_t code = -1;
+
+    for (uint8_t mb = 0; mb < 3; mb++) {
+        if (!can.tx_pending[mb]) {
+            tsr |= 1u << (26 + mb);
+            if (code < 0) {
+                code = (int8_t)mb;
+            }
+        }
+    }
+    REG(A(0x008)) = tsr | (uint32_t)(code < 0 ? 0 : code) << CAN_TSR_CODE_Pos;
+}
+
+static uint8_t in_init(void) {
+    return (REG(A(0x004)) & CAN_MSR_INAK) != 0;
+}
+
+static uint8_t receiving(void) {
+    return !(REG(A(0x004)) & (CAN_MSR_INAK | CAN_MSR_SLAK)) && !(REG(A(0x200)) & CAN_FMR_FINIT);
+}
+
+static void btr_check(void) {
+    uint32_t btr = REG(A(0x01C));
+    uint32_t brp = (btr & 0x3FF) + 1;
+    uint32_t ts1 = ((btr >> CAN_BTR_TS1_Pos) & 0xF) + 1;
+    uint32_t ts2 = ((btr >> CAN_BTR_TS2_Pos) & 0x7) + 1;
+    uint32_t sjw = ((btr >> CAN_BTR_SJW_Pos) & 0x3) + 1;
+    uint32_t tq = 1 + ts1 + ts2;
+    uint8_t loopback = (btr & (CAN_BTR_LBKM | CAN_BTR_SILM)) == (CAN_BTR_LBKM | CAN_BTR_SILM);
+
+    can.btr_checked++;
+    can.brp = brp;
+    can.tq = tq;
+    can.sample_point = (1.0 + ts1) / tq;
+    if (PCLK1_HZ % (brp * tq) || PCLK1_HZ / (brp * tq) != CAN_BITRATE) {
+        fail("bit rate is not CAN_BITRATE");
+    }
+    if (can.sample_point < 0.80 || can.sample_point > 0.90 || sjw > ts2) {
+        fail("sample point outside 80-90 %, or SJW > TS2");
+    }
+    if (loopback != can.expect_loopback || ((btr & (CAN_BTR_LBKM | CAN_BTR_SILM)) && !loopback)) {
+        fail("test mode (LBKM / SILM) not the one asked for");
+    }
+}
+
+// Filter registers straight from the reference manual: filter numbers
+// per FIFO in bank order, inactive banks included; a frame matching
+// several goes to 32-bit before 16-bit, list before mask, then the
+// lowest number
+static uint8_t banks_match(const BusFrame *f, uint8_t *fifo_out, uint8_t *fmi_out) {
+    uint32_t w32 = rir_word(f);
+    uint32_t w16 = (w32 >> 21) << 5 | (f->rtr ? CAN_F16_RTR : 0) | (f->ext ? CAN_F16_IDE : 0) |
+                   ((w32 >> 18) & 7);
+    uint32_t fm1r = REG(A(0x204)), fs1r = REG(A(0x20C)), ffa1r = REG(A(0x214)), fa1r = REG(A(0x21C));
+    uint8_t number[2] = { 0, 0 };
+    uint8_t best_rank = 0xFF;
+
+    for (uint8_t bank = 0; bank < CAN_FILTER_BANKS; bank++) {
+        uint8_t fifo = (ffa1r >> bank) & 1;
+        uint8_t wide = (fs1r >> bank) & 1;
+        uint8_t list = (fm1r >> bank) & 1;
+        uint8_t slots = wide ? (list ? 2 : 1) : (list ? 4 : 2);
+        uint32_t fr1 = REG(FR1_ADDR(bank)), fr2 = REG(FR1_ADDR(bank) + 4);
+        uint8_t rank = (uint8_t)((wide ? 0 : 2) + (list ? 0 : 1));
+
+        for (uint8_t s = 0; s < slots && ((fa1r >> bank) & 1); s++) {
+            uint8_t hit;
+            if (wide && !list) {
+                hit = ((w32 ^ fr1) & fr2) == 0;
+            } else if (wide) {
+                hit = w32 == (s ? fr2 : fr1);
+            } else if (!list) {
+                uint32_t r = s ? fr2 : fr1;
+                hit = ((w16 ^ r) & (r >> 16) & 0xFFFF) == 0;
+            } else {
+                uint32_t r = s < 2 ? fr1 : fr2;
+                hit = w16 == ((s & 1) ? r >> 16 : r & 0xFFFF);
+            }
+            if (hit && rank < best_rank) {
+                best_rank = rank;
+                *fifo_out = fifo;
+                *fmi_out = (uint8_t)(number[fifo] + s);
+            }
+        }
+        number[fifo] = (uint8_t)(number[fifo] + slots);
+    }
+    return best_rank != 0xFF;
+}
+
+static void receive(BusFrame *f) {
+    uint8_t fifo = 0;
+
+    can.on_bus_frames++;
+    uint8_t listed = list_accepts(f->id, f->ext, f->rtr);
+    can.list_accepted += listed;
+    if (!banks_match(f, &fifo, &f->fmi)) {
+        if (listed) {
+            fail("frame the list accepts stopped in the banks");
+        }
+        return;
+    }
+    if (!listed) {
+        fail("frame outside the list passed the banks");
+    }
+    can.accepted[fifo]++;
+    if (can.level[fifo] == FIFO_DEPTH) {
+        if (!(REG(A(0x000)) & CAN_MCR_RFLM)) {
+            can.fifo[fifo][FIFO_DEPTH - 1] = *f;        // Not locked: the newest goes over
+        }
+        can.lost[fifo]++;
+        can.fovr_sets += !can.fovr[fifo];
+        can.fovr[fifo] = 1;
+    } else {
+        can.fifo[fifo][can.level[fifo]++] = *f;
+        can.full[fifo] |= can.level[fifo] == FIFO_DEPTH;
+    }
+    rfr_update(fifo);
+}
+
+static void pop(uint8_t fifo) {
+    if (!can.level[fifo]) {
+        fail("RFOM on an empty FIFO");
+        return;
+    }
+    log_push(&can.log[fifo], &can.fifo[fifo][0]);
+    memmove(&can.fifo[fifo][0], &can.fifo[fifo][1], sizeof can.fifo[fifo][0] * (FIFO_DEPTH - 1));
+    can.level[fifo]--;
+    can.popped[fifo]++;
+    window.frames++;
+}
+
+// Register side effects. Hooks also run after reads: every case must be
+// harmless then (write-1 registers carry RFR_MODEL until the driver writes)
+static uint8_t in_handler;
+static uint32_t handler_accesses;
+
+static void model_hook(uint32_t addr) {
+    if (in_handler) {
+        handler_accesses++;
+    }
+    if (addr == A(0x000)) {                                     // MCR
+        uint32_t mcr = REG(addr);
+        uint8_t was_init = in_init();
+        REG(A(0x004)) = (mcr & CAN_MCR_INRQ) ? CAN_MSR_INAK : (mcr & CAN_MCR_SLEEP) ? CAN_MSR_SLAK : 0;
+        if (was_init && !in_init()) {
+            btr_check();
+        }
+    } else if (addr == A(0x01C)) {                              // BTR
+        if (!in_init()) {
+            fail("BTR accessed outside init mode");
+        }
+    } else if (addr == RFR_ADDR(0) || addr == RFR_ADDR(1)) {
+        uint8_t fifo = addr == RFR_ADDR(1);
+        uint32_t w = REG(addr);
+        if (!(w & RFR_MODEL)) {
+            if (w & CAN_RFR_RFOM) {
+                pop(fifo);
+            }
+            if ((w & CAN_RFR_FOVR) && can.fovr[fifo]) {
+                can.fovr[fifo] = 0;
+                can.fovr_clears++;
+                window.overruns++;
+            }
+            if (w & CAN_RFR_FULL) {
+                can.full[fifo] = 0;
+            }
+        }
+        rfr_update(fifo);
+    } else if (addr >= TIR_ADDR(0) && addr <= TIR_ADDR(2) && (addr & 0xF) == 0) {
+        uint8_t mb = (uint8_t)((addr - TIR_ADDR(0)) >> 4);
+        uint32_t tir = REG(addr);
+        if ((tir & CAN_TIR_TXRQ) && !can.tx_pending[mb]) {
+            BusFrame *f = &can.tx[mb];
+            uint32_t tdtr = REG(addr + 4), lo = REG(addr + 8), hi = REG(addr + 12);
+            f->ext = (tir & CAN_IR_IDE) != 0;
+            f->id = f->ext ? tir >> CAN_IR_EXID_Pos : tir >> CAN_IR_STID_Pos;
+            f->rtr = (tir & CAN_IR_RTR) != 0;
+            f->dlc = tdtr & 0xF;
+            for (uint8_t i = 0; i < 4; i++) {
+                f->data[i] = (uint8_t)(lo >> (8 * i));
+                f->data[4 + i] = (uint8_t)(hi >> (8 * i));
+            }
+            can.tx_pending[mb] = 1;
+            can.tx_order[mb] = can.tx_requests++;
+            tsr_update();
+        }
+    } else if (addr >= A(0x204) && addr <= A(0x214)) {          // FM1R, FS1R, FFA1R
+        if (!(REG(A(0x200)) & CAN_FMR_FINIT)) {
+            fail("filter mode / scale / FIFO set outside filter init");
+        }
+    } else if (addr >= FR1_ADDR(0) && addr < FR1_ADDR(CAN_FILTER_BANKS)) {
+        if (!(REG(A(0x200)) & CAN_FMR_FINIT)) {
+            fail("filter bank written outside filter init");
+        }
+    } else if (addr == 0xE000E100) {                            // ISER0
+        irq_enabled |= REG(addr);
+    }
+}
+
+// ============================================================================
+// The bus: traffic from other nodes, or our own mailboxes
+// ============================================================================
+static struct {
+    uint8_t active;
+    uint8_t traffic;                    // Other nodes sending
+    uint64_t end_ns;
+    BusFrame frame;
+    int8_t mb;                          // Mailbox on the wire, -1 = another node
+    uint32_t seq;
+} bus;
+
+static uint32_t frame_bits(const BusFrame *f) {
+    return (f->ext ? 67u : 47u) + (f->rtr ? 0 : 8u * f->dlc);
+}
+
+// Mostly near a filter (inside or just outside), sometimes anything
+static void traffic_frame(BusFrame *f) {
+    uint32_t r = rnd();
+
+    memset(f, 0, sizeof *f);
+    if (r & 3) {
+        const CanFilter *near = &filters[(r >> 2) % FILTER_COUNT];
+        f->ext = near->ext ^ ((r >> 8 & 15) == 0);
+        f->id = (near->id ^ (rnd() & (near->ext ? 0x3FF : 0x1F))) & (f->ext ? CAN_EXT_EXACT : CAN_STD_EXACT);
+    } else {
+        f->ext = (r >> 2) & 1;
+        f->id = rnd() & (f->ext ? CAN_EXT_EXACT : CAN_STD_EXACT);
+    }
+    f->rtr = (r >> 12 & 7) == 0;
+    f->dlc = (uint8_t)((r >> 16) % 9);
+    for (uint8_t i = 0; i < 8; i++) {
+        f->data[i] = (uint8_t)((bus.seq >> (8 * (i & 3))) + 0x11 * i);
+    }
+    bus.seq++;
+}
+
+static void bus_start(void) {
+    int8_t next = -1;
+
+    for (uint8_t mb = 0; mb < 3; mb++) {
+        if (can.tx_pending[mb] && (next < 0 || can.tx_order[mb] < can.tx_order[next])) {
+            next = (int8_t)mb;
+        }
+    }
+    if (next >= 0 && !in_init()) {
+        bus.frame = can.tx[next];
+        bus.mb = next;
+    } else if (bus.traffic) {
+        traffic_frame(&bus.frame);
+        bus.mb = -1;
+    } else {
+        return;
+    }
+    bus.active = 1;
+    bus.end_ns = now_ns + (uint64_t)(frame_bits(&bus.frame) + rnd() % 4) * BIT_NS;
+}
+
+static void bus_complete(void) {
+    uint32_t btr = REG(A(0x01C));
+
+    bus.active = 0;
+    if (bus.mb >= 0) {
+        can.tx_pending[bus.mb] = 0;
+        REG(TIR_ADDR(bus.mb)) &= ~CAN_TIR_TXRQ;
+        tsr_update();
+        if ((btr & CAN_BTR_LBKM) && receiving()) {
+            receive(&bus.frame);
+        }
+    } else if (!(btr & CAN_BTR_LBKM) && receiving()) {
+        receive(&bus.frame);                        // Loopback: the bus is not listened to
+    }
+}
+
+// ============================================================================
+// Interrupts: levels, lowest number first
+// ============================================================================
+void USB_LP_CAN_RX0_IRQHandler(void);
+void CAN_RX1_IRQHandler(void);
+
+static uint32_t isr_entries;
+
+static uint8_t rx_irq(uint8_t fifo) {
+    uint32_t ier = REG(A(0x014));
+    uint8_t irq = fifo ? CAN_RX1_IRQn : USB_LP_CAN_RX0_IRQn;
+
+    return ((can.level[fifo] && (ier & CAN_IER_FMPIE(fifo))) ||
+            (can.fovr[fifo] && (ier & CAN_IER_FOVIE(fifo)))) && ((irq_enabled >> irq) & 1);
+}
+
+static uint8_t take_interrupt(void) {
+    in_handler = 1;
+    if (rx_irq(0)) {
+        USB_LP_CAN_RX0_IRQHandler();
+    } else if (rx_irq(1)) {
+        CAN_RX1_IRQHandler();
+    } else {
+        in_handler = 0;
+        return 0;
+    }
+    host_sim_flush();
+    in_handler = 0;
+    isr_entries++;
+    return 1;
+}
+
+static void take_interrupts(void) {
+    host_sim_flush();
+    for (uint32_t n = 0; take_interrupt(); n++) {
+        if (n == STORM_LIMIT) {
+            fail("interrupt storm: a flag is never cleared");
+            exit(1);
+        }
+    }
+}
+
+// ============================================================================
+// The application: reads the ring, checks every frame against the model
+// ============================================================================
+static struct {
+    uint32_t frames;
+    uint32_t skipped;                   // Popped by the driver, never seen: the ring was full
+    uint8_t record;
+    CanFrame recorded[16];
+    uint32_t n_recorded;
+} app;
+
+static uint8_t same(const BusFrame *b, const CanFrame *f) {
+    return b->id == f->id && b->ext == f->ext && b->rtr == f->rtr && b->dlc == f->dlc &&
+           memcmp(b->data, f->data, f->dlc) == 0;
+}
+
+static void reader(void) {
+    const CanFrame *f;
+
+    while ((f = can_rx_peek()) != 0) {
+        app.frames++;
+        if (f->filter >= FILTER_COUNT || !filter_matches(&filters[f->filter], f->id, f->ext, f->rtr)) {
+            fail("frame reported under a filter it does not match");
+        } else {
+            FrameLog *l = &can.log[filters[f->filter].fifo];
+            uint32_t from = l->cursor;
+            while (l->cursor < l->n && !same(&l->frames[l->cursor], f)) {
+                l->cursor++;
+            }
+            if (l->cursor == l->n) {
+                fail("frame not from its filter's FIFO, changed, or out of order");
+                l->cursor = from;
+            } else {
+                app.skipped += l->cursor - from;
+                l->cursor++;
+            }
+        }
+        if (f->ms > get_time_ms()) {
+            fail("frame time in the future");
+        }
+        if (app.record && app.n_recorded < 16) {
+            app.recorded[app.n_recorded++] = *f;
+        }
+        can_rx_release();
+    }
+}
+
+// ============================================================================
+// Simulated time: bus events and 1 ms ticks
+// ============================================================================
+static uint32_t seconds_checked, second_ring_drops;
+static uint64_t hold_from, hold_ns;
+
+static void stats_check(void) {
+    const CanStats *s = can_stats();
+    uint32_t hits = 0;
+
+    for (uint8_t i = 0; i < FILTER_COUNT; i++) {
+        hits += s->last_second.hits[i];
+    }
+    if (s->last_second.frames != window.frames || s->last_second.overruns != window.overruns ||
+        hits != window.frames) {
+        fail("per-second counters differ from the model's second");
+    }
+    second_ring_drops += s->last_second.ring_drops;
+    seconds_checked++;
+    window.frames = 0;
+    window.overruns = 0;
+}
+
+static void ms_tick(void) {
+    uint32_t ms = get_time_ms();
+    uint32_t fired = system_timers.fired;
+
+    tick_hook(ms);
+    if (system_timers.fired != fired) {
+        stats_check();
+    }
+    if (ms < READER_STALL_AT_MS || ms >= READER_STALL_AT_MS + READER_STALL_MS) {
+        reader();
+    }
+}
+
+static void run_until(uint64_t end_ns) {
+    while (now_ns < end_ns) {
+        uint64_t tick = (now_ns / 1000000 + 1) * 1000000;
+        uint64_t next = tick;
+
+        if (!bus.active) {
+            bus_start();
+        }
+        if (bus.active && bus.end_ns < next) {
+            next = bus.end_ns;
+        }
+        now_ns = next;
+        if (bus.active && bus.end_ns == now_ns) {
+            bus_complete();
+        }
+        if (now_ns == tick) {
+            ms_tick();
+        }
+        if (!hold_from && now_ns >= (uint64_t)IRQ_HOLD_AT_MS * 1000000) {
+            hold_from = now_ns;
+        }
+        if (hold_from && !hold_ns) {
+            if (!can.fovr[0] && !can.fovr[1]) {
+                continue;               // Held off
+            }
+            hold_ns = now_ns - hold_from;
+        }
+        take_interrupts();
+    }
+}
+
+// Frames sent in loopback: each side of several filters
+static const CanFrame probes[] = {
+    { .id = 0x0C5, .dlc = 2, .data = { 0x0C, 0x05 } },
+    { .id = 0x0D0, .dlc = 1 },
+    { .id = 0x244, .dlc = 8, .data = { 1, 2, 3, 4, 5, 6, 7, 8 } },
+    { .id = 0x244, .rtr = 1 },
+    { .id = 0x0C5, .ext = 1, .dlc = 1 },
+    { .id = 0x18FEF100, .ext = 1, .dlc = 8, .data = { 0xF1 } },
+    { .id = 0x18FEF101, .ext = 1, .dlc = 8 },
+    { .id = 0x0CF00417, .ext = 1, .dlc = 3, .data = { 4, 0x17 } },
+    { .id = 0x0CF10417, .ext = 1, .dlc = 3 },
+    { .id = 0x7FF, .dlc = 0 },
+};
+
+#define PROBE_COUNT         (sizeof(probes) / sizeof(probes[0]))
+
+int main(int argc, char **argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 10) : DEFAULT_SECONDS;
+
+    if (seconds < 5 || seconds > 3600) {
+        fprintf(stderr, "usage: %s [seconds 5-3600]\n", argv[0]);
+        return 2;
+    }
+
+    host_sim_reset();
+    host_sim_add_hook(model_hook);
+    REG(A(0x000)) = 0x00010002;                     // Reset: asleep
+    REG(A(0x004)) = CAN_MSR_SLAK;
+    REG(A(0x200)) = CAN_FMR_FINIT;
+    REG(RFR_ADDR(0)) = RFR_MODEL;
+    REG(RFR_ADDR(1)) = RFR_MODEL;
+    tsr_update();
+    timer_service_init();
+
+    // Too many banks: refused before anything changes
+    static CanFilter too_many[CAN_FILTER_BANKS + 1];
+    for (uint8_t i = 0; i <= CAN_FILTER_BANKS; i++) {
+        too_many[i] = (CanFilter){ 0x10000u * i, 0x1FFF0000, 1, i & 1 };
+    }
+    if (can_filter_banks(too_many, CAN_FILTER_BANKS + 1) != CAN_FILTER_BANKS + 1 ||
+        can_init(too_many, CAN_FILTER_BANKS + 1, CAN_MODE_NORMAL) || REG(A(0x000)) != 0x00010002) {
+        fail("a list needing 15 banks was not refused");
+    }
+
+    // Normal mode on a full bus
+    if (can_filter_banks(filters, FILTER_COUNT) != FILTER_BANKS) {
+        fail("can_filter_banks() count");
+    }
+    if (!can_init(filters, FILTER_COUNT, CAN_MODE_NORMAL)) {
+        fail("can_init() did not get onto the bus");
+    }
+    host_sim_flush();
+    if (!(REG(A(0x000)) & CAN_MCR_RFLM) || !(REG(A(0x000)) & CAN_MCR_TXFP) ||
+        ((volatile uint8_t *)host_sim_peek(0xE000E414))[0] != IRQ_PRIO_CAN << 4 ||
+        ((volatile uint8_t *)host_sim_peek(0xE000E414))[1] != IRQ_PRIO_CAN << 4) {
+        fail("setup: locked FIFOs, request-order transmit, IRQ_PRIO_CAN");
+    }
+    printf("bxCAN replay: %u s at %u kbit/s (BRP %u, %u tq, sample point %.1f %%), "
+           "%u filters in %u banks\n\n",
+           seconds, CAN_BITRATE / 1000, can.brp, can.tq, 100 * can.sample_point,
+           FILTER_COUNT, FILTER_BANKS);
+
+    bus.traffic = 1;
+    run_until((uint64_t)seconds * 1000000000u);
+    bus.traffic = 0;
+    run_until(now_ns + 10000000);                   // Bus idle, everything read
+
+    const CanStats *s = can_stats();
+    uint32_t accepted = can.accepted[0] + can.accepted[1];
+    uint32_t lost = can.lost[0] + can.lost[1];
+    uint32_t popped = can.popped[0] + can.popped[1];
+    uint32_t hits = 0;
+    for (uint8_t i = 0; i < FILTER_COUNT; i++) {
+        hits += s->total.hits[i];
+    }
+    for (uint8_t fifo = 0; fifo < 2; fifo++) {
+        app.skipped += can.log[fifo].n - can.log[fifo].cursor;
+    }
+
+    printf("Bus           %u frames (%.0f/s), %u for the list, banks took %u (FIFO 0 %u, FIFO 1 %u)\n",
+           can.on_bus_frames, can.on_bus_frames / (double)seconds, can.list_accepted,
+           accepted, can.accepted[0], can.accepted[1]);
+    printf("Hardware      %u lost in %u overruns (interrupts held %.2f ms)\n",
+           lost, can.fovr_sets, hold_ns / 1e6);
+    printf("Driver        %u frames, %u interrupts (%.2f frames each, %.1f register accesses "
+           "per frame)\n",
+           s->total.frames, isr_entries, (double)s->total.frames / isr_entries,
+           (double)handler_accesses / s->total.frames);
+    printf("Application   %u frames, %u dropped by the ring (%u ms reader stall), "
+           "%u seconds of counters checked\n",
+           app.frames, s->total.ring_drops, READER_STALL_MS, seconds_checked);
+    can_dump_uart();
+
+    if (accepted != popped + lost || popped != s->total.frames || hits != popped ||
+        s->total.frames != app.frames + s->total.ring_drops || app.skipped != s->total.ring_drops) {
+        fail("counts do not balance: accepted = overrun + ring drops + received");
+    }
+    if (s->total.overruns != can.fovr_sets || can.fovr_clears != can.fovr_sets || !lost) {
+        fail("overruns not counted once per flag, or the hold caused none");
+    }
+    if (!s->total.ring_drops || second_ring_drops != s->total.ring_drops || seconds_checked < seconds) {
+        fail("the stall dropped nothing, or the per-second drops do not add up");
+    }
+
+    // Silent loopback: our own frames through the same filters
+    can.expect_loopback = 1;
+    if (!can_init(filters, FILTER_COUNT, CAN_MODE_SILENT_LOOPBACK)) {
+        fail("can_init() in loopback");
+    }
+    app.record = 1;
+    uint32_t expected = 0;
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) {
+        while (!can_send(&probes[i])) {
+            run_until(now_ns + BIT_NS);
+        }
+        expected += list_accepts(probes[i].id, probes[i].ext, probes[i].rtr);
+    }
+    run_until(now_ns + 10000000);
+
+    uint32_t k = 0;
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) {
+        if (list_accepts(probes[i].id, probes[i].ext, probes[i].rtr) && k < app.n_recorded) {
+            const CanFrame *r = &app.recorded[k++];
+            if (r->id != probes[i].id || r->ext != probes[i].ext || r->dlc != probes[i].dlc ||
+                memcmp(r->data, probes[i].data, r->dlc) != 0) {
+                fail("loopback frame changed or out of order");
+            }
+        }
+    }
+    printf("\nLoopback      %u frames sent, %u back through the filters (%u expected)\n\n",
+           (unsigned)PROBE_COUNT, app.n_recorded, expected);
+    if (app.n_recorded != expected || k != expected) {
+        fail("loopback frames missing or extra");
+    }
+
+    printf("%s\n", errors ? "FAILED" : "Banks match the list, every frame accounted for");
+    return errors ? 1 : 0;
+}
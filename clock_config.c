@@ -0,0 +1,203 @@
+/**
+ ******************************************************************************
+ * @file           : clock_config.c
+ * @brief          : System clock configuration (HSI / HSE / PLL up to 72 MHz)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ * Order matters when changing the clock:
+ *   Going UP:   raise FLASH latency first, then raise the clock
+ *   Going DOWN: lower the clock first, then reduce FLASH latency
+ * Otherwise the CPU fetches from flash faster than flash can answer.
+ ******************************************************************************
+ */
+
+#include "clock_config.h"
+#include "stm32f303_regs.h"
+
+#define CLOCK_STARTUP_TIMEOUT   0x5000  // Loop count to wait for HSE/PLL ready
+
+// System clock switch values (RCC_CFGR SW / SWS)
+#define SW_HSI                  0
+#define SW_HSE                  1
+#define SW_PLL                  2
+
+// Prescaler register encodings
+#define HPRE_DIV1               0x0
+#define PPRE_DIV1               0x0
+#define PPRE_DIV2               0x4
+
+typedef struct {
+    uint8_t  use_pll;
+    uint8_t  pll_from_hse;          // 0 = HSI/2, 1 = HSE/1
+    uint8_t  pll_mul;               // 2..16
+    uint8_t  ppre1;                 // APB1 prescaler encoding
+    uint32_t sysclk_hz;
+} ClockSetup;
+
+static const ClockSetup clock_setups[] = {
+    [CLOCK_PROFILE_HSI_8MHZ]      = { 0, 0,  0, PPRE_DIV1,  8000000 },
+    [CLOCK_PROFILE_HSI_PLL_64MHZ] = { 1, 0, 16, PPRE_DIV2, 64000000 },
+    [CLOCK_PROFILE_HSE_PLL_72MHZ] = { 1, 1,  9, PPRE_DIV2, 72000000 },
+};
+
+static ClockProfile current_profile = CLOCK_PROFILE_HSI_8MHZ;
+static ClockFreqs current_freqs = { 8000000, 8000000, 8000000, 8000000 };
+
+static ClockListener listeners[CLOCK_MAX_LISTENERS];
+static uint8_t listener_count = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static uint32_t flash_latency_for(uint32_t hclk_hz) {
+    if (hclk_hz <= 24000000) return 0;
+    if (hclk_hz <= 48000000) return 1;
+    return 2;
+}
+
+static void flash_set_latency(uint32_t latency) {
+    FLASH_ACR = (FLASH_ACR & ~FLASH_ACR_LATENCY_Msk) | latency;
+    while ((FLASH_ACR & FLASH_ACR_LATENCY_Msk) != latency) {
+        // Read back until the new value is active
+    }
+}
+
+static uint8_t wait_for_flag(uint32_t flag) {
+    uint32_t timeout = CLOCK_STARTUP_TIMEOUT;
+    while (!(RCC_CR & flag)) {
+        if (--timeout == 0) return 0;
+    }
+    return 1;
+}
+
+static void switch_sysclk(uint32_t sw) {
+    RCC_CFGR = (RCC_CFGR & ~RCC_CFGR_SW_Msk) | (sw << RCC_CFGR_SW_Pos);
+    while (((RCC_CFGR & RCC_CFGR_SWS_Msk) >> RCC_CFGR_SWS_Pos) != sw) {
+        // Wait for the switch to complete
+    }
+}
+
+static void notify_listeners(void) {
+    for (uint8_t i = 0; i < listener_count; i++) {
+        listeners[i](&current_freqs);
+    }
+}
+
+// ============================================================================
+// Bring the core up to 72 MHz (falls back to 64 MHz if there is no HSE)
+// ============================================================================
+ClockProfile clock_init(void) {
+    // Prefetch may only be switched while SYSCLK < 24 MHz with AHB /1,
+    // so turn it on now (still on HSI 8 MHz) and leave it on.
+    FLASH_ACR |= FLASH_ACR_PRFTBE;
+    while (!(FLASH_ACR & FLASH_ACR_PRFTBS)) {
+    }
+
+    if (!clock_set_profile(CLOCK_PROFILE_HSE_PLL_72MHZ)) {
+        clock_set_profile(CLOCK_PROFILE_HSI_PLL_64MHZ);
+    }
+    return current_profile;
+}
+
+// ============================================================================
+// Switch to another clock profile at runtime
+// Returns 1 on success, 0 if the oscillator or PLL failed to start.
+// If HSE fails the previous profile is still active; if the PLL fails
+// the core is left on HSI 8 MHz.
+// ============================================================================
+uint8_t clock_set_profile(ClockProfile profile) {
+    const ClockSetup *setup = &clock_setups[profile];
+    uint32_t old_latency = flash_latency_for(current_freqs.hclk_hz);
+    uint32_t new_latency = flash_latency_for(setup->sysclk_hz);
+    uint8_t ok = 1;
+
+    if (setup->use_pll && setup->pll_from_hse) {
+        RCC_CR |= RCC_CR_HSEBYP | RCC_CR_HSEON;
+        if (!wait_for_flag(RCC_CR_HSERDY)) {
+            RCC_CR &= ~(RCC_CR_HSEON | RCC_CR_HSEBYP);
+            return 0;
+        }
+    }
+
+    // Going up: more wait states BEFORE the clock gets faster
+    if (new_latency > old_latency) {
+        flash_set_latency(new_latency);
+    }
+
+    // Park on HSI while the PLL is reconfigured
+    RCC_CR |= RCC_CR_HSION;
+    wait_for_flag(RCC_CR_HSIRDY);
+    switch_sysclk(SW_HSI);
+    RCC_CR &= ~RCC_CR_PLLON;
+    while (RCC_CR & RCC_CR_PLLRDY) {
+    }
+
+    // AHB /1, APB2 /1, APB1 /1 or /2 - set before the fast clock is selected
+    RCC_CFGR = (RCC_CFGR & ~(RCC_CFGR_HPRE_Msk | RCC_CFGR_PPRE1_Msk | RCC_CFGR_PPRE2_Msk))
+             | (HPRE_DIV1 << RCC_CFGR_HPRE_Pos)
+             | ((uint32_t)setup->ppre1 << RCC_CFGR_PPRE1_Pos)
+             | (PPRE_DIV1 << RCC_CFGR_PPRE2_Pos);
+
+    if (setup->use_pll) {
+        RCC_CFGR2 &= ~RCC_CFGR2_PREDIV_Msk;             // PREDIV /1
+        RCC_CFGR = (RCC_CFGR & ~(RCC_CFGR_PLLSRC | RCC_CFGR_PLLMUL_Msk))
+                 | (setup->pll_from_hse ? RCC_CFGR_PLLSRC : 0)
+                 | ((uint32_t)(setup->pll_mul - 2) << RCC_CFGR_PLLMUL_Pos);
+
+        RCC_CR |= RCC_CR_PLLON;
+        if (!wait_for_flag(RCC_CR_PLLRDY)) {
+            // Stay on HSI 8 MHz rather than on a half-configured PLL
+            RCC_CR &= ~RCC_CR_PLLON;
+            ok = 0;
+            profile = CLOCK_PROFILE_HSI_8MHZ;
+            setup = &clock_setups[profile];
+            RCC_CFGR &= ~RCC_CFGR_PPRE1_Msk;
+            new_latency = flash_latency_for(setup->sysclk_hz);
+        } else {
+            switch_sysclk(SW_PLL);
+        }
+    }
+
+    // HSE no longer needed? Save the power.
+    if (!(setup->use_pll && setup->pll_from_hse)) {
+        RCC_CR &= ~(RCC_CR_HSEON | RCC_CR_HSEBYP);
+    }
+
+    // Going down: fewer wait states AFTER the clock got slower
+    if (new_latency < old_latency || !ok) {
+        flash_set_latency(new_latency);
+    }
+
+    current_profile = profile;
+    current_freqs.sysclk_hz = setup->sysclk_hz;
+    current_freqs.hclk_hz   = setup->sysclk_hz;
+    current_freqs.pclk1_hz  = (setup->ppre1 == PPRE_DIV2) ? setup->sysclk_hz / 2
+                                                          : setup->sysclk_hz;
+    current_freqs.pclk2_hz  = setup->sysclk_hz;
+
+    // Re-scale every registered timebase (SysTick, delays, UART, ...)
+    notify_listeners();
+
+    return ok;
+}
+
+ClockProfile clock_get_profile(void) {
+    return current_profile;
+}
+
+const ClockFreqs *clock_get_freqs(void) {
+    return &current_freqs;
+}
+
+// ============================================================================
+// Register a callback for clock changes (called once immediately as well)
+// ============================================================================
+uint8_t clock_add_listener(ClockListener listener) {
+    if (listener_count >= CLOCK_MAX_LISTENERS) {
+        return 0;
+    }
+    listeners[listener_count++] = listener;
+    listener(&current_freqs);
+    return 1;
+}
@@ -0,0 +1,60 @@
+/**
+ ******************************************************************************
+ * @file           : clock_config.h
+ * @brief          : System clock configuration (HSI / HSE / PLL up to 72 MHz)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ * After reset the F303 runs from the 8 MHz HSI. This module brings the
+ * core up to 72 MHz through the PLL and takes care of everything that
+ * has to change with it:
+ *   - FLASH wait states (0 WS <= 24 MHz, 1 WS <= 48 MHz, 2 WS <= 72 MHz)
+ *   - Prefetch buffer
+ *   - AHB / APB1 / APB2 prescalers (APB1 must stay <= 36 MHz)
+ *
+ * Anything that derives timing from a bus clock (SysTick, delay_us,
+ * UART baud rate, ...) registers a listener and is re-programmed
+ * every time the clock changes, e.g. when dropping to 8 MHz in idle:
+ *
+ *   clock_init();                               // 72 MHz
+ *   systick_init();                             // 1 ms tick
+ *   ...
+ *   clock_set_profile(CLOCK_PROFILE_HSI_8MHZ);  // idle, tick stays 1 ms
+ ******************************************************************************
+ */
+
+#ifndef CLOCK_CONFIG_H
+#define CLOCK_CONFIG_H
+
+#include <stdint.h>
+
+// Frequency of the HSE input. On the Discovery board this is the 8 MHz
+// MCO output of the ST-LINK, so the HSE runs in bypass mode.
+#define HSE_VALUE_HZ        8000000
+#define HSI_VALUE_HZ        8000000
+
+#define CLOCK_MAX_LISTENERS 8
+
+typedef enum {
+    CLOCK_PROFILE_HSI_8MHZ,         // Reset default - lowest power
+    CLOCK_PROFILE_HSI_PLL_64MHZ,    // HSI/2 x 16 - no external clock needed
+    CLOCK_PROFILE_HSE_PLL_72MHZ     // HSE x 9    - full speed
+} ClockProfile;
+
+typedef struct {
+    uint32_t sysclk_hz;
+    uint32_t hclk_hz;               // AHB: core, SysTick, DWT, DMA
+    uint32_t pclk1_hz;              // APB1: TIM2-7, I2C, SPI2/3, CAN
+    uint32_t pclk2_hz;              // APB2: USART1, SPI1, TIM1/8/15-17
+} ClockFreqs;
+
+// Called after every successful clock change with the new frequencies
+typedef void (*ClockListener)(const ClockFreqs *freqs);
+
+ClockProfile clock_init(void);
+uint8_t clock_set_profile(ClockProfile profile);
+ClockProfile clock_get_profile(void);
+const ClockFreqs *clock_get_freqs(void);
+uint8_t clock_add_listener(ClockListener listener);
+
+#endif // CLOCK_CONFIG_H
@@ -0,0 +1,69 @@
+/**
+ ******************************************************************************
+ * @file           : compass.c
+ * @brief          : Which ring direction is north, or downhill (LSM303 samples)
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ */
+
+#include "compass.h"
+#include "board.h"
+#include "lsm303.h"
+
+#define TAN_22_5_PERMILLE   414
+
+static int64_t abs64(int64_t v) {
+    return v < 0 ? -v : v;
+}
+
+int8_t compass_octant(int64_t north, int64_t east) {
+    int64_t n = abs64(north), e = abs64(east);
+    uint8_t off;                                // 0 = on the N-S axis, 1 = diagonal, 2 = E-W
+
+    if (n == 0 && e == 0) {
+        return -1;
+    }
+    if (e * 1000 <= n * TAN_22_5_PERMILLE) {
+        off = 0;
+    } else if (n * 1000 <= e * TAN_22_5_PERMILLE) {
+        off = 2;
+    } else {
+        off = 1;
+    }
+
+    if (east >= 0) {
+        return (int8_t)(north >= 0 ? off : 4 - off);        // N NE E / S SE E
+    }
+    return (int8_t)(north >= 0 ? (8 - off) & 7 : 4 + off);  // N NW W / S SW W
+}
+
+int8_t compass_downhill(const int16_t accel[3]) {
+    int64_t n = LSM303_NORTH(accel), e = LSM303_EAST(accel), u = LSM303_UP(accel);
+    int64_t plane = n * n + e * e;
+
+    if (plane * 1000 * 1000 <
+        (int64_t)COMPASS_TILT_MIN_PERMILLE * COMPASS_TILT_MIN_PERMILLE * (plane + u * u)) {
+        return -1;                              // Level
+    }
+    return compass_octant(-n, -e);
+}
+
+int8_t compass_north(const int16_t accel[3], const int16_t mag[3]) {
+    // Magnetometer Z to the X / Y scale first (sensor axes, before mapping)
+    int16_t m[3] = {
+        mag[0], mag[1],
+        (int16_t)((int32_t)mag[2] * LSM303_MAG_XY_LSB_PER_GAUSS / LSM303_MAG_Z_LSB_PER_GAUSS)
+    };
+    int64_t mn = LSM303_NORTH(m), me = LSM303_EAST(m), mu = LSM303_UP(m);
+    int64_t gn = LSM303_NORTH(accel), ge = LSM303_EAST(accel), gu = LSM303_UP(accel);
+    int64_t gg = gn * gn + ge * ge + gu * gu;
+
+    if (gg == 0) {
+        return compass_octant(mn, me);          // No gravity reading: take it as level
+    }
+
+    // Horizontal part, scaled by |g|^2: m * gg - (m . g) g
+    int64_t mg = mn * gn + me * ge + mu * gu;
+    return compass_octant(mn * gg - mg * gn, me * gg - mg * ge);
+}
@@ -0,0 +1,37 @@
+/**
+ ******************************************************************************
+ * @file           : compass.h
+ * @brief          : Which ring direction is north, or downhill (LSM303 samples)
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ * Answers are octants, 0 = the North LED, clockwise like LED_COMPASS_RING,
+ * or -1 when there is no answer. Sensor axes are turned into board
+ * directions with LSM303_NORTH / _EAST / _UP (board.h).
+ *
+ * Integer only, no atan2: a vector's octant comes from comparing its two
+ * components against tan(22.5 deg) ~ 0.414.
+ *
+ * Downhill: the accelerometer reads the reaction to gravity, pointing
+ * up, so its in-plane part points uphill; tilts under
+ * COMPASS_TILT_MIN_PERMILLE (sine of the tilt) count as level.
+ *
+ * North: the magnetometer vector with its part along gravity removed
+ * (tilt compensation), so the answer holds with the board tilted too.
+ ******************************************************************************
+ */
+
+#ifndef COMPASS_H
+#define COMPASS_H
+
+#include <stdint.h>
+
+#define COMPASS_TILT_MIN_PERMILLE   174     // sin 10 deg
+
+// Octant of the board-plane vector (north, east)
+int8_t compass_octant(int64_t north, int64_t east);
+
+int8_t compass_downhill(const int16_t accel[3]);
+int8_t compass_north(const int16_t accel[3], const int16_t mag[3]);
+
+#endif // COMPASS_H
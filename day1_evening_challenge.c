@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include "fmt.h"        // Build: gcc day1_evening_challenge.c fmt.c
 
 //============================================
 // CHALLENGE 1: Turn ON a specific bit
@@ -62,14 +63,13 @@ void toggleBit(uint32_t *reg, uint8_t bitPosition) {
 // Helper function to print register in binary
 //============================================
 void printRegister(uint32_t reg, const char* label) {
-    printf("%s: 0x%08X = ", label, reg);
+    char bits[FMT_BIN_MAX + 1];
 
-    // Print in binary (32 bits)
-    for (int i = 31; i >= 0; i--) {
-        printf("%d", (reg >> i) & 1);
-        if (i % 8 == 0) printf(" ");  // Space every 8 bits
-    }
-    printf("\n");
+    // All 32 bits into a buffer (space every 8 bits), then one printf
+    uint32_t n = fmt_bin(bits, reg, 32, 8, ' ');
+    bits[n] = ' ';
+    bits[n + 1] = '\0';
+    printf("%s: 0x%08X = %s\n", label, reg, bits);
 }
 
 //============================================
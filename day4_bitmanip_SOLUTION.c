@@ -5,6 +5,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include "fmt.h"        // Build: gcc day4_bitmanip_SOLUTION.c fmt.c
 
 // ============================================
 // EXERCISE 1: Set Bit
@@ -98,11 +99,10 @@ uint32_t extractBits(uint32_t value, uint8_t position, uint8_t length) {
 // Helper: Print Binary
 // ============================================
 void printBinary(uint32_t num, uint8_t bits) {
-    printf("0b");
-    for (int i = bits - 1; i >= 0; i--) {
-        printf("%d", (num >> i) & 1);
-        if (i % 4 == 0 && i != 0) printf("_");
-    }
+    char text[2 + FMT_BIN_MAX] = "0b";
+
+    fmt_bin(text + 2, num, bits, 4, '_');   // Whole number first (fmt.c)...
+    fputs(text, stdout);                    // ...then ONE write, not one per bit
 }
 
 // ============================================
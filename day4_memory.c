@@ -202,7 +202,7 @@ Quiz Answers:
 4. Stack is limited (4-16KB), can overflow
 5. Heap fragmentation, non-deterministic, memory leaks risk
 6. Peripheral address space (memory-mapped, 0x40000000+)
-7. Zeroed by startup code before main()
+7. Zeroed by startup code before main() (Reset_Handler in startup_stm32f303.s)
 8. No - it's read-only (Flash/ROM)
 */
 
@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ * @file           : debounce.c
+ * @brief          : Interchangeable button debounce strategies
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 24, 2026
+ ******************************************************************************
+ */
+
+#include "debounce.h"
+
+#define TIME_REACHED(now, t)  ((int32_t)((now) - (t)) >= 0)
+
+void debounce_init(Debouncer *db, const DebounceConfig *config) {
+    db->config = config;
+    db->level = 0;
+    db->prev_raw = 0;
+    db->until_us = 0;
+    db->count = 0;
+    db->count_max = config->poll_us ? (config->param_us + config->poll_us - 1) / config->poll_us : 1;
+    if (db->count_max == 0) db->count_max = 1;
+}
+
+// ============================================================================
+// Day 3: rising edge -> event, then blind for the delay
+// ============================================================================
+static uint8_t blocking_delay(Debouncer *db, uint8_t raw, uint32_t now_us) {
+    if (!TIME_REACHED(now_us, db->until_us)) {
+        return 0;                               // Still inside delay(50000)
+    }
+
+    uint8_t press = (raw && !db->prev_raw);
+    db->prev_raw = raw;
+    db->level = raw;
+    if (press) {
+        db->until_us = now_us + db->config->param_us;
+    }
+    return press;
+}
+
+// ============================================================================
+// Event on the first edge, then ignore the bouncing. At the end of the
+// lock-out take the level the bouncing ended on, dated from the end of
+// the lock-out - the old gesture.c settle()
+// ============================================================================
+static uint8_t lockout(Debouncer *db, uint8_t raw, uint32_t now_us) {
+    uint8_t press = 0;
+
+    if (db->prev_raw != db->level && TIME_REACHED(now_us, db->until_us)) {
+        db->level = db->prev_raw;
+        db->until_us += db->config->param_us;
+        press = db->level;
+    }
+    db->prev_raw = raw;
+
+    if (TIME_REACHED(now_us, db->until_us) && raw != db->level) {
+        db->level = raw;
+        db->until_us = now_us + db->config->param_us;
+        press |= raw;
+    }
+    return press;
+}
+
+// ============================================================================
+// Integrator with hysteresis: 0 .. count_max
+// ============================================================================
+static uint8_t integrator(Debouncer *db, uint8_t raw) {
+    if (raw) {
+        if (db->count < db->count_max) db->count++;
+    } else {
+        if (db->count > 0) db->count--;
+    }
+
+    if (db->count == db->count_max && !db->level) {
+        db->level = 1;
+        return 1;
+    }
+    if (db->count == 0) {
+        db->level = 0;
+    }
+    return 0;
+}
+
+// ============================================================================
+// Shift register: count_max identical samples in a row
+// ============================================================================
+static uint8_t shift_register(Debouncer *db, uint8_t raw) {
+    if (raw != db->prev_raw) {
+        db->prev_raw = raw;
+        db->count = 0;
+    }
+    if (raw != db->level) {
+        if (++db->count >= db->count_max) {
+            db->level = raw;
+            db->count = 0;
+            return raw;
+        }
+    }
+    return 0;
+}
+
+uint8_t debounce_sample(Debouncer *db, uint8_t raw, uint32_t now_us) {
+    raw = raw ? 1 : 0;
+
+    switch (db->config->strategy) {
+        case DEBOUNCE_BLOCKING_DELAY: return blocking_delay(db, raw, now_us);
+        case DEBOUNCE_LOCKOUT:        return lockout(db, raw, now_us);
+        case DEBOUNCE_INTEGRATOR:     return integrator(db, raw);
+        case DEBOUNCE_SHIFT_REGISTER: return shift_register(db, raw);
+    }
+    return 0;
+}
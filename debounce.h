@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * @file           : debounce.h
+ * @brief          : Interchangeable button debounce strategies
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 24, 2026
+ ******************************************************************************
+ * Every strategy is fed the same way - the raw pin level and a timestamp
+ * in microseconds - and reports 1 for a debounced press:
+ *
+ *   if (debounce_sample(&db, button_read(), now_us)) { ... }
+ *
+ * DEBOUNCE_BLOCKING_DELAY  The Day 3 button_pressed(): edge -> event, then
+ *                          the CPU sits in delay() for param_us and sees
+ *                          nothing.
+ * DEBOUNCE_LOCKOUT         Edge -> event at once, ignore changes for
+ *                          param_us, then re-check the pin and take the
+ *                          level it settled on (what gesture.c did on
+ *                          EXTI edges before button.c sampled the pin).
+ * DEBOUNCE_INTEGRATOR      Counter moves up/down with the level; the output
+ *                          only flips at full scale (param_us of net
+ *                          agreement). Tolerates single noise samples.
+ *                          button.c runs it every SysTick.
+ * DEBOUNCE_SHIFT_REGISTER  Output flips after param_us of *identical*
+ *                          samples; any glitch restarts the wait.
+ *
+ * debounce_harness.c compares them against a simulated bouncy switch.
+ ******************************************************************************
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+
+typedef enum {
+    DEBOUNCE_BLOCKING_DELAY,
+    DEBOUNCE_LOCKOUT,
+    DEBOUNCE_INTEGRATOR,
+    DEBOUNCE_SHIFT_REGISTER
+} DebounceStrategy;
+
+typedef struct {
+    DebounceStrategy strategy;
+    uint32_t param_us;              // Delay / lock-out / stable time
+    uint32_t poll_us;               // Sample period (sizes the counters)
+} DebounceConfig;
+
+typedef struct {
+    const DebounceConfig *config;
+    uint8_t  level;                 // Debounced level
+    uint8_t  prev_raw;
+    uint32_t until_us;              // End of delay / lock-out
+    uint32_t count;                 // Integrator / stable-sample counter
+    uint32_t count_max;
+} Debouncer;
+
+void debounce_init(Debouncer *db, const DebounceConfig *config);
+uint8_t debounce_sample(Debouncer *db, uint8_t raw, uint32_t now_us);
+
+#endif // DEBOUNCE_H
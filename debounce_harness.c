@@ -0,0 +1,332 @@
+/**
+ ******************************************************************************
+ * @file           : debounce_harness.c
+ * @brief          : Host tool - bounce injection test for debounce strategies
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 24, 2026
+ ******************************************************************************
+ * Was delay(50000) in button_pressed() ever right? This drives a simulated
+ * GPIOA_IDR from a model of a bouncy switch, with microsecond resolution,
+ * through as many presses as you like, and runs every debounce strategy
+ * from debounce.c against exactly the same presses.
+ *
+ *   gcc -O2 -o debounce_harness debounce_harness.c debounce.c -lm
+ *   ./debounce_harness [presses] [seed]          (default 1000000, 1)
+ *
+ * Switch model (per press, all random within the limits below):
+ *   idle ... press bounce ... hold ... release bounce ... idle
+ *   - bounce count, each bounce open/closed time ~ exponential
+ *   - noise spikes (EMI): short inverted glitches at random times
+ *
+ * For every strategy it reports:
+ *   latency  first contact -> press event (p50 / p90 / p99 / max); only
+ *            an event while the button is held counts, and only if the
+ *            output was released when the finger landed
+ *   missed   presses with no such event: none before the release edge
+ *            (one after it is the press seen too late), or the press
+ *            swallowed by an event that noise fired just before it
+ *   spurious every other event (release bounce, noise, a second event)
+ * and recommends the fastest strategy with no missed and no spurious
+ * presses.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "debounce.h"
+
+// ============================================================================
+// Switch model (microseconds)
+// ============================================================================
+#define IDLE_MIN_US         150000      // Time between presses
+#define IDLE_MAX_US         600000
+#define HOLD_MIN_US         40000       // Finger on the button
+#define HOLD_MAX_US         400000
+#define BOUNCE_COUNT_MIN    0           // Bounces per transition
+#define BOUNCE_COUNT_MAX    12
+#define BOUNCE_MEAN_US      300         // Mean open/closed time of one bounce
+#define BOUNCE_TOTAL_MAX_US 6000        // Bouncing never lasts longer
+#define NOISE_PER_SECOND    2.0         // EMI spikes per second
+#define NOISE_MAX_US        40          // Spike width 1..NOISE_MAX_US
+
+#define BUTTON_PIN          0
+#define MAX_EDGES           1024
+
+// ============================================================================
+// Strategies under test
+// ============================================================================
+typedef struct {
+    const char *name;
+    DebounceConfig config;
+    uint8_t exti;                       // 1 = also sampled at every edge (EXTI)
+} Candidate;
+
+static const Candidate candidates[] = {
+    { "Day 3 main loop (50ms, poll 150ms)", { DEBOUNCE_BLOCKING_DELAY, 50000, 150000 }, 0 },
+    { "Blocking delay 50ms, poll 1ms",      { DEBOUNCE_BLOCKING_DELAY, 50000,   1000 }, 0 },
+    { "Lock-out 20ms, EXTI (old gesture.c)",{ DEBOUNCE_LOCKOUT,        20000,   1000 }, 1 },
+    { "Lock-out 20ms, poll 1ms",            { DEBOUNCE_LOCKOUT,        20000,   1000 }, 0 },
+    { "Lock-out 8ms, EXTI edges",           { DEBOUNCE_LOCKOUT,         8000,   1000 }, 1 },
+    { "Integrator 10ms, SysTick (button.c)",{ DEBOUNCE_INTEGRATOR,     10000,   1000 }, 0 },
+    { "Integrator 5ms, poll 250us",         { DEBOUNCE_INTEGRATOR,      5000,    250 }, 0 },
+    { "Shift register 10ms, poll 1ms",      { DEBOUNCE_SHIFT_REGISTER, 10000,   1000 }, 0 },
+    { "Shift register 5ms, poll 250us",     { DEBOUNCE_SHIFT_REGISTER,  5000,    250 }, 0 },
+};
+#define CANDIDATE_COUNT     (sizeof(candidates) / sizeof(candidates[0]))
+
+typedef struct {
+    Debouncer db;
+    uint64_t next_poll;                 // Next periodic sample time
+    uint32_t *latency;                  // One per detected press
+    uint32_t detected;
+    uint32_t missed;
+    uint32_t spurious;
+} Result;
+
+static Result results[CANDIDATE_COUNT];
+
+// ============================================================================
+// Random numbers (xorshift64*) - reproducible with the seed
+// ============================================================================
+static uint64_t rng_state;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t rng_range(uint32_t lo, uint32_t hi) {
+    return lo + (uint32_t)(rng_next() % (uint64_t)(hi - lo + 1));
+}
+
+static double rng_unit(void) {
+    return (rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint32_t rng_exp(double mean) {
+    double u = rng_unit();
+    return 1 + (uint32_t)(-mean * log(1.0 - u));
+}
+
+// ============================================================================
+// One press cycle as a list of level changes of GPIOA_IDR bit 0
+// ============================================================================
+typedef struct {
+    uint64_t time;
+    uint8_t level;
+} Edge;
+
+static Edge edges[MAX_EDGES];
+static uint32_t edge_count;
+
+static void add_edge(uint64_t t, uint8_t level) {
+    if (edge_count < MAX_EDGES) {
+        edges[edge_count].time = t;
+        edges[edge_count].level = level;
+        edge_count++;
+    }
+}
+
+// Stable level from 'start' for 'length' us, with noise spikes on top
+static void add_stable(uint64_t start, uint32_t length, uint8_t level) {
+    double mean_gap = 1e6 / NOISE_PER_SECOND;
+    uint64_t t = start + rng_exp(mean_gap);
+
+    while (t + NOISE_MAX_US < start + length) {
+        uint32_t width = rng_range(1, NOISE_MAX_US);
+        add_edge(t, !level);
+        add_edge(t + width, level);
+        t += width + rng_exp(mean_gap);
+    }
+}
+
+// Contact settles to 'level' starting at t; returns when it is stable
+static uint64_t add_transition(uint64_t t, uint8_t level) {
+    uint32_t bounces = rng_range(BOUNCE_COUNT_MIN, BOUNCE_COUNT_MAX);
+    uint64_t end = t + BOUNCE_TOTAL_MAX_US;
+
+    add_edge(t, level);
+    for (uint32_t i = 0; i < bounces; i++) {
+        uint64_t open = t + rng_exp(BOUNCE_MEAN_US);
+        uint64_t close = open + rng_exp(BOUNCE_MEAN_US);
+        if (close >= end) break;
+        add_edge(open, !level);
+        add_edge(close, level);
+        t = close;
+    }
+    return t;
+}
+
+// Builds [cycle_start, returned end); *press_time = first contact,
+// *release_time = first break of the release
+static uint64_t build_cycle(uint64_t cycle_start, uint64_t *press_time, uint64_t *release_time) {
+    edge_count = 0;
+
+    uint32_t idle = rng_range(IDLE_MIN_US, IDLE_MAX_US);
+    add_stable(cycle_start, idle, 0);
+
+    *press_time = cycle_start + idle;
+    uint64_t settled = add_transition(*press_time, 1);
+
+    uint32_t hold = rng_range(HOLD_MIN_US, HOLD_MAX_US);
+    add_stable(settled, hold, 1);
+
+    *release_time = settled + hold;
+    settled = add_transition(*release_time, 0);
+    return settled + BOUNCE_TOTAL_MAX_US;
+}
+
+// ============================================================================
+// Can the strategy's output change if the input stays at 'raw'?
+// If not, sampling can jump straight to the next edge.
+// ============================================================================
+static int settled(const Debouncer *db, uint8_t raw, uint64_t now) {
+    uint8_t timer_done = (int32_t)((uint32_t)now - db->until_us) >= 0;
+
+    switch (db->config->strategy) {
+        case DEBOUNCE_BLOCKING_DELAY: return timer_done && db->prev_raw == raw;
+        case DEBOUNCE_LOCKOUT:        return timer_done && db->level == raw;
+        case DEBOUNCE_INTEGRATOR:     return raw ? (db->count == db->count_max && db->level)
+                                                 : (db->count == 0 && !db->level);
+        case DEBOUNCE_SHIFT_REGISTER: return db->level == raw;
+    }
+    return 0;
+}
+
+// ============================================================================
+// Run one strategy over the current cycle
+// ============================================================================
+static void run_cycle(const Candidate *c, Result *r, uint64_t cycle_start, uint64_t cycle_end,
+                      uint64_t press_time, uint64_t release_time) {
+    uint32_t poll = c->config.poll_us;
+    uint32_t e = 0;
+    uint8_t level = 0;                  // Simulated GPIOA_IDR bit 0
+    uint32_t gpioa_idr = 0;
+    uint8_t pressed_seen = 0;
+    uint8_t late_seen = 0;              // Event after the release of a missed press
+    uint8_t armed = 0;                  // Output released when the finger landed
+    uint8_t landed = 0;
+
+    if (r->next_poll < cycle_start) r->next_poll = cycle_start;
+
+    while (1) {
+        // Next point in time the strategy looks at the pin
+        uint64_t next_edge = (e < edge_count) ? edges[e].time : UINT64_MAX;
+        uint64_t now = r->next_poll;
+        uint8_t at_edge = 0;
+
+        if (c->exti && next_edge <= now) {
+            now = next_edge;
+            at_edge = 1;
+        }
+        if (now >= cycle_end) break;
+
+        // Bring the simulated register up to 'now'
+        while (e < edge_count && edges[e].time <= now) {
+            level = edges[e].level;
+            e++;
+        }
+        gpioa_idr = (gpioa_idr & ~(1u << BUTTON_PIN)) | ((uint32_t)level << BUTTON_PIN);
+        uint8_t raw = (gpioa_idr >> BUTTON_PIN) & 1;
+
+        if (!landed && now >= press_time) {
+            landed = 1;
+            armed = !r->db.level;
+        }
+        if (debounce_sample(&r->db, raw, (uint32_t)now)) {
+            if (armed && now < release_time && !pressed_seen) {
+                pressed_seen = 1;
+                r->latency[r->detected++] = (uint32_t)(now - press_time);
+            } else if (armed && now >= release_time && !pressed_seen && !late_seen) {
+                late_seen = 1;          // Counted as missed below
+            } else {
+                r->spurious++;
+            }
+        }
+
+        if (!at_edge) {
+            r->next_poll += poll;
+            // Nothing can happen until the pin changes: skip ahead
+            if (settled(&r->db, raw, r->next_poll)) {
+                uint64_t target = (e < edge_count) ? edges[e].time : cycle_end;
+                if (target > r->next_poll) {
+                    r->next_poll += ((target - r->next_poll) / poll) * poll;
+                }
+            }
+        }
+    }
+
+    if (!pressed_seen) r->missed++;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double pct_ms(const Result *r, uint32_t pct) {
+    if (r->detected == 0) return 0.0;
+    uint32_t i = (uint32_t)(((uint64_t)(r->detected - 1) * pct + 50) / 100);
+    return r->latency[i] / 1000.0;
+}
+
+int main(int argc, char **argv) {
+    uint32_t presses = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000;
+    rng_state = (argc > 2) ? strtoull(argv[2], NULL, 0) : 1;
+    if (rng_state == 0) rng_state = 1;
+
+    printf("=== DEBOUNCE HARNESS: %u presses, seed %llu ===\n", presses,
+           (unsigned long long)rng_state);
+    printf("Bounces 0-%d per edge (mean %d us, max %d us), noise %.1f/s up to %d us\n\n",
+           BOUNCE_COUNT_MAX, BOUNCE_MEAN_US, BOUNCE_TOTAL_MAX_US, NOISE_PER_SECOND, NOISE_MAX_US);
+
+    for (uint32_t i = 0; i < CANDIDATE_COUNT; i++) {
+        debounce_init(&results[i].db, &candidates[i].config);
+        results[i].latency = malloc(presses * sizeof(uint32_t));
+        results[i].next_poll = 0;
+    }
+
+    uint64_t t = 0;
+    for (uint32_t p = 0; p < presses; p++) {
+        uint64_t press_time, release_time;
+        uint64_t cycle_end = build_cycle(t, &press_time, &release_time);
+
+        for (uint32_t i = 0; i < CANDIDATE_COUNT; i++) {
+            run_cycle(&candidates[i], &results[i], t, cycle_end, press_time, release_time);
+        }
+        t = cycle_end;
+    }
+
+    printf("%-36s %8s %8s %8s %8s %10s %10s\n",
+           "Strategy", "p50 ms", "p90 ms", "p99 ms", "max ms", "missed", "spurious");
+
+    int best = -1;
+    for (uint32_t i = 0; i < CANDIDATE_COUNT; i++) {
+        Result *r = &results[i];
+        qsort(r->latency, r->detected, sizeof(uint32_t), cmp_u32);
+
+        printf("%-36s %8.2f %8.2f %8.2f %8.2f %10u %10u\n", candidates[i].name,
+               pct_ms(r, 50), pct_ms(r, 90), pct_ms(r, 99), pct_ms(r, 100),
+               r->missed, r->spurious);
+
+        if (r->missed == 0 && r->spurious == 0 &&
+            (best < 0 || pct_ms(r, 99) < pct_ms(&results[best], 99))) {
+            best = (int)i;
+        }
+    }
+
+    if (best >= 0) {
+        printf("\nFastest correct strategy: %s (p99 %.2f ms)\n",
+               candidates[best].name, pct_ms(&results[best], 99));
+    } else {
+        printf("\nNo strategy was free of missed and spurious presses.\n");
+    }
+    return 0;
+}
@@ -0,0 +1,621 @@
+/**
+ ******************************************************************************
+ * @file           : dsp.c
+ * @brief          : Fixed-point filters on the Cortex-M4 DSP instructions
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 4, 2026
+ ******************************************************************************
+ */
+
+#include "dsp.h"
+#include "stm32f303_regs.h"
+#include "uart.h"
+#include "fmt.h"
+
+// ============================================================================
+// Instructions: the real ones on the M4, C with the same results elsewhere
+// ============================================================================
+// Two Q15 samples from any even address (the M4 allows unaligned LDR)
+typedef uint32_t __attribute__((aligned(2), may_alias)) q15x2_t;
+
+static inline uint32_t q15x2(const q15_t *p) {
+    return *(const q15x2_t *)p;
+}
+
+#if defined(__ARM_FEATURE_DSP)
+
+// acc + a.lo * b.lo + a.hi * b.hi, wrapping
+static inline int32_t smlad(uint32_t a, uint32_t b, int32_t acc) {
+    int32_t r;
+    __asm ("smlad %0, %1, %2, %3" : "=r" (r) : "r" (a), "r" (b), "r" (acc));
+    return r;
+}
+
+// a.lo * b.lo + a.hi * b.hi, wrapping
+static inline int32_t smuad(uint32_t a, uint32_t b) {
+    int32_t r;
+    __asm ("smuad %0, %1, %2" : "=r" (r) : "r" (a), "r" (b));
+    return r;
+}
+
+// lo.lo | hi.lo << 16
+static inline uint32_t pkhbt(int32_t lo, uint32_t hi) {
+    uint32_t r;
+    __asm ("pkhbt %0, %1, %2, lsl #16" : "=r" (r) : "r" (lo), "r" (hi));
+    return r;
+}
+
+static inline q15_t sat_q15(int32_t v) {
+    int32_t r;
+    __asm ("ssat %0, #16, %1" : "=r" (r) : "r" (v));
+    return (q15_t)r;
+}
+
+#else
+
+static inline int32_t smuad(uint32_t a, uint32_t b) {
+    int32_t lo = (int16_t)a * (int16_t)b;
+    int32_t hi = (int16_t)(a >> 16) * (int16_t)(b >> 16);
+    return (int32_t)((uint32_t)lo + (uint32_t)hi);
+}
+
+static inline int32_t smlad(uint32_t a, uint32_t b, int32_t acc) {
+    return (int32_t)((uint32_t)acc + (uint32_t)smuad(a, b));
+}
+
+static inline uint32_t pkhbt(int32_t lo, uint32_t hi) {
+    return ((uint32_t)lo & 0xFFFF) | (hi << 16);
+}
+
+static inline q15_t sat_q15(int32_t v) {
+    return (q15_t)(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+}
+
+#endif
+
+// 64-bit sums (SMLAL, and the references)
+static inline q15_t sat_q15_64(int64_t v) {
+    return (q15_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+static inline q31_t sat_q31(int64_t v) {
+    return (q31_t)(v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : v);
+}
+
+#define ROUND_Q15       (1 << 14)
+#define ROUND_Q31       ((int64_t)1 << 30)
+
+// ============================================================================
+// FIR: new samples appended to the last num_taps - 1, so the window of
+// every output is one straight run of memory
+// ============================================================================
+void dsp_fir_q15_init(DspFirQ15 *f, const q15_t *coeffs, uint16_t num_taps, q15_t *state) {
+    f->coeffs = coeffs;
+    f->state = state;
+    f->num_taps = num_taps;
+    for (uint32_t i = 0; i < DSP_FIR_STATE_LEN(num_taps); i++) {
+        state[i] = 0;
+    }
+}
+
+// Two outputs per pass: each coefficient pair is loaded once for both
+static void fir_q15_block(const DspFirQ15 *f, q15_t *out, uint32_t m) {
+    const q15_t *c = f->coeffs;
+    uint16_t taps = f->num_taps;
+    uint32_t i = 0;
+
+    for (; i + 1 < m; i += 2) {
+        const q15_t *x = &f->state[i];
+        int32_t acc0 = ROUND_Q15;
+        int32_t acc1 = ROUND_Q15;
+        uint32_t k = 0;
+
+        for (; k + 1 < taps; k += 2) {
+            uint32_t cc = q15x2(&c[k]);
+            acc0 = smlad(cc, q15x2(&x[k]), acc0);
+            acc1 = smlad(cc, q15x2(&x[k + 1]), acc1);
+        }
+        if (k < taps) {
+            acc0 += c[k] * x[k];
+            acc1 += c[k] * x[k + 1];
+        }
+        out[i] = sat_q15(acc0 >> 15);
+        out[i + 1] = sat_q15(acc1 >> 15);
+    }
+    if (i < m) {
+        const q15_t *x = &f->state[i];
+        int32_t acc = ROUND_Q15;
+        uint32_t k = 0;
+
+        for (; k + 1 < taps; k += 2) {
+            acc = smlad(q15x2(&c[k]), q15x2(&x[k]), acc);
+        }
+        if (k < taps) {
+            acc += c[k] * x[k];
+        }
+        out[i] = sat_q15(acc >> 15);
+    }
+}
+
+void dsp_fir_q15(DspFirQ15 *f, const q15_t *in, q15_t *out, uint32_t n) {
+    uint32_t keep = f->num_taps - 1u;
+    q15_t *s = f->state;
+
+    while (n) {
+        uint32_t m = n < DSP_BLOCK_MAX ? n : DSP_BLOCK_MAX;
+
+        for (uint32_t i = 0; i < m; i++) {
+            s[keep + i] = in[i];
+        }
+        fir_q15_block(f, out, m);
+        for (uint32_t i = 0; i < keep; i++) {
+            s[i] = s[m + i];
+        }
+        in += m;
+        out += m;
+        n -= m;
+    }
+}
+
+void dsp_fir_q31_init(DspFirQ31 *f, const q31_t *coeffs, uint16_t num_taps, q31_t *state) {
+    f->coeffs = coeffs;
+    f->state = state;
+    f->num_taps = num_taps;
+    for (uint32_t i = 0; i < DSP_FIR_STATE_LEN(num_taps); i++) {
+        state[i] = 0;
+    }
+}
+
+void dsp_fir_q31(DspFirQ31 *f, const q31_t *in, q31_t *out, uint32_t n) {
+    const q31_t *c = f->coeffs;
+    uint16_t taps = f->num_taps;
+    uint32_t keep = taps - 1u;
+    q31_t *s = f->state;
+
+    while (n) {
+        uint32_t m = n < DSP_BLOCK_MAX ? n : DSP_BLOCK_MAX;
+
+        for (uint32_t i = 0; i < m; i++) {
+            s[keep + i] = in[i];
+        }
+        for (uint32_t i = 0; i < m; i++) {
+            const q31_t *x = &s[i];
+            int64_t acc = ROUND_Q31;
+            for (uint32_t k = 0; k < taps; k++) {
+                acc += (int64_t)c[k] * x[k];
+            }
+            out[i] = sat_q31(acc >> 31);
+        }
+        for (uint32_t i = 0; i < keep; i++) {
+            s[i] = s[m + i];
+        }
+        in += m;
+        out += m;
+        n -= m;
+    }
+}
+
+// ============================================================================
+// Biquad cascade: one section over the whole block, then the next
+// ============================================================================
+void dsp_biquad_q15_init(DspBiquadQ15 *f, DspBiquadQ15Stage *stages,
+                         const DspBiquadQ15Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift) {
+    f->stages = stages;
+    f->num_stages = num_stages;
+    f->post_shift = post_shift;
+    for (uint8_t s = 0; s < num_stages; s++) {
+        stages[s].b0 = coeffs[s].b0;
+        stages[s].b12 = pkhbt(coeffs[s].b1, (uint16_t)coeffs[s].b2);
+        stages[s].a12 = pkhbt(coeffs[s].a1, (uint16_t)coeffs[s].a2);
+        stages[s].x = 0;
+        stages[s].y = 0;
+    }
+}
+
+void dsp_biquad_q15(DspBiquadQ15 *f, const q15_t *in, q15_t *out, uint32_t n) {
+    uint8_t shift = 15 - f->post_shift;
+    int32_t round = 1 << (shift - 1);
+    const q15_t *src = in;
+
+    for (uint8_t s = 0; s < f->num_stages; s++) {
+        DspBiquadQ15Stage *st = &f->stages[s];
+        uint32_t b12 = st->b12, a12 = st->a12;
+        uint32_t xh = st->x, yh = st->y;
+        int32_t b0 = st->b0;
+
+        for (uint32_t i = 0; i < n; i++) {
+            int32_t x = src[i];
+            int32_t acc = smuad(b12, xh);
+            acc = smlad(a12, yh, acc);
+            acc += b0 * x + round;
+
+            q15_t y = sat_q15(acc >> shift);
+            out[i] = y;
+            xh = pkhbt(x, xh);
+            yh = pkhbt(y, yh);
+        }
+        st->x = xh;
+        st->y = yh;
+        src = out;
+    }
+}
+
+void dsp_biquad_q31_init(DspBiquadQ31 *f, DspBiquadQ31Stage *stages,
+                         const DspBiquadQ31Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift) {
+    f->stages = stages;
+    f->num_stages = num_stages;
+    f->post_shift = post_shift;
+    for (uint8_t s = 0; s < num_stages; s++) {
+        stages[s].c = coeffs[s];
+        stages[s].x1 = stages[s].x2 = 0;
+        stages[s].y1 = stages[s].y2 = 0;
+    }
+}
+
+void dsp_biquad_q31(DspBiquadQ31 *f, const q31_t *in, q31_t *out, uint32_t n) {
+    uint8_t shift = 31 - f->post_shift;
+    int64_t round = (int64_t)1 << (shift - 1);
+    const q31_t *src = in;
+
+    for (uint8_t s = 0; s < f->num_stages; s++) {
+        DspBiquadQ31Stage *st = &f->stages[s];
+        DspBiquadQ31Coeffs c = st->c;
+        q31_t x1 = st->x1, x2 = st->x2, y1 = st->y1, y2 = st->y2;
+
+        for (uint32_t i = 0; i < n; i++) {
+            q31_t x = src[i];
+            int64_t acc = round;
+            acc += (int64_t)c.b0 * x;
+            acc += (int64_t)c.b1 * x1;
+            acc += (int64_t)c.b2 * x2;
+            acc += (int64_t)c.a1 * y1;
+            acc += (int64_t)c.a2 * y2;
+
+            q31_t y = sat_q31(acc >> shift);
+            out[i] = y;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+        }
+        st->x1 = x1;
+        st->x2 = x2;
+        st->y1 = y1;
+        st->y2 = y2;
+        src = out;
+    }
+}
+
+// ============================================================================
+// Moving average
+// ============================================================================
+void dsp_mavg_q15_init(DspMovingAvgQ15 *f, q15_t *window, uint8_t log2_len) {
+    f->window = window;
+    f->sum = 0;
+    f->pos = 0;
+    f->log2_len = log2_len;
+    for (uint32_t i = 0; i < (1u << log2_len); i++) {
+        window[i] = 0;
+    }
+}
+
+void dsp_mavg_q15(DspMovingAvgQ15 *f, const q15_t *in, q15_t *out, uint32_t n) {
+    uint8_t log2_len = f->log2_len;
+    uint16_t mask = (uint16_t)((1u << log2_len) - 1);
+    int32_t half = (1 << log2_len) >> 1;
+    int32_t sum = f->sum;
+    uint16_t pos = f->pos;
+
+    for (uint32_t i = 0; i < n; i++) {
+        sum += in[i] - f->window[pos];
+        f->window[pos] = in[i];
+        pos = (pos + 1) & mask;
+        out[i] = (q15_t)((sum + half) >> log2_len);
+    }
+    f->sum = sum;
+    f->pos = pos;
+}
+
+void dsp_mavg_q31_init(DspMovingAvgQ31 *f, q31_t *window, uint8_t log2_len) {
+    f->window = window;
+    f->sum = 0;
+    f->pos = 0;
+    f->log2_len = log2_len;
+    for (uint32_t i = 0; i < (1u << log2_len); i++) {
+        window[i] = 0;
+    }
+}
+
+void dsp_mavg_q31(DspMovingAvgQ31 *f, const q31_t *in, q31_t *out, uint32_t n) {
+    uint8_t log2_len = f->log2_len;
+    uint16_t mask = (uint16_t)((1u << log2_len) - 1);
+    int64_t half = ((int64_t)1 << log2_len) >> 1;
+    int64_t sum = f->sum;
+    uint16_t pos = f->pos;
+
+    for (uint32_t i = 0; i < n; i++) {
+        sum += (int64_t)in[i] - f->window[pos];
+        f->window[pos] = in[i];
+        pos = (pos + 1) & mask;
+        out[i] = (q31_t)((sum + half) >> log2_len);
+    }
+    f->sum = sum;
+    f->pos = pos;
+}
+
+// ============================================================================
+// References
+// ============================================================================
+void dsp_fir_q15_ref(const q15_t *coeffs, uint16_t num_taps, const q15_t *in, q15_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t acc = ROUND_Q15;
+        for (uint32_t age = 0; age < num_taps && age <= i; age++) {
+            acc += (int64_t)coeffs[num_taps - 1 - age] * in[i - age];
+        }
+        out[i] = sat_q15_64(acc >> 15);
+    }
+}
+
+void dsp_fir_q31_ref(const q31_t *coeffs, uint16_t num_taps, const q31_t *in, q31_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t acc = ROUND_Q31;
+        for (uint32_t age = 0; age < num_taps && age <= i; age++) {
+            acc += (int64_t)coeffs[num_taps - 1 - age] * in[i - age];
+        }
+        out[i] = sat_q31(acc >> 31);
+    }
+}
+
+void dsp_biquad_q15_ref(const DspBiquadQ15Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift,
+                        const q15_t *in, q15_t *out, uint32_t n) {
+    uint8_t shift = 15 - post_shift;
+    const q15_t *src = in;
+
+    for (uint8_t s = 0; s < num_stages; s++) {
+        const DspBiquadQ15Coeffs *c = &coeffs[s];
+        int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        for (uint32_t i = 0; i < n; i++) {
+            int32_t x = src[i];
+            int64_t acc = (int64_t)c->b0 * x + (int64_t)c->b1 * x1 + (int64_t)c->b2 * x2 +
+                          (int64_t)c->a1 * y1 + (int64_t)c->a2 * y2 + (1 << (shift - 1));
+
+            out[i] = sat_q15_64(acc >> shift);
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = out[i];
+        }
+        src = out;
+    }
+}
+
+void dsp_biquad_q31_ref(const DspBiquadQ31Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift,
+                        const q31_t *in, q31_t *out, uint32_t n) {
+    uint8_t shift = 31 - post_shift;
+    const q31_t *src = in;
+
+    for (uint8_t s = 0; s < num_stages; s++) {
+        const DspBiquadQ31Coeffs *c = &coeffs[s];
+        int64_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        for (uint32_t i = 0; i < n; i++) {
+            int64_t x = src[i];
+            int64_t acc = c->b0 * x + c->b1 * x1 + c->b2 * x2 + c->a1 * y1 + c->a2 * y2 +
+                          ((int64_t)1 << (shift - 1));
+
+            out[i] = sat_q31(acc >> shift);
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = out[i];
+        }
+        src = out;
+    }
+}
+
+void dsp_mavg_q15_ref(uint8_t log2_len, const q15_t *in, q15_t *out, uint32_t n) {
+    uint32_t len = 1u << log2_len;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t sum = 0;
+        for (uint32_t age = 0; age < len && age <= i; age++) {
+            sum += in[i - age];
+        }
+        out[i] = (q15_t)((sum + (len >> 1)) >> log2_len);
+    }
+}
+
+void dsp_mavg_q31_ref(uint8_t log2_len, const q31_t *in, q31_t *out, uint32_t n) {
+    uint32_t len = 1u << log2_len;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t sum = 0;
+        for (uint32_t age = 0; age < len && age <= i; age++) {
+            sum += in[i - age];
+        }
+        out[i] = (q31_t)((sum + (len >> 1)) >> log2_len);
+    }
+}
+
+// ============================================================================
+// Benchmark: the best of DSP_BENCH_RUNS blocks, so an interrupt that
+// lands in one run does not count
+// ============================================================================
+#define DSP_BENCH_BLOCK     64
+#define DSP_BENCH_RUNS      8
+#define DSP_BENCH_TAPS_MAX  64
+
+// 2nd-order Butterworth low-pass at fs / 20, post_shift 1
+#define BENCH_POST_SHIFT    1
+static const DspBiquadQ15Coeffs bench_lowpass = { 329, 658, 329, 25576, -10508 };
+
+static struct {
+    q15_t in15[DSP_BENCH_BLOCK], out15[DSP_BENCH_BLOCK];
+    q31_t in31[DSP_BENCH_BLOCK], out31[DSP_BENCH_BLOCK];
+    q15_t c15[DSP_BENCH_TAPS_MAX];
+    q31_t c31[DSP_BENCH_TAPS_MAX];
+    q15_t state15[DSP_FIR_STATE_LEN(DSP_BENCH_TAPS_MAX)];
+    q31_t state31[DSP_FIR_STATE_LEN(DSP_BENCH_TAPS_MAX)];
+    DspBiquadQ15Coeffs bq15[4];
+    DspBiquadQ31Coeffs bq31[4];
+    DspBiquadQ15Stage stages15[4];
+    DspBiquadQ31Stage stages31[4];
+} bench;
+
+static uint32_t bench_fir_q15(uint16_t taps, uint8_t ref) {
+    DspFirQ15 f;
+    dsp_fir_q15_init(&f, bench.c15, taps, bench.state15);
+    uint32_t t0 = DWT_CYCCNT;
+    if (ref) {
+        dsp_fir_q15_ref(bench.c15, taps, bench.in15, bench.out15, DSP_BENCH_BLOCK);
+    } else {
+        dsp_fir_q15(&f, bench.in15, bench.out15, DSP_BENCH_BLOCK);
+    }
+    return DWT_CYCCNT - t0;
+}
+
+static uint32_t bench_fir_q31(uint16_t taps, uint8_t ref) {
+    DspFirQ31 f;
+    dsp_fir_q31_init(&f, bench.c31, taps, bench.state31);
+    uint32_t t0 = DWT_CYCCNT;
+    if (ref) {
+        dsp_fir_q31_ref(bench.c31, taps, bench.in31, bench.out31, DSP_BENCH_BLOCK);
+    } else {
+        dsp_fir_q31(&f, bench.in31, bench.out31, DSP_BENCH_BLOCK);
+    }
+    return DWT_CYCCNT - t0;
+}
+
+static uint32_t bench_biquad_q15(uint16_t stages, uint8_t ref) {
+    DspBiquadQ15 f;
+    dsp_biquad_q15_init(&f, bench.stages15, bench.bq15, (uint8_t)stages, BENCH_POST_SHIFT);
+    uint32_t t0 = DWT_CYCCNT;
+    if (ref) {
+        dsp_biquad_q15_ref(bench.bq15, (uint8_t)stages, BENCH_POST_SHIFT,
+                           bench.in15, bench.out15, DSP_BENCH_BLOCK);
+    } else {
+        dsp_biquad_q15(&f, bench.in15, bench.out15, DSP_BENCH_BLOCK);
+    }
+    return DWT_CYCCNT - t0;
+}
+
+static uint32_t bench_biquad_q31(uint16_t stages, uint8_t ref) {
+    DspBiquadQ31 f;
+    dsp_biquad_q31_init(&f, bench.stages31, bench.bq31, (uint8_t)stages, BENCH_POST_SHIFT);
+    uint32_t t0 = DWT_CYCCNT;
+    if (ref) {
+        dsp_biquad_q31_ref(bench.bq31, (uint8_t)stages, BENCH_POST_SHIFT,
+                           bench.in31, bench.out31, DSP_BENCH_BLOCK);
+    } else {
+        dsp_biquad_q31(&f, bench.in31, bench.out31, DSP_BENCH_BLOCK);
+    }
+    return DWT_CYCCNT - t0;
+}
+
+// The window is the FIR state buffer: both are long enough
+static uint32_t bench_mavg_q15(uint16_t log2_len, uint8_t ref) {
+    DspMovingAvgQ15 f;
+    dsp_mavg_q15_init(&f, bench.state15, (uint8_t)log2_len);
+    uint32_t t0 = DWT_CYCCNT;
+    if (ref) {
+        dsp_mavg_q15_ref((uint8_t)log2_len, bench.in15, bench.out15, DSP_BENCH_BLOCK);
+    } else {
+        dsp_mavg_q15(&f, bench.in15, bench.out15, DSP_BENCH_BLOCK);
+    }
+    return DWT_CYCCNT - t0;
+}
+
+static uint32_t bench_mavg_q31(uint16_t log2_len, uint8_t ref) {
+    DspMovingAvgQ31 f;
+    dsp_mavg_q31_init(&f, bench.state31, (uint8_t)log2_len);
+    uint32_t t0 = DWT_CYCCNT;
+    if (ref) {
+        dsp_mavg_q31_ref((uint8_t)log2_len, bench.in31, bench.out31, DSP_BENCH_BLOCK);
+    } else {
+        dsp_mavg_q31(&f, bench.in31, bench.out31, DSP_BENCH_BLOCK);
+    }
+    return DWT_CYCCNT - t0;
+}
+
+typedef struct {
+    const char *name;
+    uint32_t (*run)(uint16_t size, uint8_t ref);
+    uint16_t sizes[4];              // 0 = unused
+    const char *unit;
+} BenchCase;
+
+static const BenchCase bench_cases[] = {
+    { "fir q15",    bench_fir_q15,    { 8, 16, 32, 64 }, " taps" },
+    { "fir q31",    bench_fir_q31,    { 8, 16, 32, 64 }, " taps" },
+    { "biquad q15", bench_biquad_q15, { 1, 2, 4, 0 },    " stages" },
+    { "biquad q31", bench_biquad_q31, { 1, 2, 4, 0 },    " stages" },
+    { "mavg q15",   bench_mavg_q15,   { 3, 6, 0, 0 },    " log2 len" },
+    { "mavg q31",   bench_mavg_q31,   { 3, 6, 0, 0 },    " log2 len" },
+};
+
+static void bench_fill(void) {
+    uint32_t seed = 12345;
+
+    for (uint32_t i = 0; i < DSP_BENCH_BLOCK; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        bench.in15[i] = (q15_t)((int32_t)seed >> 17);          // Half scale
+        bench.in31[i] = (q31_t)((int32_t)seed >> 1);
+    }
+    for (uint32_t k = 0; k < DSP_BENCH_TAPS_MAX; k++) {
+        bench.c15[k] = 32767 / DSP_BENCH_TAPS_MAX;              // sum |c| < 1.0
+        bench.c31[k] = INT32_MAX / DSP_BENCH_TAPS_MAX;
+    }
+    for (uint8_t s = 0; s < 4; s++) {
+        const DspBiquadQ15Coeffs *c = &bench_lowpass;
+        bench.bq15[s] = *c;
+        bench.bq31[s] = (DspBiquadQ31Coeffs){ c->b0 * 65536, c->b1 * 65536, c->b2 * 65536,
+                                              c->a1 * 65536, c->a2 * 65536 };
+    }
+}
+
+static uint32_t bench_best(const BenchCase *bc, uint16_t size, uint8_t ref) {
+    uint32_t best = UINT32_MAX;
+
+    for (uint8_t run = 0; run < DSP_BENCH_RUNS; run++) {
+        uint32_t cycles = bc->run(size, ref);
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+// "dsp: cycles/sample, 64-sample blocks, kernel / plain C"
+// "fir q15     16 taps          11 / 52"
+void dsp_bench_uart(void) {
+    char line[64];
+    char *p;
+
+    bench_fill();
+    p = line;
+    p += fmt_str(p, "dsp: cycles/sample, ", 0);
+    p += fmt_dec(p, DSP_BENCH_BLOCK);
+    p += fmt_str(p, "-sample blocks, kernel / plain C\r\n", 0);
+    uart_write(line, (uint32_t)(p - line));
+
+    for (uint8_t i = 0; i < sizeof bench_cases / sizeof bench_cases[0]; i++) {
+        const BenchCase *bc = &bench_cases[i];
+
+        for (uint8_t j = 0; j < 4 && bc->sizes[j]; j++) {
+            char size[24];
+            char *q = size;
+            q += fmt_dec(q, bc->sizes[j]);
+            fmt_str(q, bc->unit, 0);
+
+            p = line;
+            p += fmt_str(p, bc->name, 12);
+            p += fmt_str(p, size, 16);
+            p += fmt_dec(p, (bench_best(bc, bc->sizes[j], 0) + DSP_BENCH_BLOCK / 2) / DSP_BENCH_BLOCK);
+            p += fmt_str(p, " / ", 0);
+            p += fmt_dec(p, (bench_best(bc, bc->sizes[j], 1) + DSP_BENCH_BLOCK / 2) / DSP_BENCH_BLOCK);
+            p += fmt_str(p, "\r\n", 0);
+            uart_write(line, (uint32_t)(p - line));
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ ******************************************************************************
+ * @file           : dsp.h
+ * @brief          : Fixed-point filters on the Cortex-M4 DSP instructions
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 4, 2026
+ ******************************************************************************
+ * Q15 (int16, +-1.0) and Q31 (int32) block filters for sensor data:
+ *
+ *   FIR           Q15: SMLAD, two 16x16 MACs per instruction, 32-bit sum
+ *                 Q31: SMLAL, one 32x32 MAC into 64 bits
+ *   Biquad IIR    Direct form I cascade. Q15: SMUAD + SMLAD per section,
+ *                 the history kept as packed pairs (PKHBT). Q31: SMLAL
+ *   Moving avg    Running sum over 2^log2_len samples: one add and one
+ *                 subtract per sample at any length
+ *
+ * Every filter keeps its history between calls, so a stream can be fed
+ * in blocks of any size. Results are rounded to nearest and saturated.
+ *
+ * Each kernel has a plain C reference (_ref: one MAC at a time, whole
+ * signal from silence, no DSP instructions) that defines its output.
+ * Built for anything but the M4, the kernels use C versions of the
+ * instructions with the same wrap-around, so on the PC they give the
+ * target's results bit for bit; dsp_harness.c checks them against the
+ * references there. dsp_bench_uart() (console 'f') times both on the
+ * target with the DWT counter.
+ *
+ * Headroom - the Q15 kernels sum in 32 bits, like the instructions (the
+ * Q31 ones in 64), and are only bit-exact with their references within:
+ *   FIR     sum |coeffs| <= 1.0
+ *   Biquad  sum of the five |stored coefficients| < 2.0 per section; with
+ *           post_shift 1 (coefficients stored halved) any stable section
+ *           with sum |b| < 1.0 fits
+ ******************************************************************************
+ */
+
+#ifndef DSP_H
+#define DSP_H
+
+#include <stdint.h>
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+#define DSP_BLOCK_MAX           32      // FIR samples per pass (state size)
+#define DSP_FIR_STATE_LEN(taps) ((taps) - 1u + DSP_BLOCK_MAX)
+
+// ============================================================================
+// FIR: coefficients time-reversed, coeffs[0] multiplies the oldest sample
+// ============================================================================
+typedef struct {
+    const q15_t *coeffs;
+    q15_t *state;                   // DSP_FIR_STATE_LEN(num_taps)
+    uint16_t num_taps;
+} DspFirQ15;
+
+typedef struct {
+    const q31_t *coeffs;
+    q31_t *state;                   // DSP_FIR_STATE_LEN(num_taps)
+    uint16_t num_taps;
+} DspFirQ31;
+
+void dsp_fir_q15_init(DspFirQ15 *f, const q15_t *coeffs, uint16_t num_taps, q15_t *state);
+void dsp_fir_q15(DspFirQ15 *f, const q15_t *in, q15_t *out, uint32_t n);
+void dsp_fir_q31_init(DspFirQ31 *f, const q31_t *coeffs, uint16_t num_taps, q31_t *state);
+void dsp_fir_q31(DspFirQ31 *f, const q31_t *in, q31_t *out, uint32_t n);
+
+// ============================================================================
+// Biquad: y = (b0 x0 + b1 x1 + b2 x2 + a1 y1 + a2 y2) << post_shift
+// (a1, a2 with the sign flipped from the textbook 1 + a1 z^-1 + a2 z^-2)
+// ============================================================================
+typedef struct {
+    q15_t b0, b1, b2, a1, a2;
+} DspBiquadQ15Coeffs;
+
+typedef struct {
+    uint32_t b12, a12;              // Packed b1 | b2 << 16, a1 | a2 << 16
+    uint32_t x, y;                  // Packed x[n-1] | x[n-2] << 16, y the same
+    q15_t b0;
+} DspBiquadQ15Stage;
+
+typedef struct {
+    DspBiquadQ15Stage *stages;
+    uint8_t num_stages;
+    uint8_t post_shift;             // 0..2
+} DspBiquadQ15;
+
+typedef struct {
+    q31_t b0, b1, b2, a1, a2;
+} DspBiquadQ31Coeffs;
+
+typedef struct {
+    DspBiquadQ31Coeffs c;
+    q31_t x1, x2, y1, y2;
+} DspBiquadQ31Stage;
+
+typedef struct {
+    DspBiquadQ31Stage *stages;
+    uint8_t num_stages;
+    uint8_t post_shift;             // 0..2
+} DspBiquadQ31;
+
+void dsp_biquad_q15_init(DspBiquadQ15 *f, DspBiquadQ15Stage *stages,
+                         const DspBiquadQ15Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift);
+void dsp_biquad_q15(DspBiquadQ15 *f, const q15_t *in, q15_t *out, uint32_t n);
+void dsp_biquad_q31_init(DspBiquadQ31 *f, DspBiquadQ31Stage *stages,
+                         const DspBiquadQ31Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift);
+void dsp_biquad_q31(DspBiquadQ31 *f, const q31_t *in, q31_t *out, uint32_t n);
+
+// ============================================================================
+// Moving average over the last 2^log2_len samples (silence before the first)
+// ============================================================================
+typedef struct {
+    q15_t *window;                  // 2^log2_len samples
+    int32_t sum;
+    uint16_t pos;
+    uint8_t log2_len;               // 0..15
+} DspMovingAvgQ15;
+
+typedef struct {
+    q31_t *window;
+    int64_t sum;
+    uint16_t pos;
+    uint8_t log2_len;               // 0..15
+} DspMovingAvgQ31;
+
+void dsp_mavg_q15_init(DspMovingAvgQ15 *f, q15_t *window, uint8_t log2_len);
+void dsp_mavg_q15(DspMovingAvgQ15 *f, const q15_t *in, q15_t *out, uint32_t n);
+void dsp_mavg_q31_init(DspMovingAvgQ31 *f, q31_t *window, uint8_t log2_len);
+void dsp_mavg_q31(DspMovingAvgQ31 *f, const q31_t *in, q31_t *out, uint32_t n);
+
+// ============================================================================
+// References: the whole signal 'in' from silence
+// ============================================================================
+void dsp_fir_q15_ref(const q15_t *coeffs, uint16_t num_taps, const q15_t *in, q15_t *out, uint32_t n);
+void dsp_fir_q31_ref(const q31_t *coeffs, uint16_t num_taps, const q31_t *in, q31_t *out, uint32_t n);
+void dsp_biquad_q15_ref(const DspBiquadQ15Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift,
+                        const q15_t *in, q15_t *out, uint32_t n);
+void dsp_biquad_q31_ref(const DspBiquadQ31Coeffs *coeffs, uint8_t num_stages, uint8_t post_shift,
+                        const q31_t *in, q31_t *out, uint32_t n);
+void dsp_mavg_q15_ref(uint8_t log2_len, const q15_t *in, q15_t *out, uint32_t n);
+void dsp_mavg_q31_ref(uint8_t log2_len, const q31_t *in, q31_t *out, uint32_t n);
+
+// Cycles per sample of every kernel and its reference (target only)
+void dsp_bench_uart(void);
+
+#endif // DSP_H
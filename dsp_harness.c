@@ -0,0 +1,355 @@
+/**
+ ******************************************************************************
+ * @file           : dsp_harness.c
+ * @brief          : Host tool - DSP kernels against their plain C references
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 4, 2026
+ ******************************************************************************
+ * Runs the unchanged dsp.c, whose kernels use C versions of SMLAD /
+ * SMUAD / PKHBT / SSAT here (same wrap-around and saturation as the M4),
+ * so a kernel that matches its reference on the PC matches it on the
+ * target:
+ *
+ *   gcc -O2 -o dsp_harness dsp_harness.c dsp.c fmt.c -lm
+ *   ./dsp_harness [seeds]                         (default 20)
+ *
+ * Every kernel at every size (FIR 1 .. FIR_TAPS_MAX taps, odd ones too;
+ * 1 .. 4 biquad sections at post_shift 0 .. 2; moving averages of
+ * 1 .. 1024 samples) gets SIGNAL_LEN samples fed in random block sizes,
+ * and must give the reference's output for the whole signal, bit for
+ * bit. Coefficients are random within the headroom in dsp.h, the
+ * signals random at full scale, full-scale steps and a square wave at
+ * Nyquist (saturation and rounding at the edges).
+ *
+ * The references themselves are checked against what the filters are:
+ * an FIR's impulse response is its coefficients, a low-pass biquad and a
+ * moving average pass DC and settle on a step.
+ *
+ * Cycles per sample come from the target: console 'f' (dsp_bench_uart).
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "dsp.h"
+
+#define SIGNAL_LEN          3000
+#define FIR_TAPS_MAX        70
+#define BIQUAD_STAGES_MAX   4
+#define MAVG_LOG2_MAX       10
+#define BLOCK_MAX           100         // Random block sizes 1..BLOCK_MAX
+#define DEFAULT_SEEDS       20
+
+// dsp_bench_uart() is not run on the host
+void uart_write(const char *data, uint32_t len) { (void)data; (void)len; }
+
+static uint32_t errors;
+static uint64_t samples_checked;
+static uint32_t configs_checked;
+
+static void fail(const char *what, uint32_t size, uint32_t at, int64_t got, int64_t want) {
+    if (errors++ < 10) {
+        printf("  FAIL %s size %u: sample %u is %lld, reference %lld\n",
+               what, size, at, (long long)got, (long long)want);
+    }
+}
+
+// ============================================================================
+// Random numbers and signals
+// ============================================================================
+static uint64_t rng_state;
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static double rng_unit(void) {
+    return rng() / 4294967296.0;
+}
+
+typedef enum {
+    SIGNAL_RANDOM,
+    SIGNAL_STEPS,                   // Full-scale steps, random lengths
+    SIGNAL_NYQUIST,                 // +full, -full, ...
+    SIGNAL_COUNT
+} SignalKind;
+
+static const char *const signal_names[SIGNAL_COUNT] = { "random", "steps", "nyquist" };
+
+static q15_t in15[SIGNAL_LEN], out15[SIGNAL_LEN], ref15[SIGNAL_LEN];
+static q31_t in31[SIGNAL_LEN], out31[SIGNAL_LEN], ref31[SIGNAL_LEN];
+
+static void make_signal(SignalKind kind) {
+    int32_t level = INT32_MAX;
+
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        int32_t v;
+        switch (kind) {
+        case SIGNAL_RANDOM:
+            v = (int32_t)rng();
+            break;
+        case SIGNAL_STEPS:
+            if (rng() % 50 == 0) {
+                level = (rng() & 1) ? INT32_MAX : INT32_MIN;
+            }
+            v = level;
+            break;
+        default:
+            v = (i & 1) ? INT32_MIN : INT32_MAX;
+            break;
+        }
+        in31[i] = v;
+        in15[i] = (q15_t)(v >> 16);
+    }
+}
+
+// Feeds 'run' the signal in random block sizes
+#define FEED(run, in, out) do {                                         \
+        uint32_t done_ = 0;                                             \
+        while (done_ < SIGNAL_LEN) {                                    \
+            uint32_t n_ = 1 + rng() % BLOCK_MAX;                        \
+            if (n_ > SIGNAL_LEN - done_) n_ = SIGNAL_LEN - done_;       \
+            run(&(in)[done_], &(out)[done_], n_);                       \
+            done_ += n_;                                                \
+        }                                                               \
+    } while (0)
+
+static void compare15(const char *what, uint32_t size) {
+    configs_checked++;
+    samples_checked += SIGNAL_LEN;
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        if (out15[i] != ref15[i]) {
+            fail(what, size, i, out15[i], ref15[i]);
+            return;
+        }
+    }
+}
+
+static void compare31(const char *what, uint32_t size) {
+    configs_checked++;
+    samples_checked += SIGNAL_LEN;
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        if (out31[i] != ref31[i]) {
+            fail(what, size, i, out31[i], ref31[i]);
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// Kernels vs references
+// ============================================================================
+static q15_t fir_c15[FIR_TAPS_MAX];
+static q31_t fir_c31[FIR_TAPS_MAX];
+static q15_t fir_state15[DSP_FIR_STATE_LEN(FIR_TAPS_MAX)];
+static q31_t fir_state31[DSP_FIR_STATE_LEN(FIR_TAPS_MAX)];
+static DspFirQ15 fir15;
+static DspFirQ31 fir31;
+
+static void run_fir15(const q15_t *in, q15_t *out, uint32_t n) { dsp_fir_q15(&fir15, in, out, n); }
+static void run_fir31(const q31_t *in, q31_t *out, uint32_t n) { dsp_fir_q31(&fir31, in, out, n); }
+
+// Random coefficients with sum |c| = 1.0 at most; now and then one tap
+// at -1.0 (the largest product, -32768 * -32768)
+static void make_fir(uint16_t taps) {
+    double c[FIR_TAPS_MAX], sum = 0;
+
+    for (uint16_t k = 0; k < taps; k++) {
+        c[k] = rng_unit() * 2 - 1;
+        sum += fabs(c[k]);
+    }
+    for (uint16_t k = 0; k < taps; k++) {
+        fir_c15[k] = (q15_t)floor(c[k] / sum * 32767);
+        fir_c31[k] = (q31_t)floor(c[k] / sum * 2147483647.0);
+    }
+    if (rng() % 8 == 0) {
+        memset(fir_c15, 0, sizeof fir_c15);
+        memset(fir_c31, 0, sizeof fir_c31);
+        fir_c15[rng() % taps] = INT16_MIN;
+        fir_c31[rng() % taps] = INT32_MIN;
+    }
+}
+
+static void check_fir(void) {
+    for (uint16_t taps = 1; taps <= FIR_TAPS_MAX; taps++) {
+        make_fir(taps);
+        dsp_fir_q15_init(&fir15, fir_c15, taps, fir_state15);
+        FEED(run_fir15, in15, out15);
+        dsp_fir_q15_ref(fir_c15, taps, in15, ref15, SIGNAL_LEN);
+        compare15("fir q15", taps);
+
+        dsp_fir_q31_init(&fir31, fir_c31, taps, fir_state31);
+        FEED(run_fir31, in31, out31);
+        dsp_fir_q31_ref(fir_c31, taps, in31, ref31, SIGNAL_LEN);
+        compare31("fir q31", taps);
+    }
+}
+
+static DspBiquadQ15Coeffs bq_c15[BIQUAD_STAGES_MAX];
+static DspBiquadQ31Coeffs bq_c31[BIQUAD_STAGES_MAX];
+static DspBiquadQ15Stage bq_stages15[BIQUAD_STAGES_MAX];
+static DspBiquadQ31Stage bq_stages31[BIQUAD_STAGES_MAX];
+static DspBiquadQ15 bq15;
+static DspBiquadQ31 bq31;
+
+static void run_bq15(const q15_t *in, q15_t *out, uint32_t n) { dsp_biquad_q15(&bq15, in, out, n); }
+static void run_bq31(const q31_t *in, q31_t *out, uint32_t n) { dsp_biquad_q31(&bq31, in, out, n); }
+
+// A random stable section (poles inside the unit circle) whose stored
+// coefficients add up to under 2.0
+static void make_section(uint8_t s, uint8_t post_shift) {
+    double scale = 1.0 / (1 << post_shift);
+    double r, theta, c[5], sum;
+
+    do {
+        r = 0.3 + 0.69 * rng_unit();
+        theta = M_PI * rng_unit();
+        c[3] = 2 * r * cos(theta);          // a1, a2 sign-flipped
+        c[4] = -r * r;
+        sum = 0;
+        for (uint8_t k = 0; k < 3; k++) {
+            c[k] = (rng_unit() * 2 - 1) * 0.33;
+        }
+        for (uint8_t k = 0; k < 5; k++) {
+            c[k] *= scale;
+            sum += fabs(c[k]);
+        }
+    } while (sum >= 1.99 || fabs(c[3]) >= 1.0 || fabs(c[4]) >= 1.0);
+
+    q15_t q[5];
+    for (uint8_t k = 0; k < 5; k++) {
+        q[k] = (q15_t)lround(c[k] * 32767);
+    }
+    bq_c15[s] = (DspBiquadQ15Coeffs){ q[0], q[1], q[2], q[3], q[4] };
+    bq_c31[s] = (DspBiquadQ31Coeffs){ (q31_t)lround(c[0] * 2147483647.0), (q31_t)lround(c[1] * 2147483647.0),
+                                      (q31_t)lround(c[2] * 2147483647.0), (q31_t)lround(c[3] * 2147483647.0),
+                                      (q31_t)lround(c[4] * 2147483647.0) };
+}
+
+static void check_biquad(void) {
+    for (uint8_t post_shift = 0; post_shift <= 2; post_shift++) {
+        for (uint8_t stages = 1; stages <= BIQUAD_STAGES_MAX; stages++) {
+            for (uint8_t s = 0; s < stages; s++) {
+                make_section(s, post_shift);
+            }
+            char what[32];
+            snprintf(what, sizeof what, "biquad q15 shift %u", post_shift);
+            dsp_biquad_q15_init(&bq15, bq_stages15, bq_c15, stages, post_shift);
+            FEED(run_bq15, in15, out15);
+            dsp_biquad_q15_ref(bq_c15, stages, post_shift, in15, ref15, SIGNAL_LEN);
+            compare15(what, stages);
+
+            snprintf(what, sizeof what, "biquad q31 shift %u", post_shift);
+            dsp_biquad_q31_init(&bq31, bq_stages31, bq_c31, stages, post_shift);
+            FEED(run_bq31, in31, out31);
+            dsp_biquad_q31_ref(bq_c31, stages, post_shift, in31, ref31, SIGNAL_LEN);
+            compare31(what, stages);
+        }
+    }
+}
+
+static q15_t mavg_window15[1 << MAVG_LOG2_MAX];
+static q31_t mavg_window31[1 << MAVG_LOG2_MAX];
+static DspMovingAvgQ15 mavg15;
+static DspMovingAvgQ31 mavg31;
+
+static void run_mavg15(const q15_t *in, q15_t *out, uint32_t n) { dsp_mavg_q15(&mavg15, in, out, n); }
+static void run_mavg31(const q31_t *in, q31_t *out, uint32_t n) { dsp_mavg_q31(&mavg31, in, out, n); }
+
+static void check_mavg(void) {
+    for (uint8_t log2_len = 0; log2_len <= MAVG_LOG2_MAX; log2_len++) {
+        dsp_mavg_q15_init(&mavg15, mavg_window15, log2_len);
+        FEED(run_mavg15, in15, out15);
+        dsp_mavg_q15_ref(log2_len, in15, ref15, SIGNAL_LEN);
+        compare15("mavg q15", 1u << log2_len);
+
+        dsp_mavg_q31_init(&mavg31, mavg_window31, log2_len);
+        FEED(run_mavg31, in31, out31);
+        dsp_mavg_q31_ref(log2_len, in31, ref31, SIGNAL_LEN);
+        compare31("mavg q31", 1u << log2_len);
+    }
+}
+
+// ============================================================================
+// The references against what the filters are
+// ============================================================================
+static void check(uint8_t ok, const char *what) {
+    if (!ok) {
+        errors++;
+        printf("  FAIL reference: %s\n", what);
+    }
+}
+
+static void check_references(void) {
+    static const q15_t c15[5] = { 1000, -2000, 3000, -4000, 5000 };    // Time-reversed
+    static const q31_t c31[5] = { 100000, -200000, 300000, -400000, 500000 };
+    q15_t x15[8] = { 32767 }, y15[8];
+    q31_t x31[8] = { INT32_MAX }, y31[8];
+    uint8_t ok = 1;
+
+    // Impulse (1.0 - 1 LSB) in: the coefficients out, newest tap first
+    dsp_fir_q15_ref(c15, 5, x15, y15, 8);
+    dsp_fir_q31_ref(c31, 5, x31, y31, 8);
+    for (uint8_t k = 0; k < 5; k++) {
+        ok &= y15[k] == c15[4 - k] && y31[k] == c31[4 - k];
+    }
+    ok &= y15[5] == 0 && y31[5] == 0;
+    check(ok, "FIR impulse response is the coefficients");
+
+    // The 2nd-order Butterworth low-pass at fs / 20 from dsp.c's
+    // benchmark: DC gain 1, a full-scale step settles on itself
+    static const DspBiquadQ15Coeffs lowpass = { 329, 658, 329, 25576, -10508 };
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        in15[i] = 16000;
+    }
+    dsp_biquad_q15_ref(&lowpass, 1, 1, in15, ref15, SIGNAL_LEN);
+    check(abs(ref15[SIGNAL_LEN - 1] - 16000) <= 8, "biquad low-pass passes DC");
+
+    // ... and a tone at Nyquist comes out 40 dB down or more
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        in15[i] = (i & 1) ? -16000 : 16000;
+    }
+    dsp_biquad_q15_ref(&lowpass, 1, 1, in15, ref15, SIGNAL_LEN);
+    check(abs(ref15[SIGNAL_LEN - 1]) <= 160, "biquad low-pass stops Nyquist");
+
+    // Moving average of 8: a step in reaches the step value after 8
+    for (uint32_t i = 0; i < 16; i++) {
+        in15[i] = 800;
+    }
+    dsp_mavg_q15_ref(3, in15, ref15, 16);
+    check(ref15[0] == 100 && ref15[6] == 700 && ref15[7] == 800 && ref15[15] == 800,
+          "moving average ramps up over its length");
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+int main(int argc, char **argv) {
+    uint32_t seeds = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 10) : DEFAULT_SEEDS;
+
+    check_references();
+    for (uint32_t seed = 1; seed <= seeds; seed++) {
+        for (uint8_t kind = 0; kind < SIGNAL_COUNT; kind++) {
+            rng_state = seed * 1000003u + kind;
+            make_signal((SignalKind)kind);
+            uint32_t before = errors;
+            check_fir();
+            check_biquad();
+            check_mavg();
+            if (errors != before && before < 10) {
+                printf("  (seed %u, %s signal)\n", seed, signal_names[kind]);
+            }
+        }
+    }
+
+    printf("Kernels       FIR q15/q31 1..%u taps, biquad q15/q31 1..%u sections, "
+           "moving average 1..%u\n", FIR_TAPS_MAX, BIQUAD_STAGES_MAX, 1u << MAVG_LOG2_MAX);
+    printf("Checked       %u configurations, %llu samples, blocks of 1..%u\n",
+           configs_checked, (unsigned long long)samples_checked, BLOCK_MAX);
+    printf("%s\n", errors ? "FAILED" : "Every kernel bit-exact with its reference");
+    return errors ? 1 : 0;
+}
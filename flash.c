@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file           : flash.c
+ * @brief          : On-chip Flash page erase and half-word programming
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ */
+
+#include "flash.h"
+#include "stm32f303_regs.h"
+#include "systick.h"
+
+#define FLASH_SR_ERRORS     (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)
+
+static FlashStallHook stall_hook;
+
+static void flash_unlock(void) {
+    if (FLASH_CR & FLASH_CR_LOCK) {
+        FLASH_KEYR = FLASH_KEY1;
+        FLASH_KEYR = FLASH_KEY2;
+    }
+}
+
+static void flash_lock(void) {
+    FLASH_CR |= FLASH_CR_LOCK;
+}
+
+// Wait for the operation, clear the status flags (write 1), report errors.
+// 'start' / 'cvr': DWT count and SYST_CVR taken before the write that began
+// the operation, as the next fetch already stalls. The ticks SysTick could
+// not count meanwhile are credited to the ms clock; *longest keeps the
+// longest wait so far in cycles.
+static uint8_t flash_done(uint32_t start, uint32_t cvr, uint32_t *longest) {
+    while (FLASH_SR & FLASH_SR_BSY) {
+    }
+    uint32_t end = DWT_CYCCNT;
+    systick_credit_stall(start, cvr, end);
+    if (end - start > *longest) {
+        *longest = end - start;
+    }
+    uint32_t sr = FLASH_SR;
+    FLASH_SR = FLASH_SR_EOP | FLASH_SR_ERRORS;
+    return (sr & FLASH_SR_ERRORS) == 0;
+}
+
+static void stall_report(uint32_t cycles) {
+    if (stall_hook) {
+        stall_hook(cycles / systick_cycles_per_us());
+    }
+}
+
+uint8_t flash_erase_page(uint32_t addr) {
+    uint32_t longest = 0;
+
+    flash_unlock();
+    flash_done(DWT_CYCCNT, SYST_CVR, &longest);
+
+    FLASH_CR |= FLASH_CR_PER;
+    FLASH_AR = addr;
+    uint32_t cvr = SYST_CVR;
+    uint32_t start = DWT_CYCCNT;
+    FLASH_CR |= FLASH_CR_STRT;
+    uint8_t ok = flash_done(start, cvr, &longest);
+    FLASH_CR &= ~FLASH_CR_PER;
+
+    flash_lock();
+    stall_report(longest);
+
+    // Blank check: an erase cut short by a reset is not an erase
+    const uint32_t *p = (const uint32_t *)(addr & ~(FLASH_PAGE_SIZE - 1));
+    for (uint32_t i = 0; ok && i < FLASH_PAGE_SIZE / 4; i++) {
+        ok = (p[i] == 0xFFFFFFFF);
+    }
+    return ok;
+}
+
+uint8_t flash_program(uint32_t addr, const uint16_t *data, uint32_t count) {
+    volatile uint16_t *dst = (volatile uint16_t *)addr;
+    uint32_t longest = 0;
+    uint8_t ok = 1;
+
+    flash_unlock();
+    flash_done(DWT_CYCCNT, SYST_CVR, &longest);
+    FLASH_CR |= FLASH_CR_PG;
+
+    for (uint32_t i = 0; ok && i < count; i++) {
+        uint32_t cvr = SYST_CVR;
+        uint32_t start = DWT_CYCCNT;
+        dst[i] = data[i];               // One half-word per program cycle
+        ok = flash_done(start, cvr, &longest) && dst[i] == data[i];
+    }
+
+    FLASH_CR &= ~FLASH_CR_PG;
+    flash_lock();
+    stall_report(longest);              // Interrupts get in between half-words
+    return ok;
+}
+
+const uint8_t *flash_ptr(uint32_t addr) {
+    return (const uint8_t *)addr;
+}
+
+void flash_on_stall(FlashStallHook hook) {
+    stall_hook = hook;
+}
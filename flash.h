@@ -0,0 +1,51 @@
+/**
+ ******************************************************************************
+ * @file           : flash.h
+ * @brief          : On-chip Flash page erase and half-word programming
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ * STM32F303VC: 256 KB in 2 KB pages. Erased Flash reads 0xFF; a half-word
+ * can be programmed once after an erase (the controller refuses with
+ * PGERR if it is not 0xFFFF). Flash has a single bank, so while a page
+ * erase (20-40 ms) or a program (~50 us per half-word) runs, every fetch
+ * from Flash - including interrupt handlers - waits.
+ *
+ * Nothing here runs from RAM, so that stall is real: SysTick, EXTI, the
+ * PWM planes, CAN and sensor FIFOs all wait it out. Every wait is timed
+ * on the DWT counter:
+ *   - SysTick wraps up to 40 times in an erase but pends one interrupt;
+ *     the others are credited to get_time_ms() from the measured stall
+ *     (systick_credit_stall), so the ms clock does not fall behind.
+ *   - The longest wait of each call goes to the hook set with
+ *     flash_on_stall(), so the cost shows up in the latency stats.
+ * kvstore.c only erases once the settings have been left alone.
+ *
+ * kvstore_sim.c implements these three functions over a RAM array to run
+ * kvstore.c on the PC.
+ ******************************************************************************
+ */
+
+#ifndef FLASH_H
+#define FLASH_H
+
+#include <stdint.h>
+
+#define FLASH_PAGE_SIZE     2048
+
+// Longest single wait of one erase / program call, in us
+typedef void (*FlashStallHook)(uint32_t stall_us);
+
+// 1 = erased (all 0xFF)
+uint8_t flash_erase_page(uint32_t addr);
+
+// 'count' half-words to a half-word aligned address, verified.
+// 1 = written; 0 = a target half-word was not erased, or it did not read back.
+uint8_t flash_program(uint32_t addr, const uint16_t *data, uint32_t count);
+
+// Read access (memory mapped on the target)
+const uint8_t *flash_ptr(uint32_t addr);
+
+void flash_on_stall(FlashStallHook hook);
+
+#endif // FLASH_H
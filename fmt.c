@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @file           : fmt.c
+ * @brief          : Fast hex / binary formatting into a caller buffer
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ */
+
+#include "fmt.h"
+
+static const char hex_digits[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+// Nibble -> its four binary digits, MSB first
+static const char bin_nibble[16][4] = {
+    {'0','0','0','0'}, {'0','0','0','1'}, {'0','0','1','0'}, {'0','0','1','1'},
+    {'0','1','0','0'}, {'0','1','0','1'}, {'0','1','1','0'}, {'0','1','1','1'},
+    {'1','0','0','0'}, {'1','0','0','1'}, {'1','0','1','0'}, {'1','0','1','1'},
+    {'1','1','0','0'}, {'1','1','0','1'}, {'1','1','1','0'}, {'1','1','1','1'}
+};
+
+uint32_t fmt_hex(char *dst, uint32_t value, uint8_t digits) {
+    for (int i = digits - 1; i >= 0; i--) {
+        dst[i] = hex_digits[value & 0xF];
+        value >>= 4;
+    }
+    dst[digits] = '\0';
+    return digits;
+}
+
+uint32_t fmt_bin(char *dst, uint32_t value, uint8_t bits, uint8_t group, char sep) {
+    char *p = dst;
+    int i = bits;                       // Bits still to write
+
+    // Groups that are not whole nibbles: one digit at a time
+    if (group & 3) {
+        while (i > 0) {
+            i--;
+            *p++ = (char)('0' + ((value >> i) & 1));
+            if (i % group == 0 && i != 0) *p++ = sep;
+        }
+        *p = '\0';
+        return (uint32_t)(p - dst);
+    }
+
+    // Leading partial nibble (e.g. 'bits' = 10)
+    while (i & 3) {
+        i--;
+        *p++ = (char)('0' + ((value >> i) & 1));
+    }
+    if (group && i && (i % group) == 0 && p != dst) *p++ = sep;
+
+    // Whole nibbles from the table
+    while (i > 0) {
+        const char *digits = bin_nibble[(value >> (i - 4)) & 0xF];
+        p[0] = digits[0];
+        p[1] = digits[1];
+        p[2] = digits[2];
+        p[3] = digits[3];
+        p += 4;
+        i -= 4;
+        if (group && i && (i % group) == 0) *p++ = sep;
+    }
+    *p = '\0';
+    return (uint32_t)(p - dst);
+}
+
+uint32_t fmt_dec(char *dst, uint32_t value) {
+    char tmp[FMT_DEC_MAX];
+    uint32_t n = 0;
+
+    do {
+        tmp[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = tmp[n - 1 - i];
+    }
+    dst[n] = '\0';
+    return n;
+}
+
+uint32_t fmt_str(char *dst, const char *str, uint8_t width) {
+    char *p = dst;
+
+    while (*str) {
+        *p++ = *str++;
+    }
+    while (p - dst < width) {
+        *p++ = ' ';
+    }
+    *p = '\0';
+    return (uint32_t)(p - dst);
+}
@@ -0,0 +1,45 @@
+/**
+ ******************************************************************************
+ * @file           : fmt.h
+ * @brief          : Fast hex / binary formatting into a caller buffer
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * printBinary() (day4_bitmanip_SOLUTION.c) and printRegister()
+ * (day1_evening_challenge.c) call printf once per bit. These render the
+ * whole number into a buffer first - binary a nibble at a time from a
+ * 16-entry table, hex a digit at a time - so the caller sends it with one
+ * write:
+ *
+ *   char line[FMT_BIN_MAX];
+ *   uint32_t n = fmt_bin(line, GPIOE_MODER, 32, 8, ' ');
+ *   uart_write(line, n);
+ *
+ * Every function NUL-terminates and returns the length without the NUL.
+ * Plain C, no libc calls: the same file builds for the target and the PC.
+ ******************************************************************************
+ */
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+
+#define FMT_HEX_MAX         (8 + 1)             // "89ABCDEF"
+#define FMT_BIN_MAX         (32 + 31 + 1)       // 32 digits, worst-case grouping
+#define FMT_DEC_MAX         (10 + 1)            // "4294967295"
+
+// 'digits' hex digits (1..8), upper case, zero padded, no "0x"
+uint32_t fmt_hex(char *dst, uint32_t value, uint8_t digits);
+
+// Lowest 'bits' bits (1..32), MSB first. 'sep' goes between groups of
+// 'group' bits counted from bit 0 (group 0 = no separators).
+uint32_t fmt_bin(char *dst, uint32_t value, uint8_t bits, uint8_t group, char sep);
+
+// Unsigned decimal, no padding
+uint32_t fmt_dec(char *dst, uint32_t value);
+
+// Copies 'str', then spaces up to 'width' characters
+uint32_t fmt_str(char *dst, const char *str, uint8_t width);
+
+#endif // FMT_H
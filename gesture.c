@@ -0,0 +1,134 @@
+/**
+ ******************************************************************************
+ * @file           : gesture.c
+ * @brief          : Non-blocking button gestures (single/double/triple/long)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ * Everything is evaluated in timestamp order: queued edges and the
+ * timeouts between them. So a late gesture_update() call gives the same
+ * result as a punctual one - a press that arrived after the double-press
+ * window is still a new single press, not a double.
+ ******************************************************************************
+ */
+
+#include "gesture.h"
+
+#define QUEUE_MASK          (GESTURE_QUEUE_SIZE - 1)
+
+// Signed difference handles wrap-around of the ms counter
+#define TIME_REACHED(now, t)  ((int32_t)((now) - (t)) >= 0)
+
+void gesture_init(GestureRecognizer *g, const GestureConfig *config) {
+    g->config = config;
+    g->head = 0;
+    g->tail = 0;
+    g->first_edge_time = 0;
+    g->state = GESTURE_STATE_IDLE;
+    g->press_count = 0;
+}
+
+// ============================================================================
+// Called from the button ISR - O(1), never blocks
+// If the queue is full the edge is dropped; the classifier ignores a press
+// while pressed and a release while released, so it picks up again.
+// ============================================================================
+void gesture_push_edge(GestureRecognizer *g, uint8_t level, uint32_t time_ms, uint32_t since_ms) {
+    uint8_t next = (g->head + 1) & QUEUE_MASK;
+
+    if (next == g->tail) return;
+
+    g->edge_time[g->head] = time_ms;
+    g->edge_since[g->head] = since_ms;
+    g->edge_level[g->head] = level ? 1 : 0;
+    g->head = next;
+}
+
+// ============================================================================
+// Classifier: a debounced edge
+// ============================================================================
+static GestureEvent accept_edge(GestureRecognizer *g, uint8_t level, uint32_t t, uint32_t since) {
+    if (level) {
+        // Press
+        if (g->state == GESTURE_STATE_IDLE) {
+            g->press_count = 1;
+            g->first_edge_time = since;
+        } else if (g->state == GESTURE_STATE_WAIT_NEXT) {
+            g->press_count++;
+        } else {
+            return GESTURE_NONE;
+        }
+        g->state = GESTURE_STATE_PRESSED;
+        g->press_time = t;
+        return GESTURE_NONE;
+    }
+
+    // Release
+    if (g->state == GESTURE_STATE_PRESSED) {
+        if (g->press_count >= 3) {
+            g->state = GESTURE_STATE_IDLE;   // Nothing longer to wait for
+            return GESTURE_TRIPLE;
+        }
+        g->state = GESTURE_STATE_WAIT_NEXT;
+        g->release_time = t;
+    } else if (g->state == GESTURE_STATE_HOLDING) {
+        g->state = GESTURE_STATE_IDLE;
+    }
+    return GESTURE_NONE;
+}
+
+// ============================================================================
+// Classifier: time passing without an edge
+// ============================================================================
+static GestureEvent check_timeouts(GestureRecognizer *g, uint32_t now) {
+    const GestureConfig *cfg = g->config;
+
+    switch (g->state) {
+        case GESTURE_STATE_PRESSED:
+            if (TIME_REACHED(now, g->press_time + cfg->long_press_ms)) {
+                g->state = GESTURE_STATE_HOLDING;
+                g->next_repeat = g->press_time + cfg->long_press_ms + cfg->repeat_ms;
+                return GESTURE_LONG;
+            }
+            break;
+
+        case GESTURE_STATE_HOLDING:
+            if (cfg->repeat_ms && TIME_REACHED(now, g->next_repeat)) {
+                g->next_repeat += cfg->repeat_ms;
+                return GESTURE_HOLD_REPEAT;
+            }
+            break;
+
+        case GESTURE_STATE_WAIT_NEXT:
+            if ((int32_t)(now - g->release_time) > (int32_t)cfg->multi_window_ms) {
+                g->state = GESTURE_STATE_IDLE;
+                return (g->press_count == 1) ? GESTURE_SINGLE : GESTURE_DOUBLE;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return GESTURE_NONE;
+}
+
+// ============================================================================
+// Main loop: returns at most one event per call - call until GESTURE_NONE
+// ============================================================================
+GestureEvent gesture_update(GestureRecognizer *g, uint32_t now_ms) {
+    GestureEvent ev;
+
+    while (g->tail != g->head) {
+        uint32_t t = g->edge_time[g->tail];
+        uint32_t since = g->edge_since[g->tail];
+        uint8_t level = g->edge_level[g->tail];
+
+        // Anything that happened before this edge comes first
+        if ((ev = check_timeouts(g, t)) != GESTURE_NONE) return ev;
+
+        g->tail = (g->tail + 1) & QUEUE_MASK;
+        if ((ev = accept_edge(g, level, t, since)) != GESTURE_NONE) return ev;
+    }
+
+    return check_timeouts(g, now_ms);
+}
@@ -0,0 +1,82 @@
+/**
+ ******************************************************************************
+ * @file           : gesture.h
+ * @brief          : Non-blocking button gestures (single/double/triple/long)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ * button_pressed() in Day3_Final_7_Patterns.c sees only a rising edge and
+ * then blocks for the debounce. Here the button driver queues timestamped
+ * debounced edges (gesture_push_edge) and the LED engine classifies them
+ * (gesture_update) - nothing ever waits, so patterns keep running.
+ *
+ *   Press/release timeline                          Event
+ *   _/‾\_____________  (window expires)          -> GESTURE_SINGLE
+ *   _/‾\_/‾\_________                            -> GESTURE_DOUBLE
+ *   _/‾\_/‾\_/‾\_____  (reported on 3rd release) -> GESTURE_TRIPLE
+ *   _/‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾  (held > long_press_ms)    -> GESTURE_LONG, then
+ *                      (every repeat_ms)            GESTURE_HOLD_REPEAT
+ *
+ * The edges must come debounced: button.c samples the pin every tick
+ * through debounce.c's integrator. (An EXTI lock-out here used to turn
+ * release bounce and noise into extra presses - debounce_harness.c.)
+ *
+ * first_edge_time is when the raw pin first moved towards the press that
+ * started the gesture being classified (pushed with the edge), for timing
+ * the response from the finger rather than from the classification.
+ ******************************************************************************
+ */
+
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdint.h>
+
+#define GESTURE_QUEUE_SIZE  16          // Power of 2
+
+typedef enum {
+    GESTURE_NONE,
+    GESTURE_SINGLE,
+    GESTURE_DOUBLE,
+    GESTURE_TRIPLE,
+    GESTURE_LONG,
+    GESTURE_HOLD_REPEAT
+} GestureEvent;
+
+typedef struct {
+    uint16_t multi_window_ms;       // Max release -> next press for double/triple
+    uint16_t long_press_ms;         // Held this long -> GESTURE_LONG
+    uint16_t repeat_ms;             // GESTURE_HOLD_REPEAT period (0 = off)
+} GestureConfig;
+
+typedef enum {
+    GESTURE_STATE_IDLE,
+    GESTURE_STATE_PRESSED,
+    GESTURE_STATE_WAIT_NEXT,        // Released, maybe another press follows
+    GESTURE_STATE_HOLDING           // Long press reported, waiting for release
+} GestureState;
+
+typedef struct {
+    const GestureConfig *config;
+
+    // Debounced edges: written by the button driver, read by gesture_update()
+    uint32_t edge_time[GESTURE_QUEUE_SIZE];
+    uint32_t edge_since[GESTURE_QUEUE_SIZE];   // Raw pin first moved
+    uint8_t  edge_level[GESTURE_QUEUE_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+
+    // Classifier
+    GestureState state;
+    uint8_t  press_count;
+    uint32_t press_time;
+    uint32_t release_time;
+    uint32_t first_edge_time;       // Raw edge that started the gesture
+    uint32_t next_repeat;
+} GestureRecognizer;
+
+void gesture_init(GestureRecognizer *g, const GestureConfig *config);
+void gesture_push_edge(GestureRecognizer *g, uint8_t level, uint32_t time_ms, uint32_t since_ms);
+GestureEvent gesture_update(GestureRecognizer *g, uint32_t now_ms);
+
+#endif // GESTURE_H
@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @file           : gpio.hpp
+ * @brief          : Zero-cost C++ GPIO: Pin<Port, N> and PinGroup<Pins...>
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Header only, C++17. A pin's port address and mask are template
+ * parameters, so every access compiles down to the same single load/store
+ * the hand-written macros produce - no objects, no RAM, no vtables.
+ *
+ *   using LedNorth = gpio::Pin<gpio::PortE, LED_NORTH>;
+ *   LedNorth::set();                    // GPIOE_BSRR = (1 << 9)
+ *
+ * A PinGroup folds any number of pins on ONE port into one register
+ * write, at compile time:
+ *
+ *   gpio::board::Leds::clear();         // all_leds_off(): 8 RMWs of ODR
+ *                                       // -> 1 store of 0xFF000000 to BSRR
+ *   gpio::board::Leds::mode(gpio::Mode::Output);
+ *                                       // 16 MODER RMWs -> 1 RMW
+ *
+ * Pins from different ports in one group are a compile error.
+ *
+ * leds_gpio.cpp sets up the on-board LEDs with it; gpio_codegen.cpp
+ * compiles a group write next to the macro version to check the code.
+ ******************************************************************************
+ */
+
+#ifndef GPIO_HPP
+#define GPIO_HPP
+
+#include <stdint.h>
+#include "board.h"
+
+namespace gpio {
+
+// ============================================================================
+// Ports
+// ============================================================================
+template <uint32_t Base>
+struct Port {
+    static constexpr uint32_t base = Base;
+
+    static volatile uint32_t &reg(uint32_t offset) {
+        return *reinterpret_cast<volatile uint32_t *>(Base + offset);
+    }
+    static volatile uint32_t &MODER()   { return reg(0x00); }
+    static volatile uint32_t &OTYPER()  { return reg(0x04); }
+    static volatile uint32_t &OSPEEDR() { return reg(0x08); }
+    static volatile uint32_t &PUPDR()   { return reg(0x0C); }
+    static volatile uint32_t &IDR()     { return reg(0x10); }
+    static volatile uint32_t &ODR()     { return reg(0x14); }
+    static volatile uint32_t &BSRR()    { return reg(0x18); }
+};
+
+using PortA = Port<0x48000000>;
+using PortB = Port<0x48000400>;
+using PortC = Port<0x48000800>;
+using PortD = Port<0x48000C00>;
+using PortE = Port<0x48001000>;
+using PortF = Port<0x48001400>;
+
+enum class Mode : uint32_t   { Input = 0, Output = 1, Alternate = 2, Analog = 3 };
+enum class Speed : uint32_t  { Low = 0, Medium = 1, High = 3 };
+enum class Pull : uint32_t   { None = 0, Up = 1, Down = 2 };
+
+// ============================================================================
+// Single pin
+// ============================================================================
+template <typename P, unsigned N>
+struct Pin {
+    static_assert(N < 16, "GPIO pin number must be 0..15");
+
+    using port = P;
+    static constexpr unsigned number = N;
+    static constexpr uint32_t mask = 1u << N;           // ODR / IDR / BSRR set
+    static constexpr uint32_t field2 = 3u << (2 * N);   // MODER / OSPEEDR / PUPDR
+
+    static void set()             { P::BSRR() = mask; }
+    static void clear()           { P::BSRR() = mask << 16; }
+    static void write(bool on)    { P::BSRR() = on ? mask : (mask << 16); }
+    static bool read()            { return (P::IDR() & mask) != 0; }
+    static void toggle()          { P::ODR() ^= mask; }  // RMW - not ISR-safe
+
+    static void mode(Mode m) {
+        P::MODER() = (P::MODER() & ~field2) | (static_cast<uint32_t>(m) << (2 * N));
+    }
+};
+
+// ============================================================================
+// Group of pins on the same port
+// ============================================================================
+template <typename... Pins>
+struct PinGroup;
+
+template <typename First, typename... Rest>
+struct PinGroup<First, Rest...> {
+    using port = typename First::port;
+    static_assert((... && (Rest::port::base == First::port::base)),
+                  "All pins of a PinGroup must be on the same port");
+
+    static constexpr uint32_t mask = (First::mask | ... | Rest::mask);
+    static constexpr uint32_t field2 = (First::field2 | ... | Rest::field2);
+    static_assert(__builtin_popcount(mask) == 1 + sizeof...(Rest),
+                  "A pin is listed twice in the PinGroup");
+
+    // Value of a 2-bit field repeated for every pin of the group
+    static constexpr uint32_t spread2(uint32_t value) {
+        return ((value << (2 * First::number)) | ... | (value << (2 * Rest::number)));
+    }
+
+    static void set()   { port::BSRR() = mask; }
+    static void clear() { port::BSRR() = mask << 16; }
+
+    // bits are port-aligned (bit n = pin n): group pins follow bits, one write
+    static void write_port_bits(uint32_t bits) {
+        port::BSRR() = (bits & mask) | ((~bits & mask) << 16);
+    }
+
+    // bit i of 'value' -> i-th pin of the list, one write
+    static void write(uint32_t value) {
+        uint32_t bits = port_bits(value);
+        port::BSRR() = bits | ((~bits & mask) << 16);
+    }
+
+    // List-ordered value -> port-aligned bits (constant-folds when possible)
+    static constexpr uint32_t port_bits(uint32_t value) {
+        return spread(value, typename MakeSeq<1 + sizeof...(Rest)>::type{});
+    }
+
+    static uint32_t read_port_bits() { return port::IDR() & mask; }
+
+    static void mode(Mode m) {
+        port::MODER() = (port::MODER() & ~field2) | spread2(static_cast<uint32_t>(m));
+    }
+    static void speed(Speed s) {
+        port::OSPEEDR() = (port::OSPEEDR() & ~field2) | spread2(static_cast<uint32_t>(s));
+    }
+    static void pull(Pull p) {
+        port::PUPDR() = (port::PUPDR() & ~field2) | spread2(static_cast<uint32_t>(p));
+    }
+    static void push_pull()  { port::OTYPER() &= ~mask; }
+    static void open_drain() { port::OTYPER() |= mask; }
+
+private:
+    template <unsigned... I>
+    struct Seq {};
+
+    template <unsigned... I>
+    static constexpr uint32_t spread(uint32_t value, Seq<I...>) {
+        constexpr unsigned numbers[] = { First::number, Rest::number... };
+        return ((((value >> I) & 1u) << numbers[I]) | ...);
+    }
+
+    template <unsigned N, unsigned... I>
+    struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+    template <unsigned... I>
+    struct MakeSeq<0, I...> { using type = Seq<I...>; };
+};
+
+// ============================================================================
+// STM32F303 Discovery pins (board.h)
+// ============================================================================
+namespace board {
+
+using Button   = Pin<PortA, BUTTON_PIN>;
+
+using LedNorth = Pin<PortE, LED_NORTH>;
+using LedNE    = Pin<PortE, LED_NE>;
+using LedEast  = Pin<PortE, LED_EAST>;
+using LedSE    = Pin<PortE, LED_SE>;
+using LedSouth = Pin<PortE, LED_SOUTH>;
+using LedSW    = Pin<PortE, LED_SW>;
+using LedWest  = Pin<PortE, LED_WEST>;
+using LedNW    = Pin<PortE, LED_NW>;
+
+// Clockwise from North: Leds::write(1 << i) lights compass position i
+using Leds = PinGroup<LedNorth, LedNE, LedEast, LedSE,
+                      LedSouth, LedSW, LedWest, LedNW>;
+
+static_assert(Leds::mask == 0xFF00, "LEDs are PE8..PE15");
+static_assert(Leds::field2 == 0xFFFF0000, "MODER field of PE8..PE15");
+static_assert(Leds::spread2(1) == 0x55550000, "All eight LEDs as outputs");
+static_assert(Leds::port_bits(0x01) == (1u << LED_NORTH), "Compass position 0 = North");
+static_assert(Leds::port_bits(0x80) == (1u << LED_NW), "Compass position 7 = North-West");
+
+} // namespace board
+
+} // namespace gpio
+
+#endif // GPIO_HPP
@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file           : gpio_codegen.cpp
+ * @brief          : Codegen check - gpio.hpp against the hand-written macros
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Not linked into anything: compiled to assembly only, to check that a
+ * PinGroup write is the single store gpio.hpp promises. Each pair below
+ * does the same thing once with macros and once with gpio.hpp. Stores
+ * per function, on the host and (if installed) with arm-none-eabi-g++,
+ * checked against the expected counts - exit status 1 on a mismatch:
+ *
+ *   sh gpio_codegen_check.sh
+ *
+ * Expected: leds_off_macro 8 (the Day 3 read-modify-writes of ODR, with
+ * 8 loads), leds_off_group 1 (0xFF000000 to BSRR, no load),
+ * leds_write_macro 1, leds_write_group 1 (same instruction count).
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include "gpio.hpp"
+
+using gpio::board::Leds;
+
+// Day3_Button_Controlled_LEDs.c, as written there
+#define GPIOE_BASE          0x48001000
+#define GPIOE_ODR           (*((volatile uint32_t*)(GPIOE_BASE + 0x14)))
+#define GPIOE_BSRR          (*((volatile uint32_t*)(GPIOE_BASE + 0x18)))
+
+extern "C" void leds_off_macro(void) {
+    GPIOE_ODR &= ~(1 << LED_NORTH);
+    GPIOE_ODR &= ~(1 << LED_NE);
+    GPIOE_ODR &= ~(1 << LED_EAST);
+    GPIOE_ODR &= ~(1 << LED_SE);
+    GPIOE_ODR &= ~(1 << LED_SOUTH);
+    GPIOE_ODR &= ~(1 << LED_SW);
+    GPIOE_ODR &= ~(1 << LED_WEST);
+    GPIOE_ODR &= ~(1 << LED_NW);
+}
+
+extern "C" void leds_off_group(void) {
+    Leds::clear();
+}
+
+// main.c leds_write()
+extern "C" void leds_write_macro(uint8_t frame) {
+    GPIOE_BSRR = LED_FRAME_BSRR(frame);
+}
+
+extern "C" void leds_write_group(uint8_t frame) {
+    Leds::write_port_bits((uint32_t)frame << LED_FIRST_PIN);
+}
@@ -0,0 +1,71 @@
+#!/bin/sh
+# ******************************************************************************
+# @file           : gpio_codegen_check.sh
+# @brief          : Host tool - checks gpio_codegen.cpp's stores per function
+# @author         : Aabel Jeevan Jose
+# @date           : October 25, 2026
+# ******************************************************************************
+# Compiles gpio_codegen.cpp to assembly with the host g++ and, when it is on
+# the PATH, with arm-none-eabi-g++ for the Cortex-M4, counts the stores to
+# GPIOE in each function and compares them with the expected counts below.
+#
+#   sh gpio_codegen_check.sh            (CXX / ARM_CXX override the compilers)
+#
+# Exit status 1 on any mismatch or compile error, 0 when everything matches
+# (a missing arm-none-eabi-g++ is reported as skipped, not as a failure).
+# ******************************************************************************
+
+cd "$(dirname "$0")" || exit 1
+
+CXX=${CXX:-g++}
+ARM_CXX=${ARM_CXX:-arm-none-eabi-g++}
+
+# Function, stores: macros vs gpio.hpp (see gpio_codegen.cpp)
+EXPECTED="leds_off_macro 8
+leds_off_group 1
+leds_write_macro 1
+leds_write_group 1"
+
+failed=0
+
+# $1 = target name, $2 = store pattern (awk), rest = compiler and flags
+check() {
+    name=$1
+    store=$2
+    shift 2
+
+    if ! asm=$("$@" -std=c++17 -O2 -S -o - gpio_codegen.cpp); then
+        echo "$name: compile failed"
+        failed=1
+        return
+    fi
+    counts=$(printf '%s\n' "$asm" | awk -v store="$store" '
+        /^[a-z_]+:/ { f = substr($1, 1, length($1) - 1) }
+        $0 ~ store  { n[f]++ }
+        END         { for (f in n) print f, n[f] }')
+
+    echo "$name:"
+    while read -r func want; do
+        got=$(printf '%s\n' "$counts" | awk -v f="$func" '$1 == f { print $2 }')
+        got=${got:-0}
+        if [ "$got" = "$want" ]; then
+            printf '  %-20s %2s stores  ok\n' "$func" "$got"
+        else
+            printf '  %-20s %2s stores  MISMATCH (expected %s)\n' "$func" "$got" "$want"
+            failed=1
+        fi
+    done <<EOF
+$EXPECTED
+EOF
+}
+
+# Host: x86-64 stores to the GPIOE ODR / BSRR addresses (0x48001014 / 18)
+check "host ($CXX)" '^\tmovl\t.*, 12079636' "$CXX"
+
+if command -v "$ARM_CXX" >/dev/null 2>&1; then
+    check "target ($ARM_CXX)" '^\tstr' "$ARM_CXX" -mcpu=cortex-m4 -mthumb
+else
+    echo "target: $ARM_CXX not found, skipped"
+fi
+
+exit $failed
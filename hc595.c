@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file           : hc595.c
+ * @brief          : 74HC595 chain output over SPI2 + DMA, latched on the tick
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ */
+
+#include "hc595.h"
+#include "clock_config.h"
+#include "systick.h"
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+
+#define HC595_SPI           SPI2_BASE
+#define HC595_DMA_CH        DMA_SPI2_TX_CH
+#define HC595_SCK_PIN       13          // PB13
+#define HC595_MOSI_PIN      15          // PB15
+#define HC595_LATCH_PIN     12          // PB12 -> RCLK
+#define HC595_AF            5           // AF5 = SPI2
+
+static const PinConfig hc595_pins[] = {
+    PIN_ALT(GPIO_PORT_B, HC595_SCK_PIN, HC595_AF, PIN_SPEED_HIGH),
+    PIN_ALT(GPIO_PORT_B, HC595_MOSI_PIN, HC595_AF, PIN_SPEED_HIGH),
+    PIN_OUTPUT(GPIO_PORT_B, HC595_LATCH_PIN),
+};
+
+static struct {
+    uint8_t *buf[2];
+    uint16_t width;
+    uint16_t bytes;
+    volatile uint8_t back;          // Buffer the CPU draws into
+    volatile uint8_t pending;       // Back buffer committed, swap on next tick
+    volatile uint8_t shifting;      // DMA transfer started, not latched yet
+} chain;
+
+static Hc595Stats stats;
+
+// ============================================================================
+// Clock listener: fastest SCK that stays under HC595_SCK_MAX_HZ
+// ============================================================================
+static void hc595_on_clock_change(const ClockFreqs *freqs) {
+    uint32_t br = 0;
+    while (br < 7 && (freqs->pclk1_hz >> (br + 1)) > HC595_SCK_MAX_HZ) {
+        br++;
+    }
+
+    // Let a running frame finish at the old rate
+    if (chain.shifting) {
+        while (DMA1_CNDTR(HC595_DMA_CH) != 0) {
+        }
+        while (SPI_SR(HC595_SPI) & SPI_SR_BSY) {
+        }
+    }
+
+    SPI_CR1(HC595_SPI) &= ~SPI_CR1_SPE;
+    SPI_CR1(HC595_SPI) = (SPI_CR1(HC595_SPI) & ~SPI_CR1_BR_Msk) | (br << SPI_CR1_BR_Pos);
+    SPI_CR1(HC595_SPI) |= SPI_CR1_SPE;
+}
+
+// ============================================================================
+// Tick hook: latch the frame shifted during the last tick, start the next
+// ============================================================================
+static void hc595_tick(uint32_t now_ms) {
+    (void)now_ms;
+
+    if (chain.shifting) {
+        if (!(DMA1_ISR & DMA_ISR_TCIF(HC595_DMA_CH)) ||
+            (SPI_SR(HC595_SPI) & SPI_SR_BSY)) {
+            stats.late++;                       // Latch on the next tick instead
+            return;
+        }
+        DMA1_IFCR = DMA_IFCR_ALL(HC595_DMA_CH);
+        GPIOB_BSRR = (1 << HC595_LATCH_PIN);    // RCLK rising edge: show it
+        chain.shifting = 0;
+        stats.latched++;
+    }
+
+    if (chain.pending) {
+        uint8_t front = chain.back;
+
+        chain.back = front ^ 1;
+        chain.pending = 0;
+
+        GPIOB_BSRR = (1 << (HC595_LATCH_PIN + 16));
+        DMA1_CCR(HC595_DMA_CH) &= ~DMA_CCR_EN;
+        DMA1_CMAR(HC595_DMA_CH) = (uint32_t)(uintptr_t)chain.buf[front];
+        DMA1_CNDTR(HC595_DMA_CH) = chain.bytes;
+        DMA1_CCR(HC595_DMA_CH) |= DMA_CCR_EN;
+        chain.shifting = 1;
+        stats.shifted++;
+    }
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+void hc595_init(uint8_t *buf_a, uint8_t *buf_b, uint16_t width) {
+    chain.buf[0] = buf_a;
+    chain.buf[1] = buf_b;
+    chain.width = width;
+    chain.bytes = LED_FRAME_BYTES(width);
+    chain.shifting = 0;
+    stats.shifted = stats.latched = stats.late = 0;
+    for (uint16_t i = 0; i < chain.bytes; i++) {
+        buf_a[i] = 0;
+        buf_b[i] = 0;
+    }
+
+    RCC_AHBENR  |= RCC_AHBENR_DMA1EN;
+    RCC_APB1ENR |= RCC_APB1ENR_SPI2EN;
+    pin_config_apply(hc595_pins, PIN_TABLE_SIZE(hc595_pins));
+    GPIOB_BSRR = (1 << (HC595_LATCH_PIN + 16));
+
+    // SPI2: master, mode 0, MSB first, transmit only, 8-bit, TX via DMA
+    SPI_CR1(HC595_SPI) = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI |
+                         SPI_CR1_BIDIMODE | SPI_CR1_BIDIOE;
+    SPI_CR2(HC595_SPI) = SPI_CR2_DS_8BIT | SPI_CR2_FRXTH | SPI_CR2_TXDMAEN;
+
+    // DMA: memory -> SPI2_DR, byte by byte, one frame per transfer, no IRQ
+    DMA1_CCR(HC595_DMA_CH) = 0;
+    DMA1_CPAR(HC595_DMA_CH) = SPI_DR_ADDR(HC595_SPI);
+    DMA1_CCR(HC595_DMA_CH) = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PL_HIGH;
+
+    clock_add_listener(hc595_on_clock_change);  // Sets SCK, enables SPI
+
+    chain.back = 0;
+    chain.pending = 1;                          // Blank the panel first
+    systick_add_hook(hc595_tick);
+}
+
+// ============================================================================
+// Frame access
+// ============================================================================
+uint8_t hc595_ready(void) {
+    return !chain.pending;
+}
+
+void hc595_frame(LedFrame *frame) {
+    frame->bits = chain.buf[chain.back];
+    frame->width = chain.width;
+    frame->ring = 0;                            // Straight panel
+}
+
+void hc595_commit(void) {
+    chain.pending = 1;
+}
+
+const Hc595Stats *hc595_stats(void) {
+    return &stats;
+}
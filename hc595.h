@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @file           : hc595.h
+ * @brief          : 74HC595 chain output over SPI2 + DMA, latched on the tick
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Panels with 64-256 indicators on daisy-chained 74HC595s. The driver
+ * holds two frame buffers of 'width' bits:
+ *
+ *   if (hc595_ready()) {
+ *       hc595_frame(&frame);            // back buffer as an LedFrame
+ *       patterns[n].step(&frame);       // draw the whole frame
+ *       hc595_commit();                 // just a flag - no CPU time
+ *   }
+ *
+ * On the next 1 ms tick the buffers swap and DMA shifts the frame out
+ * while the panel keeps showing the old one. The tick after that pulses
+ * RCLK, so every panel update lands exactly on a tick boundary, 1-2 ms
+ * after the commit, and the CPU never touches a byte of the transfer.
+ *
+ * Wiring (SPI mode 0, MSB first):
+ *   PB13 SCK  -> SRCLK of every chip
+ *   PB15 MOSI -> SER of the first chip, QH' -> SER of the next one
+ *   PB12      -> RCLK of every chip (latch)
+ * Frame byte 0 is shifted first, so it ends up in the LAST chip of the
+ * chain: output i = chip (i / 8) counted from the far end, pin Q(A + i % 8).
+ * Number the panel from the far end of the chain.
+ *
+ * hc595_sim.c runs this driver against a simulated SPI/DMA and chain.
+ ******************************************************************************
+ */
+
+#ifndef HC595_H
+#define HC595_H
+
+#include <stdint.h>
+#include "led_frame.h"
+
+#define HC595_MAX_WIDTH     256
+#define HC595_SCK_MAX_HZ    10000000    // 74HC595 at 3.3 V, with margin
+
+typedef struct {
+    uint32_t shifted;               // Frames sent to the chain
+    uint32_t latched;               // Frames shown (RCLK pulses)
+    uint32_t late;                  // Ticks where a transfer was still running
+} Hc595Stats;
+
+// buf_a / buf_b: LED_FRAME_BYTES(width) bytes each, must stay valid
+void hc595_init(uint8_t *buf_a, uint8_t *buf_b, uint16_t width);
+uint8_t hc595_ready(void);
+void hc595_frame(LedFrame *frame);
+void hc595_commit(void);
+const Hc595Stats *hc595_stats(void);
+
+#endif // HC595_H
@@ -0,0 +1,314 @@
+/**
+ ******************************************************************************
+ * @file           : hc595_sim.c
+ * @brief          : Host tool - hc595.c against a simulated SPI/DMA and chain
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Runs the unchanged driver (HOST_SIM register space, host_sim.h) with
+ * models of SPI2, DMA1 channel 5, GPIOB and a chain of 74HC595s, and the
+ * unchanged patterns as the frame source:
+ *
+ *   g++ -std=c++17 -O2 -c brightness_lut.cpp
+ *   gcc -DHOST_SIM -O2 -o hc595_sim hc595_sim.c hc595.c pin_config.c \
+ *       patterns.c zone.c anim.c anim_demo.c compass.c host_sim.c brightness_lut.o
+ *   ./hc595_sim
+ *
+ * The SPI model shifts bit by bit at the SCK the driver programmed (BR
+ * field, MSB/LSB first from CR1) into the chain model, which only copies
+ * its shift registers to the outputs on an RCLK rising edge. Checked:
+ *   - bit order: after every latch, output i == frame bit i (hc595.h)
+ *   - latch timing: RCLK only rises inside the tick, never mid-transfer,
+ *     and 1-2 ms after the commit (later only if SCK is too slow)
+ *   - nothing dropped or repeated: every committed frame is shown once
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hc595.h"
+#include "patterns.h"
+#include "clock_config.h"
+#include "systick.h"
+#include "lsm303.h"
+#include "host_sim.h"
+#include "stm32f303_regs.h"
+
+#define LATCH_PIN           12
+#define TICK_US             1000
+#define MAX_BYTES           LED_FRAME_BYTES(HC595_MAX_WIDTH)
+#define QUEUE_LEN           8
+
+// ============================================================================
+// Board stubs: clock and tick come from the harness
+// ============================================================================
+static ClockFreqs sim_freqs;
+static SysTickHook tick_hook;
+
+uint8_t clock_add_listener(ClockListener listener) {
+    listener(&sim_freqs);
+    return 1;
+}
+
+uint8_t systick_add_hook(SysTickHook hook) {
+    tick_hook = hook;
+    return 1;
+}
+
+// No sensor: the compass pattern stays dark
+const Lsm303Sample *lsm303_latest(void) {
+    static const Lsm303Sample none;
+    return &none;
+}
+
+// ============================================================================
+// Models
+// ============================================================================
+static uint64_t now_us;
+
+static struct {
+    uint8_t active;
+    const uint8_t *src;
+    uint32_t bytes;                     // Transfer length
+    uint32_t done;                      // Bytes fully shifted
+    uint64_t start_us;
+    double bit_us;
+} spi;
+
+static uint16_t chain_bits;             // Chips * 8
+static uint8_t shift[MAX_BYTES * 8];    // [0] = QA of the chip next to the MCU
+static uint8_t outputs[MAX_BYTES * 8];
+static uint32_t latch_odr;
+static uint32_t errors;
+
+static struct {
+    uint8_t frame[QUEUE_LEN][MAX_BYTES];
+    uint64_t commit_us[QUEUE_LEN];
+    uint32_t head, tail;
+} expect;
+
+static uint32_t latches;
+static uint64_t latency_max_us;
+
+static void fail(const char *what) {
+    if (errors++ < 10) {
+        printf("  ERROR at %llu us: %s\n", (unsigned long long)now_us, what);
+    }
+}
+
+static uint32_t reg(uint32_t addr) {
+    return *host_sim_peek(addr);
+}
+
+static void chain_clock_in(uint8_t bit) {
+    memmove(&shift[1], &shift[0], chain_bits - 1);
+    shift[0] = bit;
+}
+
+static void chain_latch(uint16_t width) {
+    memcpy(outputs, shift, chain_bits);
+    latches++;
+
+    if (spi.active) {
+        fail("RCLK rose while the frame was still shifting");
+    }
+    if (expect.head == expect.tail) {
+        fail("latch without a committed frame");
+        return;
+    }
+
+    const uint8_t *frame = expect.frame[expect.tail % QUEUE_LEN];
+    uint64_t latency = now_us - expect.commit_us[expect.tail % QUEUE_LEN];
+    expect.tail++;
+
+    if (now_us % TICK_US) {
+        fail("latch off the tick boundary");
+    }
+    if (latency > latency_max_us) {
+        latency_max_us = latency;
+    }
+
+    uint16_t chips = chain_bits / 8;
+    for (uint16_t i = 0; i < chain_bits; i++) {
+        uint16_t pos = (chips - 1 - i / 8) * 8 + i % 8;    // hc595.h wiring
+        uint8_t want = (i < width) ? ((frame[i >> 3] >> (i & 7)) & 1) : 0;
+        if (outputs[pos] != want) {
+            fail("wrong output after latch (bit order)");
+            break;
+        }
+    }
+}
+
+// Move the SPI model forward to 'until'
+static void spi_run(uint64_t until) {
+    if (!spi.active) {
+        return;
+    }
+    uint32_t lsb_first = reg(SPI2_BASE + 0x00) & SPI_CR1_LSBFIRST;
+
+    while (spi.done < spi.bytes &&
+           spi.start_us + (uint64_t)((spi.done + 1) * 8 * spi.bit_us) <= until) {
+        uint8_t byte = spi.src[spi.done++];
+        for (int b = 0; b < 8; b++) {
+            chain_clock_in(lsb_first ? (byte >> b) & 1 : (byte >> (7 - b)) & 1);
+        }
+        *host_sim_peek(DMA1_BASE + 0x0C + 20 * (DMA_SPI2_TX_CH - 1)) = spi.bytes - spi.done;
+    }
+    if (spi.done == spi.bytes) {
+        spi.active = 0;
+        *host_sim_peek(DMA1_BASE + 0x00) |= DMA_ISR_TCIF(DMA_SPI2_TX_CH);
+        *host_sim_peek(SPI2_BASE + 0x08) &= ~SPI_SR_BSY;
+    }
+}
+
+static uint16_t sim_width;
+
+// Register hook: react to the driver's last access
+static void sim_hook(uint32_t addr) {
+    const uint32_t ch = DMA_SPI2_TX_CH;
+
+    if (addr == GPIOB_BASE + 0x18) {                    // BSRR
+        volatile uint32_t *bsrr = host_sim_peek(addr);
+        uint32_t v = *bsrr;
+        uint32_t odr = (latch_odr | (v & 0xFFFF)) & ~(v >> 16);
+        *bsrr = 0;
+        if ((odr & (1 << LATCH_PIN)) && !(latch_odr & (1 << LATCH_PIN))) {
+            chain_latch(sim_width);
+        }
+        latch_odr = odr;
+        *host_sim_peek(GPIOB_BASE + 0x14) = odr;
+    } else if (addr == DMA1_BASE + 0x04) {              // IFCR
+        volatile uint32_t *ifcr = host_sim_peek(addr);
+        *host_sim_peek(DMA1_BASE + 0x00) &= ~*ifcr;
+        *ifcr = 0;
+    } else if (addr == DMA1_BASE + 0x08 + 20 * (ch - 1)) {   // CCR
+        uint32_t ccr = reg(addr);
+        uint32_t cr1 = reg(SPI2_BASE + 0x00);
+        if ((ccr & DMA_CCR_EN) && !spi.active && reg(DMA1_BASE + 0x0C + 20 * (ch - 1))) {
+            if (!(cr1 & SPI_CR1_SPE) || !(cr1 & SPI_CR1_MSTR) ||
+                (cr1 & (SPI_CR1_CPOL | SPI_CR1_CPHA)) ||
+                !(reg(SPI2_BASE + 0x04) & SPI_CR2_TXDMAEN) ||
+                !(ccr & DMA_CCR_DIR) || !(ccr & DMA_CCR_MINC)) {
+                fail("SPI/DMA not set up for a mode 0 memory -> SPI transfer");
+            }
+            if (reg(DMA1_BASE + 0x10 + 20 * (ch - 1)) != SPI2_BASE + 0x0C) {
+                fail("DMA peripheral address is not SPI2_DR");
+            }
+            uint32_t br = (cr1 & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos;
+            spi.active = 1;
+            spi.src = host_sim_ptr(reg(DMA1_BASE + 0x14 + 20 * (ch - 1)));
+            spi.bytes = reg(DMA1_BASE + 0x0C + 20 * (ch - 1));
+            spi.done = 0;
+            spi.start_us = now_us;
+            spi.bit_us = 1e6 / (double)(sim_freqs.pclk1_hz >> (br + 1));
+            *host_sim_peek(SPI2_BASE + 0x08) |= SPI_SR_BSY;
+        }
+    }
+}
+
+// ============================================================================
+// One run: all patterns, one after the other, on a 'width'-output panel
+// ============================================================================
+static uint8_t buf_a[MAX_BYTES], buf_b[MAX_BYTES];
+
+static uint32_t run(const char *name, uint16_t width, uint32_t pclk1_hz,
+                    uint32_t steps_per_pattern, uint32_t step_ms) {
+    host_sim_reset();
+    host_sim_add_hook(sim_hook);
+    host_sim_map(buf_a, sizeof(buf_a));
+    host_sim_map(buf_b, sizeof(buf_b));
+
+    memset(&spi, 0, sizeof(spi));
+    memset(&expect, 0, sizeof(expect));
+    memset(shift, 0, sizeof(shift));
+    memset(outputs, 0, sizeof(outputs));
+    latch_odr = 0;
+    errors = 0;
+    latches = 0;
+    latency_max_us = 0;
+    now_us = 0;
+    sim_width = width;
+    chain_bits = LED_FRAME_BYTES(width) * 8;
+
+    sim_freqs.pclk1_hz = pclk1_hz;
+    sim_freqs.pclk2_hz = sim_freqs.hclk_hz = sim_freqs.sysclk_hz = pclk1_hz * 2;
+
+    hc595_init(buf_a, buf_b, width);
+    host_sim_flush();
+    expect.head = 1;                    // The blank frame from init
+
+    uint32_t frames = PATTERN_COUNT * steps_per_pattern;
+    uint32_t frame = 0;
+    uint32_t next_step_ms = 0;
+    uint32_t tick = 0;
+    Pt pts[PATTERN_COUNT];
+
+    for (uint8_t i = 0; i < PATTERN_COUNT; i++) {
+        pattern_start(&pts[i], 0);
+    }
+
+    while (frame < frames || expect.tail < expect.head) {
+        // Main loop runs somewhere inside the millisecond
+        uint64_t cpu_us = (uint64_t)tick * TICK_US + 137 + (tick * 311) % 700;
+        spi_run(cpu_us);
+        now_us = cpu_us;
+
+        if (frame < frames && tick >= next_step_ms && hc595_ready()) {
+            LedFrame f;
+            hc595_frame(&f);
+            Pt *pt = &pts[frame / steps_per_pattern];
+            pattern_run(&patterns[frame / steps_per_pattern], pt, &f, pt->wake_ms);  // Always due
+            hc595_commit();
+
+            if (expect.head - expect.tail >= QUEUE_LEN) {
+                fail("frames are not being shown");
+                break;
+            }
+            memcpy(expect.frame[expect.head % QUEUE_LEN], f.bits, LED_FRAME_BYTES(width));
+            expect.commit_us[expect.head % QUEUE_LEN] = now_us;
+            expect.head++;
+            frame++;
+            next_step_ms = tick + step_ms;
+        }
+
+        // Tick boundary
+        tick++;
+        spi_run((uint64_t)tick * TICK_US);
+        now_us = (uint64_t)tick * TICK_US;
+        tick_hook(tick);
+        host_sim_flush();
+
+        if (tick > frames * (step_ms + 4) + 100) {
+            fail("simulation did not finish");
+            break;
+        }
+    }
+
+    const Hc595Stats *st = hc595_stats();
+    uint32_t br = (reg(SPI2_BASE + 0x00) & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos;
+    if (st->latched != latches || st->shifted != expect.head) {
+        fail("driver statistics disagree with the chain");
+    }
+
+    printf("%-28s %4u outputs  SCK %5.2f MHz  frames %5u  late ticks %4u  "
+           "max commit->show %5.2f ms  %s\n",
+           name, width, (pclk1_hz >> (br + 1)) / 1e6, latches, st->late,
+           latency_max_us / 1000.0, errors ? "FAIL" : "ok");
+    return errors;
+}
+
+int main(void) {
+    uint32_t failures = 0;
+
+    printf("74HC595 chain over SPI2 + DMA, driver hc595.c, simulated\n\n");
+    failures += run("On-board width",       8, 36000000, 40, 1);
+    failures += run("64-output panel",     64, 36000000, 80, 1);
+    failures += run("100 outputs (13 chips)", 100, 36000000, 120, 2);
+    failures += run("256-output panel",   256, 36000000, 300, 1);
+    failures += run("256, 8 MHz HSI",     256,  8000000, 40, 3);
+    failures += run("256, SCK too slow",  256,   200000, 10, 5);
+
+    printf("\n%s\n", failures ? "FAILED" : "All frames shown bit-exact, latched on tick boundaries");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file           : host_sim.c
+ * @brief          : Host tool support - simulated register space (HOST_SIM)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "host_sim.h"
+
+#define REG_SLOTS           4096        // Power of two, far more than used
+#define MAP_MAX             16
+
+typedef struct {
+    uint32_t addr;
+    uint8_t used;
+    volatile uint32_t value;
+} RegSlot;
+
+typedef struct {
+    uintptr_t host;
+    uint32_t size;
+} MapEntry;
+
+static RegSlot regs[REG_SLOTS];
+static HostSimHook hooks[HOST_SIM_MAX_HOOKS];
+static uint8_t hook_count;
+static MapEntry maps[MAP_MAX];
+static uint8_t map_count;
+
+static uint32_t last_addr;
+static uint8_t last_valid;
+static uint8_t in_hook;                 // Hooks use host_sim_peek() only
+
+void host_sim_reset(void) {
+    for (uint32_t i = 0; i < REG_SLOTS; i++) {
+        regs[i].used = 0;
+        regs[i].value = 0;
+    }
+    hook_count = 0;
+    map_count = 0;
+    last_valid = 0;
+}
+
+uint8_t host_sim_add_hook(HostSimHook hook) {
+    if (hook_count >= HOST_SIM_MAX_HOOKS) {
+        return 0;
+    }
+    hooks[hook_count++] = hook;
+    return 1;
+}
+
+// ============================================================================
+// Register lookup (open addressing on the word address)
+// ============================================================================
+volatile uint32_t *host_sim_peek(uint32_t addr) {
+    uint32_t i = ((addr >> 2) * 2654435761u) & (REG_SLOTS - 1);
+
+    while (regs[i].used && regs[i].addr != addr) {
+        i = (i + 1) & (REG_SLOTS - 1);
+    }
+    if (!regs[i].used) {
+        regs[i].used = 1;
+        regs[i].addr = addr;
+        regs[i].value = 0;
+    }
+    return &regs[i].value;
+}
+
+void host_sim_flush(void) {
+    if (!last_valid || in_hook) {
+        return;
+    }
+    last_valid = 0;
+    in_hook = 1;
+    for (uint8_t i = 0; i < hook_count; i++) {
+        hooks[i](last_addr);
+    }
+    in_hook = 0;
+}
+
+volatile uint32_t *host_sim_reg(uint32_t addr) {
+    host_sim_flush();                   // The previous access is complete now
+    if (addr & 3) {
+        fprintf(stderr, "host_sim: unaligned register access 0x%08X\n", (unsigned)addr);
+        exit(1);
+    }
+    last_addr = addr;
+    last_valid = 1;
+    return host_sim_peek(addr);
+}
+
+// ============================================================================
+// Host memory seen through 32-bit DMA addresses
+// ============================================================================
+void host_sim_map(void *host, uint32_t size) {
+    if (map_count < MAP_MAX) {
+        maps[map_count].host = (uintptr_t)host;
+        maps[map_count].size = size;
+        map_count++;
+    }
+}
+
+void *host_sim_ptr(uint32_t addr) {
+    for (uint8_t i = 0; i < map_count; i++) {
+        uint32_t start = (uint32_t)maps[i].host;      // What the driver wrote
+        if (addr - start < maps[i].size) {
+            return (void *)(maps[i].host + (addr - start));
+        }
+    }
+    fprintf(stderr, "host_sim: DMA address 0x%08X is not mapped\n", (unsigned)addr);
+    exit(1);
+}
@@ -0,0 +1,45 @@
+/**
+ ******************************************************************************
+ * @file           : host_sim.h
+ * @brief          : Host tool support - simulated register space (HOST_SIM)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Built with -DHOST_SIM, stm32f303_regs.h turns every REG32(addr) into
+ * *host_sim_reg(addr), so the unchanged drivers run on a PC against
+ * simulated peripherals:
+ *
+ *   gcc -DHOST_SIM -o tool tool.c host_sim.c driver.c ...
+ *
+ * Registers are plain words (reset value 0). A peripheral model sees the
+ * driver's accesses through a hook: every REG32() access first completes
+ * the previous one and calls the hooks with its address, so a model can
+ * react to writes (BSRR, DR, DMA enable, write-1-to-clear flags) in
+ * program order. Call host_sim_flush() to complete the last access.
+ * Models read and write registers with host_sim_peek(), which does not
+ * trigger hooks.
+ *
+ * DMA address registers are only 32 bits wide; host_sim_map() registers
+ * host buffers so a model can turn a CMAR value back into a pointer.
+ ******************************************************************************
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdint.h>
+
+#define HOST_SIM_MAX_HOOKS  8
+
+// Called after an access to 'addr' has completed
+typedef void (*HostSimHook)(uint32_t addr);
+
+void host_sim_reset(void);
+uint8_t host_sim_add_hook(HostSimHook hook);
+void host_sim_flush(void);
+volatile uint32_t *host_sim_peek(uint32_t addr);
+
+void host_sim_map(void *host, uint32_t size);
+void *host_sim_ptr(uint32_t addr);
+
+#endif // HOST_SIM_H
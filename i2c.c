@@ -0,0 +1,217 @@
+/**
+ ******************************************************************************
+ * @file           : i2c.c
+ * @brief          : I2C1 master: register writes, register bursts by DMA
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ */
+
+#include "i2c.h"
+#include "board.h"
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+#ifdef HOST_SIM
+#include "host_sim.h"
+#endif
+
+#define I2C                 I2C1_BASE
+#define I2C_TX_CH           DMA_I2C1_TX_CH
+#define I2C_RX_CH           DMA_I2C1_RX_CH
+#define I2C_SCL_PIN         6           // PB6
+#define I2C_SDA_PIN         7           // PB7
+#define I2C_AF              4           // AF4 = I2C1
+
+// Set only while a burst runs (polled writes see plain flags)
+#define I2C_CR1_BURST       (I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN | I2C_CR1_TCIE | I2C_CR1_NACKIE)
+
+// Open drain, pull-ups are on the board
+static const PinConfig i2c_pins[] = {
+    { GPIO_PORT_B, I2C_SCL_PIN, PIN_MODE_AF, PIN_OPEN_DRAIN, PIN_SPEED_HIGH, PIN_PULL_NONE, I2C_AF },
+    { GPIO_PORT_B, I2C_SDA_PIN, PIN_MODE_AF, PIN_OPEN_DRAIN, PIN_SPEED_HIGH, PIN_PULL_NONE, I2C_AF },
+};
+
+static struct {
+    uint8_t addr;
+    uint8_t reg;                    // Sent by DMA: must stay put
+    uint8_t len;
+    I2cDone done;
+    volatile uint8_t busy;
+} burst;
+
+static I2cStats stats;
+
+static uint32_t cr2_for(uint8_t addr, uint8_t nbytes) {
+    return ((uint32_t)addr << I2C_CR2_SADD_Pos) | ((uint32_t)nbytes << I2C_CR2_NBYTES_Pos);
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+void i2c_init(void) {
+    RCC_AHBENR  |= RCC_AHBENR_DMA1EN;
+    RCC_APB1ENR |= RCC_APB1ENR_I2C1EN;
+    pin_config_apply(i2c_pins, PIN_TABLE_SIZE(i2c_pins));
+
+    I2C_CR1(I2C) = 0;
+    I2C_TIMINGR(I2C) = I2C_TIMING_400KHZ;
+    I2C_CR1(I2C) = I2C_CR1_PE | I2C_CR1_ERRIE;
+
+    // DMA: register address -> TXDR (one byte), RXDR -> buffer
+    DMA1_CCR(I2C_TX_CH) = 0;
+    DMA1_CPAR(I2C_TX_CH) = I2C_TXDR_ADDR(I2C);
+    DMA1_CMAR(I2C_TX_CH) = (uint32_t)(uintptr_t)&burst.reg;
+#ifdef HOST_SIM
+    host_sim_map(&burst.reg, 1);
+#endif
+    DMA1_CCR(I2C_TX_CH) = DMA_CCR_DIR | DMA_CCR_PL_HIGH;
+
+    DMA1_CCR(I2C_RX_CH) = 0;
+    DMA1_CPAR(I2C_RX_CH) = I2C_RXDR_ADDR(I2C);
+    DMA1_CCR(I2C_RX_CH) = DMA_CCR_MINC | DMA_CCR_PL_HIGH | DMA_CCR_TCIE | DMA_CCR_TEIE;
+
+    NVIC_SET_PRIORITY(DMA1_Channel7_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_SET_PRIORITY(I2C1_EV_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_SET_PRIORITY(I2C1_ER_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_ENABLE_IRQ(DMA1_Channel7_IRQn);
+    NVIC_ENABLE_IRQ(I2C1_EV_IRQn);
+    NVIC_ENABLE_IRQ(I2C1_ER_IRQn);
+}
+
+// ============================================================================
+// Polled register write (setup)
+// ============================================================================
+// 1 = flag set; 0 = NACK or no answer
+static uint8_t wait_flag(uint32_t flag) {
+    for (uint32_t i = 0; i < I2C_POLL_LIMIT; i++) {
+        uint32_t isr = I2C_ISR(I2C);
+        if (isr & I2C_ISR_NACKF) {
+            return 0;
+        }
+        if (isr & flag) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t i2c_write_reg(uint8_t addr, uint8_t reg, uint8_t value) {
+    if (burst.busy) {
+        return 0;
+    }
+
+    I2C_ICR(I2C) = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+    I2C_CR2(I2C) = cr2_for(addr, 2) | I2C_CR2_AUTOEND | I2C_CR2_START;
+
+    uint8_t ok = wait_flag(I2C_ISR_TXIS);
+    if (ok) {
+        I2C_TXDR(I2C) = reg;
+        ok = wait_flag(I2C_ISR_TXIS);
+    }
+    if (ok) {
+        I2C_TXDR(I2C) = value;
+    }
+
+    // STOP follows the last byte (AUTOEND) or a NACK by itself
+    for (uint32_t i = 0; i < I2C_POLL_LIMIT && !(I2C_ISR(I2C) & I2C_ISR_STOPF); i++) {
+    }
+    if (I2C_ISR(I2C) & I2C_ISR_NACKF) {
+        stats.nacks++;
+        ok = 0;
+    }
+    I2C_ICR(I2C) = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+    return ok;
+}
+
+// ============================================================================
+// Burst read: address out by DMA, TC -> repeated start, data in by DMA
+// ============================================================================
+uint8_t i2c_read_dma(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len, I2cDone done) {
+    if (burst.busy || len == 0) {
+        return 0;
+    }
+    burst.busy = 1;
+    burst.addr = addr;
+    burst.reg = reg;
+    burst.len = len;
+    burst.done = done;
+
+    DMA1_CCR(I2C_TX_CH) &= ~DMA_CCR_EN;
+    DMA1_CCR(I2C_RX_CH) &= ~DMA_CCR_EN;
+    DMA1_IFCR = DMA_IFCR_ALL(I2C_TX_CH) | DMA_IFCR_ALL(I2C_RX_CH);
+    DMA1_CNDTR(I2C_TX_CH) = 1;
+    DMA1_CMAR(I2C_RX_CH) = (uint32_t)(uintptr_t)buf;
+    DMA1_CNDTR(I2C_RX_CH) = len;
+    DMA1_CCR(I2C_TX_CH) |= DMA_CCR_EN;
+    DMA1_CCR(I2C_RX_CH) |= DMA_CCR_EN;          // Idle until RXNE requests
+
+    I2C_ICR(I2C) = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+    I2C_CR1(I2C) |= I2C_CR1_BURST;
+    I2C_CR2(I2C) = cr2_for(addr, 1) | I2C_CR2_START;   // No STOP: TC after the address
+    return 1;
+}
+
+static void burst_end(uint8_t ok) {
+    DMA1_CCR(I2C_TX_CH) &= ~DMA_CCR_EN;
+    DMA1_CCR(I2C_RX_CH) &= ~DMA_CCR_EN;
+    DMA1_IFCR = DMA_IFCR_ALL(I2C_TX_CH) | DMA_IFCR_ALL(I2C_RX_CH);
+    I2C_CR1(I2C) &= ~I2C_CR1_BURST;
+    burst.busy = 0;
+    if (ok) {
+        stats.bursts++;
+    }
+    if (burst.done) {
+        burst.done(ok);                         // May start the next burst
+    }
+}
+
+// Register address sent: turn round and read (the STOP comes by itself)
+void I2C1_EV_IRQHandler(void) {
+    uint32_t isr = I2C_ISR(I2C);
+
+    if (isr & I2C_ISR_NACKF) {
+        I2C_ICR(I2C) = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+        stats.nacks++;
+        if (burst.busy) {
+            burst_end(0);
+        }
+        return;
+    }
+    if ((isr & I2C_ISR_TC) && burst.busy) {
+        I2C_CR2(I2C) = cr2_for(burst.addr, burst.len) | I2C_CR2_RD_WRN |
+                       I2C_CR2_AUTOEND | I2C_CR2_START;
+    }
+}
+
+// Bus error / arbitration lost: reset the peripheral, drop the burst
+void I2C1_ER_IRQHandler(void) {
+    I2C_ICR(I2C) = I2C_ICR_BERRCF | I2C_ICR_ARLOCF;
+    stats.bus_errors++;
+    I2C_CR1(I2C) &= ~I2C_CR1_PE;
+    I2C_CR1(I2C) |= I2C_CR1_PE;
+    if (burst.busy) {
+        burst_end(0);
+    }
+}
+
+// Last byte landed in the buffer
+void DMA1_Channel7_IRQHandler(void) {
+    uint32_t isr = DMA1_ISR;
+
+    if (burst.busy && (isr & (DMA_ISR_TCIF(I2C_RX_CH) | DMA_ISR_TEIF(I2C_RX_CH)))) {
+        burst_end(!(isr & DMA_ISR_TEIF(I2C_RX_CH)));
+    } else {
+        DMA1_IFCR = DMA_IFCR_ALL(I2C_RX_CH);
+    }
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+uint8_t i2c_busy(void) {
+    return burst.busy;
+}
+
+const I2cStats *i2c_stats(void) {
+    return &stats;
+}
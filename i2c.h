@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @file           : i2c.h
+ * @brief          : I2C1 master: register writes, register bursts by DMA
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ * 400 kHz on PB6 (SCL) / PB7 (SDA), the bus of the on-board LSM303.
+ *
+ * Setup writes are short and only happen at init, so they poll:
+ *   i2c_write_reg(0x19, 0x20, 0x57);
+ *
+ * Sample reads do not: i2c_read_dma() sends the register address, then a
+ * repeated start reads 'len' bytes straight into the buffer by DMA
+ * (DMA1 channel 7), and 'done' is called from the DMA interrupt at the
+ * end. The CPU only runs twice per burst - once when the address has
+ * gone out (TC: the I2C peripheral cannot chain the repeated start by
+ * itself) and once at completion - never per byte:
+ *
+ *   i2c_read_dma(0x19, 0x28 | 0x80, buf, 6, accel_done);
+ *
+ * One burst at a time: i2c_read_dma() returns 0 while one is running,
+ * callers queue their own (lsm303.c starts the next from 'done').
+ *
+ * The I2C kernel clock is HSI (8 MHz) whatever clock_set_profile() does
+ * to SYSCLK, so the bus timing never needs re-computing.
+ ******************************************************************************
+ */
+
+#ifndef I2C_H
+#define I2C_H
+
+#include <stdint.h>
+
+#define I2C_TIMING_400KHZ   0x00310309  // RM0316 example for an 8 MHz I2CCLK
+#define I2C_POLL_LIMIT      10000       // Status polls before a setup write gives up
+
+// ok = 0: NACK or bus error, the buffer is incomplete
+typedef void (*I2cDone)(uint8_t ok);
+
+typedef struct {
+    uint32_t bursts;                // Completed DMA reads
+    uint32_t nacks;                 // Device did not answer
+    uint32_t bus_errors;            // Bus error / arbitration lost
+} I2cStats;
+
+void i2c_init(void);
+
+// Polled write of one register; 1 = acknowledged
+uint8_t i2c_write_reg(uint8_t addr, uint8_t reg, uint8_t value);
+
+// Starts a burst read; 0 = a burst is still running
+uint8_t i2c_read_dma(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len, I2cDone done);
+
+uint8_t i2c_busy(void);
+const I2cStats *i2c_stats(void);
+
+#endif // I2C_H
@@ -0,0 +1,372 @@
+/**
+ ******************************************************************************
+ * @file           : kernel.c
+ * @brief          : Small preemptive kernel - PendSV switch, bitmap scheduler
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 30, 2026
+ ******************************************************************************
+ */
+
+#include "kernel.h"
+#include "board.h"
+#include "systick.h"
+#include "stm32f303_regs.h"
+#include "uart.h"
+#include "fmt.h"
+
+#define XPSR_THUMB              0x01000000
+#define EXC_RETURN_THREAD_PSP   0xFFFFFFFD      // Thread mode, PSP, no FP frame
+#define CONTROL_FPCA            (1 << 2)        // FP context active
+
+static Task *tasks[KERNEL_PRIORITIES];
+static volatile uint32_t ready;                 // Bit (31 - prio) = ready
+static Task *volatile current;
+
+static Task idle_task;
+static uint32_t idle_stack[KERNEL_IDLE_STACK_WORDS] __attribute__((aligned(8)));
+
+KernelBench kernel_bench;
+
+uint32_t *kernel_switch(uint32_t *sp);
+
+static inline uint32_t prio_bit(uint8_t prio) {
+    return 0x80000000u >> prio;
+}
+
+static inline uint32_t irq_save(void) {
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void irq_restore(uint32_t primask) {
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+static inline void switch_pend(void) {
+    SCB_ICSR = SCB_ICSR_PENDSVSET;
+}
+
+// Interrupts masked or in an ISR
+static void make_ready(Task *t) {
+    ready |= prio_bit(t->prio);
+    if (current && t->prio < current->prio) {
+        switch_pend();
+    }
+}
+
+// Interrupts masked: take the caller off the ready set; it is switched
+// out as soon as interrupts are enabled again
+static void block_current(void) {
+    ready &= ~prio_bit(current->prio);
+    switch_pend();
+}
+
+// ============================================================================
+// Context switch
+// ============================================================================
+__attribute__((naked)) void PendSV_Handler(void) {
+    __asm volatile (
+        ".fpu   fpv4-sp-d16             \n"
+        "mrs    r0, psp                 \n"
+        "isb                            \n"
+        "tst    lr, #0x10               \n"     // EXC_RETURN bit 4 = 0: FP frame
+        "it     eq                      \n"
+        "vstmdbeq r0!, {s16-s31}        \n"     // Also forces the lazy s0-s15 save
+        "stmdb  r0!, {r4-r11, lr}       \n"
+        "bl     kernel_switch           \n"     // r0: old sp in, new sp out
+        "ldmia  r0!, {r4-r11, lr}       \n"
+        "tst    lr, #0x10               \n"
+        "it     eq                      \n"
+        "vldmiaeq r0!, {s16-s31}        \n"
+        "msr    psp, r0                 \n"
+        "isb                            \n"
+        "bx     lr                      \n"
+    );
+}
+
+uint32_t *kernel_switch(uint32_t *sp) {
+    current->sp = sp;
+
+    uint32_t primask = irq_save();
+    Task *next = tasks[__builtin_clz(ready)];   // Idle is always ready
+    irq_restore(primask);
+
+    next->switches++;
+    current = next;
+    return next->sp;
+}
+
+// First task: straight onto its stack in thread mode, no exception return
+// (The arguments arrive in r0-r3; the compiler cannot see the asm use them)
+__attribute__((naked)) static void kernel_launch(uint32_t *sp __attribute__((unused)),
+                                                 TaskFn entry __attribute__((unused)),
+                                                 void *arg __attribute__((unused)),
+                                                 void (*exit)(void) __attribute__((unused))) {
+    __asm volatile (
+        "msr    psp, r0                 \n"
+        "movs   r0, #2                  \n"     // CONTROL.SPSEL: thread mode on PSP
+        "msr    control, r0             \n"
+        "isb                            \n"
+        "mov    r0, r2                  \n"
+        "mov    lr, r3                  \n"
+        "cpsie  i                       \n"
+        "bx     r1                      \n"
+    );
+}
+
+// ============================================================================
+// Tasks
+// ============================================================================
+static void task_exit(void) {
+    uint32_t primask = irq_save();
+    tasks[current->prio] = 0;
+    block_current();
+    irq_restore(primask);                       // Switched out for good
+    for (;;) {
+    }
+}
+
+static void task_wake(Timer *timer, uint32_t now_ms) {
+    (void)now_ms;
+    make_ready((Task *)timer->arg);
+}
+
+static uint32_t *stack_top(const Task *t) {
+    return (uint32_t *)((uint32_t)(t->stack + t->stack_words) & ~7u);
+}
+
+uint8_t task_create(Task *t, const char *name, uint8_t prio, TaskFn entry, void *arg,
+                    uint32_t *stack, uint32_t stack_words) {
+    if (prio >= KERNEL_PRIORITIES || tasks[prio]) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < stack_words; i++) {
+        stack[i] = KERNEL_STACK_FILL;
+    }
+    t->stack = stack;
+    t->stack_words = stack_words;
+    t->entry = entry;
+    t->arg = arg;
+    t->name = name;
+    t->prio = prio;
+    t->notified = 0;
+    t->switches = 0;
+    timer_init(&t->wake, task_wake, t);
+
+    // Frame as PendSV would have left it: hardware part, then r4-r11 + EXC_RETURN
+    uint32_t *sp = stack_top(t);
+    *--sp = XPSR_THUMB;
+    *--sp = (uint32_t)entry & ~1u;              // PC
+    *--sp = (uint32_t)task_exit;                // LR: entry returned
+    *--sp = 0;                                  // R12
+    *--sp = 0;                                  // R3
+    *--sp = 0;                                  // R2
+    *--sp = 0;                                  // R1
+    *--sp = (uint32_t)arg;                      // R0
+    *--sp = EXC_RETURN_THREAD_PSP;
+    for (uint8_t r = 0; r < 8; r++) {
+        *--sp = 0;                              // R11 .. R4
+    }
+    t->sp = sp;
+
+    uint32_t primask = irq_save();
+    tasks[prio] = t;
+    ready |= prio_bit(prio);
+    irq_restore(primask);
+    return 1;
+}
+
+uint32_t task_stack_free(const Task *t) {
+    uint32_t free = 0;
+    while (free < t->stack_words && t->stack[free] == KERNEL_STACK_FILL) {
+        free++;
+    }
+    return free;
+}
+
+void kernel_sleep(uint32_t ms) {
+    uint32_t primask = irq_save();
+
+    timer_start(&system_timers, &current->wake, ms, 0);
+    while (timer_armed(&current->wake)) {
+        block_current();
+        irq_restore(primask);                   // Switched out here until task_wake()
+        primask = irq_save();
+    }
+    irq_restore(primask);
+}
+
+void task_wait(void) {
+    uint32_t primask = irq_save();
+
+    while (!current->notified) {
+        block_current();
+        irq_restore(primask);                   // Switched out here until task_notify()
+        primask = irq_save();
+    }
+    current->notified = 0;
+    irq_restore(primask);
+}
+
+void task_notify(Task *t) {
+    uint32_t primask = irq_save();
+    t->notified = 1;
+    make_ready(t);
+    irq_restore(primask);                       // Switch here if t is more urgent
+}
+
+// ============================================================================
+// Idle: sleep until the next interrupt, or the next timer if tickless
+// ============================================================================
+static void idle_run(void *arg) {
+    (void)arg;
+    for (;;) {
+#if KERNEL_TICKLESS
+        uint32_t primask = irq_save();
+        systick_idle(timer_wheel_idle_ms(&system_timers, KERNEL_IDLE_MAX_MS));
+        irq_restore(primask);
+#else
+        __asm volatile ("wfi");
+#endif
+    }
+}
+
+// ============================================================================
+// Benchmark: task_notify() -> first instruction of the woken task
+// ============================================================================
+static Task bench_task;
+static uint32_t bench_stack[KERNEL_BENCH_STACK_WORDS] __attribute__((aligned(8)));
+static volatile uint32_t bench_start;
+static volatile uint32_t bench_cycles;
+static volatile uint8_t bench_fpu;
+
+// Any FPU instruction marks the context as having FP state (CONTROL.FPCA)
+static inline void fpu_touch(void) {
+    __asm volatile (".fpu fpv4-sp-d16\n vmov.f32 s16, s16" ::: "memory");
+}
+
+// Drop the FP state again, so later switches are integer-only
+static inline void fpu_release(void) {
+    uint32_t control;
+    __asm volatile ("mrs %0, control\n bic %0, %0, %1\n msr control, %0\n isb"
+                    : "=&r" (control) : "i" (CONTROL_FPCA) : "memory");
+}
+
+static void bench_run_task(void *arg) {
+    (void)arg;
+    for (;;) {
+        task_wait();
+        bench_cycles = DWT_CYCCNT - bench_start;
+        if (bench_fpu) {
+            fpu_touch();
+        } else {
+            fpu_release();
+        }
+    }
+}
+
+static void bench_measure(KernelSwitchStats *s, uint8_t fpu) {
+    s->min = 0xFFFFFFFF;
+    s->max = 0;
+    s->total = 0;
+    s->count = 0;
+    bench_fpu = fpu;
+
+    // Round 0 only gives both tasks the FP state (or not) being measured
+    for (uint32_t round = 0; round <= KERNEL_BENCH_ROUNDS; round++) {
+        if (fpu) {
+            fpu_touch();
+        }
+        bench_start = DWT_CYCCNT;
+        task_notify(&bench_task);               // Runs and waits again before we return
+        if (round == 0) {
+            continue;
+        }
+
+        uint32_t cycles = bench_cycles;
+        if (cycles < s->min) s->min = cycles;
+        if (cycles > s->max) s->max = cycles;
+        s->total += cycles;
+        s->count++;
+    }
+
+    if (fpu) {
+        fpu_release();
+        bench_fpu = 0;
+        task_notify(&bench_task);               // It drops its FP state too
+    }
+}
+
+static char *put_stats(char *p, const char *name, const KernelSwitchStats *s) {
+    p += fmt_str(p, name, 10);
+    p += fmt_dec(p, s->min);
+    *p++ = ' ';
+    p += fmt_dec(p, s->count ? s->total / s->count : 0);
+    *p++ = ' ';
+    p += fmt_dec(p, s->max);
+    p += fmt_str(p, " cycles (min avg max)\r\n", 0);
+    return p;
+}
+
+// "switch:   integer   98 101 163 cycles (min avg max)"
+// "task console   prio 2  switches 1234  stack free 391/512"
+void kernel_bench_uart(void) {
+    char line[96];
+    char *p;
+
+    bench_measure(&kernel_bench.integer, 0);
+    bench_measure(&kernel_bench.fpu, 1);
+
+    p = line;
+    p += fmt_str(p, "switch:   ", 0);
+    p = put_stats(p, "integer", &kernel_bench.integer);
+    uart_write(line, (uint32_t)(p - line));
+    p = line;
+    p += fmt_str(p, "switch:   ", 0);
+    p = put_stats(p, "fpu", &kernel_bench.fpu);
+    uart_write(line, (uint32_t)(p - line));
+
+    for (uint8_t prio = 0; prio < KERNEL_PRIORITIES; prio++) {
+        const Task *t = tasks[prio];
+        if (!t) {
+            continue;
+        }
+        p = line;
+        p += fmt_str(p, "task ", 0);
+        p += fmt_str(p, t->name, 10);
+        p += fmt_str(p, " prio ", 0);
+        p += fmt_dec(p, t->prio);
+        p += fmt_str(p, "  switches ", 0);
+        p += fmt_dec(p, t->switches);
+        p += fmt_str(p, "  stack free ", 0);
+        p += fmt_dec(p, task_stack_free(t));
+        *p++ = '/';
+        p += fmt_dec(p, t->stack_words);
+        p += fmt_str(p, "\r\n", 0);
+        uart_write(line, (uint32_t)(p - line));
+    }
+}
+
+// ============================================================================
+// Start
+// ============================================================================
+void kernel_init(void) {
+    task_create(&idle_task, "idle", KERNEL_PRIO_IDLE, idle_run, 0,
+                idle_stack, TASK_STACK_WORDS(idle_stack));
+    task_create(&bench_task, "bench", KERNEL_PRIO_BENCH, bench_run_task, 0,
+                bench_stack, TASK_STACK_WORDS(bench_stack));
+}
+
+void kernel_start(void) {
+    SCB_SHPR_PENDSV = 0xFF;                     // Lowest: never delays an ISR
+    FPU_FPCCR |= FPU_FPCCR_ASPEN | FPU_FPCCR_LSPEN;
+
+    irq_save();
+    current = tasks[__builtin_clz(ready)];
+    current->switches++;
+    kernel_launch(stack_top(current), current->entry, current->arg, task_exit);
+    for (;;) {
+    }
+}
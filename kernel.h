@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * @file           : kernel.h
+ * @brief          : Small preemptive kernel - PendSV switch, bitmap scheduler
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 30, 2026
+ ******************************************************************************
+ * Replaces the super-loop with tasks that preempt each other by fixed
+ * priority, so a slow UART dump no longer holds up the settings writer
+ * (or any later comms task):
+ *
+ *   static Task console;
+ *   static uint32_t console_stack[512];
+ *   task_create(&console, "console", 2, console_run, 0,
+ *               console_stack, TASK_STACK_WORDS(console_stack));
+ *   kernel_start();                        // Never returns
+ *
+ * Scheduling: one task per priority, 0 = most urgent. The ready set is
+ * one 32-bit word with bit (31 - prio) per task, so the next task is
+ * tasks[CLZ(ready)] - one instruction, whatever the number of tasks.
+ * Tasks block in kernel_sleep() (a timer on system_timers, timer.h) or
+ * task_wait() (until task_notify(), also from an ISR); the idle task at
+ * KERNEL_PRIO_IDLE always runs last.
+ *
+ * Context switch: requests only pend PendSV, which has the lowest
+ * exception priority, so the switch runs once no ISR is active and the
+ * LED engine / PWM interrupts are never delayed by it. PendSV saves
+ * r4-r11 and EXC_RETURN on the task's own static stack (the hardware
+ * already stacked r0-r3, r12, lr, pc, xPSR) and restores the next task's.
+ *
+ * FPU: s16-s31 are only saved for a task that has used the FPU since
+ * its last switch (EXC_RETURN bit 4 clear). s0-s15 are lazily stacked by
+ * the hardware (FPCCR.LSPEN): their slot is reserved on exception entry
+ * and only written if PendSV itself touches the FPU - which the
+ * s16-s31 save does. Integer-only tasks never pay for the FPU.
+ *
+ * Tickless idle (KERNEL_TICKLESS in board.h): while only the idle task
+ * is ready, SysTick is stretched to the next software timer
+ * (systick_idle()) instead of waking the CPU every millisecond.
+ *
+ * Benchmark: kernel_bench_uart() (console 'k') times task_notify() of a
+ * higher-priority task to the first instruction that task runs,
+ * KERNEL_BENCH_ROUNDS times, with integer-only and with FPU contexts on
+ * both sides, and prints min / average / max cycles.
+ *
+ * Stacks are filled with KERNEL_STACK_FILL so task_stack_free() can
+ * report each task's high-water mark.
+ ******************************************************************************
+ */
+
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <stdint.h>
+#include "timer.h"
+
+#define KERNEL_PRIORITIES       32          // Bits of the ready word
+#define KERNEL_PRIO_BENCH       0           // kernel_bench_uart()'s partner
+#define KERNEL_PRIO_IDLE        (KERNEL_PRIORITIES - 1)
+#define KERNEL_IDLE_STACK_WORDS 128
+#define KERNEL_BENCH_STACK_WORDS 128
+#define KERNEL_BENCH_ROUNDS     1000
+#define KERNEL_IDLE_MAX_MS      1000        // Longest tickless sleep (systick_idle() caps too)
+#define KERNEL_STACK_FILL       0xA5A5A5A5
+
+#define TASK_STACK_WORDS(stack) (sizeof(stack) / sizeof((stack)[0]))
+
+typedef void (*TaskFn)(void *arg);
+
+typedef struct {
+    uint32_t *sp;                   // Saved stack pointer - first member (PendSV)
+    uint32_t *stack;                // Lowest word, for task_stack_free()
+    uint32_t stack_words;
+    TaskFn entry;
+    void *arg;
+    const char *name;
+    uint8_t prio;
+    volatile uint8_t notified;      // task_notify() since the last task_wait()
+    Timer wake;                     // kernel_sleep()
+    uint32_t switches;              // Times switched in
+} Task;
+
+typedef struct {
+    uint32_t min, max, total, count;
+} KernelSwitchStats;
+
+typedef struct {
+    KernelSwitchStats integer;      // Neither task has FPU state
+    KernelSwitchStats fpu;          // Both tasks have FPU state
+} KernelBench;
+
+extern KernelBench kernel_bench;
+
+// Before the first task_create(): idle and benchmark tasks
+void kernel_init(void);
+
+// 0 = priority already taken. Stack: static, 8-byte aligned is best.
+uint8_t task_create(Task *t, const char *name, uint8_t prio, TaskFn entry, void *arg,
+                    uint32_t *stack, uint32_t stack_words);
+
+// Runs the most urgent ready task on its own stack; never returns
+void kernel_start(void) __attribute__((noreturn));
+
+// Blocks the calling task for 'ms' ticks
+void kernel_sleep(uint32_t ms);
+
+// Blocks the calling task until task_notify() (returns at once if it
+// was notified since the last wait)
+void task_wait(void);
+
+// Task or ISR
+void task_notify(Task *t);
+
+// Words of the task's stack never written so far
+uint32_t task_stack_free(const Task *t);
+
+// From a task below KERNEL_PRIO_BENCH: run the benchmark, print it and
+// the task table
+void kernel_bench_uart(void);
+
+#endif // KERNEL_H
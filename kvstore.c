@@ -0,0 +1,422 @@
+/**
+ ******************************************************************************
+ * @file           : kvstore.c
+ * @brief          : Wear-levelled settings log in the last Flash pages
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ */
+
+#include "kvstore.h"
+#include "flash.h"
+
+#define PAGE_ADDR(p)        (KV_FLASH_BASE + (uint32_t)(p) * FLASH_PAGE_SIZE)
+#define PAGE_MAGIC          0x3153564BUL        // "KVS1"
+#define HEADER_SIZE         8
+#define RECORD_SIZE(len)    (4 + (((len) + 1) & ~1))
+#define RECORD_MAX          RECORD_SIZE(KV_MAX_LEN)
+#define COMPACT_RESERVE     (2 * RECORD_MAX)    // Compact before the page is this full
+#define BLANK16             0xFFFF
+
+#define TIME_REACHED(now, t)  ((int32_t)((now) - (t)) >= 0)
+
+typedef char kv_keys_fit_dirty_mask[(KV_MAX_KEYS <= 16) ? 1 : -1];
+typedef char kv_live_data_fits_page[(HEADER_SIZE + KV_MAX_KEYS * RECORD_MAX + COMPACT_RESERVE
+                                     <= FLASH_PAGE_SIZE) ? 1 : -1];
+
+typedef enum {
+    PHASE_IDLE,
+    PHASE_ERASE,                    // Make the target page blank
+    PHASE_COPY,                     // One live value per call
+    PHASE_COMMIT,                   // Target header: the target is now the log
+    PHASE_RELEASE                   // Erase the old page
+} Phase;
+
+typedef struct {
+    uint8_t  active;                // Page holding the log
+    uint32_t seq;                   // Its header sequence number
+    uint16_t tail;                  // Append offset
+    uint8_t  must_compact;          // Page full, or not blank past 'tail'
+    uint16_t index[KV_MAX_KEYS];    // Newest record of each key, 0 = none
+
+    uint8_t  value[KV_MAX_KEYS][KV_MAX_LEN];
+    uint8_t  len[KV_MAX_KEYS];      // 0 = no value
+    uint16_t dirty;                 // Bit per key: changed since written
+    uint32_t changed_ms;            // Last kv_set() that changed something
+    uint32_t written_ms;            // End of the last write burst
+    uint8_t  burst;                 // Writing pending values now
+
+    Phase    phase;
+    uint8_t  target;
+    uint8_t  copy_key;
+    uint16_t copy_tail;
+    uint16_t new_index[KV_MAX_KEYS];
+} KvState;
+
+static KvState kv;
+
+static KvStats stats;
+
+// ============================================================================
+// CRC-16/CCITT (0x1021), a nibble at a time from a 16-entry table
+// ============================================================================
+static const uint16_t crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] & 0xF)]);
+    }
+    return crc;
+}
+
+static uint16_t record_crc(uint8_t key, const uint8_t *value, uint8_t len) {
+    uint8_t head[2] = { key, len };
+    return crc16(crc16(0xFFFF, head, 2), value, len);
+}
+
+// ============================================================================
+// Flash access
+// ============================================================================
+static const uint8_t *page_ptr(uint8_t page, uint16_t off) {
+    return flash_ptr(PAGE_ADDR(page) + off);
+}
+
+static uint16_t read16(uint8_t page, uint16_t off) {
+    const uint8_t *p = page_ptr(page, off);
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint8_t is_blank(uint8_t page, uint16_t off, uint16_t size) {
+    const uint8_t *p = page_ptr(page, off);
+    for (uint16_t i = 0; i < size; i++) {
+        if (p[i] != 0xFF) return 0;
+    }
+    return 1;
+}
+
+static uint8_t erase(uint8_t page) {
+    stats.erases++;
+    return flash_erase_page(PAGE_ADDR(page));
+}
+
+static uint8_t header_valid(uint8_t page, uint32_t *seq) {
+    uint32_t magic = read16(page, 0) | ((uint32_t)read16(page, 2) << 16);
+    *seq = read16(page, 4) | ((uint32_t)read16(page, 6) << 16);
+    return magic == PAGE_MAGIC;
+}
+
+// Sequence number first, magic last: the header is the commit
+static uint8_t write_header(uint8_t page, uint32_t seq) {
+    uint16_t seq_hw[2] = { (uint16_t)seq, (uint16_t)(seq >> 16) };
+    uint16_t magic_hi = (uint16_t)(PAGE_MAGIC >> 16);
+    uint16_t magic_lo = (uint16_t)PAGE_MAGIC;
+
+    return flash_program(PAGE_ADDR(page) + 4, seq_hw, 2) &&
+           flash_program(PAGE_ADDR(page) + 2, &magic_hi, 1) &&
+           flash_program(PAGE_ADDR(page) + 0, &magic_lo, 1);
+}
+
+// CRC and value first, key/length half-word last
+static uint8_t write_record(uint8_t page, uint16_t off, uint8_t key,
+                            const uint8_t *value, uint8_t len) {
+    uint16_t buf[RECORD_MAX / 2];
+    uint16_t count = RECORD_SIZE(len) / 2;
+
+    buf[0] = (uint16_t)(key | (len << 8));
+    buf[1] = record_crc(key, value, len);
+    for (uint8_t i = 0; i < len; i += 2) {
+        uint8_t hi = (i + 1 < len) ? value[i + 1] : 0xFF;
+        buf[2 + i / 2] = (uint16_t)(value[i] | (hi << 8));
+    }
+
+    return flash_program(PAGE_ADDR(page) + off + 2, &buf[1], count - 1u) &&
+           flash_program(PAGE_ADDR(page) + off, &buf[0], 1);
+}
+
+static uint8_t record_matches(uint8_t key) {
+    uint16_t off = kv.index[key];
+    if (!off || page_ptr(kv.active, off)[1] != kv.len[key]) {
+        return 0;
+    }
+    const uint8_t *stored = page_ptr(kv.active, off + 4);
+    for (uint8_t i = 0; i < kv.len[key]; i++) {
+        if (stored[i] != kv.value[key][i]) return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// Boot: pick the newest page, one linear scan of its records
+// ============================================================================
+static void scan(void) {
+    uint16_t off = HEADER_SIZE;
+
+    while (off + 2 <= FLASH_PAGE_SIZE) {
+        uint16_t head = read16(kv.active, off);
+        if (head == BLANK16) {
+            break;                                  // End of the log
+        }
+
+        uint8_t key = (uint8_t)head;
+        uint8_t len = (uint8_t)(head >> 8);
+        uint16_t size = RECORD_SIZE(len);
+        if (key >= KV_MAX_KEYS || len == 0 || len > KV_MAX_LEN || off + size > FLASH_PAGE_SIZE) {
+            stats.bad_records++;                    // Nothing after this can be trusted
+            kv.must_compact = 1;
+            break;
+        }
+
+        const uint8_t *value = page_ptr(kv.active, off + 4);
+        if (record_crc(key, value, len) == read16(kv.active, off + 2)) {
+            kv.index[key] = off;
+        } else {
+            stats.bad_records++;
+        }
+        off += size;
+    }
+    kv.tail = off;
+
+    for (uint8_t key = 0; key < KV_MAX_KEYS; key++) {
+        if (kv.index[key]) {
+            const uint8_t *rec = page_ptr(kv.active, kv.index[key]);
+            kv.len[key] = rec[1];
+            for (uint8_t i = 0; i < rec[1]; i++) {
+                kv.value[key][i] = rec[4 + i];
+            }
+        }
+    }
+}
+
+uint8_t kv_init(void) {
+    uint8_t found = 0;
+    uint32_t seq;
+
+    kv = (KvState){ 0 };
+    stats = (KvStats){ 0 };
+
+    for (uint8_t p = 0; p < KV_PAGES; p++) {
+        if (header_valid(p, &seq) && (!found || (int32_t)(seq - kv.seq) > 0)) {
+            kv.active = p;
+            kv.seq = seq;
+            found = 1;
+        }
+    }
+
+    // Anything else is left over from a cut-short compaction
+    for (uint8_t p = 0; p < KV_PAGES; p++) {
+        if ((!found || p != kv.active) && !is_blank(p, 0, FLASH_PAGE_SIZE)) {
+            erase(p);
+        }
+    }
+
+    if (!found) {
+        kv.active = 0;
+        kv.seq = 1;
+        write_header(kv.active, kv.seq);
+    }
+    scan();
+    return found;
+}
+
+// ============================================================================
+// Compaction, one step per call
+// ============================================================================
+static uint8_t needs_compaction(void) {
+    return kv.must_compact || (FLASH_PAGE_SIZE - kv.tail) < COMPACT_RESERVE;
+}
+
+static void compact_step(void) {
+    switch (kv.phase) {
+        case PHASE_ERASE:
+            if (is_blank(kv.target, 0, FLASH_PAGE_SIZE) || erase(kv.target)) {
+                kv.copy_key = 0;
+                kv.copy_tail = HEADER_SIZE;
+                for (uint8_t k = 0; k < KV_MAX_KEYS; k++) {
+                    kv.new_index[k] = 0;
+                }
+                kv.phase = PHASE_COPY;
+            }
+            break;
+
+        case PHASE_COPY:
+            while (kv.copy_key < KV_MAX_KEYS && kv.len[kv.copy_key] == 0) {
+                kv.copy_key++;
+            }
+            if (kv.copy_key == KV_MAX_KEYS) {
+                kv.phase = PHASE_COMMIT;
+                break;
+            }
+            // The RAM value: a pending change is written here too
+            if (write_record(kv.target, kv.copy_tail, kv.copy_key,
+                             kv.value[kv.copy_key], kv.len[kv.copy_key])) {
+                kv.new_index[kv.copy_key] = kv.copy_tail;
+                kv.copy_tail += RECORD_SIZE(kv.len[kv.copy_key]);
+                kv.dirty &= (uint16_t)~(1u << kv.copy_key);
+                kv.copy_key++;
+            } else {
+                kv.phase = PHASE_ERASE;             // Start over on a clean page
+            }
+            break;
+
+        case PHASE_COMMIT:
+            if (write_header(kv.target, kv.seq + 1)) {
+                uint8_t old = kv.active;
+                kv.active = kv.target;
+                kv.target = old;
+                kv.seq++;
+                kv.tail = kv.copy_tail;
+                kv.must_compact = 0;
+                for (uint8_t k = 0; k < KV_MAX_KEYS; k++) {
+                    kv.index[k] = kv.new_index[k];
+                }
+                kv.phase = PHASE_RELEASE;
+            } else {
+                kv.phase = PHASE_ERASE;
+            }
+            break;
+
+        case PHASE_RELEASE:
+            erase(kv.target);
+            kv.phase = PHASE_IDLE;
+            break;
+
+        default:
+            kv.phase = PHASE_IDLE;
+            break;
+    }
+}
+
+// ============================================================================
+// One pending value -> one appended record
+// ============================================================================
+static void commit_one(void) {
+    uint8_t key = 0;
+    while (!(kv.dirty & (1u << key))) {
+        key++;
+    }
+
+    if (record_matches(key)) {
+        kv.dirty &= (uint16_t)~(1u << key);          // Changed back: nothing to write
+        return;
+    }
+
+    uint16_t size = RECORD_SIZE(kv.len[key]);
+    if (kv.tail + size > FLASH_PAGE_SIZE || !is_blank(kv.active, kv.tail, size)) {
+        kv.must_compact = 1;                        // Compaction writes it
+        return;
+    }
+    if (write_record(kv.active, kv.tail, key, kv.value[key], kv.len[key])) {
+        kv.index[key] = kv.tail;
+        kv.dirty &= (uint16_t)~(1u << key);
+        stats.records++;
+    } else {
+        kv.must_compact = 1;
+    }
+    kv.tail += size;
+}
+
+static void kv_step(void) {
+    if (kv.phase != PHASE_IDLE) {
+        compact_step();
+    } else if (needs_compaction()) {
+        kv.target = (uint8_t)((kv.active + 1) % KV_PAGES);
+        kv.phase = PHASE_ERASE;
+        stats.compactions++;
+    } else if (kv.dirty) {
+        commit_one();
+    }
+}
+
+// ============================================================================
+// API
+// ============================================================================
+uint8_t kv_get(uint8_t key, void *value, uint8_t len) {
+    if (key >= KV_MAX_KEYS || kv.len[key] == 0) {
+        return 0;
+    }
+    uint8_t *dst = value;
+    for (uint8_t i = 0; i < len && i < kv.len[key]; i++) {
+        dst[i] = kv.value[key][i];
+    }
+    return kv.len[key];
+}
+
+uint8_t kv_set(uint8_t key, const void *value, uint8_t len, uint32_t now_ms) {
+    const uint8_t *src = value;
+    uint8_t same;
+
+    if (key >= KV_MAX_KEYS || len == 0 || len > KV_MAX_LEN) {
+        return 0;
+    }
+    stats.sets++;
+
+    same = (kv.len[key] == len);
+    for (uint8_t i = 0; same && i < len; i++) {
+        same = (kv.value[key][i] == src[i]);
+    }
+    if (same) {
+        stats.unchanged++;
+        return 1;
+    }
+
+    for (uint8_t i = 0; i < len; i++) {
+        kv.value[key][i] = src[i];
+    }
+    kv.len[key] = len;
+    kv.dirty |= (uint16_t)(1u << key);
+    kv.changed_ms = now_ms;
+    return 1;
+}
+
+// The next kv_step() erases a page
+static uint8_t erase_next(void) {
+    return kv.phase == PHASE_RELEASE ||
+           (kv.phase == PHASE_ERASE && !is_blank(kv.target, 0, FLASH_PAGE_SIZE));
+}
+
+void kv_poll(uint32_t now_ms) {
+    if (kv.phase == PHASE_IDLE && !needs_compaction()) {
+        if (!kv.dirty) {
+            return;
+        }
+        if (!kv.burst) {
+            if (!TIME_REACHED(now_ms, kv.changed_ms + KV_WRITE_DELAY_MS) ||
+                !TIME_REACHED(now_ms, kv.written_ms + KV_MIN_INTERVAL_MS)) {
+                return;                             // Still changing, or throttled
+            }
+            kv.burst = 1;
+        }
+    }
+
+    // An erase stalls everything for up to 40 ms (flash.h): only once the
+    // settings have been left alone, as right after a write burst
+    if (erase_next() && !TIME_REACHED(now_ms, kv.changed_ms + KV_WRITE_DELAY_MS)) {
+        return;
+    }
+
+    kv_step();
+
+    if (kv.burst && !kv.dirty) {
+        kv.burst = 0;
+        kv.written_ms = now_ms;
+    }
+}
+
+void kv_flush(void) {
+    // Bounded: a failing page is retried, not looped on forever
+    for (uint32_t i = 0; i < 4 * KV_MAX_KEYS + 16 && !kv_idle(); i++) {
+        kv_step();
+    }
+}
+
+uint8_t kv_idle(void) {
+    return kv.phase == PHASE_IDLE && !kv.dirty && !needs_compaction();
+}
+
+const KvStats *kv_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file           : kvstore.h
+ * @brief          : Wear-levelled settings log in the last Flash pages
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ * current_pattern used to reset to 0 at every power-up. Settings are now
+ * small key/value records appended to a log in the last KV_PAGES Flash
+ * pages (kept out of the program by the linker script):
+ *
+ *   page:   [ header: magic, seq ][ rec ][ rec ][ rec ] ... 0xFF 0xFF
+ *   record: [ key | len << 8 ][ CRC-16 ][ value, padded to 16 bits ]
+ *
+ * - Boot: kv_init() scans the newest page once, front to back, and keeps
+ *   the offset of each key's newest record in a RAM index; the values
+ *   are cached, so kv_get() never touches Flash.
+ * - Power-fail safe: a record's first half-word is programmed last, so a
+ *   record is either complete or invisible, and each carries a CRC. A
+ *   half-written tail is never programmed over - the page is compacted.
+ * - Compaction: when the page is nearly full, the live values are copied
+ *   to the next page of the ring one per kv_poll() call, its header is
+ *   written last (that is the commit), then the old page is erased. The
+ *   pages take turns, so each wears at the same rate.
+ * - Fewer writes: kv_set() only changes the RAM cache. kv_poll() writes
+ *   a value once it has been left alone for KV_WRITE_DELAY_MS (ten quick
+ *   presses -> one record) and starts at most one write burst per
+ *   KV_MIN_INTERVAL_MS. Values equal to what is stored are not written.
+ *
+ * kv_poll() does at most one Flash operation per call. The CPU stalls
+ * while Flash is busy (flash.h), up to 40 ms for an erase, so call it
+ * from a task (main.c: the settings task), not an ISR. Erases only
+ * happen after KV_WRITE_DELAY_MS without changes - right after a write
+ * burst, or once a kv_set() that came in mid-compaction has settled -
+ * so nobody is pressing buttons while the CPU stalls.
+ *
+ * kvstore_sim.c runs this file on the PC against a simulated Flash with
+ * erase counts and power cuts at every possible point.
+ ******************************************************************************
+ */
+
+#ifndef KVSTORE_H
+#define KVSTORE_H
+
+#include <stdint.h>
+
+#define KV_FLASH_BASE       0x0803F000  // Linker script: KVSTORE
+#define KV_PAGES            2           // Pages in rotation (>= 2)
+#define KV_MAX_KEYS         16          // Keys 0 .. KV_MAX_KEYS - 1 (max 16)
+#define KV_MAX_LEN          16          // Bytes per value
+#define KV_WRITE_DELAY_MS   2000        // Quiet time before a change is written
+#define KV_MIN_INTERVAL_MS  10000       // Min time between write bursts
+
+typedef struct {
+    uint32_t sets;                  // kv_set() calls
+    uint32_t unchanged;             // ... that did not change the value
+    uint32_t records;               // Records appended
+    uint32_t compactions;
+    uint32_t erases;
+    uint32_t bad_records;           // CRC errors / torn records seen by kv_init()
+} KvStats;
+
+// 1 = an existing store was found, 0 = formatted a new one
+uint8_t kv_init(void);
+
+// Copies up to 'len' bytes; returns the stored length, 0 = no value
+uint8_t kv_get(uint8_t key, void *value, uint8_t len);
+
+// 1 = accepted (RAM only); 0 = bad key or length (1 .. KV_MAX_LEN)
+uint8_t kv_set(uint8_t key, const void *value, uint8_t len, uint32_t now_ms);
+
+// Background work: at most one Flash operation per call
+void kv_poll(uint32_t now_ms);
+
+// Write everything now, ignoring the delays (e.g. before a reset)
+void kv_flush(void);
+
+uint8_t kv_idle(void);
+const KvStats *kv_stats(void);
+
+#endif // KVSTORE_H
@@ -0,0 +1,412 @@
+/**
+ ******************************************************************************
+ * @file           : kvstore_sim.c
+ * @brief          : Host tool - kvstore.c against a simulated Flash
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ * Runs the unchanged store with flash.h implemented over a RAM array that
+ * behaves like the STM32F3 Flash: erase sets a page to 0xFF, a half-word
+ * can only be programmed while it is 0xFFFF (else PGERR), and every page
+ * erase is counted.
+ *
+ *   gcc -O2 -o kvstore_sim kvstore_sim.c kvstore.c
+ *   ./kvstore_sim
+ *
+ * Checked:
+ *   - restore: values written before a reset come back after kv_init()
+ *   - coalescing: a burst of quick changes becomes one record
+ *   - wear: erases spread evenly over the pages, records per erase
+ *   - quiet erases: a user pressing in bursts, kv_poll() every ms for
+ *     hours; every erase must come KV_WRITE_DELAY_MS after the last
+ *     change (an erase stalls the CPU for up to 40 ms), none skipped
+ *   - power cuts: the power is cut before every single program/erase of
+ *     a workload that runs through several compactions (the cut
+ *     half-word gets a random mix of old and new bits, a cut erase
+ *     leaves half the page). After the reset every key must hold its
+ *     last flushed value or the one being written, and the store must
+ *     keep working - also when the power fails again during recovery.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include "kvstore.h"
+#include "flash.h"
+
+#define SIM_SIZE            (KV_PAGES * FLASH_PAGE_SIZE)
+
+// ============================================================================
+// Flash model
+// ============================================================================
+static uint8_t sim_flash[SIM_SIZE];
+static uint32_t erase_count[KV_PAGES];
+static uint32_t program_count;          // Half-words
+static int32_t cut_after = -1;          // Operations until the power fails, -1 = never
+static jmp_buf power_fail;
+static uint32_t rng = 12345;
+static uint32_t sim_now;                // test_quiet_erases(): ms of the running kv_poll()
+static uint32_t last_change = 0;
+static uint32_t loud_erases;            // Erases too soon after a change
+static uint8_t compacting;              // Started, old page not erased yet
+
+static uint32_t rand32(void) {
+    rng = rng * 1103515245 + 12345;
+    return rng >> 8;
+}
+
+static uint32_t sim_offset(uint32_t addr) {
+    uint32_t off = addr - KV_FLASH_BASE;
+    if (off >= SIM_SIZE) {
+        printf("  access outside the store: 0x%08X\n", (unsigned)addr);
+        longjmp(power_fail, 2);
+    }
+    return off;
+}
+
+// One operation closer to the power cut; 1 = this one is cut
+static uint8_t power_cut_now(void) {
+    if (cut_after < 0) return 0;
+    return cut_after-- == 0;
+}
+
+uint8_t flash_erase_page(uint32_t addr) {
+    uint32_t off = sim_offset(addr) & ~(uint32_t)(FLASH_PAGE_SIZE - 1);
+
+    erase_count[off / FLASH_PAGE_SIZE]++;
+    if (sim_now - last_change < KV_WRITE_DELAY_MS) {
+        loud_erases++;
+    }
+    compacting = 0;
+    if (power_cut_now()) {
+        memset(&sim_flash[off], 0xFF, FLASH_PAGE_SIZE / 2);
+        longjmp(power_fail, 1);
+    }
+    memset(&sim_flash[off], 0xFF, FLASH_PAGE_SIZE);
+    return 1;
+}
+
+uint8_t flash_program(uint32_t addr, const uint16_t *data, uint32_t count) {
+    uint32_t off = sim_offset(addr);
+
+    for (uint32_t i = 0; i < count; i++, off += 2) {
+        uint16_t old = (uint16_t)(sim_flash[off] | (sim_flash[off + 1] << 8));
+        if (old != 0xFFFF) {
+            return 0;                           // PGERR
+        }
+        uint16_t v = data[i];
+        uint8_t cut = power_cut_now();
+        if (cut) {
+            v |= (uint16_t)rand32();            // Some bits made it, some did not
+        }
+        sim_flash[off] = (uint8_t)v;
+        sim_flash[off + 1] = (uint8_t)(v >> 8);
+        program_count++;
+        if (cut) {
+            longjmp(power_fail, 1);
+        }
+    }
+    return 1;
+}
+
+const uint8_t *flash_ptr(uint32_t addr) {
+    return &sim_flash[sim_offset(addr)];
+}
+
+static void sim_reset(void) {
+    memset(sim_flash, 0xA5, sizeof(sim_flash));     // Never-erased chip
+    memset(erase_count, 0, sizeof(erase_count));
+    program_count = 0;
+    cut_after = -1;
+}
+
+static uint32_t total_erases(void) {
+    uint32_t n = 0;
+    for (int p = 0; p < KV_PAGES; p++) n += erase_count[p];
+    return n;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+static uint32_t test_restore(void) {
+    uint8_t pattern = 5, v = 0;
+    uint8_t name[] = "compass";
+    uint8_t got[KV_MAX_LEN] = { 0 };
+    uint32_t fail = 0;
+
+    sim_reset();
+    if (kv_init() != 0) fail++;                 // Blank chip: formatted
+    kv_set(0, &pattern, 1, 0);
+    kv_set(3, name, sizeof(name), 0);
+    kv_flush();
+
+    if (kv_init() != 1) fail++;                 // "Power cycle"
+    if (kv_get(0, &v, 1) != 1 || v != 5) fail++;
+    if (kv_get(3, got, sizeof(got)) != sizeof(name) || memcmp(got, name, sizeof(name))) fail++;
+    if (kv_get(1, got, sizeof(got)) != 0) fail++;
+
+    printf("  %-32s %s\n", "Restore after reset", fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static uint32_t test_coalescing(void) {
+    uint32_t fail = 0;
+    uint8_t v = 0;
+
+    sim_reset();
+    kv_init();
+    uint32_t programs = program_count;
+
+    // 20 presses 300 ms apart, then nothing for a minute; kv_poll every ms
+    for (uint32_t now = 0; now < 60000; now++) {
+        if (now < 20 * 300 && now % 300 == 0) {
+            uint8_t pattern = (uint8_t)((now / 300) % 8);
+            kv_set(0, &pattern, 1, now);
+        }
+        kv_poll(now);
+    }
+    uint32_t records = kv_stats()->records;
+
+    kv_init();
+    if (kv_get(0, &v, 1) != 1 || v != (19 % 8)) fail++;
+    if (records != 1) fail++;
+
+    printf("  %-32s %s  (20 changes -> %u record, %u half-words)\n", "Coalescing",
+           fail ? "FAIL" : "ok", (unsigned)records, (unsigned)(program_count - programs));
+    return fail;
+}
+
+static uint32_t test_wear(void) {
+    const uint32_t changes = 200000;
+    uint32_t fail = 0;
+
+    sim_reset();
+    kv_init();
+    memset(erase_count, 0, sizeof(erase_count));
+
+    for (uint32_t i = 0; i < changes; i++) {
+        uint8_t key = (uint8_t)(rand32() % 4);
+        uint8_t value[4] = { (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16), key };
+        kv_set(key, value, (uint8_t)(1 + key), i);
+        kv_flush();
+    }
+
+    uint32_t lo = erase_count[0], hi = erase_count[0];
+    for (int p = 1; p < KV_PAGES; p++) {
+        if (erase_count[p] < lo) lo = erase_count[p];
+        if (erase_count[p] > hi) hi = erase_count[p];
+    }
+    if (hi - lo > 1) fail++;
+
+    // STM32F303: 10,000 erase cycles per page guaranteed
+    double per_erase = (double)changes / (total_erases() ? total_erases() : 1);
+    printf("  %-32s %s  (%u changes: erases/page %u..%u, %.0f changes per erase,\n"
+           "  %32s      10k cycles -> %.1f M changes, %.0f years at 100 changes/day)\n",
+           "Wear levelling", fail ? "FAIL" : "ok", (unsigned)changes, (unsigned)lo, (unsigned)hi,
+           per_erase, "", per_erase * 10000 * KV_PAGES / 1e6,
+           per_erase * 10000 * KV_PAGES / 100 / 365);
+    return fail;
+}
+
+// Bursts of presses on 8 keys, 1-5 s long and 300 ms apart, with 1-8 s of
+// quiet between them; compactions start in quiet, half get a press mid-way
+static uint32_t test_quiet_erases(void) {
+    const uint32_t run_ms = 4 * 3600 * 1000;
+    uint8_t last[8][KV_MAX_LEN];
+    uint32_t fail = 0;
+    uint32_t next_press = 1, burst_end = 0, mid_compaction = 0, started = 0;
+
+    sim_reset();
+    kv_init();
+    memset(erase_count, 0, sizeof(erase_count));
+    memset(last, 0, sizeof(last));
+    loud_erases = 0;
+    last_change = 0;
+
+    for (sim_now = 1; sim_now < run_ms; sim_now++) {
+        if (sim_now == next_press) {
+            next_press = sim_now + 300;
+            if (next_press >= burst_end) {
+                next_press += 1000 + rand32() % 7000;       // Quiet, then the next burst
+                burst_end = next_press + 1000 + rand32() % 4000;
+            }
+            uint8_t key = (uint8_t)(rand32() % 8);
+            for (uint8_t i = 0; i < KV_MAX_LEN; i++) {
+                last[key][i] = (uint8_t)rand32();
+            }
+            last[key][0] |= 1;
+            mid_compaction += compacting;
+            kv_set(key, last[key], KV_MAX_LEN, sim_now);
+            last_change = sim_now;
+        }
+        kv_poll(sim_now);
+        if (kv_stats()->compactions != started) {
+            started = kv_stats()->compactions;
+            compacting = 1;
+            if (rand32() & 1) {
+                next_press = sim_now + 1 + rand32() % 4;    // Half of them get a press mid-way
+            }
+        }
+    }
+    uint32_t erases = total_erases();
+    uint32_t compactions = kv_stats()->compactions;
+
+    sim_now = last_change + KV_WRITE_DELAY_MS;      // kv_flush() ignores the delays
+    kv_flush();
+    kv_init();
+    for (uint8_t key = 0; key < 8; key++) {
+        uint8_t v[KV_MAX_LEN];
+        if (last[key][0] && (kv_get(key, v, KV_MAX_LEN) != KV_MAX_LEN || memcmp(v, last[key], KV_MAX_LEN))) {
+            fail++;
+        }
+    }
+    if (loud_erases || compactions < 10 || erases < compactions) fail++;
+
+    printf("  %-32s %s  (%u compactions, %u erases, %u too soon after a change,\n"
+           "  %32s      %u presses mid-compaction)\n",
+           "Erases only in quiet", fail ? "FAIL" : "ok", (unsigned)compactions, (unsigned)erases,
+           (unsigned)loud_erases, "", (unsigned)mid_compaction);
+    sim_now = 0;
+    last_change = 0;
+    return fail;
+}
+
+// ----------------------------------------------------------------------------
+// Power cuts: the workload, and what must hold after any cut
+// ----------------------------------------------------------------------------
+#define WORK_STEPS          600
+#define WORK_KEYS           5
+#define WORK_LEN            8
+
+static uint8_t flushed[WORK_KEYS][WORK_LEN];    // Last flushed value, [0] = 0: none
+static int16_t in_flight_key;
+static uint8_t in_flight[WORK_LEN];
+
+static void work_value(uint32_t step, uint8_t *key, uint8_t value[WORK_LEN]) {
+    *key = (uint8_t)((step * 7) % WORK_KEYS);
+    value[0] = 0x80 | (uint8_t)(step >> 8);     // Never 0: marks "set"
+    for (uint8_t i = 1; i < WORK_LEN; i++) {
+        value[i] = (uint8_t)(step * i);
+    }
+}
+
+// Runs from 'step' until done; may be cut by longjmp
+static void workload(void) {
+    kv_init();
+    for (uint32_t step = 0; step < WORK_STEPS; step++) {
+        uint8_t key, value[WORK_LEN];
+        work_value(step, &key, value);
+        in_flight_key = key;
+        memcpy(in_flight, value, WORK_LEN);
+        kv_set(key, value, WORK_LEN, step);
+        kv_flush();
+        memcpy(flushed[key], value, WORK_LEN);
+        in_flight_key = -1;
+    }
+}
+
+static uint32_t check_store(void) {
+    uint32_t bad = 0;
+
+    for (uint8_t key = 0; key < WORK_KEYS; key++) {
+        uint8_t v[WORK_LEN] = { 0 };
+        uint8_t len = kv_get(key, v, WORK_LEN);
+        uint8_t ok_flushed = flushed[key][0] ? (len == WORK_LEN && !memcmp(v, flushed[key], WORK_LEN))
+                                             : (len == 0);
+        uint8_t ok_flight = (key == in_flight_key) && len == WORK_LEN && !memcmp(v, in_flight, WORK_LEN);
+        if (!ok_flushed && !ok_flight) bad++;
+    }
+    for (uint8_t key = WORK_KEYS; key < KV_MAX_KEYS; key++) {
+        uint8_t v[KV_MAX_LEN];
+        if (kv_get(key, v, sizeof(v))) bad++;     // Never written
+    }
+
+    // Still works: one more value survives a reset
+    uint8_t probe[2] = { 0x5A, 0xA5 }, back[2] = { 0, 0 };
+    kv_set(KV_MAX_KEYS - 1, probe, 2, 0);
+    kv_flush();
+    kv_init();
+    if (kv_get(KV_MAX_KEYS - 1, back, 2) != 2 || memcmp(back, probe, 2)) bad++;
+    return bad;
+}
+
+// Outlive the longjmps
+static uint32_t cuts, failures, bad_records;
+
+static uint32_t test_power_cuts(void) {
+    uint32_t total_ops;
+
+    // Dry run: how many Flash operations does the workload take?
+    sim_reset();
+    memset(flushed, 0, sizeof(flushed));
+    in_flight_key = -1;
+    workload();
+    total_ops = program_count + total_erases();
+    uint32_t compactions = kv_stats()->compactions;
+
+    for (uint32_t cut = 0; cut < total_ops; cut++) {
+        for (int32_t second = -1; second < 3; second++) {
+            sim_reset();
+            memset(flushed, 0, sizeof(flushed));
+            in_flight_key = -1;
+
+            int r = setjmp(power_fail);
+            if (r == 0) {
+                cut_after = (int32_t)cut;
+                workload();
+                continue;                       // Cut point past the end
+            }
+            if (r == 2) {
+                failures++;
+                continue;
+            }
+
+            // Power back - and maybe failing again during recovery
+            if (second >= 0) {
+                int r2 = setjmp(power_fail);
+                if (r2 == 0) {
+                    cut_after = second;
+                    kv_init();
+                }
+            }
+            cut_after = -1;
+            if (setjmp(power_fail) != 0) {
+                failures++;
+                continue;
+            }
+            kv_init();
+            bad_records += kv_stats()->bad_records;
+            cuts++;
+            if (check_store()) {
+                if (failures < 5) {
+                    printf("  cut at operation %u (second cut %d): values lost or corrupt\n",
+                           (unsigned)cut, (int)second);
+                }
+                failures++;
+            }
+        }
+    }
+
+    printf("  %-32s %s  (%u ops, %u compactions, %u cuts, %u torn records rejected)\n",
+           "Power cut at every operation", failures ? "FAIL" : "ok", (unsigned)total_ops,
+           (unsigned)compactions, (unsigned)cuts, (unsigned)bad_records);
+    return failures;
+}
+
+int main(void) {
+    uint32_t failed = 0;
+
+    printf("Settings log (kvstore.c) on simulated Flash: %u pages of %u bytes\n\n",
+           KV_PAGES, FLASH_PAGE_SIZE);
+    failed += test_restore();
+    failed += test_coalescing();
+    failed += test_wear();
+    failed += test_quiet_erases();
+    failed += test_power_cuts();
+
+    printf("\n%s\n", failed ? "FAILED" : "All values restored, no corruption after any power cut");
+    return failed ? 1 : 0;
+}
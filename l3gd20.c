@@ -0,0 +1,325 @@
+/**
+ ******************************************************************************
+ * @file           : l3gd20.c
+ * @brief          : L3GD20 gyroscope: FIFO drained by SPI DMA, decimated
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 3, 2026
+ ******************************************************************************
+ */
+
+#include "l3gd20.h"
+#include "board.h"
+#include "clock_config.h"
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+#include "uart.h"
+#include "fmt.h"
+#ifdef HOST_SIM
+#include "host_sim.h"
+#endif
+
+#define GYRO_SPI            SPI1_BASE
+#define GYRO_RX_CH          DMA_SPI1_RX_CH
+#define GYRO_TX_CH          DMA_SPI1_TX_CH
+#define GYRO_SCK_PIN        5           // PA5
+#define GYRO_MISO_PIN       6           // PA6
+#define GYRO_MOSI_PIN       7           // PA7
+#define GYRO_AF             5           // AF5 = SPI1
+
+// Registers
+#define WHO_AM_I            0x0F
+#define CTRL_REG1           0x20
+#define CTRL_REG3           0x22
+#define CTRL_REG4           0x23
+#define CTRL_REG5           0x24
+#define OUT_X_L             0x28
+#define FIFO_CTRL_REG       0x2E
+
+#define SPI_READ            0x80        // Command byte: read ...
+#define SPI_MULTI           0x40        // ... several bytes, address incrementing
+
+#define ID_L3GD20           0xD4
+#define ID_L3GD20H          0xD7
+#define CTRL1_760HZ_XYZ     0xFF        // ODR 760 Hz, cut-off 100 Hz, on, X Y Z
+#define CTRL3_INT2_WTM      0x04        // FIFO watermark on INT2
+#define CTRL4_BDU_500DPS    0x90        // Block update, 500 dps
+#define CTRL5_FIFO_EN       0x40
+#define FIFO_STREAM         0x40        // FM = stream, WTM in bits 4:0
+
+#define SAMPLE_BYTES        6
+#define BURST_BYTES         (1 + SAMPLE_BYTES * L3GD20_WATERMARK)
+#define CIC_SHIFT           6           // Gain L3GD20_DECIMATION^2 = 64
+
+#if L3GD20_WATERMARK < 1 || L3GD20_WATERMARK > 31
+#error "L3GD20_WATERMARK: the FIFO holds 32 samples"
+#endif
+#if L3GD20_DECIMATION * L3GD20_DECIMATION != (1 << CIC_SHIFT)
+#error "CIC_SHIFT must match L3GD20_DECIMATION"
+#endif
+
+static const PinConfig gyro_pins[] = {
+    PIN_ALT(GPIO_PORT_A, GYRO_SCK_PIN, GYRO_AF, PIN_SPEED_HIGH),
+    PIN_ALT(GPIO_PORT_A, GYRO_MISO_PIN, GYRO_AF, PIN_SPEED_HIGH),
+    PIN_ALT(GPIO_PORT_A, GYRO_MOSI_PIN, GYRO_AF, PIN_SPEED_HIGH),
+    PIN_OUTPUT(GPIO_PORT_E, L3GD20_CS_PIN),
+    PIN_INPUT(GPIO_PORT_E, L3GD20_INT2_PIN, PIN_PULL_NONE),         // Push-pull output
+};
+
+static uint8_t tx_buf[BURST_BYTES];     // Read command, then dummy bytes
+static uint8_t rx_buf[BURST_BYTES];     // Status byte, then the samples
+static volatile uint8_t busy;
+static uint32_t start_cycles;           // EXTI time charged to the running burst
+
+// Decimator: running sums wrap on purpose, the combs undo it
+static struct {
+    uint32_t integ[2][3];
+    uint32_t comb[2][3];
+    uint8_t phase;
+} cic;
+
+static GyroSample queue[L3GD20_QUEUE_SIZE];
+static volatile uint8_t head;           // Written by the DMA interrupt
+static volatile uint8_t tail;           // Written by the reader
+static L3gd20Stats stats;
+
+// ============================================================================
+// Polled register access (setup only)
+// ============================================================================
+static void cs(uint8_t selected) {
+    GPIOE_BSRR = selected ? 1u << (L3GD20_CS_PIN + 16) : 1u << L3GD20_CS_PIN;
+}
+
+static uint8_t spi_byte(uint8_t out) {
+    while (!(SPI_SR(GYRO_SPI) & SPI_SR_TXE)) {
+    }
+    SPI_DR8(GYRO_SPI) = out;
+    while (!(SPI_SR(GYRO_SPI) & SPI_SR_RXNE)) {
+    }
+    return SPI_DR8(GYRO_SPI);
+}
+
+static void write_reg(uint8_t reg, uint8_t value) {
+    cs(1);
+    spi_byte(reg);
+    spi_byte(value);
+    cs(0);
+}
+
+static uint8_t read_reg(uint8_t reg) {
+    cs(1);
+    spi_byte(SPI_READ | reg);
+    uint8_t value = spi_byte(0);
+    cs(0);
+    return value;
+}
+
+// ============================================================================
+// Clock listener: fastest SCK that stays under L3GD20_SCK_MAX_HZ
+// ============================================================================
+static void gyro_on_clock_change(const ClockFreqs *freqs) {
+    uint32_t br = 0;
+    while (br < 7 && (freqs->pclk2_hz >> (br + 1)) > L3GD20_SCK_MAX_HZ) {
+        br++;
+    }
+
+    // Let a running burst finish at the old rate
+    while (busy && DMA1_CNDTR(GYRO_RX_CH) != 0) {
+    }
+    while (SPI_SR(GYRO_SPI) & SPI_SR_BSY) {
+    }
+
+    SPI_CR1(GYRO_SPI) &= ~SPI_CR1_SPE;
+    SPI_CR1(GYRO_SPI) = (SPI_CR1(GYRO_SPI) & ~SPI_CR1_BR_Msk) | (br << SPI_CR1_BR_Pos);
+    SPI_CR1(GYRO_SPI) |= SPI_CR1_SPE;
+}
+
+// ============================================================================
+// Burst: the whole watermark's worth of samples in one DMA transfer
+// ============================================================================
+static uint8_t int2_high(void) {
+    return (GPIOE_IDR & (1u << L3GD20_INT2_PIN)) != 0;
+}
+
+static void burst_start(void) {
+    busy = 1;
+    cs(1);
+    DMA1_IFCR = DMA_IFCR_ALL(GYRO_RX_CH) | DMA_IFCR_ALL(GYRO_TX_CH);
+    DMA1_CNDTR(GYRO_RX_CH) = BURST_BYTES;
+    DMA1_CNDTR(GYRO_TX_CH) = BURST_BYTES;
+    DMA1_CCR(GYRO_RX_CH) |= DMA_CCR_EN;         // Receive first, then transmit
+    DMA1_CCR(GYRO_TX_CH) |= DMA_CCR_EN;
+}
+
+static void queue_put(const int32_t rate[3]) {
+    uint8_t next = (head + 1) & (L3GD20_QUEUE_SIZE - 1);
+
+    if (next == tail) {
+        stats.dropped++;
+        return;
+    }
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        queue[head].rate[axis] = (int16_t)rate[axis];
+    }
+    queue[head].seq = stats.outputs;
+    head = next;
+}
+
+static void decimate(const uint8_t *p, uint8_t samples) {
+    for (uint8_t n = 0; n < samples; n++, p += SAMPLE_BYTES) {
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            int16_t x = (int16_t)(p[2 * axis] | (p[2 * axis + 1] << 8));
+            cic.integ[0][axis] += (uint32_t)(int32_t)x;
+            cic.integ[1][axis] += cic.integ[0][axis];
+        }
+        if (++cic.phase < L3GD20_DECIMATION) {
+            continue;
+        }
+        cic.phase = 0;
+
+        int32_t rate[3];
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            uint32_t c1 = cic.integ[1][axis] - cic.comb[0][axis];
+            uint32_t c2 = c1 - cic.comb[1][axis];
+            cic.comb[0][axis] = cic.integ[1][axis];
+            cic.comb[1][axis] = c1;
+            rate[axis] = (int32_t)c2 >> CIC_SHIFT;
+        }
+        queue_put(rate);
+        stats.outputs++;
+    }
+}
+
+// Watermark reached
+void EXTI1_IRQHandler(void) {
+    uint32_t t0 = DWT_CYCCNT;
+
+    EXTI_PR = 1u << L3GD20_INT2_PIN;
+    if (!busy && int2_high()) {                 // Busy: the completion looks again
+        burst_start();
+    }
+    start_cycles += DWT_CYCCNT - t0;
+}
+
+// Burst received: filter it, go again if the FIFO refilled meanwhile
+void DMA1_Channel2_IRQHandler(void) {
+    uint32_t t0 = DWT_CYCCNT;
+
+    cs(0);
+    DMA1_CCR(GYRO_TX_CH) &= ~DMA_CCR_EN;
+    DMA1_CCR(GYRO_RX_CH) &= ~DMA_CCR_EN;
+    DMA1_IFCR = DMA_IFCR_ALL(GYRO_RX_CH) | DMA_IFCR_ALL(GYRO_TX_CH);
+    busy = 0;
+
+    decimate(&rx_buf[1], L3GD20_WATERMARK);
+    stats.bursts++;
+    stats.samples += L3GD20_WATERMARK;
+
+    uint32_t cycles = start_cycles;
+    start_cycles = 0;
+    if (int2_high()) {
+        stats.refills++;
+        burst_start();
+    }
+    cycles += DWT_CYCCNT - t0;
+    stats.cycles += cycles;
+    if (cycles > stats.worst_burst_cycles) {
+        stats.worst_burst_cycles = cycles;
+    }
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+uint8_t l3gd20_init(void) {
+    RCC_AHBENR  |= RCC_AHBENR_DMA1EN;
+    RCC_APB2ENR |= RCC_APB2ENR_SPI1EN | RCC_APB2ENR_SYSCFGEN;
+    pin_config_apply(gyro_pins, PIN_TABLE_SIZE(gyro_pins));
+    cs(0);
+
+    // SPI1: master, mode 3, MSB first, 8-bit frames, RXNE per byte
+    SPI_CR1(GYRO_SPI) = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_CPOL | SPI_CR1_CPHA;
+    SPI_CR2(GYRO_SPI) = SPI_CR2_DS_8BIT | SPI_CR2_FRXTH;
+    clock_add_listener(gyro_on_clock_change);   // Sets SCK, enables SPI
+
+    uint8_t id = read_reg(WHO_AM_I);
+    if (id != ID_L3GD20 && id != ID_L3GD20H) {
+        return 0;
+    }
+    write_reg(CTRL_REG4, CTRL4_BDU_500DPS);
+    write_reg(CTRL_REG5, CTRL5_FIFO_EN);
+    write_reg(FIFO_CTRL_REG, FIFO_STREAM | L3GD20_WATERMARK);
+    write_reg(CTRL_REG3, CTRL3_INT2_WTM);
+    write_reg(CTRL_REG1, CTRL1_760HZ_XYZ);
+
+    // DMA: the command and dummies out, the answer in; no byte-level IRQ
+    tx_buf[0] = SPI_READ | SPI_MULTI | OUT_X_L;
+    DMA1_CCR(GYRO_TX_CH) = 0;
+    DMA1_CPAR(GYRO_TX_CH) = SPI_DR_ADDR(GYRO_SPI);
+    DMA1_CMAR(GYRO_TX_CH) = (uint32_t)(uintptr_t)tx_buf;
+    DMA1_CCR(GYRO_TX_CH) = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PL_HIGH;
+    DMA1_CCR(GYRO_RX_CH) = 0;
+    DMA1_CPAR(GYRO_RX_CH) = SPI_DR_ADDR(GYRO_SPI);
+    DMA1_CMAR(GYRO_RX_CH) = (uint32_t)(uintptr_t)rx_buf;
+    DMA1_CCR(GYRO_RX_CH) = DMA_CCR_MINC | DMA_CCR_PL_HIGH | DMA_CCR_TCIE;
+#ifdef HOST_SIM
+    host_sim_map(tx_buf, sizeof tx_buf);
+    host_sim_map(rx_buf, sizeof rx_buf);
+#endif
+    SPI_CR2(GYRO_SPI) |= SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+
+    // INT2 -> EXTI1, rising edge
+    SYSCFG_EXTICR1 = (SYSCFG_EXTICR1 & ~(0xFu << (L3GD20_INT2_PIN * 4))) |
+                     ((uint32_t)GPIO_PORT_E << (L3GD20_INT2_PIN * 4));
+    EXTI_RTSR |= 1u << L3GD20_INT2_PIN;
+    EXTI_IMR  |= 1u << L3GD20_INT2_PIN;
+
+    NVIC_SET_PRIORITY(EXTI1_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_SET_PRIORITY(DMA1_Channel2_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_ENABLE_IRQ(EXTI1_IRQn);
+    NVIC_ENABLE_IRQ(DMA1_Channel2_IRQn);
+
+    EXTI_SWIER = 1u << L3GD20_INT2_PIN;         // Already above the watermark?
+    return 1;
+}
+
+// ============================================================================
+// Application side
+// ============================================================================
+uint8_t l3gd20_read(GyroSample *out) {
+    uint8_t t = tail;
+
+    if (t == head) {
+        return 0;
+    }
+    *out = queue[t];
+    tail = (t + 1) & (L3GD20_QUEUE_SIZE - 1);
+    return 1;
+}
+
+const L3gd20Stats *l3gd20_stats(void) {
+    return &stats;
+}
+
+// "gyro: 2375 bursts, 38000 samples, 4750 out, 0 dropped, 1 refills, 31 cycles/sample, worst burst 612"
+void l3gd20_dump_uart(void) {
+    char line[160];
+    char *p = line;
+    L3gd20Stats s = stats;
+
+    p += fmt_str(p, "gyro: ", 0);
+    p += fmt_dec(p, s.bursts);
+    p += fmt_str(p, " bursts, ", 0);
+    p += fmt_dec(p, s.samples);
+    p += fmt_str(p, " samples, ", 0);
+    p += fmt_dec(p, s.outputs);
+    p += fmt_str(p, " out, ", 0);
+    p += fmt_dec(p, s.dropped);
+    p += fmt_str(p, " dropped, ", 0);
+    p += fmt_dec(p, s.refills);
+    p += fmt_str(p, " refills, ", 0);
+    p += fmt_dec(p, s.samples ? s.cycles / s.samples : 0);
+    p += fmt_str(p, " cycles/sample, worst burst ", 0);
+    p += fmt_dec(p, s.worst_burst_cycles);
+    p += fmt_str(p, "\r\n", 0);
+    uart_write(line, (uint32_t)(p - line));
+}
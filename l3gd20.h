@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file           : l3gd20.h
+ * @brief          : L3GD20 gyroscope: FIFO drained by SPI DMA, decimated
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 3, 2026
+ ******************************************************************************
+ * The on-board L3GD20 on SPI1 (CS and INT2 in board.h) runs at its full
+ * 760 Hz, 500 dps (17.5 mdps per LSB), with its 32-sample FIFO in stream
+ * mode. Nothing happens per sample:
+ *
+ *   - INT2 rises when the FIFO holds L3GD20_WATERMARK samples (EXTI1)
+ *   - one SPI burst reads all of them: DMA1 channel 3 sends the read
+ *     command and dummy bytes, channel 2 takes the answer, and the
+ *     L3GD20 rolls its output address back to OUT_X_L for each sample
+ *   - the DMA completion filters the burst and starts another one if
+ *     INT2 is still high (the FIFO filled up again meanwhile)
+ *
+ * Filter: a 2nd-order CIC decimator (integrators per input, combs per
+ * output - the same as a moving average over L3GD20_DECIMATION samples,
+ * applied twice), 760 Hz -> 95 Hz, gain 1, no multiplications. Its
+ * zeros sit on the output rate and its multiples, which is where
+ * anything faster would alias to.
+ *
+ * The decimated samples go into a queue for the application:
+ *
+ *   GyroSample g;
+ *   while (l3gd20_read(&g)) { use g.rate[] }
+ *
+ * Read it at least every L3GD20_QUEUE_SIZE output periods (168 ms), or
+ * samples are dropped (counted). The CPU time of both interrupts is
+ * taken with the DWT counter; console 'g' prints it per sample.
+ *
+ * l3gd20_sim.c runs this driver against a simulated SPI device.
+ ******************************************************************************
+ */
+
+#ifndef L3GD20_H
+#define L3GD20_H
+
+#include <stdint.h>
+
+#define L3GD20_ODR_HZ           760
+#define L3GD20_UDPS_PER_LSB     17500   // 500 dps full scale
+#define L3GD20_WATERMARK        16      // FIFO samples per burst (1-31)
+#define L3GD20_DECIMATION       8       // -> 95 Hz
+#define L3GD20_QUEUE_SIZE       16      // Decimated samples (power of 2)
+#define L3GD20_SCK_MAX_HZ       10000000
+
+typedef struct {
+    int16_t rate[3];                // X Y Z, LSB (sensor axes)
+    uint32_t seq;                   // Decimated samples before this one
+} GyroSample;
+
+typedef struct {
+    uint32_t bursts;                // FIFO reads
+    uint32_t samples;               // 760 Hz samples read
+    uint32_t outputs;               // Decimated samples made
+    uint32_t dropped;               // ... with the queue full
+    uint32_t refills;               // INT2 still high after a burst: fell behind
+    uint32_t cycles;                // CPU cycles in both interrupts, all bursts
+    uint32_t worst_burst_cycles;
+} L3gd20Stats;
+
+// SPI1, sensor setup, FIFO and interrupts; 1 = WHO_AM_I answered
+uint8_t l3gd20_init(void);
+
+// 1 = the oldest decimated sample taken from the queue
+uint8_t l3gd20_read(GyroSample *out);
+
+const L3gd20Stats *l3gd20_stats(void);
+void l3gd20_dump_uart(void);
+
+#endif // L3GD20_H
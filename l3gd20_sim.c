@@ -0,0 +1,518 @@
+/**
+ ******************************************************************************
+ * @file           : l3gd20_sim.c
+ * @brief          : Host tool - l3gd20.c against a simulated SPI gyroscope
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 3, 2026
+ ******************************************************************************
+ * Runs the unchanged driver (HOST_SIM register space, host_sim.h) with
+ * models of SPI1, DMA1 channels 2 / 3, EXTI, the CS and INT2 pins on
+ * GPIOE and the L3GD20 itself: register file, 32-sample FIFO in stream
+ * mode filling at 760 Hz, watermark on INT2, the FIFO-mode address
+ * roll-over from OUT_Z_H back to OUT_X_L. Bursts take bus time at the
+ * SCK the driver programmed; interrupts are taken between bus events.
+ *
+ *   gcc -DHOST_SIM -O2 -o l3gd20_sim l3gd20_sim.c l3gd20.c pin_config.c \
+ *       fmt.c host_sim.c -lm
+ *   ./l3gd20_sim [seconds]
+ *
+ * The sensor sees a 1 Hz swing on X, a slow ramp on Y and, on Z, a
+ * 150 Hz vibration the decimator has to keep out of its 95 Hz stream.
+ * Checked:
+ *   - setup: SPI mode 3, SCK <= 10 MHz, the sensor registers
+ *   - every FIFO sample read once, no FIFO overrun, no empty read, CS
+ *     held low for whole bursts only
+ *   - one EXTI and one DMA interrupt per burst, none per byte or sample
+ *   - the decimated stream is bit-exact against the filter written out
+ *     as a plain 15-tap FIR, with nothing dropped by a reader every ms
+ *   - the longest hold-off the FIFO allows: once, interrupts are held
+ *     from a watermark until the FIFO is full; the driver must catch up
+ *     (a second burst straight away) without losing a sample
+ * Also printed: the vibration left in the output, bus and register work
+ * per sample (the CPU cycles are measured on target: console 'g').
+ * Exit code 1 on any failure.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "l3gd20.h"
+#include "clock_config.h"
+#include "board.h"
+#include "host_sim.h"
+#include "stm32f303_regs.h"
+
+#define DEFAULT_SECONDS     10
+#define PCLK2_HZ            72000000
+#define SAMPLE_NS(k)        ((uint64_t)(k) * 1000000000u / L3GD20_ODR_HZ)
+#define FIFO_DEPTH          32
+#define STALL_AT_MS         2000        // First watermark after this: hold interrupts off
+#define VIBRATION_HZ        150
+#define VIBRATION_LSB       400
+#define STORM_LIMIT         64
+
+#define PR_MODEL            (1u << 31)  // EXTI_PR written by the model, not the driver
+
+#define SPI                 SPI1_BASE
+#define REG(addr)           (*host_sim_peek(addr))
+#define CCR_ADDR(ch)        (DMA1_BASE + 0x08 + 20 * ((ch) - 1))
+#define CNDTR_ADDR(ch)      (DMA1_BASE + 0x0C + 20 * ((ch) - 1))
+#define CPAR_ADDR(ch)       (DMA1_BASE + 0x10 + 20 * ((ch) - 1))
+#define CMAR_ADDR(ch)       (DMA1_BASE + 0x14 + 20 * ((ch) - 1))
+#define GPIOE_IDR_ADDR      (GPIOE_BASE + 0x10)
+#define GPIOE_ODR_ADDR      (GPIOE_BASE + 0x14)
+
+static uint64_t now_ns;
+static uint32_t errors;
+
+static void fail(const char *what) {
+    if (errors++ < 10) {
+        printf("  FAIL at %.3f ms: %s\n", now_ns / 1e6, what);
+    }
+}
+
+// ============================================================================
+// Board stubs: APB2 at 72 MHz, the UART is stdout
+// ============================================================================
+uint8_t clock_add_listener(ClockListener listener) {
+    ClockFreqs f = { PCLK2_HZ, PCLK2_HZ, PCLK2_HZ / 2, PCLK2_HZ };
+    listener(&f);
+    return 1;
+}
+
+void uart_write(const char *data, uint32_t len) {
+    fwrite(data, 1, len, stdout);
+}
+
+// ============================================================================
+// What the sensor sees
+// ============================================================================
+static int16_t signal(uint32_t k, uint8_t axis) {
+    double t = (double)k / L3GD20_ODR_HZ;
+    int16_t noise = (int16_t)((k * 2654435761u >> (8 + axis * 5)) % 5) - 2;
+
+    switch (axis) {
+    case 0:  return (int16_t)lround(3000 * sin(2 * M_PI * t)) + noise;
+    case 1:  return (int16_t)((int32_t)(k % 20000) - 10000);
+    default: return (int16_t)lround(VIBRATION_LSB * sin(2 * M_PI * VIBRATION_HZ * t)) + noise;
+    }
+}
+
+// ============================================================================
+// L3GD20 model: registers, FIFO, INT2
+// ============================================================================
+static struct {
+    uint8_t regs[0x40];
+    int16_t fifo[FIFO_DEPTH][3];
+    uint32_t fifo_first;                // Sample number of fifo[0 .. level)
+    uint8_t level;
+    uint32_t made;                      // Samples the sensor produced
+    uint32_t popped;                    // ... and the driver read
+    uint32_t overruns;
+    uint32_t empty_reads;
+    // Current SPI transaction
+    uint8_t selected;
+    uint8_t index;                      // Byte within the transaction
+    uint8_t read;
+    uint8_t multi;
+    uint8_t addr;
+    uint32_t bytes;
+} dev;
+
+static uint32_t exti_pending;
+
+static uint8_t fifo_mode(void) {
+    return (dev.regs[0x24] & 0x40) != 0;
+}
+
+static void int2_update(void) {
+    uint8_t wtm = dev.regs[0x2E] & 0x1F;
+    uint8_t high = (dev.regs[0x22] & 0x04) && fifo_mode() && wtm && dev.level >= wtm;
+    uint32_t idr = REG(GPIOE_IDR_ADDR);
+    uint32_t bit = 1u << L3GD20_INT2_PIN;
+
+    if (high && !(idr & bit) && (REG(EXTI_BASE + 0x08) & bit)) {
+        exti_pending |= bit;
+        REG(EXTI_BASE + 0x14) = exti_pending | PR_MODEL;
+    }
+    REG(GPIOE_IDR_ADDR) = high ? idr | bit : idr & ~bit;
+}
+
+static void dev_sample(void) {
+    uint32_t k = dev.made++;
+
+    if (!(dev.regs[0x20] & 0x08)) {
+        return;                                 // Powered down
+    }
+    if (dev.level == FIFO_DEPTH) {              // Stream mode: the oldest goes
+        memmove(dev.fifo[0], dev.fifo[1], sizeof dev.fifo[0] * (FIFO_DEPTH - 1));
+        dev.level--;
+        dev.fifo_first++;
+        dev.overruns++;
+    }
+    if (dev.level == 0) {
+        dev.fifo_first = k;
+    }
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        dev.fifo[dev.level][axis] = signal(k, axis);
+    }
+    dev.level++;
+    int2_update();
+}
+
+static uint8_t dev_out_byte(uint8_t addr) {
+    if (!dev.level) {
+        dev.empty_reads++;
+        return 0;
+    }
+    uint16_t v = (uint16_t)dev.fifo[0][(addr - 0x28) / 2];
+    return (addr & 1) ? (uint8_t)(v >> 8) : (uint8_t)v;
+}
+
+static void dev_pop(void) {
+    if (!dev.level) {
+        return;
+    }
+    if (dev.fifo_first != dev.popped) {
+        fail("FIFO sample read out of order");
+    }
+    memmove(dev.fifo[0], dev.fifo[1], sizeof dev.fifo[0] * (FIFO_DEPTH - 1));
+    dev.level--;
+    dev.fifo_first++;
+    dev.popped++;
+    int2_update();
+}
+
+static uint8_t dev_byte(uint8_t in) {
+    uint8_t out = 0xFF;
+
+    if (!dev.selected) {
+        fail("SPI byte with CS high");
+        return out;
+    }
+    dev.bytes++;
+    if (dev.index++ == 0) {
+        dev.read = (in & 0x80) != 0;
+        dev.multi = (in & 0x40) != 0;
+        dev.addr = in & 0x3F;
+        return out;
+    }
+    uint8_t addr = dev.addr;
+    if (dev.read) {
+        out = (addr >= 0x28 && addr <= 0x2D && fifo_mode()) ? dev_out_byte(addr) : dev.regs[addr];
+        if (addr == 0x0F) {
+            out = 0xD4;                         // WHO_AM_I
+        }
+        if (addr == 0x2D && fifo_mode()) {
+            dev_pop();
+        }
+    } else {
+        dev.regs[addr] = in;
+    }
+    if (dev.multi) {
+        dev.addr = (addr == 0x2D && fifo_mode()) ? 0x28 : (uint8_t)((addr + 1) & 0x3F);
+    }
+    return out;
+}
+
+// ============================================================================
+// SPI1 + DMA1 channels 2 / 3 model
+// ============================================================================
+static struct {
+    uint32_t sck_hz;
+    uint8_t rx_full;                    // Polled: answer waiting in DR
+    uint8_t active;                     // DMA burst on the wire
+    uint64_t done_ns;
+    uint32_t n;
+    uint64_t busy_ns;
+    uint32_t bursts;
+} spi;
+
+static void spi_config(void) {
+    uint32_t cr1 = REG(SPI + 0x00);
+
+    if (!(cr1 & SPI_CR1_SPE)) {
+        return;
+    }
+    spi.sck_hz = PCLK2_HZ >> (((cr1 & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos) + 1);
+    if (!(cr1 & SPI_CR1_MSTR) || !(cr1 & SPI_CR1_CPOL) || !(cr1 & SPI_CR1_CPHA)) {
+        fail("SPI1 not master / mode 3");
+    }
+    if (spi.sck_hz > L3GD20_SCK_MAX_HZ) {
+        fail("SCK above the L3GD20's 10 MHz");
+    }
+}
+
+static void spi_dma_start(void) {
+    uint32_t n = REG(CNDTR_ADDR(DMA_SPI1_TX_CH));
+
+    if (spi.active || n == 0 || !(REG(CCR_ADDR(DMA_SPI1_TX_CH)) & DMA_CCR_EN) ||
+        !(REG(SPI + 0x04) & SPI_CR2_TXDMAEN)) {
+        return;
+    }
+    if (!(REG(CCR_ADDR(DMA_SPI1_RX_CH)) & DMA_CCR_EN) || !(REG(SPI + 0x04) & SPI_CR2_RXDMAEN) ||
+        REG(CNDTR_ADDR(DMA_SPI1_RX_CH)) != n) {
+        fail("transmit DMA started without its receive side");
+    }
+    if (REG(CPAR_ADDR(DMA_SPI1_TX_CH)) != SPI + 0x0C || REG(CPAR_ADDR(DMA_SPI1_RX_CH)) != SPI + 0x0C) {
+        fail("DMA not pointed at SPI1_DR");
+    }
+    if (!dev.selected) {
+        fail("burst with CS high");
+    }
+    spi.active = 1;
+    spi.n = n;
+    spi.done_ns = now_ns + (uint64_t)n * 8 * 1000000000u / spi.sck_hz;
+    spi.busy_ns += spi.done_ns - now_ns;
+}
+
+static void spi_dma_complete(void) {
+    const uint8_t *tx = host_sim_ptr(REG(CMAR_ADDR(DMA_SPI1_TX_CH)));
+    uint8_t *rx = host_sim_ptr(REG(CMAR_ADDR(DMA_SPI1_RX_CH)));
+
+    for (uint32_t i = 0; i < spi.n; i++) {
+        rx[i] = dev_byte(tx[i]);
+    }
+    REG(CNDTR_ADDR(DMA_SPI1_TX_CH)) = 0;
+    REG(CNDTR_ADDR(DMA_SPI1_RX_CH)) = 0;
+    REG(DMA1_BASE + 0x00) |= DMA_ISR_TCIF(DMA_SPI1_TX_CH) | DMA_ISR_TCIF(DMA_SPI1_RX_CH) |
+                             (1u << (4 * (DMA_SPI1_TX_CH - 1))) | (1u << (4 * (DMA_SPI1_RX_CH - 1)));
+    spi.active = 0;
+    spi.bursts++;
+}
+
+// Register side effects. Hooks also run after reads: every case must be
+// harmless then (write-1 registers are zeroed once acted on)
+static uint32_t irq_enabled[2];
+static uint8_t in_handler;
+static uint32_t handler_accesses;
+
+static void model_hook(uint32_t addr) {
+    if (in_handler) {
+        handler_accesses++;
+    }
+    if (addr == SPI + 0x00) {                                   // CR1
+        spi_config();
+    } else if (addr == SPI + 0x04) {                            // CR2
+        if (REG(addr) & ((1u << 6) | (1u << 7))) {
+            fail("RXNEIE / TXEIE: an interrupt per byte");
+        }
+    } else if (addr == SPI + 0x0C) {                            // DR
+        if (spi.rx_full) {                                      // The driver took the answer
+            spi.rx_full = 0;
+            REG(SPI + 0x08) &= ~SPI_SR_RXNE;
+        } else {
+            REG(addr) = dev_byte((uint8_t)REG(addr));
+            spi.rx_full = 1;
+            REG(SPI + 0x08) |= SPI_SR_RXNE;
+        }
+    } else if (addr == CCR_ADDR(DMA_SPI1_TX_CH)) {
+        spi_dma_start();
+    } else if (addr == DMA1_BASE + 0x04) {                      // IFCR
+        REG(DMA1_BASE + 0x00) &= ~REG(addr);
+        REG(addr) = 0;
+    } else if (addr == GPIOE_BASE + 0x18) {                     // BSRR: CS
+        uint32_t bsrr = REG(addr);
+        uint32_t odr = (REG(GPIOE_ODR_ADDR) | (bsrr & 0xFFFF)) & ~(bsrr >> 16);
+        uint8_t selected = !(odr & (1u << L3GD20_CS_PIN));
+        REG(GPIOE_ODR_ADDR) = odr;
+        REG(addr) = 0;
+        if (selected && !dev.selected) {
+            dev.index = 0;
+        }
+        if (!selected && spi.active) {
+            fail("CS released mid-burst");
+        }
+        dev.selected = selected;
+    } else if (addr == EXTI_BASE + 0x14) {                      // PR: write 1 to clear
+        if (!(REG(addr) & PR_MODEL)) {
+            exti_pending &= ~REG(addr);
+        }
+        REG(addr) = exti_pending | PR_MODEL;
+    } else if (addr == EXTI_BASE + 0x10) {                      // SWIER
+        exti_pending |= REG(addr) & REG(EXTI_BASE + 0x00);
+        REG(addr) = 0;
+        REG(EXTI_BASE + 0x14) = exti_pending | PR_MODEL;
+    } else if (addr == 0xE000E100 || addr == 0xE000E104) {      // ISER
+        irq_enabled[(addr >> 2) & 1] |= REG(addr);
+    }
+}
+
+// ============================================================================
+// Interrupts: levels, lowest number first
+// ============================================================================
+void EXTI1_IRQHandler(void);
+void DMA1_Channel2_IRQHandler(void);
+
+static struct {
+    uint32_t exti;
+    uint32_t dma;
+} entries;
+
+static uint8_t enabled(uint8_t irq) {
+    return (irq_enabled[irq >> 5] >> (irq & 31)) & 1;
+}
+
+static uint8_t take_interrupt(void) {
+    uint32_t dma = (REG(CCR_ADDR(DMA_SPI1_RX_CH)) & DMA_CCR_TCIE) ? DMA_ISR_TCIF(DMA_SPI1_RX_CH) : 0;
+
+    in_handler = 1;
+    if ((exti_pending & REG(EXTI_BASE + 0x00) & (1u << L3GD20_INT2_PIN)) && enabled(EXTI1_IRQn)) {
+        entries.exti++;
+        EXTI1_IRQHandler();
+    } else if ((REG(DMA1_BASE + 0x00) & dma) && enabled(DMA1_Channel2_IRQn)) {
+        entries.dma++;
+        DMA1_Channel2_IRQHandler();
+    } else {
+        in_handler = 0;
+        return 0;
+    }
+    host_sim_flush();
+    in_handler = 0;
+    return 1;
+}
+
+static void take_interrupts(void) {
+    host_sim_flush();
+    for (uint32_t n = 0; take_interrupt(); n++) {
+        if (n == STORM_LIMIT) {
+            fail("interrupt storm: a flag is never cleared");
+            exit(1);
+        }
+    }
+}
+
+// ============================================================================
+// Reference: the decimator as a plain FIR (two 8-sample averages = a
+// triangle of 15 taps summing to 64), output k after input 8k + 7
+// ============================================================================
+static int32_t reference(uint32_t k, uint8_t axis) {
+    int64_t sum = 0;
+
+    for (int32_t j = 0; j < 2 * L3GD20_DECIMATION - 1; j++) {
+        int32_t n = (int32_t)(k * L3GD20_DECIMATION + L3GD20_DECIMATION - 1) - j;
+        int32_t h = j < L3GD20_DECIMATION ? j + 1 : 2 * L3GD20_DECIMATION - 1 - j;
+        if (n >= 0) {
+            sum += (int64_t)h * signal((uint32_t)n, axis);
+        }
+    }
+    return (int32_t)(sum >> 6);
+}
+
+int main(int argc, char **argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 10) : DEFAULT_SECONDS;
+    uint64_t end_ns = (uint64_t)seconds * 1000000000u;
+    uint32_t received = 0, mismatches = 0;
+    uint64_t stall_from = 0, stall_ns = 0;
+    double vib_in = 0, vib_out = 0;
+    GyroSample g;
+
+    if (seconds == 0 || seconds > 3600) {
+        fprintf(stderr, "usage: %s [seconds 1-3600]\n", argv[0]);
+        return 2;
+    }
+
+    host_sim_reset();
+    host_sim_add_hook(model_hook);
+    REG(SPI + 0x08) = SPI_SR_TXE;
+
+    if (!l3gd20_init()) {
+        fail("l3gd20_init: no WHO_AM_I answer");
+    }
+    take_interrupts();                  // The SWIER kick: FIFO still empty
+    if (dev.regs[0x20] != 0xFF || dev.regs[0x22] != 0x04 || dev.regs[0x23] != 0x90 ||
+        dev.regs[0x24] != 0x40 || dev.regs[0x2E] != (0x40 | L3GD20_WATERMARK)) {
+        fail("sensor configuration (CTRL_REG1 / 3 / 4 / 5, FIFO_CTRL_REG)");
+    }
+    printf("L3GD20 replay: %u s at %u Hz, watermark %u, SCK %.2f MHz, decimation %u -> %u Hz\n\n",
+           seconds, L3GD20_ODR_HZ, L3GD20_WATERMARK, spi.sck_hz / 1e6,
+           L3GD20_DECIMATION, L3GD20_ODR_HZ / L3GD20_DECIMATION);
+
+    uint32_t exti_at_start = entries.exti;
+    for (;;) {
+        uint64_t next = SAMPLE_NS(dev.made);
+        uint64_t tick = (now_ns / 1000000 + 1) * 1000000;
+
+        if (spi.active && spi.done_ns < next) {
+            next = spi.done_ns;
+        }
+        if (tick < next) {
+            next = tick;                // The reader runs every ms
+        }
+        if (next > end_ns) {
+            break;
+        }
+        now_ns = next;
+
+        if (spi.active && spi.done_ns == now_ns) {
+            spi_dma_complete();
+        }
+        if (SAMPLE_NS(dev.made) == now_ns) {
+            dev_sample();
+        }
+        if (!stall_from && now_ns >= (uint64_t)STALL_AT_MS * 1000000 && exti_pending) {
+            stall_from = now_ns;
+        }
+        if (stall_from && !stall_ns) {
+            if (dev.level < FIFO_DEPTH) {
+                continue;               // Held off
+            }
+            stall_ns = now_ns - stall_from;
+        }
+        take_interrupts();
+        if (now_ns % 1000000 == 0) {
+            while (l3gd20_read(&g)) {
+                if (g.seq != received) {
+                    fail("decimated samples dropped");
+                }
+                for (uint8_t axis = 0; axis < 3; axis++) {
+                    if (g.rate[axis] != reference(received, axis) && mismatches++ < 3) {
+                        fail("decimated sample differs from the FIR");
+                    }
+                }
+                if (received >= 4) {    // Past the filter's start-up
+                    vib_in += pow(VIBRATION_LSB, 2) / 2;
+                    vib_out += pow(g.rate[2], 2);
+                }
+                received = g.seq + 1;
+            }
+        }
+    }
+
+    const L3gd20Stats *s = l3gd20_stats();
+    uint32_t samples = s->samples ? s->samples : 1;
+
+    printf("FIFO          %u made, %u read, %u overruns, %u empty reads\n",
+           dev.made, dev.popped, dev.overruns, dev.empty_reads);
+    printf("Bursts        %u of %u bytes, %u refills after the %.1f ms stall, bus busy %.2f %%\n",
+           spi.bursts, 1 + 6 * L3GD20_WATERMARK, s->refills, stall_ns / 1e6,
+           100.0 * spi.busy_ns / (double)now_ns);
+    printf("CPU entries   EXTI %u, DMA %u: %.3f per sample, %.1f register accesses per sample\n",
+           entries.exti - exti_at_start, entries.dma,
+           (double)(entries.exti - exti_at_start + entries.dma) / samples,
+           (double)handler_accesses / samples);
+    printf("Output        %u samples, %u dropped, bit-exact %s, %u Hz vibration %.1f dB\n",
+           received, s->dropped, mismatches ? "NO" : "yes", VIBRATION_HZ,
+           10 * log10((vib_out + 1e-9) / vib_in));
+    l3gd20_dump_uart();
+    printf("\n");
+
+    if (dev.overruns || dev.empty_reads || dev.made - dev.popped > FIFO_DEPTH) {
+        fail("FIFO samples lost or left behind");
+    }
+    if (s->samples != dev.popped || s->bursts != spi.bursts || s->refills == 0) {
+        fail("driver counts do not match the device, or the stall was never caught up");
+    }
+    if (entries.dma != spi.bursts || entries.exti - exti_at_start != spi.bursts - s->refills) {
+        fail("CPU entries per burst");
+    }
+    if (received != s->outputs || s->dropped || received < dev.popped / L3GD20_DECIMATION) {
+        fail("decimated stream incomplete");
+    }
+
+    printf("%s\n", errors ? "FAILED" : "Every FIFO sample read once, stream bit-exact");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file           : latency.c
+ * @brief          : Worst-case input-to-output latency
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ */
+
+#include "latency.h"
+#include "systick.h"
+#include "stm32f303_regs.h"
+#include "uart.h"
+#include "fmt.h"
+
+volatile LatencyStats input_latency;
+
+static inline uint32_t irq_save(void) {
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static inline void irq_restore(uint32_t primask) {
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+void latency_record(uint32_t start_cycles, uint32_t edge_ms) {
+    uint32_t end = DWT_CYCCNT;
+    uint32_t cycles = end - start_cycles;
+    uint32_t us = cycles / systick_cycles_per_us();
+    // The edge is stamped in whole ms: count from the start of its tick
+    uint32_t edge_us = (get_time_ms() - edge_ms) * 1000 +
+                       (end - systick_tick_cycles()) / systick_cycles_per_us();
+
+    input_latency.count++;
+    input_latency.last_us = us;
+    if (cycles > input_latency.worst_cycles) {
+        input_latency.worst_cycles = cycles;
+        input_latency.worst_us = us;
+    }
+    if (us > LATENCY_BUDGET_US) {
+        input_latency.over_budget++;
+    }
+    input_latency.edge_last_us = edge_us;
+    if (edge_us > input_latency.edge_worst_us) {
+        input_latency.edge_worst_us = edge_us;
+    }
+}
+
+// From the task that wrote Flash: the engine ISR updates over_budget too
+void latency_stall(uint32_t stall_us) {
+    uint32_t primask = irq_save();
+
+    input_latency.stalls++;
+    if (stall_us > input_latency.stall_worst_us) {
+        input_latency.stall_worst_us = stall_us;
+    }
+    if (stall_us > LATENCY_BUDGET_US) {
+        input_latency.over_budget++;
+    }
+    irq_restore(primask);
+}
+
+void latency_reset(void) {
+    input_latency.count = 0;
+    input_latency.last_us = 0;
+    input_latency.worst_us = 0;
+    input_latency.worst_cycles = 0;
+    input_latency.over_budget = 0;
+    input_latency.edge_last_us = 0;
+    input_latency.edge_worst_us = 0;
+    input_latency.stalls = 0;
+    input_latency.stall_worst_us = 0;
+}
+
+// "latency: 12 responses
+//    classification -> output: last 9 us, worst 23 us (1656 cycles), 0 over 1000 us
+//    edge -> output: last 321004 us, worst 341870 us
+//    flash stalls: 3, worst 23516 us"
+void latency_dump_uart(void) {
+    char line[320];
+    char *p = line;
+    LatencyStats s = input_latency;
+
+    p += fmt_str(p, "latency: ", 0);
+    p += fmt_dec(p, s.count);
+    p += fmt_str(p, " responses\r\n  classification -> output: last ", 0);
+    p += fmt_dec(p, s.last_us);
+    p += fmt_str(p, " us, worst ", 0);
+    p += fmt_dec(p, s.worst_us);
+    p += fmt_str(p, " us (", 0);
+    p += fmt_dec(p, s.worst_cycles);
+    p += fmt_str(p, " cycles), ", 0);
+    p += fmt_dec(p, s.over_budget);
+    p += fmt_str(p, " over ", 0);
+    p += fmt_dec(p, LATENCY_BUDGET_US);
+    p += fmt_str(p, " us\r\n  edge -> output: last ", 0);
+    p += fmt_dec(p, s.edge_last_us);
+    p += fmt_str(p, " us, worst ", 0);
+    p += fmt_dec(p, s.edge_worst_us);
+    p += fmt_str(p, " us\r\n  flash stalls: ", 0);
+    p += fmt_dec(p, s.stalls);
+    p += fmt_str(p, ", worst ", 0);
+    p += fmt_dec(p, s.stall_worst_us);
+    p += fmt_str(p, " us\r\n", 0);
+    uart_write(line, (uint32_t)(p - line));
+}
@@ -0,0 +1,63 @@
+/**
+ ******************************************************************************
+ * @file           : latency.h
+ * @brief          : Worst-case input-to-output latency
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ * In Day3_Final_7_Patterns.c a press is noticed only after the running
+ * pattern's delay(150000..300000) - the response time is the frame time.
+ * Here every response is measured twice, up to the same end:
+ *
+ *   end = right after the response reached the output register
+ *
+ *   classification -> output: from the DWT count at entry of the
+ *       SysTick that classified the gesture (the tick that debounced the
+ *       edge, or the end of a time-out such as the double-press window).
+ *       The firmware's own share; LATENCY_BUDGET_US applies to it.
+ *   edge -> output: from the gesture's first raw edge (the tick the
+ *       pin first moved, gesture.h first_edge_time) - what the user
+ *       waits, debounce and double-press window included. 1 ms resolution.
+ *
+ *   latency_record(start, edge_ms);     // once the output is written
+ *
+ * Flash erases and programs stall every fetch, interrupts included
+ * (flash.h). Each stall is passed in with latency_stall(); one longer
+ * than LATENCY_BUDGET_US counts in over_budget, since no response can
+ * get out while it lasts, whether or not one was pending.
+ *
+ * The stats stay in RAM (input_latency) for the debugger and are printed
+ * on the console with 'l'.
+ ******************************************************************************
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+#define LATENCY_BUDGET_US   1000
+
+typedef struct {
+    uint32_t count;                 // Responses measured
+    // Classification -> output
+    uint32_t last_us;
+    uint32_t worst_us;
+    uint32_t worst_cycles;
+    uint32_t over_budget;           // Responses + Flash stalls over LATENCY_BUDGET_US
+    // Edge -> output
+    uint32_t edge_last_us;
+    uint32_t edge_worst_us;
+    // Flash erase / program (every ISR waits)
+    uint32_t stalls;
+    uint32_t stall_worst_us;
+} LatencyStats;
+
+extern volatile LatencyStats input_latency;
+
+void latency_record(uint32_t start_cycles, uint32_t edge_ms);
+void latency_stall(uint32_t stall_us);
+void latency_reset(void);
+void latency_dump_uart(void);
+
+#endif // LATENCY_H
@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @file           : led_frame.h
+ * @brief          : N-output LED frame shared by all output backends
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * A frame is a bit array: output i is bits[i / 8] bit (i % 8). For the
+ * on-board LEDs that is the one-byte frame of board.h (bit i = PE(8 + i));
+ * for a 74HC595 chain it is the byte stream sent to the chain (hc595.h).
+ *
+ * 'ring' lists the outputs in physical ring order for patterns that spin
+ * (the compass order of the Discovery LEDs). NULL means the outputs are
+ * already in order, as on a straight panel.
+ *
+ * LedLevels is the same idea with brightness: one perceptual level
+ * (0..255, see brightness.h) per output, for outputs that can dim.
+ ******************************************************************************
+ */
+
+#ifndef LED_FRAME_H
+#define LED_FRAME_H
+
+#include <stdint.h>
+
+#define LED_FRAME_BYTES(width)  (((width) + 7) / 8)
+
+typedef struct {
+    uint8_t *bits;                  // LED_FRAME_BYTES(width) bytes
+    uint16_t width;                 // Number of outputs
+    const uint8_t *ring;            // Ring position -> output, or NULL
+} LedFrame;
+
+typedef struct {
+    uint8_t *level;                 // 'width' bytes
+    uint16_t width;
+    const uint8_t *ring;            // Ring position -> output, or NULL
+} LedLevels;
+
+static inline void led_frame_fill(LedFrame *f, uint8_t on) {
+    uint16_t bytes = LED_FRAME_BYTES(f->width);
+    for (uint16_t i = 0; i < bytes; i++) {
+        f->bits[i] = on ? 0xFF : 0x00;
+    }
+    if (on && (f->width & 7)) {
+        f->bits[bytes - 1] = (uint8_t)((1 << (f->width & 7)) - 1);  // No bits past width
+    }
+}
+
+static inline void led_frame_set(LedFrame *f, uint16_t output) {
+    f->bits[output >> 3] |= (uint8_t)(1 << (output & 7));
+}
+
+static inline uint16_t led_frame_ring(const LedFrame *f, uint16_t position) {
+    return f->ring ? f->ring[position] : position;
+}
+
+#endif // LED_FRAME_H
@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * @file           : led_pwm.c
+ * @brief          : Soft PWM for the 8 on-board LEDs (bit-angle modulation)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ */
+
+#include "led_pwm.h"
+#include "brightness.h"
+#include "clock_config.h"
+#include "stm32f303_regs.h"
+
+#define PWM_TIM             TIM7_BASE
+#define PWM_PLANES          GAMMA_OUT_BITS
+#define PWM_TICK_HZ         1000000     // Timer counts microseconds
+
+static uint32_t planes[2][PWM_PLANES];  // BSRR value of each bit plane
+static volatile uint8_t front;
+static volatile uint8_t swap_pending;
+static uint8_t plane;                   // Plane on the LEDs right now
+static uint16_t unit_ticks;             // Length of plane 0
+
+// ============================================================================
+// Clock listener: keep the timer counting microseconds
+// ============================================================================
+static void led_pwm_on_clock_change(const ClockFreqs *freqs) {
+    uint32_t tim_hz = (freqs->pclk1_hz == freqs->hclk_hz) ? freqs->pclk1_hz : 2 * freqs->pclk1_hz;
+
+    TIM_PSC(PWM_TIM) = tim_hz / PWM_TICK_HZ - 1;    // Applies at the next update
+}
+
+// ============================================================================
+// One interrupt per bit plane
+// ============================================================================
+void TIM7_IRQHandler(void) {
+    TIM_SR(PWM_TIM) = 0;
+
+    if (++plane == PWM_PLANES) {
+        plane = 0;
+        if (swap_pending) {
+            front ^= 1;
+            swap_pending = 0;
+        }
+    }
+    GPIOE_BSRR = planes[front][plane];
+
+    // ARR is preloaded: this sets the length of the NEXT plane
+    uint8_t next = (plane + 1 == PWM_PLANES) ? 0 : plane + 1;
+    TIM_ARR(PWM_TIM) = ((uint32_t)unit_ticks << next) - 1;
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+void led_pwm_init(void) {
+    unit_ticks = PWM_TICK_HZ / (LED_PWM_FRAME_HZ * GAMMA_MAX);
+    if (unit_ticks < 2) unit_ticks = 2;
+
+    for (uint8_t p = 0; p < PWM_PLANES; p++) {
+        planes[0][p] = planes[1][p] = LED_FRAME_BSRR(0);
+    }
+    plane = PWM_PLANES - 1;             // First interrupt shows plane 0
+
+    RCC_APB1ENR |= RCC_APB1ENR_TIM7EN;
+    clock_add_listener(led_pwm_on_clock_change);
+
+    TIM_CR1(PWM_TIM) = TIM_CR1_ARPE;
+    TIM_ARR(PWM_TIM) = unit_ticks - 1;
+    TIM_EGR(PWM_TIM) = TIM_EGR_UG;      // Load PSC / ARR now
+    TIM_SR(PWM_TIM) = 0;
+    TIM_DIER(PWM_TIM) = TIM_DIER_UIE;
+    NVIC_SET_PRIORITY(TIM7_IRQn, IRQ_PRIO_PWM);
+    NVIC_ENABLE_IRQ(TIM7_IRQn);
+    TIM_CR1(PWM_TIM) |= TIM_CR1_CEN;
+}
+
+// ============================================================================
+// Levels -> bit planes (one gamma lookup per LED)
+// ============================================================================
+static void levels_to_planes(uint32_t *back, const uint8_t level[LED_COUNT]) {
+    uint16_t duty[LED_COUNT];
+
+    for (uint8_t i = 0; i < LED_COUNT; i++) {
+        duty[i] = gamma_apply(level[i]);
+    }
+    for (uint8_t p = 0; p < PWM_PLANES; p++) {
+        uint8_t bits = 0;
+        for (uint8_t i = 0; i < LED_COUNT; i++) {
+            bits |= (uint8_t)(((duty[i] >> p) & 1) << i);
+        }
+        back[p] = LED_FRAME_BSRR(bits);
+    }
+}
+
+uint8_t led_pwm_show(const uint8_t level[LED_COUNT]) {
+    if (swap_pending) {
+        return 0;
+    }
+    levels_to_planes(planes[front ^ 1], level);
+    swap_pending = 1;
+    return 1;
+}
+
+// ============================================================================
+// Restart the frame: the update event below lets the ISR show plane 0 of
+// the new buffer straight away (it preempts the caller, IRQ_PRIO_PWM)
+// ============================================================================
+void led_pwm_show_now(const uint8_t level[LED_COUNT]) {
+    NVIC_DISABLE_IRQ(TIM7_IRQn);
+
+    levels_to_planes(planes[front ^ 1], level);
+    front ^= 1;
+    swap_pending = 0;
+    plane = PWM_PLANES - 1;             // Next interrupt shows plane 0
+    TIM_ARR(PWM_TIM) = unit_ticks - 1;  // ... for plane 0's length
+    TIM_EGR(PWM_TIM) = TIM_EGR_UG;      // Counter restarts, UIF set
+
+    NVIC_ENABLE_IRQ(TIM7_IRQn);
+}
@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @file           : led_pwm.h
+ * @brief          : Soft PWM for the 8 on-board LEDs (bit-angle modulation)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * Only half of PE8-PE15 sit on timer channels, so all eight are dimmed in
+ * software with bit-angle modulation: a PWM frame is GAMMA_OUT_BITS bit
+ * planes, plane k lasting 2^k time units. TIM7 interrupts once per plane
+ * and writes that plane with one BSRR store - 8 interrupts per frame
+ * instead of one per duty step.
+ *
+ *   led_pwm_show(levels);   // perceptual 0..255 per LED (bit i = PE(8 + i))
+ *
+ * Levels go through gamma_apply() (brightness.h) and are turned into the
+ * bit planes of a back buffer; the ISR swaps buffers at the start of the
+ * next frame, so a frame is never half old, half new.
+ *
+ * led_pwm_show_now() is for input responses: it cuts the running frame
+ * short and starts a new one with the new levels within microseconds,
+ * instead of up to one frame (1 / LED_PWM_FRAME_HZ) later. The cut frame
+ * is slightly dimmer - invisible once, so keep it to button events.
+ ******************************************************************************
+ */
+
+#ifndef LED_PWM_H
+#define LED_PWM_H
+
+#include <stdint.h>
+#include "board.h"
+
+#define LED_PWM_FRAME_HZ    200         // Well above flicker fusion
+
+void led_pwm_init(void);
+
+// 0 if the previous levels have not reached the LEDs yet (try next tick)
+uint8_t led_pwm_show(const uint8_t level[LED_COUNT]);
+
+// Always accepted: restarts the PWM frame with 'level' right away
+void led_pwm_show_now(const uint8_t level[LED_COUNT]);
+
+#endif // LED_PWM_H
@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @file           : leds_gpio.cpp
+ * @brief          : On-board LED port setup (gpio.hpp, callable from C)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ */
+
+#include "leds_gpio.h"
+#include "gpio.hpp"
+#include "stm32f303_regs.h"
+
+using gpio::board::Leds;
+
+extern "C" void leds_gpio_init(void) {
+    RCC_AHBENR |= RCC_AHBENR_GPIOEEN;
+
+    Leds::mode(gpio::Mode::Output);     // 0x55550000 into MODER, one RMW
+    Leds::push_pull();
+    Leds::speed(gpio::Speed::Low);
+    Leds::pull(gpio::Pull::None);
+    Leds::clear();                      // all_leds_off(): one BSRR store
+}
@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @file           : leds_gpio.h
+ * @brief          : On-board LED port setup (gpio.hpp, callable from C)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Day3_Final_7_Patterns.c sets up PE8-PE15 with sixteen read-modify-writes
+ * of GPIOE_MODER and turns them off with all_leds_off()'s eight more on
+ * ODR. leds_gpio_init() does the same through gpio::board::Leds, which
+ * folds the eight pins at compile time: one RMW per config register and
+ * one BSRR store for "all off" (gpio_codegen.cpp checks the code).
+ ******************************************************************************
+ */
+
+#ifndef LEDS_GPIO_H
+#define LEDS_GPIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// GPIOE clock on, LED pins push-pull outputs, low speed, no pull, all off
+void leds_gpio_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEDS_GPIO_H
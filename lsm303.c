@@ -0,0 +1,257 @@
+/**
+ ******************************************************************************
+ * @file           : lsm303.c
+ * @brief          : LSM303DLHC accelerometer + magnetometer, read on data-ready
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ */
+
+#include "lsm303.h"
+#include "i2c.h"
+#include "board.h"
+#include "systick.h"
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+#include "uart.h"
+#include "fmt.h"
+#ifdef HOST_SIM
+#include "host_sim.h"
+#endif
+
+// Accelerometer registers
+#define ACC_CTRL_REG1       0x20
+#define ACC_CTRL_REG3       0x22
+#define ACC_CTRL_REG4       0x23
+#define ACC_OUT_X_L         0x28
+#define ACC_AUTO_INC        0x80        // Register address MSB: burst
+
+#define ACC_100HZ_XYZ       0x57        // ODR 100 Hz, normal power, X Y Z on
+#define ACC_INT1_DRDY1      0x10        // Data ready on INT1
+#define ACC_BDU_HR_2G       0x88        // Block update, high resolution, +-2 g
+
+// Magnetometer registers
+#define MAG_CRA             0x00
+#define MAG_CRB             0x01
+#define MAG_MR              0x02
+#define MAG_OUT_X_H         0x03        // X_H X_L Z_H Z_L Y_H Y_L
+
+#define MAG_30HZ            0x14
+#define MAG_GAIN_1_3        0x20        // +-1.3 gauss
+#define MAG_CONTINUOUS      0x00
+
+typedef enum {
+    SENSOR_ACC,
+    SENSOR_MAG,
+    SENSOR_COUNT
+} Sensor;
+
+#define SENSOR_BIT(s)       (1u << (s))
+#define NONE                0xFF
+
+static const uint8_t sensor_addr[SENSOR_COUNT] = { LSM303_ACC_ADDR, LSM303_MAG_ADDR };
+static const uint8_t sensor_reg[SENSOR_COUNT] = { ACC_OUT_X_L | ACC_AUTO_INC, MAG_OUT_X_H };
+static const uint8_t drdy_pin[SENSOR_COUNT] = { LSM303_DRDY_ACC_PIN, LSM303_DRDY_MAG_PIN };
+
+static const PinConfig drdy_pins[] = {
+    PIN_INPUT(GPIO_PORT_E, LSM303_DRDY_ACC_PIN, PIN_PULL_NONE),     // Push-pull outputs
+    PIN_INPUT(GPIO_PORT_E, LSM303_DRDY_MAG_PIN, PIN_PULL_NONE),
+};
+
+static uint8_t raw[SENSOR_COUNT][6];            // DMA targets
+static Lsm303Sample samples[2];
+static volatile uint8_t front;                  // samples[front] is published
+static volatile uint8_t waiting;                // SENSOR_BIT: data ready, not read yet
+static volatile uint8_t reading = NONE;         // Sensor whose burst runs
+static uint8_t failures[SENSOR_COUNT];          // In a row
+static Lsm303Stats stats;
+
+static void burst_done(uint8_t ok);
+
+// ============================================================================
+// Reads: one burst at a time, the next one started from the completion
+// ============================================================================
+static void start_next(void) {
+    for (uint8_t s = 0; s < SENSOR_COUNT && reading == NONE; s++) {
+        if ((waiting & SENSOR_BIT(s)) &&
+            i2c_read_dma(sensor_addr[s], sensor_reg[s], raw[s], sizeof raw[s], burst_done)) {
+            waiting &= ~SENSOR_BIT(s);
+            reading = s;
+        }
+    }
+}
+
+static uint8_t drdy_high(uint8_t s) {
+    return (GPIOE_IDR & (1u << drdy_pin[s])) != 0;
+}
+
+static int16_t le16(const uint8_t *p) {
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static int16_t be16(const uint8_t *p) {
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+static void publish(uint8_t s) {
+    Lsm303Sample *next = &samples[front ^ 1];
+    const uint8_t *r = raw[s];
+
+    *next = samples[front];
+    if (s == SENSOR_ACC) {
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            next->accel[axis] = (int16_t)(le16(&r[2 * axis]) >> 4);   // 12 bits, left-justified
+        }
+        next->accel_ms = get_time_ms();
+        next->accel_count++;
+    } else {
+        next->mag[0] = be16(&r[0]);
+        next->mag[1] = be16(&r[4]);
+        next->mag[2] = be16(&r[2]);
+        next->mag_ms = get_time_ms();
+        next->mag_count++;
+    }
+    front ^= 1;
+}
+
+static void burst_done(uint8_t ok) {
+    uint8_t s = reading;
+
+    reading = NONE;
+    if (ok) {
+        publish(s);
+        failures[s] = 0;
+    } else {
+        stats.failed++;
+        failures[s]++;
+    }
+
+    // Still (or again) high: a sample came during the read, or it failed
+    if (drdy_high(s) && failures[s] < LSM303_RETRIES) {
+        waiting |= SENSOR_BIT(s);
+    }
+    start_next();
+}
+
+// ============================================================================
+// Data-ready interrupts
+// ============================================================================
+static void drdy(uint8_t s) {
+    uint8_t other = s ^ 1;
+
+    EXTI_PR = 1u << drdy_pin[s];
+    if (drdy_high(s)) {                 // Low: the init kick, nothing to read yet
+        waiting |= SENSOR_BIT(s);
+        failures[s] = 0;
+    }
+
+    // The other line high with no edge pending or read queued: its edge
+    // was lost, it would never interrupt again
+    if (drdy_high(other) && reading != other && !(waiting & SENSOR_BIT(other)) &&
+        !(EXTI_PR & (1u << drdy_pin[other]))) {
+        waiting |= SENSOR_BIT(other);
+        stats.missed_edges++;
+    }
+    start_next();
+}
+
+void EXTI2_TSC_IRQHandler(void) {
+    drdy(SENSOR_MAG);                   // PE2
+}
+
+void EXTI4_IRQHandler(void) {
+    drdy(SENSOR_ACC);                   // PE4
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+// EXTI line 'pin' <- port E, rising edge
+static void drdy_route(uint8_t pin) {
+    if (pin < 4) {
+        SYSCFG_EXTICR1 = (SYSCFG_EXTICR1 & ~(0xFu << (pin * 4))) | ((uint32_t)GPIO_PORT_E << (pin * 4));
+    } else {
+        SYSCFG_EXTICR2 = (SYSCFG_EXTICR2 & ~(0xFu << ((pin - 4) * 4))) |
+                         ((uint32_t)GPIO_PORT_E << ((pin - 4) * 4));
+    }
+    EXTI_RTSR |= 1u << pin;
+    EXTI_IMR  |= 1u << pin;
+}
+
+uint8_t lsm303_init(void) {
+    uint8_t ok = 1;
+
+    i2c_init();
+#ifdef HOST_SIM
+    host_sim_map(raw, sizeof raw);
+#endif
+
+    ok &= i2c_write_reg(LSM303_ACC_ADDR, ACC_CTRL_REG4, ACC_BDU_HR_2G);
+    ok &= i2c_write_reg(LSM303_ACC_ADDR, ACC_CTRL_REG3, ACC_INT1_DRDY1);
+    ok &= i2c_write_reg(LSM303_ACC_ADDR, ACC_CTRL_REG1, ACC_100HZ_XYZ);
+    ok &= i2c_write_reg(LSM303_MAG_ADDR, MAG_CRA, MAG_30HZ);
+    ok &= i2c_write_reg(LSM303_MAG_ADDR, MAG_CRB, MAG_GAIN_1_3);
+    ok &= i2c_write_reg(LSM303_MAG_ADDR, MAG_MR, MAG_CONTINUOUS);
+
+    RCC_APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    pin_config_apply(drdy_pins, PIN_TABLE_SIZE(drdy_pins));
+    drdy_route(LSM303_DRDY_ACC_PIN);
+    drdy_route(LSM303_DRDY_MAG_PIN);
+
+    NVIC_SET_PRIORITY(EXTI4_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_SET_PRIORITY(EXTI2_TSC_IRQn, IRQ_PRIO_SENSOR);
+    NVIC_ENABLE_IRQ(EXTI4_IRQn);
+    NVIC_ENABLE_IRQ(EXTI2_TSC_IRQn);
+
+    // The lines may be high already (no edge to come): look at both once
+    EXTI_SWIER = (1u << LSM303_DRDY_ACC_PIN) | (1u << LSM303_DRDY_MAG_PIN);
+    return ok;
+}
+
+const Lsm303Sample *lsm303_latest(void) {
+    return &samples[front];
+}
+
+const Lsm303Stats *lsm303_stats(void) {
+    return &stats;
+}
+
+// ============================================================================
+// Recording: "<ms> a <x> <y> <z>" / "<ms> m <x> <y> <z>"
+// ============================================================================
+static char *put_int(char *p, int32_t v) {
+    *p++ = ' ';
+    if (v < 0) {
+        *p++ = '-';
+        v = -v;
+    }
+    return p + fmt_dec(p, (uint32_t)v);
+}
+
+static void record_line(uint32_t ms, char kind, const int16_t v[3]) {
+    char line[48];
+    char *p = line;
+
+    p += fmt_dec(p, ms);
+    *p++ = ' ';
+    *p++ = kind;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        p = put_int(p, v[axis]);
+    }
+    *p++ = '\r';
+    *p++ = '\n';
+    uart_write(line, (uint32_t)(p - line));
+}
+
+void lsm303_record_uart(uint32_t *accel_seen, uint32_t *mag_seen) {
+    Lsm303Sample s = *lsm303_latest();          // Copy: the buffers flip under us
+
+    if (s.accel_count != *accel_seen) {
+        record_line(s.accel_ms, 'a', s.accel);
+        *accel_seen = s.accel_count;
+    }
+    if (s.mag_count != *mag_seen) {
+        record_line(s.mag_ms, 'm', s.mag);
+        *mag_seen = s.mag_count;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ ******************************************************************************
+ * @file           : lsm303.h
+ * @brief          : LSM303DLHC accelerometer + magnetometer, read on data-ready
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ * The on-board LSM303DLHC on I2C1 (i2c.h):
+ *   accelerometer  100 Hz, +-2 g, high resolution: 1 mg per LSB
+ *   magnetometer    30 Hz, +-1.3 gauss: 1100 LSB/gauss (X, Y), 980 (Z)
+ *
+ * Nothing polls. Each sensor's data-ready line (board.h) interrupts on
+ * its rising edge and only queues a read; the read is one DMA burst of
+ * all six output registers (the accelerometer needs the auto-increment
+ * bit in the register address, the magnetometer increments by itself).
+ * The DMA completion converts the bytes and starts the other sensor's
+ * burst if its data-ready came meanwhile. A data-ready line still high
+ * after a read (an edge missed while the bus was busy) is read again
+ * rather than stalling the sensor.
+ *
+ * Samples are double-buffered: the completion fills the spare copy and
+ * then switches lsm303_latest() over, so a reader on a higher priority
+ * (the LED engine) always sees one whole sample.
+ *
+ * lsm303_record_uart() prints new samples as lines that lsm303_sim.c can
+ * replay (console 'm' records LSM303_RECORD_MS):
+ *   "<ms> a <x> <y> <z>"     accelerometer, mg
+ *   "<ms> m <x> <y> <z>"     magnetometer, raw
+ ******************************************************************************
+ */
+
+#ifndef LSM303_H
+#define LSM303_H
+
+#include <stdint.h>
+
+#define LSM303_ACC_ADDR             0x19
+#define LSM303_MAG_ADDR             0x1E
+#define LSM303_MAG_XY_LSB_PER_GAUSS 1100
+#define LSM303_MAG_Z_LSB_PER_GAUSS  980
+#define LSM303_RETRIES              3       // Failed reads in a row before waiting for an edge
+#define LSM303_RECORD_MS            10000
+
+typedef struct {
+    int16_t accel[3];               // mg, sensor axes (board.h places them)
+    int16_t mag[3];                 // Raw, X Y Z (the registers are X Z Y)
+    uint32_t accel_ms;              // Tick of the last sample of each
+    uint32_t mag_ms;
+    uint32_t accel_count;           // Samples so far, 0 = none yet
+    uint32_t mag_count;
+} Lsm303Sample;
+
+typedef struct {
+    uint32_t failed;                // Reads that ended in NACK / bus error
+    uint32_t missed_edges;          // Data ready found high with no edge seen
+} Lsm303Stats;
+
+// I2C, both sensors, data-ready interrupts; 1 = both answered
+uint8_t lsm303_init(void);
+
+const Lsm303Sample *lsm303_latest(void);
+const Lsm303Stats *lsm303_stats(void);
+
+// Prints the samples newer than *accel_seen / *mag_seen, updates them
+void lsm303_record_uart(uint32_t *accel_seen, uint32_t *mag_seen);
+
+#endif // LSM303_H
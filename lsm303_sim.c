@@ -0,0 +1,778 @@
+/**
+ ******************************************************************************
+ * @file           : lsm303_sim.c
+ * @brief          : Host tool - lsm303.c / i2c.c against a simulated LSM303
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 2, 2026
+ ******************************************************************************
+ * Runs the unchanged drivers and the compass pattern (HOST_SIM register
+ * space, host_sim.h) with models of I2C1, DMA1 channels 6 / 7, EXTI, the
+ * data-ready pins on GPIOE and both LSM303 devices, and replays a
+ * recording (lsm303_record_uart() format, console 'm') as the sensor
+ * samples, each at its own ms:
+ *
+ *   g++ -std=c++17 -O2 -c brightness_lut.cpp
+ *   gcc -DHOST_SIM -O2 -o lsm303_sim lsm303_sim.c lsm303.c i2c.c compass.c \
+ *       pin_config.c fmt.c patterns.c zone.c anim.c anim_demo.c host_sim.c \
+ *       brightness_lut.o -lm
+ *   ./lsm303_sim [lsm303_rec.txt]
+ *
+ * The I2C model takes bus time (9 bits per byte at the programmed
+ * 400 kHz), moves burst bytes only through the DMA channels, and answers
+ * register addresses like the devices do: the accelerometer increments
+ * only with the address MSB set, the magnetometer always. A device raises
+ * its data-ready pin with each sample and drops it when the output
+ * registers are read. Interrupts are taken between bus events, as levels
+ * from the flags the handlers must clear. Checked:
+ *   - the setup writes reach the configuration registers
+ *   - every recorded sample is published once, in order, bit-exact,
+ *     within SAMPLE_LATENCY_MAX_MS, and printed back the same
+ *   - no per-byte CPU work: one EXTI, one TC and one DMA interrupt per
+ *     burst
+ *   - recovery with no sample lost: an address NACK, a bus error and a
+ *     lost magnetometer edge, injected once each
+ *   - the compass pattern lights the octant atan2() says (either side
+ *     within BOUNDARY_DEG of a sector edge)
+ * Exit code 1 on any failure.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "lsm303.h"
+#include "i2c.h"
+#include "compass.h"
+#include "patterns.h"
+#include "board.h"
+#include "uart.h"
+#include "host_sim.h"
+#include "stm32f303_regs.h"
+
+#define MAX_SAMPLES             4096
+#define BUS_NS_PER_BIT          2500        // 400 kHz
+#define SAMPLE_LATENCY_MAX_MS   2
+#define LOST_EDGE_LATENCY_MS    10          // Found by the next accelerometer edge
+#define BOUNDARY_DEG            2.0
+#define COMPASS_PATTERN         10
+#define REPLAY_TAIL_MS          100         // Bus still busy this long after: stuck
+#define STORM_LIMIT             64          // Handler entries per step: one is stuck
+
+#define PR_MODEL                (1u << 31)  // EXTI_PR written by the model, not the driver
+
+// Faults, each injected once, at a sample of the recording
+#define FAULT_NACK_AT           100         // Accelerometer sample index
+#define FAULT_BERR_AT           200
+#define FAULT_LOST_EDGE_AT      50          // Magnetometer sample index
+
+#define I2C                     I2C1_BASE
+#define REG(addr)               (*host_sim_peek(addr))
+#define CCR_ADDR(ch)            (DMA1_BASE + 0x08 + 20 * ((ch) - 1))
+#define CNDTR_ADDR(ch)          (DMA1_BASE + 0x0C + 20 * ((ch) - 1))
+#define CMAR_ADDR(ch)           (DMA1_BASE + 0x14 + 20 * ((ch) - 1))
+
+// ============================================================================
+// Board stubs: time comes from the harness, the UART is a buffer
+// ============================================================================
+static uint64_t now_ns;
+static char uart_out[1 << 16];
+static uint32_t uart_len;
+
+uint32_t get_time_ms(void) {
+    return (uint32_t)(now_ns / 1000000);
+}
+
+void uart_write(const char *data, uint32_t len) {
+    if (uart_len + len < sizeof uart_out) {
+        memcpy(&uart_out[uart_len], data, len);
+        uart_len += len;
+    }
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+enum { ACC, MAG, SENSORS };
+
+typedef struct {
+    uint32_t ms;
+    int16_t v[3];
+} Sample;
+
+static Sample recorded[SENSORS][MAX_SAMPLES];
+static uint32_t recorded_count[SENSORS];
+
+static uint8_t load_recording(const char *path) {
+    char line[128];
+    FILE *f = fopen(path, "r");
+
+    if (!f) {
+        perror(path);
+        return 0;
+    }
+    while (fgets(line, sizeof line, f)) {
+        unsigned ms;
+        char kind;
+        int x, y, z;
+
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (sscanf(line, "%u %c %d %d %d", &ms, &kind, &x, &y, &z) != 5 ||
+            (kind != 'a' && kind != 'm')) {
+            fprintf(stderr, "%s: bad line: %s", path, line);
+            fclose(f);
+            return 0;
+        }
+        uint8_t s = kind == 'a' ? ACC : MAG;
+        if (recorded_count[s] < MAX_SAMPLES) {
+            Sample *r = &recorded[s][recorded_count[s]++];
+            r->ms = ms;
+            r->v[0] = (int16_t)x;
+            r->v[1] = (int16_t)y;
+            r->v[2] = (int16_t)z;
+        }
+    }
+    fclose(f);
+    return recorded_count[ACC] && recorded_count[MAG];
+}
+
+// ============================================================================
+// Device models: register files, data-ready pins
+// ============================================================================
+typedef struct {
+    uint8_t addr;
+    uint8_t always_increment;           // Magnetometer: no MSB needed
+    uint8_t out_last;                   // Reading this output register drops data-ready
+    uint8_t pin;
+    uint8_t regs[0x80];
+    uint8_t ptr;
+    uint8_t increment;
+    uint32_t next;                      // Recorded sample to come
+    uint32_t overruns;                  // Sample replaced before it was read
+} Device;
+
+static Device devices[SENSORS] = {
+    { LSM303_ACC_ADDR, 0, 0x2D, LSM303_DRDY_ACC_PIN, {0}, 0, 0, 0, 0 },    // OUT_Z_H
+    { LSM303_MAG_ADDR, 1, 0x08, LSM303_DRDY_MAG_PIN, {0}, 0, 0, 0, 0 },    // OUT_Y_L
+};
+
+static uint32_t exti_pending;
+static uint32_t errors;
+
+static void fail(const char *what) {
+    if (errors++ < 10) {
+        printf("  FAIL at %.3f ms: %s\n", now_ns / 1e6, what);
+    }
+}
+
+static Device *device_at(uint8_t addr) {
+    for (uint8_t s = 0; s < SENSORS; s++) {
+        if (devices[s].addr == addr) {
+            return &devices[s];
+        }
+    }
+    return 0;
+}
+
+static void set_pin(uint8_t pin, uint8_t high) {
+    uint32_t idr = REG(GPIOE_BASE + 0x10);
+
+    if (high && !(idr & (1u << pin)) && (REG(EXTI_BASE + 0x08) & (1u << pin))) {
+        exti_pending |= 1u << pin;      // Rising edge
+    }
+    REG(GPIOE_BASE + 0x10) = high ? idr | (1u << pin) : idr & ~(1u << pin);
+    REG(EXTI_BASE + 0x14) = exti_pending | PR_MODEL;
+}
+
+// The first byte of a write is the register address
+static void device_write(Device *d, const uint8_t *bytes, uint8_t n) {
+    d->ptr = bytes[0] & 0x7F;
+    d->increment = d->always_increment || (bytes[0] & 0x80);
+    for (uint8_t i = 1; i < n; i++) {
+        d->regs[d->ptr] = bytes[i];
+        d->ptr = (uint8_t)((d->ptr + d->increment) & 0x7F);
+    }
+}
+
+static void device_read(Device *d, uint8_t *bytes, uint8_t n) {
+    uint8_t emptied = 0;
+
+    for (uint8_t i = 0; i < n; i++) {
+        bytes[i] = d->regs[d->ptr];
+        emptied |= d->ptr == d->out_last;
+        d->ptr = (uint8_t)((d->ptr + d->increment) & 0x7F);
+    }
+    if (emptied) {
+        set_pin(d->pin, 0);
+    }
+}
+
+// Next recorded sample into the output registers, data-ready up
+static void device_sample(uint8_t s, uint8_t lose_edge) {
+    Device *d = &devices[s];
+    const Sample *r = &recorded[s][d->next++];
+
+    if (REG(GPIOE_BASE + 0x10) & (1u << d->pin)) {
+        d->overruns++;
+    }
+    if (s == ACC) {
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            uint16_t v = (uint16_t)(r->v[axis] * 16);           // 12 bits, left-justified
+            d->regs[0x28 + 2 * axis] = (uint8_t)v;
+            d->regs[0x29 + 2 * axis] = (uint8_t)(v >> 8);
+        }
+    } else {
+        static const uint8_t at[3] = { 0x03, 0x07, 0x05 };     // X, Y, Z high bytes
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            d->regs[at[axis]] = (uint8_t)((uint16_t)r->v[axis] >> 8);
+            d->regs[at[axis] + 1] = (uint8_t)r->v[axis];
+        }
+    }
+    if (lose_edge) {
+        REG(GPIOE_BASE + 0x10) |= 1u << d->pin;                 // High, but no edge seen
+    } else {
+        set_pin(d->pin, 1);
+    }
+}
+
+// Sampling only once configured: ODR set / continuous mode, DRDY routed
+static uint8_t device_running(uint8_t s) {
+    if (s == ACC) {
+        return (devices[ACC].regs[0x20] & 0xF0) && (devices[ACC].regs[0x22] & 0x10);
+    }
+    return (devices[MAG].regs[0x02] & 0x03) == 0;
+}
+
+// ============================================================================
+// I2C1 + DMA1 channels 6 / 7 model
+// ============================================================================
+typedef enum {
+    BUS_IDLE,
+    BUS_ADDRESS_NACK,
+    BUS_DMA_WRITE,
+    BUS_READ,
+} BusPhase;
+
+static struct {
+    BusPhase phase;
+    uint64_t done_ns;
+    Device *dev;
+    uint8_t nbytes;
+    uint8_t autoend;
+    uint8_t nack_next;                  // Fault injection
+    uint8_t berr_next;
+    uint32_t polled_write[4];           // Bytes of a polled write so far
+    uint8_t polled_len;
+    uint8_t polled_left;
+    uint32_t bytes;                     // Moved over the bus, all transfers
+} bus;
+
+static void isr_set(uint32_t flags) {
+    REG(I2C + 0x18) |= flags;
+}
+
+static uint64_t bus_ns(uint32_t bytes) {
+    return (uint64_t)bytes * 9 * BUS_NS_PER_BIT;
+}
+
+static void bus_end(uint32_t flags) {
+    bus.phase = BUS_IDLE;
+    REG(I2C + 0x18) &= ~I2C_ISR_BUSY;
+    isr_set(flags);
+}
+
+static void bus_start(void) {
+    uint32_t cr1 = REG(I2C + 0x00);
+    uint32_t cr2 = REG(I2C + 0x04);
+
+    REG(I2C + 0x04) = cr2 & ~I2C_CR2_START;                     // Cleared by hardware
+    REG(I2C + 0x18) &= ~(I2C_ISR_TC | I2C_ISR_TXIS);
+    isr_set(I2C_ISR_BUSY);
+
+    if (!(cr1 & I2C_CR1_PE) || REG(I2C + 0x10) != I2C_TIMING_400KHZ) {
+        fail("START with the peripheral off or the timing not set");
+    }
+    bus.dev = device_at((uint8_t)((cr2 >> I2C_CR2_SADD_Pos) & 0x7F));
+    bus.nbytes = (uint8_t)(cr2 >> I2C_CR2_NBYTES_Pos);
+    bus.autoend = (cr2 & I2C_CR2_AUTOEND) != 0;
+
+    if (!bus.dev || bus.nack_next) {
+        bus.nack_next = 0;
+        bus.phase = BUS_ADDRESS_NACK;
+        bus.done_ns = now_ns + bus_ns(1);
+    } else if (cr2 & I2C_CR2_RD_WRN) {
+        bus.phase = BUS_READ;
+        bus.done_ns = now_ns + bus_ns(1u + bus.nbytes);
+    } else if (cr1 & I2C_CR1_TXDMAEN) {
+        bus.phase = BUS_DMA_WRITE;
+        bus.done_ns = now_ns + bus_ns(1u + bus.nbytes);
+    } else {
+        // Polled (setup) write: the driver's loop has no time, so its
+        // bytes go as fast as it feeds TXDR
+        bus.phase = BUS_IDLE;
+        bus.polled_len = 0;
+        bus.polled_left = bus.nbytes;
+        isr_set(I2C_ISR_TXIS);
+    }
+}
+
+static void bus_polled_byte(void) {
+    uint32_t txdr = REG(I2C + 0x28);
+
+    REG(I2C + 0x18) &= ~I2C_ISR_TXIS;
+    if (!bus.dev || !bus.polled_left) {
+        fail("TXDR written outside a write");
+        return;
+    }
+    if (bus.polled_len < 4) {
+        bus.polled_write[bus.polled_len++] = txdr;
+    }
+    bus.bytes++;
+    if (--bus.polled_left) {
+        isr_set(I2C_ISR_TXIS);
+        return;
+    }
+    uint8_t bytes[4] = { 0 };
+    for (uint8_t i = 0; i < bus.polled_len; i++) {
+        bytes[i] = (uint8_t)bus.polled_write[i];
+    }
+    device_write(bus.dev, bytes, bus.polled_len);
+    bus_end(bus.autoend ? I2C_ISR_STOPF : I2C_ISR_TC);
+}
+
+// A DMA channel serving I2C1: enabled, pointed at the right register,
+// enough bytes left; 0 = not set up for this transfer
+static uint8_t *dma_buffer(uint8_t ch, uint32_t periph, uint8_t n) {
+    if (!(REG(CCR_ADDR(ch)) & DMA_CCR_EN) || REG(DMA1_BASE + 0x10 + 20 * (ch - 1)) != periph ||
+        REG(CNDTR_ADDR(ch)) < n) {
+        return 0;
+    }
+    uint8_t *buf = host_sim_ptr(REG(CMAR_ADDR(ch)));
+    REG(CNDTR_ADDR(ch)) -= n;
+    if (REG(CNDTR_ADDR(ch)) == 0) {
+        REG(DMA1_BASE + 0x00) |= DMA_ISR_TCIF(ch) | (1u << (4 * (ch - 1)));    // TCIF + GIF
+    }
+    return buf;
+}
+
+static void bus_complete(void) {
+    uint32_t cr1 = REG(I2C + 0x00);
+    uint8_t *buf;
+
+    switch (bus.phase) {
+    case BUS_ADDRESS_NACK:
+        bus_end(I2C_ISR_NACKF | I2C_ISR_STOPF);                 // STOP follows a NACK
+        break;
+    case BUS_DMA_WRITE:
+        buf = (cr1 & I2C_CR1_TXDMAEN) ? dma_buffer(DMA_I2C1_TX_CH, I2C_TXDR_ADDR(I2C), bus.nbytes) : 0;
+        if (!buf) {
+            fail("burst write without its DMA channel");
+            bus_end(I2C_ISR_STOPF);
+            break;
+        }
+        device_write(bus.dev, buf, bus.nbytes);
+        bus.bytes += 1u + bus.nbytes;
+        bus_end(bus.autoend ? I2C_ISR_STOPF : I2C_ISR_TC);
+        if (!bus.autoend) {
+            isr_set(I2C_ISR_BUSY);      // Holds the bus for the repeated start
+        }
+        break;
+    case BUS_READ:
+        if (bus.berr_next) {
+            bus.berr_next = 0;
+            bus_end(I2C_ISR_BERR);
+            break;
+        }
+        buf = (cr1 & I2C_CR1_RXDMAEN) ? dma_buffer(DMA_I2C1_RX_CH, I2C_RXDR_ADDR(I2C), bus.nbytes) : 0;
+        if (!buf) {
+            fail("burst read without its DMA channel");
+            bus_end(I2C_ISR_STOPF);
+            break;
+        }
+        device_read(bus.dev, buf, bus.nbytes);
+        bus.bytes += 1u + bus.nbytes;
+        bus_end(bus.autoend ? I2C_ISR_STOPF : I2C_ISR_TC);
+        break;
+    case BUS_IDLE:
+        break;
+    }
+}
+
+// Register write side effects. A hook also runs after reads, so each
+// case must be harmless then: write-1 registers are zeroed once acted on
+static uint32_t irq_enabled[2];
+
+static void model_hook(uint32_t addr) {
+    if (addr == I2C + 0x04) {                                   // CR2
+        if (REG(addr) & I2C_CR2_START) {
+            if (bus.phase != BUS_IDLE) {
+                fail("START while a transfer runs");
+            }
+            bus_start();
+        }
+    } else if (addr == I2C + 0x28) {                            // TXDR
+        bus_polled_byte();
+    } else if (addr == I2C + 0x1C) {                            // ICR
+        REG(I2C + 0x18) &= ~REG(addr);
+        REG(addr) = 0;
+    } else if (addr == I2C + 0x00) {                            // CR1
+        if (!(REG(addr) & I2C_CR1_PE)) {
+            bus.phase = BUS_IDLE;                               // PE = 0 resets the state
+            REG(I2C + 0x18) = 0;
+        }
+        if (REG(addr) & ((1u << 1) | (1u << 2))) {
+            fail("RXIE / TXIE: an interrupt per byte");
+        }
+    } else if (addr == DMA1_BASE + 0x04) {                      // IFCR
+        REG(DMA1_BASE + 0x00) &= ~REG(addr);
+        REG(addr) = 0;
+    } else if (addr == EXTI_BASE + 0x14) {                      // PR: write 1 to clear
+        if (!(REG(addr) & PR_MODEL)) {
+            exti_pending &= ~REG(addr);
+        }
+        REG(addr) = exti_pending | PR_MODEL;
+    } else if (addr == EXTI_BASE + 0x10) {                      // SWIER
+        exti_pending |= REG(addr) & REG(EXTI_BASE + 0x00);
+        REG(addr) = 0;
+        REG(EXTI_BASE + 0x14) = exti_pending | PR_MODEL;
+    } else if (addr == 0xE000E100 || addr == 0xE000E104) {      // ISER
+        irq_enabled[(addr >> 2) & 1] |= REG(addr);
+    }
+}
+
+// ============================================================================
+// Interrupts: levels, lowest number first (all on IRQ_PRIO_SENSOR)
+// ============================================================================
+void EXTI2_TSC_IRQHandler(void);
+void EXTI4_IRQHandler(void);
+void DMA1_Channel7_IRQHandler(void);
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+
+static struct {
+    uint32_t exti;
+    uint32_t i2c_ev;
+    uint32_t i2c_er;
+    uint32_t dma;
+} entries;
+
+static uint8_t enabled(uint8_t irq) {
+    return (irq_enabled[irq >> 5] >> (irq & 31)) & 1;
+}
+
+static uint8_t take_interrupt(void) {
+    uint32_t pending = exti_pending & REG(EXTI_BASE + 0x00);
+    uint32_t isr = REG(I2C + 0x18);
+    uint32_t cr1 = REG(I2C + 0x00);
+    uint32_t ev = ((cr1 & I2C_CR1_TCIE) ? I2C_ISR_TC : 0) | ((cr1 & I2C_CR1_NACKIE) ? I2C_ISR_NACKF : 0);
+    uint32_t dma_ie = REG(CCR_ADDR(DMA_I2C1_RX_CH));
+    uint32_t dma = ((dma_ie & DMA_CCR_TCIE) ? DMA_ISR_TCIF(DMA_I2C1_RX_CH) : 0) |
+                   ((dma_ie & DMA_CCR_TEIE) ? DMA_ISR_TEIF(DMA_I2C1_RX_CH) : 0);
+
+    if ((pending & (1u << 2)) && enabled(EXTI2_TSC_IRQn)) {
+        entries.exti++;
+        EXTI2_TSC_IRQHandler();
+    } else if ((pending & (1u << 4)) && enabled(EXTI4_IRQn)) {
+        entries.exti++;
+        EXTI4_IRQHandler();
+    } else if ((REG(DMA1_BASE + 0x00) & dma) && enabled(DMA1_Channel7_IRQn)) {
+        entries.dma++;
+        DMA1_Channel7_IRQHandler();
+    } else if ((isr & ev) && enabled(I2C1_EV_IRQn)) {
+        entries.i2c_ev++;
+        I2C1_EV_IRQHandler();
+    } else if ((isr & (I2C_ISR_BERR | I2C_ISR_ARLO)) && (cr1 & I2C_CR1_ERRIE) && enabled(I2C1_ER_IRQn)) {
+        entries.i2c_er++;
+        I2C1_ER_IRQHandler();
+    } else {
+        return 0;
+    }
+    host_sim_flush();
+    return 1;
+}
+
+static void take_interrupts(void) {
+    host_sim_flush();
+    for (uint32_t n = 0; take_interrupt(); n++) {
+        if (n == STORM_LIMIT) {
+            fail("interrupt storm: a flag is never cleared");
+            exit(1);
+        }
+    }
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+static uint32_t latency_max_ms(uint8_t k, uint32_t index) {
+    return (k == MAG && index == FAULT_LOST_EDGE_AT) ? LOST_EDGE_LATENCY_MS : SAMPLE_LATENCY_MAX_MS;
+}
+
+static uint32_t published[SENSORS];     // Samples seen through lsm303_latest()
+
+static void check_published(void) {
+    const Lsm303Sample *s = lsm303_latest();
+    uint32_t count[SENSORS] = { s->accel_count, s->mag_count };
+    const int16_t *v[SENSORS] = { s->accel, s->mag };
+    uint32_t ms[SENSORS] = { s->accel_ms, s->mag_ms };
+
+    for (uint8_t k = 0; k < SENSORS; k++) {
+        if (count[k] == published[k]) {
+            continue;
+        }
+        if (count[k] != published[k] + 1) {
+            fail("samples skipped between two looks");
+        }
+        if (count[k] > devices[k].next) {
+            fail("more samples published than the device made");
+            published[k] = count[k];
+            continue;
+        }
+        const Sample *r = &recorded[k][count[k] - 1];
+        if (memcmp(r->v, v[k], sizeof r->v) != 0) {
+            fail(k == ACC ? "accelerometer sample differs" : "magnetometer sample differs");
+        }
+        if (ms[k] - r->ms > latency_max_ms(k, count[k] - 1)) {
+            fail("sample published late");
+        }
+        published[k] = count[k];
+    }
+}
+
+// Octant from double atan2 on the same vectors; -1 = either side of an
+// edge is right, -2 = no answer
+static double deg(double n, double e) {
+    double a = atan2(e, n) * 180.0 / M_PI;
+    return a < 0 ? a + 360.0 : a;
+}
+
+static int reference_octant(const int16_t accel[3], const int16_t mag[3], int *near_edge) {
+    double g[3] = { LSM303_NORTH(accel), LSM303_EAST(accel), LSM303_UP(accel) };
+    double mz[3] = { mag[0], mag[1], mag[2] * (double)LSM303_MAG_XY_LSB_PER_GAUSS / LSM303_MAG_Z_LSB_PER_GAUSS };
+    double m[3] = { LSM303_NORTH(mz), LSM303_EAST(mz), LSM303_UP(mz) };
+    double gg = g[0] * g[0] + g[1] * g[1] + g[2] * g[2];
+    double plane = sqrt(g[0] * g[0] + g[1] * g[1]);
+    double a;
+
+    if (plane / sqrt(gg) >= COMPASS_TILT_MIN_PERMILLE / 1000.0) {
+        a = deg(-g[0], -g[1]);                                  // Downhill
+    } else {
+        double mg = (m[0] * g[0] + m[1] * g[1] + m[2] * g[2]) / gg;
+        a = deg(m[0] - mg * g[0], m[1] - mg * g[1]);            // Horizontal field
+    }
+    double sector = fmod(a + 22.5, 45.0);
+    *near_edge = sector < BOUNDARY_DEG || sector > 45.0 - BOUNDARY_DEG ||
+                 fabs(sqrt(gg) / 1000.0 - 1.0) > 0.5;
+    return (int)((a + 22.5) / 45.0) & 7;
+}
+
+static struct {
+    Pt pt;
+    uint8_t bits[LED_FRAME_BYTES(LED_COUNT)];
+    LedFrame frame;
+    uint32_t frames;
+    uint32_t edges;                     // Accepted either side
+    uint32_t per_octant[8];
+} compass;
+
+static const uint8_t ring[LED_COUNT] = LED_COMPASS_RING;
+
+static void compass_step(void) {
+    const Lsm303Sample *s = lsm303_latest();
+    int near_edge;
+
+    if (!pattern_run(&patterns[COMPASS_PATTERN], &compass.pt, &compass.frame, get_time_ms())) {
+        return;
+    }
+    if (!s->accel_count || !s->mag_count) {
+        return;
+    }
+    int want = reference_octant(s->accel, s->mag, &near_edge);
+    int got = -1;
+    for (uint8_t pos = 0; pos < LED_COUNT; pos++) {
+        if (compass.bits[0] == (1u << ring[pos])) {
+            got = pos;
+        }
+    }
+    compass.frames++;
+    if (got < 0) {
+        fail("compass frame is not one LED");
+    } else if (got != want) {
+        if (near_edge && (((got - want) & 7) == 1 || ((want - got) & 7) == 1)) {
+            compass.edges++;
+        } else {
+            char what[64];
+            snprintf(what, sizeof what, "compass lit octant %d, atan2 says %d", got, want);
+            fail(what);
+        }
+    } else {
+        compass.per_octant[got]++;
+    }
+}
+
+// Recorded lines in, lsm303_record_uart() lines out: same values, the
+// ms when published
+static void check_recording_roundtrip(void) {
+    uint32_t seen[SENSORS] = { 0, 0 };
+    char *line = uart_out;
+
+    uart_out[uart_len] = 0;
+    while (*line) {
+        unsigned ms;
+        char kind;
+        int v[3];
+        char *end = strchr(line, '\n');
+
+        if (!end || sscanf(line, "%u %c %d %d %d", &ms, &kind, &v[0], &v[1], &v[2]) != 5) {
+            fail("record line unreadable");
+            return;
+        }
+        uint8_t k = kind == 'a' ? ACC : MAG;
+        if (seen[k] == recorded_count[k]) {
+            fail("recorder printed more lines than recorded");
+            return;
+        }
+        const Sample *r = &recorded[k][seen[k]];
+        if (r->v[0] != v[0] || r->v[1] != v[1] || r->v[2] != v[2] ||
+            ms - r->ms > latency_max_ms(k, seen[k])) {
+            fail("recorded line does not replay");
+            return;
+        }
+        seen[k]++;
+        line = end + 1;
+    }
+    if (seen[ACC] != recorded_count[ACC] || seen[MAG] != recorded_count[MAG]) {
+        fail("recorder dropped lines");
+    }
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+static uint64_t sample_ns(uint8_t s) {
+    if (devices[s].next >= recorded_count[s]) {
+        return UINT64_MAX;
+    }
+    return (uint64_t)recorded[s][devices[s].next].ms * 1000000;
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "lsm303_rec.txt";
+    uint32_t accel_seen = 0, mag_seen = 0;
+    uint32_t samples;
+
+    if (!load_recording(path)) {
+        fprintf(stderr, "usage: %s [recording]\n", argv[0]);
+        return 2;
+    }
+    samples = recorded_count[ACC] + recorded_count[MAG];
+
+    host_sim_reset();
+    host_sim_add_hook(model_hook);
+    compass.frame = (LedFrame){ compass.bits, LED_COUNT, ring };
+
+    uint8_t ok = lsm303_init();
+    take_interrupts();                  // The SWIER kick: nothing ready yet
+    if (!ok) {
+        fail("lsm303_init: a device did not answer");
+    }
+    if (devices[ACC].regs[0x20] != 0x57 || devices[ACC].regs[0x22] != 0x10 ||
+        devices[ACC].regs[0x23] != 0x88) {
+        fail("accelerometer configuration (CTRL_REG1 / 3 / 4)");
+    }
+    if (devices[MAG].regs[0x00] != 0x14 || devices[MAG].regs[0x01] != 0x20 ||
+        devices[MAG].regs[0x02] != 0x00) {
+        fail("magnetometer configuration (CRA / CRB / MR)");
+    }
+    if (!device_running(ACC) || !device_running(MAG)) {
+        printf("Devices not sampling: nothing to replay\n");
+        return 1;
+    }
+    pattern_start(&compass.pt, 0);
+
+    printf("LSM303 replay: %s, %u accelerometer + %u magnetometer samples, %.1f s\n\n",
+           path, recorded_count[ACC], recorded_count[MAG],
+           recorded[ACC][recorded_count[ACC] - 1].ms / 1000.0);
+
+    uint64_t end_ns = (uint64_t)(recorded[ACC][recorded_count[ACC] - 1].ms + REPLAY_TAIL_MS) * 1000000;
+    for (;;) {
+        uint64_t next = sample_ns(ACC) < sample_ns(MAG) ? sample_ns(ACC) : sample_ns(MAG);
+        uint64_t tick = (now_ns / 1000000 + 1) * 1000000;
+
+        if (bus.phase != BUS_IDLE && bus.done_ns < next) {
+            next = bus.done_ns;
+        }
+        if (tick < next) {
+            next = tick;                // The engine and the recorder run per ms
+        }
+        if (next == tick && sample_ns(ACC) == UINT64_MAX && sample_ns(MAG) == UINT64_MAX &&
+            (bus.phase == BUS_IDLE || next > end_ns)) {
+            break;                      // Replay over, the bus quiet (or never)
+        }
+        now_ns = next;
+
+        if (bus.phase != BUS_IDLE && bus.done_ns == now_ns) {
+            bus_complete();
+        }
+        for (uint8_t s = 0; s < SENSORS; s++) {
+            if (sample_ns(s) == now_ns) {
+                uint32_t index = devices[s].next;
+                if (s == ACC && index == FAULT_NACK_AT) {
+                    bus.nack_next = 1;
+                }
+                if (s == ACC && index == FAULT_BERR_AT) {
+                    bus.berr_next = 1;
+                }
+                device_sample(s, s == MAG && index == FAULT_LOST_EDGE_AT);
+            }
+        }
+        take_interrupts();
+        check_published();
+        if (now_ns % 1000000 == 0) {
+            compass_step();
+            lsm303_record_uart(&accel_seen, &mag_seen);
+        }
+    }
+    lsm303_record_uart(&accel_seen, &mag_seen);
+    check_recording_roundtrip();
+
+    const I2cStats *i2c = i2c_stats();
+    const Lsm303Stats *st = lsm303_stats();
+    uint32_t cpu = entries.exti + entries.i2c_ev + entries.i2c_er + entries.dma;
+
+    printf("Published     accelerometer %u / %u, magnetometer %u / %u, overruns %u / %u\n",
+           published[ACC], recorded_count[ACC], published[MAG], recorded_count[MAG],
+           devices[ACC].overruns, devices[MAG].overruns);
+    printf("Bus           %u bursts, %u bytes, %u NACK, %u bus error, %u failed reads, "
+           "%u missed edge\n",
+           i2c->bursts, bus.bytes, i2c->nacks, i2c->bus_errors, st->failed, st->missed_edges);
+    printf("CPU entries   EXTI %u, I2C event %u, I2C error %u, DMA %u: %.2f per sample\n",
+           entries.exti, entries.i2c_ev, entries.i2c_er, entries.dma, (double)cpu / samples);
+    printf("Compass       %u frames checked, %u on a sector edge, per octant:",
+           compass.frames, compass.edges);
+    for (uint8_t o = 0; o < 8; o++) {
+        printf(" %u", compass.per_octant[o]);
+    }
+    printf("\n\n");
+
+    if (published[ACC] != recorded_count[ACC] || published[MAG] != recorded_count[MAG] ||
+        devices[ACC].overruns || devices[MAG].overruns) {
+        fail("samples lost");
+    }
+    if (i2c->nacks != 1 || i2c->bus_errors != 1 || st->failed != 2 || st->missed_edges != 1) {
+        fail("injected faults not seen exactly once each");
+    }
+    // Per burst: its EXTI, the TC that turns the bus round, the DMA
+    // completion. Besides: the init kick (two EXTI), the lost edge (none),
+    // the NACK (an event, no TC), the bus error (TC, then the error)
+    if (i2c->bursts != samples || entries.dma != samples || entries.i2c_er != 1 ||
+        entries.i2c_ev != samples + 2 || entries.exti != samples - 1 + 2) {
+        fail("CPU entries per burst");
+    }
+
+    printf("%s\n", errors ? "FAILED" : "All samples delivered, compass as expected");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,601 @@
+/**
+ ******************************************************************************
+ * @file           : main.c
+ * @brief          : Non-blocking LED pattern controller - STM32F303 Discovery
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ * Day3_Final_7_Patterns.c without a single blocking delay:
+ *   - 72 MHz core, 1 ms SysTick (clock_config / systick)
+ *   - Button sampled every tick and debounced (button.c), gestures
+ *     classified by gesture.c
+ *   - Patterns step on their own period and never wait
+ *   - The LED engine (gestures, pattern switch, steps, output) runs in
+ *     SysTick, right after the button sample. The rest runs
+ *     as kernel tasks (kernel.h): settings above the console, so even a
+ *     long UART dump never delays a response or a settings write. Each
+ *     response is timed from the gesture's first edge and from its
+ *     classification, budget < 1 ms for the latter (latency.h).
+ *
+ * Button:
+ *   Single press  -> next pattern
+ *   Double press  -> previous pattern
+ *   Triple press  -> back to pattern 0
+ *   Long press    -> pause / resume
+ *
+ * Debug console on USART1 (115200 8N1, PC4/PC5):
+ *   r / a / e     dump RCC / GPIOA / GPIOE, d = diff-only on/off (regdump.h)
+ *   p             dump the profiler trace (profiler.h)
+ *   l             worst-case edge / classification -> output latency (latency.h)
+ *   k             context-switch benchmark and task stacks (kernel.h)
+ *   m             record the LSM303 for LSM303_RECORD_MS (lsm303.h)
+ *   g             gyro: mean rate over GYRO_WATCH_MS, driver stats (l3gd20.h)
+ *   f             filter kernels: cycles per sample (dsp.h)
+ *   c             CAN: frames received, per-filter counts (can.h)
+ *
+ * The current pattern survives a power cycle: the settings task hands it to
+ * the settings log (kvstore.h), which writes it once it stops changing.
+ *
+ * A pattern switch never goes dark or waits: on the on-board LEDs the old
+ * and new pattern run side by side for TRANSITION_MS while the output
+ * crossfades (LED_PWM) or is handed over LED by LED around the ring
+ * (transition.h). Panel and strip outputs cut straight to the new pattern.
+ *
+ * Pattern 8 splits the ring into zones (zone.h), each running its own
+ * pattern; the engine still shows one composed frame per step. Pattern 9
+ * plays a compressed animation stored in Flash (anim.h). Pattern 10 is
+ * a tilt / compass needle driven by the LSM303 (lsm303.h, compass.h).
+ *
+ * With LED_PWM (board.h) the on-board LEDs are dimmed in software, and
+ * patterns with a brightness version (e.g. breathing) are drawn as a
+ * smooth gamma-corrected curve every SHADE_PERIOD_MS instead of stepping.
+ *
+ * With PANEL_WIDTH set in board.h the same patterns drive a 74HC595
+ * panel of that many outputs instead (hc595.h); with STRIP_PIXELS, a
+ * WS2812 RGB strip (ws2812.h). Their latency is measured up to the
+ * driver hand-off: the panel latches it on a following tick, the strip
+ * after its DMA transfer.
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include "stm32f303_regs.h"
+#include "board.h"
+#include "clock_config.h"
+#include "systick.h"
+#include "button.h"
+#include "gesture.h"
+#include "patterns.h"
+#include "profiler.h"
+#include "leds_gpio.h"
+#include "led_frame.h"
+#include "hc595.h"
+#include "ws2812.h"
+#include "uart.h"
+#include "regdump.h"
+#include "led_pwm.h"
+#include "transition.h"
+#include "latency.h"
+#include "timer.h"
+#include "kernel.h"
+#include "kvstore.h"
+#include "flash.h"
+#include "lsm303.h"
+#include "l3gd20.h"
+#include "dsp.h"
+#include "can.h"
+#include "fmt.h"
+
+// Global Variables
+volatile uint8_t current_pattern = 0;  // Current pattern (0-10), set by the engine
+uint8_t paused = 0;
+
+// Settings log keys (kvstore.h)
+#define SETTING_PATTERN     0
+
+static Pt pattern_pt;                  // Current pattern's instance: next step / resume point
+
+// Input response on its way to the output (latency.h)
+static uint8_t response_pending = 0;
+static uint32_t response_start;        // DWT count at entry of the ISR that classified it
+static uint32_t response_edge;         // Its gesture's first edge (ms)
+
+static GestureRecognizer button_gestures;
+
+static const GestureConfig button_config = {
+    .multi_window_ms = 300,
+    .long_press_ms   = 1000,
+    .repeat_ms       = 0,              // Not used here
+};
+
+// On-board LEDs: one-byte frame, compass ring for the spin patterns
+static uint8_t led_bits[LED_FRAME_BYTES(LED_COUNT)];
+static const uint8_t led_ring[LED_COUNT] = LED_COMPASS_RING;
+static LedFrame led_frame = { led_bits, LED_COUNT, led_ring };
+
+#define ONBOARD_LEDS        (PANEL_WIDTH == 0 && STRIP_PIXELS == 0)
+#define ONBOARD_PWM         (LED_PWM && ONBOARD_LEDS)
+#define SHADE_PERIOD_MS     10
+#define TRANSITION_MS       400
+
+#if ONBOARD_PWM
+static uint8_t led_level[LED_COUNT];
+static LedLevels led_levels = { led_level, LED_COUNT, led_ring };
+static uint8_t levels_dirty = 0;       // led_level not yet taken by led_pwm
+#endif
+
+// Pattern switch (on-board LEDs only; stays inactive on panel/strip)
+static Transition transition;
+
+#if ONBOARD_LEDS
+// Outgoing pattern's frame - the incoming one steps into led_frame
+static uint8_t tr_from_bits[LED_FRAME_BYTES(LED_COUNT)];
+#if ONBOARD_PWM
+#define TRANSITION_KIND     TRANSITION_CROSSFADE
+static uint8_t tr_from_level[LED_COUNT];
+static uint8_t tr_to_level[LED_COUNT];
+#else
+#define TRANSITION_KIND     TRANSITION_WIPE
+static uint8_t tr_out_bits[LED_FRAME_BYTES(LED_COUNT)];
+static LedFrame tr_out_frame = { tr_out_bits, LED_COUNT, led_ring };
+#endif
+#endif
+
+#if PANEL_WIDTH > 0
+static uint8_t panel_bits[2][LED_FRAME_BYTES(PANEL_WIDTH)];
+#elif STRIP_PIXELS > 0
+static uint8_t strip_bits[LED_FRAME_BYTES(STRIP_PIXELS)];
+static LedFrame strip_frame = { strip_bits, STRIP_PIXELS, 0 };
+static uint8_t strip_grb[STRIP_PIXELS * 3];
+#endif
+
+// ============================================================================
+// A pending input response has reached the output
+// ============================================================================
+static void response_done(void) {
+    if (response_pending) {
+        response_pending = 0;
+        latency_record(response_start, response_edge);
+    }
+}
+
+// ============================================================================
+// Show a whole frame with one atomic BSRR write
+// ============================================================================
+static void leds_write(uint8_t frame) {
+#if ONBOARD_PWM
+    for (uint8_t i = 0; i < LED_COUNT; i++) {
+        led_level[i] = ((frame >> i) & 1) ? 255 : 0;
+    }
+    levels_dirty = 1;                   // Soft PWM owns the port now
+#else
+    GPIOE_BSRR = LED_FRAME_BSRR(frame);
+    response_done();
+#endif
+}
+
+// ============================================================================
+// Brightness output (soft PWM): shade the current pattern, hand levels over
+// ============================================================================
+static uint8_t pattern_shaded(void) {
+#if ONBOARD_PWM
+    return patterns[current_pattern].shade != 0;
+#else
+    return 0;
+#endif
+}
+
+static void leds_shade(uint32_t now) {
+#if ONBOARD_PWM
+    static uint32_t next_shade = 0;
+
+    if (!paused && pattern_shaded() && !transition_active(&transition) &&
+        (response_pending || (int32_t)(now - next_shade) >= 0)) {
+        patterns[current_pattern].shade(&led_levels, now);
+        levels_dirty = 1;
+        next_shade = now + SHADE_PERIOD_MS;
+    }
+    if (levels_dirty && response_pending) {
+        led_pwm_show_now(led_level);    // Input response: don't wait for the frame end
+        levels_dirty = 0;
+        response_done();
+    } else if (levels_dirty && led_pwm_show(led_level)) {
+        levels_dirty = 0;               // Shown from the next PWM frame
+    }
+#else
+    (void)now;
+#endif
+}
+
+// ============================================================================
+// Step the current pattern into the active output (it is due)
+// If the output is still busy nothing is stepped: retried next tick
+// ============================================================================
+static void pattern_step(uint32_t now) {
+    const Pattern *p = &patterns[current_pattern];
+#if PANEL_WIDTH > 0
+    LedFrame panel;
+
+    if (!hc595_ready()) {
+        return;                             // Previous frame not swapped yet
+    }
+    hc595_frame(&panel);
+    pattern_run(p, &pattern_pt, &panel, now);
+    hc595_commit();                         // Shown on the tick after next
+    response_done();
+#elif STRIP_PIXELS > 0
+    if (ws2812_busy()) {
+        return;                             // Previous frame still going out
+    }
+    pattern_run(p, &pattern_pt, &strip_frame, now);
+    ws2812_from_frame(strip_grb, &strip_frame, STRIP_COLOR);
+    ws2812_show(strip_grb, STRIP_PIXELS);   // DMA + HT/TC refills from here
+    response_done();
+#else
+    pattern_run(p, &pattern_pt, &led_frame, now);
+    leds_write(led_bits[0]);
+#endif
+}
+
+// ============================================================================
+// Pattern switch: start a transition from what is showing now
+// ============================================================================
+static void transitions_init(void) {
+#if ONBOARD_PWM
+    transition_init(&transition,
+                    (LedFrame){ tr_from_bits, LED_COUNT, led_ring }, led_frame,
+                    (LedLevels){ tr_from_level, LED_COUNT, led_ring },
+                    (LedLevels){ tr_to_level, LED_COUNT, led_ring });
+#elif ONBOARD_LEDS
+    transition_init(&transition,
+                    (LedFrame){ tr_from_bits, LED_COUNT, led_ring }, led_frame,
+                    (LedLevels){ 0, 0, 0 }, (LedLevels){ 0, 0, 0 });
+#endif
+}
+
+static void pattern_switch(uint8_t next, uint32_t now) {
+    uint8_t prev = current_pattern;
+
+    current_pattern = next;
+#if ONBOARD_LEDS
+    if (!paused && next != prev) {
+        // Mid-transition the incoming pattern becomes the outgoing one
+        uint8_t mid = transition_active(&transition);
+        const uint8_t *shown_levels = 0;
+#if ONBOARD_PWM
+        shown_levels = mid ? tr_to_level : led_level;
+#endif
+        transition_start(&transition, &led_frame, shown_levels,
+                         &patterns[prev], mid ? transition_incoming(&transition) : &pattern_pt,
+                         &patterns[next], TRANSITION_KIND, TRANSITION_MS, now);
+        return;
+    }
+#else
+    (void)prev;
+#endif
+    pattern_start(&pattern_pt, now);
+}
+
+// Advance a running transition; returns 0 if none is running
+static uint8_t transition_show(uint32_t now) {
+#if ONBOARD_LEDS
+    if (!transition_active(&transition)) {
+        return 0;
+    }
+#if ONBOARD_PWM
+    transition_update(&transition, now, 0, &led_levels);
+    levels_dirty = 1;
+#else
+    transition_update(&transition, now, &tr_out_frame, 0);
+    leds_write(tr_out_bits[0]);
+#endif
+    return 1;
+#else
+    (void)now;
+    return 0;
+#endif
+}
+
+// ============================================================================
+// LED engine: gestures -> pattern switch -> steps -> output
+// Runs from SysTick every tick, after the button hook, so a debounced
+// edge is classified in the tick that produced it. It preempts the
+// tasks - input takes effect at once whatever the frame period or the
+// console is doing.
+// ============================================================================
+static void led_engine(uint32_t now, uint32_t entry_cycles) {
+    GestureEvent event;
+
+    PROF_ENTER(PROF_LED_ENGINE);
+
+    // Handle button gestures
+    PROF_ENTER(PROF_GESTURES);
+    while ((event = gesture_update(&button_gestures, now)) != GESTURE_NONE) {
+        switch (event) {
+            case GESTURE_SINGLE:
+                pattern_switch((current_pattern + 1) % PATTERN_COUNT, now);
+                break;
+
+            case GESTURE_DOUBLE:
+                pattern_switch((current_pattern + PATTERN_COUNT - 1) % PATTERN_COUNT, now);
+                break;
+
+            case GESTURE_TRIPLE:
+                pattern_switch(0, now);
+                break;
+
+            case GESTURE_LONG:
+                paused = !paused;
+                pattern_pt.wake_ms = now;
+                break;
+
+            default:
+                continue;
+        }
+        response_pending = 1;
+        response_start = entry_cycles;
+        response_edge = button_gestures.first_edge_time;
+    }
+    PROF_EXIT(PROF_GESTURES);
+
+    // Execute current pattern when its step is due; a transition steps
+    // both patterns itself and hands the incoming one back when done
+    if (transition_show(now)) {
+        if (!transition_active(&transition)) {
+            pattern_pt = *transition_incoming(&transition);
+        }
+    } else if (!paused && !pattern_shaded() && pt_due(&pattern_pt, now)) {
+        PROF_ENTER(PROF_PATTERN_STEP);
+        pattern_step(now);
+        PROF_EXIT(PROF_PATTERN_STEP);
+    }
+    leds_shade(now);
+
+    if (paused) {
+        response_done();                // Pausing shows nothing new
+    }
+    PROF_EXIT(PROF_LED_ENGINE);
+}
+
+static void led_engine_tick(uint32_t now) {
+    led_engine(now, systick_tick_cycles());
+}
+
+// ============================================================================
+// Tasks (kernel.h): what used to be the main loop, by urgency
+// ============================================================================
+#define SETTINGS_PRIO       1
+#define CONSOLE_PRIO        2
+#define SETTINGS_POLL_MS    10
+#define CONSOLE_POLL_MS     10
+
+static Task settings_task;
+static Task console_task;
+static uint32_t settings_stack[256] __attribute__((aligned(8)));
+static uint32_t console_stack[512] __attribute__((aligned(8)));
+
+// Settings: kv_set() only touches RAM, kv_poll() decides when to write
+// (at most one Flash operation per pass)
+static void settings_run(void *arg) {
+    uint8_t saved_pattern = current_pattern;
+
+    (void)arg;
+    for (;;) {
+        uint8_t pattern = current_pattern;
+        if (pattern != saved_pattern) {
+            kv_set(SETTING_PATTERN, &pattern, 1, get_time_ms());
+            saved_pattern = pattern;
+        }
+        kv_poll(get_time_ms());
+        kernel_sleep(SETTINGS_POLL_MS);
+    }
+}
+
+// Prints samples as they come; the sensor ISRs keep reading meanwhile.
+// Polled well inside the 10 ms accelerometer period so none is skipped.
+#define RECORD_POLL_MS      2
+
+static void lsm303_record(void) {
+    uint32_t accel_seen = lsm303_latest()->accel_count;
+    uint32_t mag_seen = lsm303_latest()->mag_count;
+    uint32_t start = get_time_ms();
+
+    while (get_time_ms() - start < LSM303_RECORD_MS) {
+        lsm303_record_uart(&accel_seen, &mag_seen);
+        kernel_sleep(RECORD_POLL_MS);
+    }
+}
+
+#if GYRO_ENABLED
+// Takes the decimated stream for a while, as an application would, and
+// prints its mean (mdps) and what was dropped meanwhile
+#define GYRO_WATCH_MS       1000
+
+static char *put_signed(char *p, int32_t v) {
+    *p++ = ' ';
+    if (v < 0) {
+        *p++ = '-';
+        v = -v;
+    }
+    return p + fmt_dec(p, (uint32_t)v);
+}
+
+static void gyro_watch(void) {
+    GyroSample g;
+    int32_t sum[3] = { 0, 0, 0 };
+    uint32_t n = 0;
+
+    while (l3gd20_read(&g)) {                   // Backlog from before
+    }
+    uint32_t dropped = l3gd20_stats()->dropped;
+    uint32_t start = get_time_ms();
+    while (get_time_ms() - start < GYRO_WATCH_MS) {
+        while (l3gd20_read(&g)) {
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                sum[axis] += g.rate[axis];
+            }
+            n++;
+        }
+        kernel_sleep(CONSOLE_POLL_MS);
+    }
+
+    char line[96];
+    char *p = line;
+    p += fmt_str(p, "gyro mean (mdps):", 0);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        int32_t mean = n ? sum[axis] / (int32_t)n : 0;
+        p = put_signed(p, mean * (L3GD20_UDPS_PER_LSB / 100) / 10);
+    }
+    p += fmt_str(p, " over ", 0);
+    p += fmt_dec(p, n);
+    p += fmt_str(p, " samples, ", 0);
+    p += fmt_dec(p, l3gd20_stats()->dropped - dropped);
+    p += fmt_str(p, " dropped\r\n", 0);
+    uart_write(line, (uint32_t)(p - line));
+    l3gd20_dump_uart();
+}
+#endif
+
+// CAN traffic the application takes; everything else stops in the filter
+// banks. J1939 (29-bit) on FIFO 1, so a burst there never delays the rest.
+static const CanFilter can_filters[] = {
+    { 0x0C0, 0x7F0, 0, 0 },                     // 0x0C0-0x0CF
+    { 0x244, CAN_STD_EXACT, 0, 0 },
+    { 0x245, CAN_STD_EXACT, 0, 0 },
+    { 0x18FEF100, CAN_EXT_EXACT, 1, 1 },        // CCVS from the engine (SA 0)
+    { 0x0CF00400, 0x1FFFFF00, 1, 1 },           // EEC1, any source address
+};
+
+static void can_frame_uart(const CanFrame *f) {
+    char line[64];
+    char *p = line;
+
+    p += fmt_str(p, "can rx ", 0);
+    p += fmt_hex(p, f->id, f->ext ? 8 : 3);
+    p += fmt_str(p, " [", 0);
+    p += fmt_dec(p, f->dlc);
+    p += fmt_str(p, "]", 0);
+    for (uint8_t i = 0; i < f->dlc && i < 8; i++) {
+        *p++ = ' ';
+        p += fmt_hex(p, f->data[i], 2);
+    }
+    p += fmt_str(p, ", filter ", 0);
+    p += fmt_dec(p, f->filter);
+    p += fmt_str(p, "\r\n", 0);
+    uart_write(line, (uint32_t)(p - line));
+}
+
+// In loopback, sends frames on both sides of every filter first: only
+// the matching ones come back. Then prints what is in the ring.
+static void can_watch(void) {
+#if CAN_LOOPBACK
+    static const CanFrame probes[] = {
+        { .id = 0x0C5, .dlc = 2, .data = { 0x0C, 0x05 } },     // Filter 0
+        { .id = 0x0D0, .dlc = 0 },                              // Outside the range
+        { .id = 0x244, .dlc = 8, .data = { 1, 2, 3, 4, 5, 6, 7, 8 } },
+        { .id = 0x244, .rtr = 1 },                              // Remote frame
+        { .id = 0x246, .dlc = 1 },
+        { .id = 0x0C5, .ext = 1, .dlc = 1 },                    // 29-bit, same number
+        { .id = 0x18FEF100, .ext = 1, .dlc = 8 },               // Filter 3
+        { .id = 0x18FEF117, .ext = 1, .dlc = 8 },               // Other source
+        { .id = 0x0CF00417, .ext = 1, .dlc = 8 },               // Filter 4
+    };
+
+    for (uint8_t i = 0; i < sizeof(probes) / sizeof(probes[0]); i++) {
+        while (!can_send(&probes[i])) {
+            kernel_sleep(1);
+        }
+    }
+    kernel_sleep(CONSOLE_POLL_MS);
+#endif
+
+    const CanFrame *f;
+    while ((f = can_rx_peek()) != 0) {
+        can_frame_uart(f);
+        can_rx_release();
+    }
+    can_dump_uart();
+}
+
+// Debug console (polled). A dump blocks on the UART, but only this task
+// waits for it: the engine and the settings task preempt it.
+static void console_run(void *arg) {
+    (void)arg;
+    for (;;) {
+        int c = uart_getc();
+        if (c < 0) {
+            kernel_sleep(CONSOLE_POLL_MS);
+            continue;
+        }
+
+        PROF_ENTER(PROF_MAIN_LOOP);
+        if (c == 'p') {
+            prof_dump_uart();
+        } else if (c == 'l') {
+            latency_dump_uart();
+        } else if (c == 'k') {
+            kernel_bench_uart();
+        } else if (c == 'm') {
+            lsm303_record();
+        } else if (c == 'f') {
+            dsp_bench_uart();
+        } else if (c == 'c') {
+            can_watch();
+#if GYRO_ENABLED
+        } else if (c == 'g') {
+            gyro_watch();
+#endif
+        } else {
+            regdump_command((char)c);
+        }
+        PROF_EXIT(PROF_MAIN_LOOP);
+    }
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(void)
+{
+    clock_init();
+    systick_init();
+    prof_init();
+    uart_init(115200);
+    leds_gpio_init();                   // PE8-PE15: one write per register (gpio.hpp)
+    lsm303_init();                      // Samples from here on, by interrupt + DMA
+#if GYRO_ENABLED
+    l3gd20_init();
+#endif
+
+    uint8_t saved_pattern;
+    flash_on_stall(latency_stall);      // Erases stall every ISR: count them
+    kv_init();
+    if (kv_get(SETTING_PATTERN, &saved_pattern, 1) == 1 && saved_pattern < PATTERN_COUNT) {
+        current_pattern = saved_pattern;
+    }
+#if ONBOARD_PWM
+    led_pwm_init();
+#endif
+#if PANEL_WIDTH > 0
+    hc595_init(panel_bits[0], panel_bits[1], PANEL_WIDTH);
+#elif STRIP_PIXELS > 0
+    ws2812_init();
+#endif
+
+    transitions_init();
+    gesture_init(&button_gestures, &button_config);
+    button_init(&button_gestures);
+
+    timer_service_init();               // Software timers tick before the engine
+    can_init(can_filters, sizeof(can_filters) / sizeof(can_filters[0]),
+             CAN_LOOPBACK ? CAN_MODE_SILENT_LOOPBACK : CAN_MODE_NORMAL);
+    pattern_start(&pattern_pt, get_time_ms());
+    systick_add_hook(led_engine_tick);   // After the button's hook
+
+    kernel_init();
+    task_create(&settings_task, "settings", SETTINGS_PRIO, settings_run, 0,
+                settings_stack, TASK_STACK_WORDS(settings_stack));
+    task_create(&console_task, "console", CONSOLE_PRIO, console_run, 0,
+                console_stack, TASK_STACK_WORDS(console_stack));
+    kernel_start();
+}
@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ * @file           : morse.c
+ * @brief          : Non-blocking Morse code beacon for any ASCII string
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 21, 2026
+ ******************************************************************************
+ */
+
+#include "morse.h"
+#include "stm32f303_regs.h"
+
+// ============================================================================
+// Packed code table: one byte per character, ASCII 0x20 (' ') to 0x5F ('_')
+//
+// Symbols are read LSB first, 0 = dot, 1 = dash. The highest set bit is an
+// end marker, so the length needs no extra field:
+//   'A' = .-   -> bits 0,1 = 0,1, marker at bit 2 -> 0b110 = 0x06
+// 0x00 = character not supported (skipped).
+// ============================================================================
+static const uint8_t morse_table[64] = {
+    0x00, 0x75, 0x52, 0x00,  // ' '          '!' -.-.--   '"' .-..-.   '#'
+    0xC8, 0x00, 0x22, 0x5E,  // '$' ...-..-  '%'          '&' .-...    ''' .----.
+    0x2D, 0x6D, 0x00, 0x2A,  // '(' -.--.    ')' -.--.-   '*'          '+' .-.-.
+    0x73, 0x61, 0x6A, 0x29,  // ',' --..--   '-' -....-   '.' .-.-.-   '/' -..-.
+    0x3F, 0x3E, 0x3C, 0x38,  // '0' -----    '1' .----    '2' ..---    '3' ...--
+    0x30, 0x20, 0x21, 0x23,  // '4' ....-    '5' .....    '6' -....    '7' --...
+    0x27, 0x2F, 0x47, 0x55,  // '8' ---..    '9' ----.    ':' ---...   ';' -.-.-.
+    0x00, 0x31, 0x00, 0x4C,  // '<'          '=' -...-    '>'          '?' ..--..
+    0x56, 0x06, 0x11, 0x15,  // '@' .--.-.   'A' .-       'B' -...     'C' -.-.
+    0x09, 0x02, 0x14, 0x0B,  // 'D' -..      'E' .        'F' ..-.     'G' --.
+    0x10, 0x04, 0x1E, 0x0D,  // 'H' ....     'I' ..       'J' .---     'K' -.-
+    0x12, 0x07, 0x05, 0x0F,  // 'L' .-..     'M' --       'N' -.       'O' ---
+    0x16, 0x1B, 0x0A, 0x08,  // 'P' .--.     'Q' --.-     'R' .-.      'S' ...
+    0x03, 0x0C, 0x18, 0x0E,  // 'T' -        'U' ..-      'V' ...-     'W' .--
+    0x19, 0x1D, 0x13, 0x00,  // 'X' -..-     'Y' -.--     'Z' --..     '['
+    0x00, 0x00, 0x00, 0x6C,  // '\\'          ']'          '^'          '_' ..--.-
+};
+
+#define MORSE_TABLE_FIRST   0x20
+#define MORSE_TABLE_LAST    0x5F
+
+static uint8_t morse_lookup(char c) {
+    if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';                 // Lower case sends the same code
+    }
+    if (c < MORSE_TABLE_FIRST || c > MORSE_TABLE_LAST) {
+        return 0;
+    }
+    return morse_table[c - MORSE_TABLE_FIRST];
+}
+
+// ============================================================================
+// Compile a string into ON/OFF runs - one pass, no backtracking
+// Returns the number of runs. A message that does not fit is cut after
+// the last complete letter. The message always ends with a word gap so
+// it can be repeated seamlessly.
+// ============================================================================
+uint16_t morse_compile(const char *text, MorseTiming *out) {
+    uint16_t n = 0;
+
+    for (; *text; text++) {
+        if (*text == ' ') {
+            // Stretch the gap after the previous letter into a word gap
+            if (n > 0) out->runs[n - 1] = MORSE_WORD_GAP;
+            continue;
+        }
+
+        uint8_t code = morse_lookup(*text);
+        if (code == 0) continue;
+
+        // Count symbols (position of the end marker) and check space
+        uint8_t symbols = 0;
+        for (uint8_t c = code; c > 1; c >>= 1) symbols++;
+        if (n + 2 * symbols > MORSE_MAX_RUNS) break;
+
+        for (; code > 1; code >>= 1) {
+            out->runs[n++] = (code & 1) ? MORSE_DASH_UNITS : MORSE_DOT_UNITS;
+            out->runs[n++] = MORSE_SYMBOL_GAP;
+        }
+        out->runs[n - 1] = MORSE_LETTER_GAP;
+    }
+
+    if (n > 0) out->runs[n - 1] = MORSE_WORD_GAP;
+    out->length = n;
+    return n;
+}
+
+// ============================================================================
+// Beacon player
+// BSRR writes are atomic, so beacons on different pins never disturb
+// each other (no read-modify-write of ODR).
+// ============================================================================
+static void beacon_output(MorseBeacon *beacon, uint8_t on) {
+    GPIO_BSRR(beacon->gpio_base) = on ? beacon->pin_mask
+                                      : ((uint32_t)beacon->pin_mask << 16);
+}
+
+// Dot length: PARIS (50 dots) once per minute. 0 wpm is taken as 1.
+static uint16_t unit_for_wpm(uint8_t wpm) {
+    return (uint16_t)(1200 / (wpm ? wpm : 1));
+}
+
+static void beacon_enter_run(MorseBeacon *beacon, uint32_t start_ms) {
+    beacon->run_start_ms = start_ms;
+    beacon->run_end_ms = start_ms
+                       + (uint32_t)beacon->timing->runs[beacon->index] * beacon->unit_ms;
+    beacon_output(beacon, (beacon->index & 1) == 0);
+}
+
+void morse_beacon_start(MorseBeacon *beacon, const MorseTiming *timing,
+                        uint32_t gpio_base, uint8_t pin, uint8_t wpm,
+                        uint8_t repeat, uint32_t now_ms) {
+    beacon->timing = timing;
+    beacon->gpio_base = gpio_base;
+    beacon->pin_mask = (uint16_t)(1 << pin);
+    beacon->unit_ms = unit_for_wpm(wpm);
+    beacon->repeat = repeat;
+    beacon->index = 0;
+    beacon->active = (timing->length > 0);
+
+    if (beacon->active) {
+        beacon_enter_run(beacon, now_ms);
+    }
+}
+
+// ============================================================================
+// Change speed mid-message: the rest of the current run is rescaled,
+// every following run uses the new dot length.
+// ============================================================================
+void morse_beacon_set_wpm(MorseBeacon *beacon, uint8_t wpm, uint32_t now_ms) {
+    uint16_t new_unit = unit_for_wpm(wpm);
+
+    if (beacon->active && (int32_t)(beacon->run_end_ms - now_ms) > 0) {
+        uint32_t remaining = beacon->run_end_ms - now_ms;
+        beacon->run_end_ms = now_ms + (remaining * new_unit) / beacon->unit_ms;
+    }
+    beacon->unit_ms = new_unit;
+}
+
+void morse_beacon_stop(MorseBeacon *beacon) {
+    if (beacon->active) {
+        beacon->active = 0;
+        beacon_output(beacon, 0);
+    }
+}
+
+// ============================================================================
+// Advance the beacon. Touches the GPIO only when a run ends.
+// Returns 1 while the message is still playing.
+// ============================================================================
+uint8_t morse_beacon_tick(MorseBeacon *beacon, uint32_t now_ms) {
+    if (!beacon->active) return 0;
+
+    // Catch up run by run if the caller was late (keeps long-term timing exact)
+    while ((int32_t)(now_ms - beacon->run_end_ms) >= 0) {
+        beacon->index++;
+        if (beacon->index >= beacon->timing->length) {
+            if (!beacon->repeat) {
+                morse_beacon_stop(beacon);
+                return 0;
+            }
+            beacon->index = 0;
+        }
+        beacon_enter_run(beacon, beacon->run_end_ms);
+    }
+    return 1;
+}
@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file           : morse.h
+ * @brief          : Non-blocking Morse code beacon for any ASCII string
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 21, 2026
+ ******************************************************************************
+ * Generalises the SOS boss challenge (WEEK_1_CHALLENGES.md) in two steps:
+ *
+ * 1. morse_compile() turns a string into a run-length timing array,
+ *    in one pass, measured in dot units:
+ *        "SOS" -> ON 1, OFF 1, ON 1, OFF 1, ON 1, OFF 3, ON 3, OFF 1, ...
+ *    Even entries are ON, odd entries are OFF (standard PARIS timing:
+ *    dot 1, dash 3, symbol gap 1, letter gap 3, word gap 7).
+ *
+ * 2. morse_beacon_tick() plays a compiled message on one LED. It never
+ *    waits - call it from the main loop or tick as often as you like.
+ *    Each beacon has its own state, so several can run at once on
+ *    different LEDs:
+ *
+ *        static MorseTiming sos;
+ *        static MorseBeacon north, south;
+ *        morse_compile("SOS", &sos);
+ *        morse_beacon_start(&north, &sos, GPIOE_BASE, LED_NORTH, 12, 1, now);
+ *        morse_beacon_start(&south, &sos, GPIOE_BASE, LED_SOUTH, 20, 1, now);
+ *        while (1) {
+ *            morse_beacon_tick(&north, get_time_ms());
+ *            morse_beacon_tick(&south, get_time_ms());
+ *        }
+ *
+ * morse_sim.c plays two beacons on the host's virtual clock (systick.h)
+ * and checks every LED edge, across a speed change mid-symbol.
+ ******************************************************************************
+ */
+
+#ifndef MORSE_H
+#define MORSE_H
+
+#include <stdint.h>
+
+#define MORSE_MAX_RUNS      128     // ON/OFF runs per compiled message
+#define MORSE_DOT_UNITS     1
+#define MORSE_DASH_UNITS    3
+#define MORSE_SYMBOL_GAP    1
+#define MORSE_LETTER_GAP    3
+#define MORSE_WORD_GAP      7
+
+typedef struct {
+    uint8_t  runs[MORSE_MAX_RUNS];  // Duration in dot units, even = ON, odd = OFF
+    uint16_t length;                // Number of valid runs (always even)
+} MorseTiming;
+
+typedef struct {
+    const MorseTiming *timing;
+    uint32_t gpio_base;             // Port of the LED, e.g. GPIOE_BASE
+    uint16_t pin_mask;              // 1 << pin
+    uint16_t index;                 // Current run
+    uint16_t unit_ms;               // Dot length = 1200 / wpm (0 wpm = 1)
+    uint8_t  repeat;                // 1 = loop the message forever
+    uint8_t  active;
+    uint32_t run_start_ms;
+    uint32_t run_end_ms;
+} MorseBeacon;
+
+uint16_t morse_compile(const char *text, MorseTiming *out);
+
+void morse_beacon_start(MorseBeacon *beacon, const MorseTiming *timing,
+                        uint32_t gpio_base, uint8_t pin, uint8_t wpm,
+                        uint8_t repeat, uint32_t now_ms);
+void morse_beacon_set_wpm(MorseBeacon *beacon, uint8_t wpm, uint32_t now_ms);
+void morse_beacon_stop(MorseBeacon *beacon);
+uint8_t morse_beacon_tick(MorseBeacon *beacon, uint32_t now_ms);
+
+#endif // MORSE_H
@@ -0,0 +1,242 @@
+/**
+ ******************************************************************************
+ * @file           : morse_sim.c
+ * @brief          : Host tool - two Morse beacons on the virtual clock
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 21, 2026
+ ******************************************************************************
+ * Runs the unchanged morse.c from a SysTick hook on the virtual clock
+ * (systick.h, HOST_SIM), as main.c would, with a GPIOE model logging
+ * every LED edge:
+ *
+ *   gcc -DHOST_SIM -DPROFILER_ENABLED=0 -O2 -o morse_sim morse_sim.c \
+ *       morse.c systick.c host_sim.c
+ *   ./morse_sim
+ *
+ * North sends "SOS" at 12 wpm over and over, ticked every ms; South sends
+ * "PARIS" once at 20 wpm, started 36 ms later by a caller that only gets
+ * round every 7 ms. Each changes speed once in the middle of a symbol:
+ * North speeds up to 24 wpm during a dash, South slows to 10 wpm during
+ * a gap. Checked:
+ *   - the compiled runs against the messages written out by hand
+ *   - each LED's edges against a timeline built from those runs: every
+ *     edge on its exact ms (South: the first tick of its caller from
+ *     then on, never drifting), the interrupted run rescaled from the
+ *     change on, the runs after it at the new speed, South dark after
+ *     its one message
+ *   - a beacon's BSRR writes never touch the other LED
+ *   - 0 wpm is played at 1 wpm instead of dividing by zero
+ * Exit code 1 on any failure.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "morse.h"
+#include "clock_config.h"
+#include "systick.h"
+#include "board.h"
+#include "host_sim.h"
+#include "stm32f303_regs.h"
+
+#define START_MS            1000
+#define RUN_MS              12000
+#define EDGES_MAX           512
+
+static uint32_t errors;
+
+static void fail(const char *what, uint32_t now) {
+    if (errors++ < 10) {
+        printf("  FAIL at %u ms: %s\n", now, what);
+    }
+}
+
+// ============================================================================
+// Board stub: no clock tree on the host (systick.c keeps HSI timing)
+// ============================================================================
+uint8_t clock_add_listener(ClockListener listener) {
+    (void)listener;
+    return 1;
+}
+
+// ============================================================================
+// The messages in dot units, ON / OFF alternating, written out by hand
+// ============================================================================
+static const uint8_t sos_runs[] = {
+    1, 1, 1, 1, 1, 3,                   // S ...
+    3, 1, 3, 1, 3, 3,                   // O ---
+    1, 1, 1, 1, 1, 7,                   // S ... + word gap
+};
+
+static const uint8_t paris_runs[] = {
+    1, 1, 3, 1, 3, 1, 1, 3,             // P .--.
+    1, 1, 3, 3,                         // A .-
+    1, 1, 3, 1, 1, 3,                   // R .-.
+    1, 1, 1, 3,                         // I ..
+    1, 1, 1, 1, 1, 7,                   // S ... + word gap
+};
+
+// ============================================================================
+// Beacons, their speed changes, and the edges they should make
+// ============================================================================
+typedef struct {
+    const char *name;
+    const char *text;
+    const uint8_t *runs;
+    uint8_t length;
+    uint8_t pin;
+    uint8_t wpm;
+    uint8_t repeat;
+    uint32_t start_ms;
+    uint32_t change_ms;                 // Mid-symbol
+    uint8_t change_wpm;
+    uint8_t every_ms;                   // The caller ticks the beacon this often
+    MorseTiming timing;
+    MorseBeacon beacon;
+    uint32_t edge_ms[EDGES_MAX];        // Logged by the GPIOE model
+    uint8_t edge_on[EDGES_MAX];
+    uint32_t edges;
+} Sender;
+
+static Sender senders[2] = {
+    { .name = "North", .text = "SOS", .runs = sos_runs, .length = sizeof sos_runs,
+      .pin = LED_NORTH, .wpm = 12, .repeat = 1, .start_ms = START_MS,
+      .change_ms = START_MS + 3400 + 850, .change_wpm = 24,         // 2nd SOS, first dash
+      .every_ms = 1 },
+    { .name = "South", .text = "paris", .runs = paris_runs, .length = sizeof paris_runs,
+      .pin = LED_SOUTH, .wpm = 20, .repeat = 0, .start_ms = START_MS + 36,
+      .change_ms = START_MS + 36 + 329, .change_wpm = 10,           // Gap after the first dash
+      .every_ms = 7 },
+};
+
+// Edges from the hand-written runs: rescale the run the change falls in,
+// the later ones at the new dot length
+static uint32_t expected_edges(const Sender *s, uint32_t *at, uint8_t *on) {
+    uint32_t unit = 1200u / s->wpm;
+    uint32_t t = s->start_ms;
+    uint8_t changed = 0;
+    uint32_t n = 0;
+
+    at[n] = t;
+    on[n++] = 1;
+    for (uint32_t i = 0; n < EDGES_MAX; i = (i + 1) % s->length) {
+        uint32_t end = t + s->runs[i] * unit;
+        if (!changed && s->change_ms > t && s->change_ms < end) {
+            uint32_t new_unit = 1200u / s->change_wpm;
+            end = s->change_ms + (end - s->change_ms) * new_unit / unit;
+            unit = new_unit;
+            changed = 1;
+        }
+        t = end;
+        if (t >= START_MS + RUN_MS || (i == s->length - 1u && !s->repeat)) {
+            break;                      // Ends on a gap: already dark
+        }
+        at[n] = (t + s->every_ms - 1) / s->every_ms * s->every_ms;     // The caller's next tick
+        on[n++] = (i & 1) != 0;         // Leaving an OFF run turns the LED on
+    }
+    return n;
+}
+
+// ============================================================================
+// GPIOE model: BSRR onto ODR, one edge log per LED
+// ============================================================================
+static uint16_t writer_mask;            // Pin of the beacon being ticked
+
+static void gpioe_hook(uint32_t addr) {
+    if (addr != GPIOE_BASE + 0x18) {
+        return;
+    }
+    volatile uint32_t *bsrr = host_sim_peek(addr);
+    volatile uint32_t *odr = host_sim_peek(GPIOE_BASE + 0x14);
+    uint32_t before = *odr;
+    uint32_t now = get_time_ms();
+
+    if (((*bsrr & 0xFFFF) | (*bsrr >> 16)) & ~(uint32_t)writer_mask) {
+        fail("BSRR write touches another beacon's pin", now);
+    }
+    *odr = (*odr | (*bsrr & 0xFFFF)) & ~(*bsrr >> 16);
+    *bsrr = 0;                          // Write-only
+
+    for (uint8_t k = 0; k < 2; k++) {
+        Sender *s = &senders[k];
+        uint32_t bit = 1u << s->pin;
+        if (((before ^ *odr) & bit) && s->edges < EDGES_MAX) {
+            s->edge_ms[s->edges] = now;
+            s->edge_on[s->edges++] = (*odr & bit) != 0;
+        }
+    }
+}
+
+// What main.c would do from its tick: start, change speed, play
+static void beacons_tick(uint32_t now) {
+    for (uint8_t k = 0; k < 2; k++) {
+        Sender *s = &senders[k];
+        if (now % s->every_ms) {
+            continue;
+        }
+        writer_mask = (uint16_t)(1u << s->pin);
+        if (now == s->start_ms) {
+            morse_beacon_start(&s->beacon, &s->timing, GPIOE_BASE, s->pin, s->wpm, s->repeat, now);
+        } else if (now == s->change_ms) {
+            morse_beacon_set_wpm(&s->beacon, s->change_wpm, now);
+        }
+        morse_beacon_tick(&s->beacon, now);
+        host_sim_flush();               // Its BSRR write, under its mask
+    }
+}
+
+int main(void) {
+    static uint32_t at[EDGES_MAX];
+    static uint8_t on[EDGES_MAX];
+
+    host_sim_reset();
+    host_sim_add_hook(gpioe_hook);
+    systick_add_hook(beacons_tick);
+
+    for (uint8_t k = 0; k < 2; k++) {
+        Sender *s = &senders[k];
+        if (morse_compile(s->text, &s->timing) != s->length ||
+            memcmp(s->timing.runs, s->runs, s->length) != 0) {
+            fail("compiled runs differ from the message written out", 0);
+        }
+    }
+
+    systick_sim_set_time(START_MS - 1);
+    systick_sim_run(RUN_MS + 1);
+    host_sim_flush();
+
+    printf("Morse: two beacons for %u ms on the virtual clock\n\n", RUN_MS);
+    for (uint8_t k = 0; k < 2; k++) {
+        Sender *s = &senders[k];
+        uint32_t n = expected_edges(s, at, on);
+        uint32_t first_bad = 0;
+
+        while (first_bad < n && first_bad < s->edges &&
+               s->edge_ms[first_bad] == at[first_bad] && s->edge_on[first_bad] == on[first_bad]) {
+            first_bad++;
+        }
+        printf("  %-6s %-6s %2u -> %2u wpm at %5u ms: %3u edges, %3u expected, %s\n",
+               s->name, s->text, s->wpm, s->change_wpm, s->change_ms, s->edges, n,
+               first_bad == n && n == s->edges ? "all on time" : "MISMATCH");
+        if (first_bad != n || n != s->edges) {
+            printf("         first difference: edge %u, got %u ms, want %u ms\n", first_bad,
+                   first_bad < s->edges ? s->edge_ms[first_bad] : 0,
+                   first_bad < n ? at[first_bad] : 0);
+            fail("LED timeline differs from the message", first_bad < n ? at[first_bad] : 0);
+        }
+    }
+
+    MorseBeacon zero;
+    writer_mask = 1u << LED_EAST;
+    morse_beacon_start(&zero, &senders[0].timing, GPIOE_BASE, LED_EAST, 0, 0, get_time_ms());
+    uint16_t unit_at_0 = zero.unit_ms;
+    morse_beacon_set_wpm(&zero, 0, get_time_ms());
+    host_sim_flush();
+    if (unit_at_0 != 1200 || zero.unit_ms != 1200) {
+        fail("0 wpm not played as 1 wpm", get_time_ms());
+    }
+
+    printf("\n%s\n", errors ? "FAILED" : "Every edge on its ms, speed changes mid-symbol included");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,344 @@
+/**
+ ******************************************************************************
+ * @file           : patterns.c
+ * @brief          : The Day3_Final_7_Patterns.c LED patterns as frames, plus zones
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ * Same animations as Day 3, same step logic, but each one draws a frame
+ * of any width. On the eight on-board LEDs (ring = compass order) the
+ * output is exactly the Day 3 sequence. Knight Rider and Breathing, the
+ * two with direction state machines, are written as coroutines (pt.h),
+ * and so is Clockwise Spin so that it can also run in a zone.
+ *
+ * Pattern 8 is not from Day 3: the ring split into zones (zone.h), the
+ * north half spinning while the south half breathes. Pattern 9 plays a
+ * stored animation (anim.h) instead of computing its frames. Pattern 10
+ * lights the LED facing downhill, or north when the board lies flat
+ * (compass.h, from the LSM303 samples).
+ *
+ * Periods are the Day 3 delay() counts converted to ms (~1 count = 1 us
+ * at 8 MHz).
+ ******************************************************************************
+ */
+
+#include "patterns.h"
+#include "brightness.h"
+#include "zone.h"
+#include "anim.h"
+#include "compass.h"
+#include "lsm303.h"
+
+// ============================================================================
+// Pattern 0: Clockwise Spin
+// ============================================================================
+static PT_THREAD(pattern_clockwise(Pt *pt, LedFrame *f)) {
+    PT_BEGIN(pt);
+
+    for (;;) {
+        for (pt->i = 0; pt->i < f->width; pt->i++) {
+            led_frame_fill(f, 0);
+            led_frame_set(f, led_frame_ring(f, pt->i));
+            PT_YIELD_FOR(pt, 150);
+        }
+    }
+
+    PT_END(pt);
+}
+
+// ============================================================================
+// Pattern 1: Counter-Clockwise Spin
+// ============================================================================
+static void pattern_counter_clockwise_step(LedFrame *f) {
+    static uint16_t step = 0;
+
+    if (step >= f->width) step = 0;
+    led_frame_fill(f, 0);
+    led_frame_set(f, led_frame_ring(f, (f->width - step) % f->width));  // N, NW, W, SW, ...
+
+    step++;
+}
+
+// ============================================================================
+// Pattern 2: All Blink Together
+// ============================================================================
+static void pattern_all_blink_step(LedFrame *f) {
+    static uint8_t on = 0;
+
+    led_frame_fill(f, on);
+    on = !on;
+}
+
+// ============================================================================
+// Pattern 3: Custom Sequential (by pin number)
+// ============================================================================
+static void pattern_sequential_pin_order(LedFrame *f) {
+    static uint16_t step = 0;
+
+    if (step >= f->width) step = 0;
+    led_frame_fill(f, 0);
+    led_frame_set(f, step);                         // PE8, PE9, ... PE15
+
+    step++;
+}
+
+// ============================================================================
+// Pattern 4: Knight Rider (back and forth)
+// ============================================================================
+static PT_THREAD(pattern_knight_rider(Pt *pt, LedFrame *f)) {
+    PT_BEGIN(pt);
+
+    for (;;) {
+        // Forward up to the last LED, then back down to the second
+        for (pt->i = 0; pt->i + 1 < f->width; pt->i++) {
+            led_frame_fill(f, 0);
+            led_frame_set(f, pt->i);
+            PT_YIELD_FOR(pt, 100);
+        }
+        for (pt->i = f->width - 1; pt->i > 0; pt->i--) {
+            led_frame_fill(f, 0);
+            led_frame_set(f, pt->i);
+            PT_YIELD_FOR(pt, 100);
+        }
+        if (f->width < 2) {
+            led_frame_fill(f, 0);
+            led_frame_set(f, 0);
+            PT_YIELD_FOR(pt, 100);
+        }
+    }
+
+    PT_END(pt);
+}
+
+// ============================================================================
+// Pattern 5: Binary Counter (0-255 on 8 LEDs, low 32 outputs on a panel)
+// ============================================================================
+static void pattern_binary_counter(LedFrame *f) {
+    static uint32_t count = 0;
+
+    led_frame_fill(f, 0);
+    for (uint16_t i = 0; i < f->width && i < 32; i += 8) {
+        f->bits[i >> 3] = (uint8_t)(count >> i);   // Bit i of count -> output i
+    }
+    if (f->width & 7) {
+        f->bits[LED_FRAME_BYTES(f->width) - 1] &= (uint8_t)((1 << (f->width & 7)) - 1);
+    }
+    count++;
+}
+
+// ============================================================================
+// Pattern 6: Random Chaos
+// ============================================================================
+static void pattern_random_chaos(LedFrame *f) {
+    static uint32_t random = 123;
+    uint16_t bytes = LED_FRAME_BYTES(f->width);
+
+    for (uint16_t i = 0; i < bytes; i++) {
+        random = (random * 1103515245 + 12345) % 256;
+        f->bits[i] = (uint8_t)random;
+    }
+    if (f->width & 7) {
+        f->bits[bytes - 1] &= (uint8_t)((1 << (f->width & 7)) - 1);
+    }
+}
+
+// ============================================================================
+// Pattern 7: Breathing Effect
+// ============================================================================
+static void draw_lowest(LedFrame *f, uint16_t count) {
+    led_frame_fill(f, 0);
+    for (uint16_t i = 0; i < count; i++) {      // Lowest 'count' LEDs
+        led_frame_set(f, i);
+    }
+}
+
+static PT_THREAD(pattern_breathing(Pt *pt, LedFrame *f)) {
+    PT_BEGIN(pt);
+
+    for (;;) {
+        // Add LEDs up to all of them, then take them away again
+        for (pt->i = 0; pt->i < f->width; pt->i++) {
+            draw_lowest(f, pt->i);
+            PT_YIELD_FOR(pt, 150);
+        }
+        for (pt->i = f->width; pt->i > 0; pt->i--) {
+            draw_lowest(f, pt->i);
+            PT_YIELD_FOR(pt, 150);
+        }
+    }
+
+    PT_END(pt);
+}
+
+// Brightness version: a sine breath, each ring position lagging a little
+// (16 steps x 150 ms = same 2.4 s cycle as the LED-count version)
+#define BREATH_PHASE_PER_MS 27          // 65536 / 2400
+
+static void pattern_breathing_shade(LedLevels *out, uint32_t now_ms) {
+    uint16_t phase = (uint16_t)(now_ms * BREATH_PHASE_PER_MS);
+    uint16_t lag = (uint16_t)(0x4000 / out->width);     // Quarter turn over the ring
+
+    // One interpolated sine (one multiply) per LED; gamma is applied at output
+
+    for (uint16_t pos = 0; pos < out->width; pos++) {
+        uint16_t output = out->ring ? out->ring[pos] : pos;
+        out->level[output] = breathe_level((uint16_t)(phase - pos * lag));
+    }
+}
+
+// ============================================================================
+// Pattern 8: Split - north half spins, south half breathes
+// ============================================================================
+static Zone split_zones[] = {
+    ZONE(&patterns[0], 6, 4),           // W, NW, N, NE
+    ZONE(&patterns[7], 2, 4),           // E, SE, S, SW
+};
+
+#define SPLIT_ZONES     (sizeof split_zones / sizeof split_zones[0])
+
+static PT_THREAD(pattern_split(Pt *pt, LedFrame *f)) {
+    PT_BEGIN(pt);
+
+    zones_start(split_zones, SPLIT_ZONES, pt->wake_ms);
+    for (;;) {
+        // Back when the next zone is due, not every tick: a frame is only
+        // drawn (and shown) when some zone has moved
+        uint32_t next = zones_run(split_zones, SPLIT_ZONES, f, pt->wake_ms);
+        PT_YIELD_FOR(pt, next - pt->wake_ms);
+    }
+
+    PT_END(pt);
+}
+
+static void pattern_split_shade(LedLevels *out, uint32_t now_ms) {
+    zones_shade(split_zones, SPLIT_ZONES, out, now_ms);
+}
+
+// ============================================================================
+// Pattern 9: Animation - anim_demo.txt, packed by anim_encode
+// ============================================================================
+extern const uint8_t anim_demo[];       // anim_demo.c (generated)
+extern const uint32_t anim_demo_size;
+
+// Decoder state and the previous frame live here, not in the Pt and not
+// in the output frame (which may be one of two alternating buffers):
+// one instance at a time, like the step patterns
+#define ANIM_MAX_WIDTH  256
+
+static AnimStream anim;
+static uint8_t anim_bits[LED_FRAME_BYTES(ANIM_MAX_WIDTH)];
+
+// Stretched over the frame: ring position p shows animation output
+// p * anim width / frame width
+static void draw_animation(LedFrame *f) {
+    led_frame_fill(f, 0);
+    for (uint16_t pos = 0; pos < f->width; pos++) {
+        uint16_t bit = (uint16_t)((uint32_t)pos * anim.width / f->width);
+        if (anim_bits[bit >> 3] & (1 << (bit & 7))) {
+            led_frame_set(f, led_frame_ring(f, pos));
+        }
+    }
+}
+
+static PT_THREAD(pattern_animation(Pt *pt, LedFrame *f)) {
+    uint32_t duration_ms;
+
+    PT_BEGIN(pt);
+
+    if (!anim_open(&anim, anim_demo, anim_demo_size) || anim.width > ANIM_MAX_WIDTH) {
+        led_frame_fill(f, 0);
+        PT_WAIT_UNTIL(pt, 0);                   // Dark for good
+    }
+    for (uint16_t i = 0; i < sizeof anim_bits; i++) {
+        anim_bits[i] = 0;
+    }
+
+    for (;;) {
+        // One record per frame: a few bytes of Flash, whatever the length
+        duration_ms = anim_next(&anim, anim_bits);
+        if (duration_ms == 0) {
+            led_frame_fill(f, 0);               // Broken stream: stay dark
+            PT_WAIT_UNTIL(pt, 0);
+        }
+        draw_animation(f);
+        PT_YIELD_FOR(pt, duration_ms);
+    }
+
+    PT_END(pt);
+}
+
+// ============================================================================
+// Pattern 10: Compass - downhill when tilted, north when level
+// ============================================================================
+#define COMPASS_PERIOD_MS   50
+
+static PT_THREAD(pattern_compass(Pt *pt, LedFrame *f)) {
+    const Lsm303Sample *s;
+    int8_t octant;
+
+    PT_BEGIN(pt);
+
+    for (;;) {
+        s = lsm303_latest();                    // One whole sample, whatever the sensor ISR does
+        octant = -1;
+        if (s->accel_count != 0) {
+            octant = compass_downhill(s->accel);
+            if (octant < 0 && s->mag_count != 0) {
+                octant = compass_north(s->accel, s->mag);
+            }
+        }
+
+        led_frame_fill(f, 0);                   // No data / no answer: dark
+        if (octant >= 0) {
+            led_frame_set(f, led_frame_ring(f, (uint16_t)((uint32_t)octant * f->width / 8)));
+        }
+        PT_YIELD_FOR(pt, COMPASS_PERIOD_MS);
+    }
+
+    PT_END(pt);
+}
+
+// ============================================================================
+// Pattern table (index = current_pattern)
+// ============================================================================
+const Pattern patterns[PATTERN_COUNT] = {
+    // step                         period  shade                    run
+    { 0,                                0,  0,                       pattern_clockwise },
+    { pattern_counter_clockwise_step, 150,  0,                       0 },
+    { pattern_all_blink_step,         300,  0,                       0 },
+    { pattern_sequential_pin_order,   150,  0,                       0 },
+    { 0,                                0,  0,                       pattern_knight_rider },
+    { pattern_binary_counter,         200,  0,                       0 },
+    { pattern_random_chaos,           150,  0,                       0 },
+    { 0,                                0,  pattern_breathing_shade, pattern_breathing },
+    { 0,                                0,  pattern_split_shade,     pattern_split },
+    { 0,                                0,  0,                       pattern_animation },
+    { 0,                                0,  0,                       pattern_compass },
+};
+
+// ============================================================================
+// Scheduling: one Pt per running instance
+// ============================================================================
+void pattern_start(Pt *pt, uint32_t now_ms) {
+    PT_INIT(pt, now_ms);
+}
+
+uint8_t pattern_run(const Pattern *p, Pt *pt, LedFrame *frame, uint32_t now_ms) {
+    if (!pt_due(pt, now_ms)) {
+        return 0;
+    }
+
+    if (p->run) {
+        p->run(pt, frame);
+        if (pt_due(pt, now_ms)) {
+            pt->wake_ms = now_ms + 1;           // Fell behind: carry on from the next tick
+        }
+    } else {
+        p->step(frame);
+        pt->wake_ms += p->period_ms;
+        if (pt_due(pt, now_ms)) {
+            pt->wake_ms = now_ms + p->period_ms;    // Fell behind (e.g. debugger halt)
+        }
+    }
+    return 1;
+}
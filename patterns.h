@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file           : patterns.h
+ * @brief          : The Day3_Final_7_Patterns.c LED patterns as frames, plus zones
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 22, 2026
+ ******************************************************************************
+ * Each step function advances its own animation by one step and draws
+ * the whole new frame into an LedFrame (led_frame.h) instead of writing
+ * GPIOE_ODR itself. The caller decides when to step (period_ms) and where
+ * the frame goes - the eight on-board LEDs or a 74HC595 panel of any
+ * width - so no delay() and no pin numbers inside a pattern.
+ *
+ * Animation state is per pattern, not per frame: step one target only.
+ * (The split pattern runs other patterns in zones of the ring, zone.h.)
+ *
+ * A pattern can instead be a coroutine ('run', pt.h): straight-line code
+ * that draws a frame and PT_YIELD_FOR()s as long as it should stay up.
+ * All its state is in the caller's Pt, so any number of instances can
+ * run side by side. pattern_run() drives both kinds with the same Pt:
+ *
+ *   pattern_start(&pt, now);
+ *   if (pattern_run(&patterns[n], &pt, &frame, now)) { show frame }
+ *
+ * A pattern may also have a 'shade' function for outputs that can dim
+ * (led_pwm.h): it draws levels for a point in time instead of stepping,
+ * so it can be called every tick for a smooth curve.
+ ******************************************************************************
+ */
+
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include <stdint.h>
+#include "led_frame.h"
+#include "pt.h"
+
+#define PATTERN_COUNT       11      // 8 from Day 3 + the split zones + an animation + compass
+
+typedef void (*PatternStepFn)(LedFrame *frame);
+typedef void (*PatternShadeFn)(LedLevels *levels, uint32_t now_ms);
+typedef PT_THREAD((*PatternRunFn)(Pt *pt, LedFrame *frame));
+
+typedef struct {
+    PatternStepFn step;             // Fixed-period pattern ...
+    uint16_t period_ms;             // Time between steps
+    PatternShadeFn shade;           // Optional (0): brightness version
+    PatternRunFn run;               // ... or a coroutine that paces itself
+} Pattern;
+
+extern const Pattern patterns[PATTERN_COUNT];
+
+// (Re)start an instance: first frame at now_ms
+void pattern_start(Pt *pt, uint32_t now_ms);
+
+// Step / resume the instance if it is due; 1 = drew a new frame
+uint8_t pattern_run(const Pattern *p, Pt *pt, LedFrame *frame, uint32_t now_ms);
+
+#endif // PATTERNS_H
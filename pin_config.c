@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file           : pin_config.c
+ * @brief          : Declarative pin tables, applied with one write per register
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ */
+
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+
+// Clear / set masks of one register
+typedef struct {
+    uint32_t clear;
+    uint32_t set;
+} RegMasks;
+
+typedef struct {
+    RegMasks moder, otyper, ospeedr, pupdr, afrl, afrh;
+} PortMasks;
+
+static void reg_apply(volatile uint32_t *reg, const RegMasks *m) {
+    if (m->clear) {
+        *reg = (*reg & ~m->clear) | m->set;     // The one RMW for this register
+    }
+}
+
+void pin_config_apply(const PinConfig *table, uint32_t count) {
+    PortMasks ports[GPIO_PORT_COUNT] = { 0 };
+    uint32_t used = 0;                          // Bit n = port n has rows
+
+    // Fold the table into masks - flash reads only, no peripheral access
+    for (uint32_t i = 0; i < count; i++) {
+        const PinConfig *cfg = &table[i];
+        PortMasks *m = &ports[cfg->port];
+        uint8_t pin = cfg->pin;
+
+        used |= 1u << cfg->port;
+
+        m->moder.clear   |= PIN_FIELD2(pin, 3);
+        m->moder.set     |= PIN_FIELD2(pin, cfg->mode);
+        m->otyper.clear  |= PIN_FIELD1(pin, 1);
+        m->otyper.set    |= PIN_FIELD1(pin, cfg->otype);
+        m->ospeedr.clear |= PIN_FIELD2(pin, 3);
+        m->ospeedr.set   |= PIN_FIELD2(pin, cfg->speed);
+        m->pupdr.clear   |= PIN_FIELD2(pin, 3);
+        m->pupdr.set     |= PIN_FIELD2(pin, cfg->pull);
+
+        if (cfg->mode == PIN_MODE_AF) {
+            RegMasks *afr = (pin < 8) ? &m->afrl : &m->afrh;
+            afr->clear |= PIN_FIELD4(pin, 0xF);
+            afr->set   |= PIN_FIELD4(pin, cfg->af);
+        }
+    }
+
+    // All port clocks in one write
+    uint32_t clocks = 0;
+    for (uint32_t port = 0; port < GPIO_PORT_COUNT; port++) {
+        if (used & (1u << port)) {
+            clocks |= RCC_AHBENR_GPIOxEN(port);
+        }
+    }
+    RCC_AHBENR |= clocks;
+
+    // AF number before the mode switch, so a pin never shows a stale function
+    for (uint32_t port = 0; port < GPIO_PORT_COUNT; port++) {
+        if (!(used & (1u << port))) {
+            continue;
+        }
+        uint32_t base = GPIO_PORT_BASE(port);
+        const PortMasks *m = &ports[port];
+
+        reg_apply(&GPIO_AFRL(base), &m->afrl);
+        reg_apply(&GPIO_AFRH(base), &m->afrh);
+        reg_apply(&GPIO_OTYPER(base), &m->otyper);
+        reg_apply(&GPIO_OSPEEDR(base), &m->ospeedr);
+        reg_apply(&GPIO_PUPDR(base), &m->pupdr);
+        reg_apply(&GPIO_MODER(base), &m->moder);
+    }
+}
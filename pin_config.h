@@ -0,0 +1,85 @@
+/**
+ ******************************************************************************
+ * @file           : pin_config.h
+ * @brief          : Declarative pin tables, applied with one write per register
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 25, 2026
+ ******************************************************************************
+ * Day3_Final_7_Patterns.c sets up the LEDs with sixteen read-modify-writes
+ * of GPIOE_MODER. Here every pin is one table row:
+ *
+ *   static const PinConfig led_pins[] = {
+ *       PIN_OUTPUT(GPIO_PORT_E, LED_NORTH),
+ *       ...
+ *   };
+ *   pin_config_apply(led_pins, PIN_TABLE_SIZE(led_pins));
+ *
+ * pin_config_apply() folds the rows into clear/set masks per port (no bus
+ * access), then enables the port clocks with one RCC_AHBENR write and
+ * touches MODER, OTYPER, OSPEEDR, PUPDR, AFRL and AFRH at most once per
+ * port. A register no row cares about is not touched at all.
+ *
+ * The single-port PIN_FIELD*() macros below give the same masks as
+ * compile-time constants for code that wants to hard-code them; gpio.hpp
+ * does the full fold at compile time for C++.
+ ******************************************************************************
+ */
+
+#ifndef PIN_CONFIG_H
+#define PIN_CONFIG_H
+
+#include <stdint.h>
+
+// Port index, as used by GPIO_PORT_BASE() / RCC_AHBENR_GPIOxEN()
+#define GPIO_PORT_A         0
+#define GPIO_PORT_B         1
+#define GPIO_PORT_C         2
+#define GPIO_PORT_D         3
+#define GPIO_PORT_E         4
+#define GPIO_PORT_F         5
+
+// Field values (reference manual encodings)
+#define PIN_MODE_INPUT      0
+#define PIN_MODE_OUTPUT     1
+#define PIN_MODE_AF         2
+#define PIN_MODE_ANALOG     3
+
+#define PIN_PUSH_PULL       0
+#define PIN_OPEN_DRAIN      1
+
+#define PIN_SPEED_LOW       0
+#define PIN_SPEED_MEDIUM    1
+#define PIN_SPEED_HIGH      3
+
+#define PIN_PULL_NONE       0
+#define PIN_PULL_UP         1
+#define PIN_PULL_DOWN       2
+
+typedef struct {
+    uint8_t port;                   // GPIO_PORT_x
+    uint8_t pin;                    // 0..15
+    uint8_t mode;                   // PIN_MODE_x
+    uint8_t otype;                  // PIN_PUSH_PULL / PIN_OPEN_DRAIN
+    uint8_t speed;                  // PIN_SPEED_x
+    uint8_t pull;                   // PIN_PULL_x
+    uint8_t af;                     // 0..15, only used with PIN_MODE_AF
+} PinConfig;
+
+#define PIN_TABLE_SIZE(table)   (sizeof(table) / sizeof((table)[0]))
+
+// Common rows
+#define PIN_INPUT(port, pin, pull) \
+    { (port), (pin), PIN_MODE_INPUT, PIN_PUSH_PULL, PIN_SPEED_LOW, (pull), 0 }
+#define PIN_OUTPUT(port, pin) \
+    { (port), (pin), PIN_MODE_OUTPUT, PIN_PUSH_PULL, PIN_SPEED_LOW, PIN_PULL_NONE, 0 }
+#define PIN_ALT(port, pin, af, speed) \
+    { (port), (pin), PIN_MODE_AF, PIN_PUSH_PULL, (speed), PIN_PULL_NONE, (af) }
+
+// Register fields of one pin (constant when pin and value are)
+#define PIN_FIELD1(pin, value)  ((uint32_t)(value) << (pin))              // OTYPER
+#define PIN_FIELD2(pin, value)  ((uint32_t)(value) << ((pin) * 2))        // MODER/OSPEEDR/PUPDR
+#define PIN_FIELD4(pin, value)  ((uint32_t)(value) << (((pin) & 7) * 4))  // AFRL/AFRH
+
+void pin_config_apply(const PinConfig *table, uint32_t count);
+
+#endif // PIN_CONFIG_H
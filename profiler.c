@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @file           : profiler.c
+ * @brief          : DWT cycle profiler - trace buffer and UART drain
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 23, 2026
+ ******************************************************************************
+ */
+
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include "boot_stats.h"
+#include "clock_config.h"
+#include "uart.h"
+#include "fmt.h"
+
+// .noinit: 4 KB less to zero at boot, and a trace survives a warm reset
+NOINIT ProfTrace prof_trace;
+uint32_t prof_last_cycles;
+volatile uint8_t prof_paused;
+
+static void prof_on_clock_change(const ClockFreqs *freqs) {
+    prof_trace.cpu_hz = freqs->hclk_hz;
+}
+
+// ============================================================================
+// Init: needs the DWT counter running (systick_init / Reset_Handler)
+// ============================================================================
+void prof_init(void) {
+    prof_trace.magic = PROF_MAGIC;
+    prof_trace.head = 0;
+    prof_trace.size = PROF_RECORDS;
+    prof_last_cycles = DWT_CYCCNT;
+    prof_paused = 0;
+
+    clock_add_listener(prof_on_clock_change);
+}
+
+// ============================================================================
+// Rare path: the gap to the previous stamp does not fit in 24 bits
+// (called from prof_stamp with interrupts already masked)
+// ============================================================================
+void prof_sync(uint32_t delta) {
+    prof_trace.records[prof_trace.head++ & (PROF_RECORDS - 1)] =
+        ((uint32_t)PROF_ID_SYNC << PROF_ID_SHIFT) | (delta >> 24);
+}
+
+// ============================================================================
+// UART drain: same layout as a memory dump, as hex text
+//   PROF <magic> <head> <cpu_hz> <size>
+//   <8 records per line>
+//   END
+// The ring is frozen from before the header is taken until END, so head
+// and records belong together. A stamp runs with interrupts masked, so
+// once the flag is set no stamp is half-way through.
+// ============================================================================
+void prof_dump_uart(void) {
+    prof_paused = 1;
+    __asm volatile ("" ::: "memory");   // Read the ring only after that
+
+    uint32_t header[4] = { prof_trace.magic, prof_trace.head,
+                           prof_trace.cpu_hz, prof_trace.size };
+    char line[8 * 9 + 2];
+    char *p = line;
+
+    p += fmt_str(p, "PROF", 0);
+    for (int i = 0; i < 4; i++) {
+        *p++ = ' ';
+        p += fmt_hex(p, header[i], 8);
+    }
+    *p++ = '\r';
+    *p++ = '\n';
+    uart_write(line, (uint32_t)(p - line));
+
+    // One UART write per line of 8 records
+    p = line;
+    for (uint32_t i = 0; i < PROF_RECORDS; i++) {
+        p += fmt_hex(p, prof_trace.records[i], 8);
+        if ((i & 7) == 7) {
+            *p++ = '\r';
+            *p++ = '\n';
+            uart_write(line, (uint32_t)(p - line));
+            p = line;
+        } else {
+            *p++ = ' ';
+        }
+    }
+    uart_puts("END\r\n");
+
+    // Resume: the next stamp counts from now, not across the dump
+    prof_last_cycles = DWT_CYCCNT;
+    __asm volatile ("" ::: "memory");   // Stored before stamping restarts
+    prof_paused = 0;
+}
+
+#endif // PROFILER_ENABLED
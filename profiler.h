@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file           : profiler.h
+ * @brief          : DWT cycle profiler - entry/exit stamps in a RAM ring
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 23, 2026
+ ******************************************************************************
+ * Usage:
+ *   PROF_ENTER(PROF_PATTERN_STEP);
+ *   frame = patterns[current_pattern].step();
+ *   PROF_EXIT(PROF_PATTERN_STEP);
+ *
+ * Each stamp is ONE 32-bit word in prof_trace.records[]:
+ *   bit 31..25  zone ID (profiler_ids.h)
+ *   bit 24      0 = enter, 1 = exit
+ *   bit 23..0   DWT cycles since the previous stamp
+ * A gap longer than 2^24 cycles (233 ms at 72 MHz) first writes a SYNC
+ * record (ID 127) carrying the upper bits of the delta.
+ *
+ * Cost: read CYCCNT, subtract, one store - with interrupts masked for
+ * those few cycles so stamps from ISRs can't interleave wrongly.
+ *
+ * Getting the data out:
+ *   - Debugger: dump the prof_trace struct to a file (it is
+ *     self-describing), e.g. in gdb
+ *       dump binary value trace.bin prof_trace
+ *   - UART: prof_dump_uart() prints it as hex text. The ring is frozen
+ *     (prof_paused) while it prints - about 0.8 s at 115200 baud, in
+ *     which the ISRs would overwrite it several times - so the dump is
+ *     one consistent snapshot. Stamps during the dump are dropped, and
+ *     the dump's own time is not in the next trace.
+ * Then on the PC:  ./profiler_decode trace.bin   (or uart_log.txt)
+ *
+ * Build with -DPROFILER_ENABLED=0 and every macro disappears.
+ ******************************************************************************
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "profiler_ids.h"
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED    1
+#endif
+
+#define PROF_RECORDS        1024        // Power of 2
+#define PROF_MAGIC          0x50524F46  // "PROF"
+
+#define PROF_ID_SHIFT       25
+#define PROF_EXIT_FLAG      (1UL << 24)
+#define PROF_DELTA_MAX      0x00FFFFFFUL
+#define PROF_ID_SYNC        127
+
+typedef struct {
+    uint32_t magic;                     // PROF_MAGIC
+    uint32_t head;                      // Total records written (wraps the ring)
+    uint32_t cpu_hz;                    // HCLK when the trace was taken
+    uint32_t size;                      // PROF_RECORDS
+    uint32_t records[PROF_RECORDS];
+} ProfTrace;
+
+#if PROFILER_ENABLED
+
+#include "stm32f303_regs.h"
+
+extern ProfTrace prof_trace;
+extern uint32_t prof_last_cycles;
+extern volatile uint8_t prof_paused;    // 1 = ring frozen, stamps dropped
+
+void prof_init(void);
+void prof_sync(uint32_t delta);
+void prof_dump_uart(void);
+
+static inline __attribute__((always_inline)) void prof_stamp(uint32_t tag) {
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+
+    if (prof_paused) {
+        __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+        return;
+    }
+    uint32_t now = DWT_CYCCNT;
+    uint32_t delta = now - prof_last_cycles;
+    prof_last_cycles = now;
+
+    if (delta > PROF_DELTA_MAX) {
+        prof_sync(delta);
+    }
+    prof_trace.records[prof_trace.head++ & (PROF_RECORDS - 1)] = tag | (delta & PROF_DELTA_MAX);
+
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+#define PROF_ENTER(zone)    prof_stamp((uint32_t)(zone) << PROF_ID_SHIFT)
+#define PROF_EXIT(zone)     prof_stamp(((uint32_t)(zone) << PROF_ID_SHIFT) | PROF_EXIT_FLAG)
+
+#else
+
+#define prof_init()         ((void)0)
+#define prof_dump_uart()    ((void)0)
+#define PROF_ENTER(zone)    ((void)0)
+#define PROF_EXIT(zone)     ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
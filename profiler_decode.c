@@ -0,0 +1,305 @@
+/**
+ ******************************************************************************
+ * @file           : profiler_decode.c
+ * @brief          : Host tool - decode a profiler trace into timing tables
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 23, 2026
+ ******************************************************************************
+ * Runs on the PC, not on the board:
+ *   gcc -O2 -o profiler_decode profiler_decode.c
+ *   ./profiler_decode trace.bin          (gdb: dump binary value ... prof_trace)
+ *   ./profiler_decode uart_log.txt       (output of prof_dump_uart())
+ *
+ * Prints:
+ *   1. Per zone: calls, min / avg / max / p50 / p90 / p99 (inclusive time)
+ *   2. Flame-style summary: self time per call path, biggest first.
+ *      The "folded" lines can be fed straight into flamegraph.pl.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILER_ENABLED 0
+#include "profiler.h"
+
+#define MAX_RECORDS         (1 << 20)
+#define MAX_DEPTH           32
+#define MAX_PATHS           512
+#define PATH_LEN            256
+
+#define PROF_ZONE_NAME(id, name)    name,
+static const char *zone_names[PROF_ZONE_COUNT] = { PROF_ZONE_LIST(PROF_ZONE_NAME) };
+
+typedef struct {
+    uint64_t *samples;
+    uint32_t count;
+    uint32_t capacity;
+} ZoneStats;
+
+typedef struct {
+    char path[PATH_LEN];
+    uint64_t self_cycles;
+    uint32_t calls;
+} PathStats;
+
+typedef struct {
+    uint32_t zone;
+    uint64_t enter_time;
+    uint64_t child_cycles;
+} Frame;
+
+static uint32_t header[4];              // magic, head, cpu_hz, size
+static uint32_t *records;
+
+static ZoneStats zones[PROF_ZONE_COUNT];
+static PathStats paths[MAX_PATHS];
+static uint32_t path_count = 0;
+
+// ============================================================================
+// Input: binary dump of ProfTrace, or the hex text from prof_dump_uart()
+// ============================================================================
+static int load_trace(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (f == NULL) {
+        perror(filename);
+        return 0;
+    }
+
+    records = malloc(MAX_RECORDS * sizeof(uint32_t));
+    uint8_t first[4] = {0};
+    size_t got = fread(first, 1, 4, f);
+    rewind(f);
+
+    uint32_t word0 = first[0] | (first[1] << 8) | (first[2] << 16) | ((uint32_t)first[3] << 24);
+
+    if (got == 4 && word0 == PROF_MAGIC) {
+        // Binary memory dump (little-endian, same layout as ProfTrace)
+        if (fread(header, sizeof(uint32_t), 4, f) != 4 || header[3] > MAX_RECORDS) {
+            fprintf(stderr, "Bad binary header\n");
+            return 0;
+        }
+        if (fread(records, sizeof(uint32_t), header[3], f) != header[3]) {
+            fprintf(stderr, "Dump is shorter than %u records\n", header[3]);
+            return 0;
+        }
+    } else {
+        // UART text: find the "PROF" line, then hex words until "END"
+        char word[32];
+        int found = 0;
+        while (fscanf(f, "%31s", word) == 1) {
+            if (strcmp(word, "PROF") == 0) { found = 1; break; }
+        }
+        if (!found) {
+            fprintf(stderr, "No PROF header in %s\n", filename);
+            return 0;
+        }
+        for (int i = 0; i < 4; i++) {
+            if (fscanf(f, "%x", &header[i]) != 1) return 0;
+        }
+        if (header[3] > MAX_RECORDS) return 0;
+        for (uint32_t i = 0; i < header[3]; i++) {
+            if (fscanf(f, "%x", &records[i]) != 1) {
+                fprintf(stderr, "Text dump ends after %u records\n", i);
+                return 0;
+            }
+        }
+    }
+
+    fclose(f);
+    return 1;
+}
+
+// ============================================================================
+// Bookkeeping
+// ============================================================================
+static void zone_add_sample(uint32_t zone, uint64_t cycles) {
+    ZoneStats *z = &zones[zone];
+    if (z->count == z->capacity) {
+        z->capacity = z->capacity ? z->capacity * 2 : 256;
+        z->samples = realloc(z->samples, z->capacity * sizeof(uint64_t));
+    }
+    z->samples[z->count++] = cycles;
+}
+
+static void path_add(const Frame *stack, uint32_t depth, uint64_t self_cycles) {
+    char path[PATH_LEN] = "";
+
+    for (uint32_t i = 0; i < depth; i++) {
+        if (i) strncat(path, ";", PATH_LEN - strlen(path) - 1);
+        strncat(path, zone_names[stack[i].zone], PATH_LEN - strlen(path) - 1);
+    }
+
+    for (uint32_t i = 0; i < path_count; i++) {
+        if (strcmp(paths[i].path, path) == 0) {
+            paths[i].self_cycles += self_cycles;
+            paths[i].calls++;
+            return;
+        }
+    }
+    if (path_count < MAX_PATHS) {
+        strcpy(paths[path_count].path, path);
+        paths[path_count].self_cycles = self_cycles;
+        paths[path_count].calls = 1;
+        path_count++;
+    }
+}
+
+// ============================================================================
+// Replay the trace oldest -> newest with a call stack
+// ============================================================================
+static void replay(void) {
+    uint32_t head = header[1];
+    uint32_t size = header[3];
+    uint32_t count = (head < size) ? head : size;
+    uint32_t start = (head < size) ? 0 : head % size;
+
+    Frame stack[MAX_DEPTH];
+    uint32_t depth = 0;
+    uint64_t now = 0;
+    uint64_t pending_high = 0;
+    uint32_t unmatched = 0;
+
+    for (uint32_t n = 0; n < count; n++) {
+        uint32_t r = records[(start + n) % size];
+        uint32_t zone = r >> PROF_ID_SHIFT;
+        uint32_t delta = r & PROF_DELTA_MAX;
+
+        if (zone == PROF_ID_SYNC) {
+            pending_high += (uint64_t)delta << 24;
+            continue;
+        }
+        now += pending_high + delta;
+        pending_high = 0;
+
+        if (zone >= PROF_ZONE_COUNT) {
+            unmatched++;
+            continue;
+        }
+
+        if (!(r & PROF_EXIT_FLAG)) {
+            if (depth < MAX_DEPTH) {
+                stack[depth].zone = zone;
+                stack[depth].enter_time = now;
+                stack[depth].child_cycles = 0;
+                depth++;
+            }
+            continue;
+        }
+
+        // Exit: find the matching entry (the oldest records of a wrapped
+        // ring may have lost their entries - those exits are skipped)
+        int32_t match = -1;
+        for (int32_t i = (int32_t)depth - 1; i >= 0; i--) {
+            if (stack[i].zone == zone) { match = i; break; }
+        }
+        if (match < 0) {
+            unmatched++;
+            continue;
+        }
+        unmatched += depth - 1 - match;
+
+        uint64_t inclusive = now - stack[match].enter_time;
+        uint64_t self = inclusive - stack[match].child_cycles;
+        zone_add_sample(zone, inclusive);
+        path_add(stack, match + 1, self);
+
+        depth = match;
+        if (depth > 0) {
+            stack[depth - 1].child_cycles += inclusive;
+        }
+    }
+
+    printf("Records: %u  (head %u, ring %u)  unmatched: %u  still open: %u\n\n",
+           count, head, size, unmatched, depth);
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_path(const void *a, const void *b) {
+    const PathStats *x = a, *y = b;
+    return (x->self_cycles < y->self_cycles) - (x->self_cycles > y->self_cycles);
+}
+
+static uint64_t percentile(const ZoneStats *z, uint32_t pct) {
+    uint32_t index = (uint32_t)(((uint64_t)(z->count - 1) * pct + 50) / 100);
+    return z->samples[index];
+}
+
+static void print_zone_table(double cycles_per_us) {
+    printf("%-20s %8s %9s %9s %9s %9s %9s %9s   (cycles)\n",
+           "Zone", "Calls", "Min", "Avg", "Max", "p50", "p90", "p99");
+
+    for (uint32_t i = 0; i < PROF_ZONE_COUNT; i++) {
+        ZoneStats *z = &zones[i];
+        if (z->count == 0) continue;
+
+        qsort(z->samples, z->count, sizeof(uint64_t), cmp_u64);
+        uint64_t sum = 0;
+        for (uint32_t s = 0; s < z->count; s++) sum += z->samples[s];
+
+        printf("%-20s %8u %9llu %9llu %9llu %9llu %9llu %9llu   max %.1f us\n",
+               zone_names[i], z->count,
+               (unsigned long long)z->samples[0],
+               (unsigned long long)(sum / z->count),
+               (unsigned long long)z->samples[z->count - 1],
+               (unsigned long long)percentile(z, 50),
+               (unsigned long long)percentile(z, 90),
+               (unsigned long long)percentile(z, 99),
+               z->samples[z->count - 1] / cycles_per_us);
+    }
+    printf("\n");
+}
+
+static void print_flame_summary(void) {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < path_count; i++) total += paths[i].self_cycles;
+    if (total == 0) return;
+
+    qsort(paths, path_count, sizeof(PathStats), cmp_path);
+
+    printf("Self time by call path:\n");
+    for (uint32_t i = 0; i < path_count; i++) {
+        double pct = 100.0 * paths[i].self_cycles / total;
+        char bar[41];
+        int width = (int)(pct * 40 / 100 + 0.5);
+        memset(bar, '#', width);
+        bar[width] = '\0';
+        printf("  %5.1f%% %-40s %s\n", pct, bar, paths[i].path);
+    }
+
+    printf("\nFolded stacks (flamegraph.pl input):\n");
+    for (uint32_t i = 0; i < path_count; i++) {
+        printf("%s %llu\n", paths[i].path, (unsigned long long)paths[i].self_cycles);
+    }
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <trace.bin | uart_log.txt>\n", argv[0]);
+        return 1;
+    }
+    if (!load_trace(argv[1])) {
+        return 1;
+    }
+
+    double cycles_per_us = header[2] ? header[2] / 1e6 : 72.0;
+    printf("=== PROFILER TRACE: %s (%.0f MHz) ===\n", argv[1], cycles_per_us);
+
+    replay();
+    print_zone_table(cycles_per_us);
+    print_flame_summary();
+
+    return 0;
+}
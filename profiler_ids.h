@@ -0,0 +1,32 @@
+/**
+ ******************************************************************************
+ * @file           : profiler_ids.h
+ * @brief          : Profiler zone IDs - shared by firmware and host decoder
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 23, 2026
+ ******************************************************************************
+ * Add a zone here once; the enum (firmware) and the name table
+ * (profiler_decode.c) are both generated from this list.
+ * Max 126 zones (7-bit ID, 127 is reserved).
+ ******************************************************************************
+ */
+
+#ifndef PROFILER_IDS_H
+#define PROFILER_IDS_H
+
+#define PROF_ZONE_LIST(X)                           \
+    X(PROF_MAIN_LOOP,       "main_loop")            \
+    X(PROF_GESTURES,        "gesture_update")       \
+    X(PROF_PATTERN_STEP,    "pattern_step")         \
+    X(PROF_SYSTICK_ISR,     "SysTick_Handler")      \
+    X(PROF_BUTTON_TICK,     "button_tick")          \
+    X(PROF_LED_ENGINE,      "led_engine")
+
+#define PROF_ZONE_ENUM(id, name)    id,
+
+typedef enum {
+    PROF_ZONE_LIST(PROF_ZONE_ENUM)
+    PROF_ZONE_COUNT
+} ProfZone;
+
+#endif // PROFILER_IDS_H
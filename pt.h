@@ -0,0 +1,85 @@
+/**
+ ******************************************************************************
+ * @file           : pt.h
+ * @brief          : Stackless coroutines (protothreads) for the tick scheduler
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 27, 2026
+ ******************************************************************************
+ * The Day 3 patterns keep their place in static step/position/direction
+ * variables and a hand-written state machine. A protothread is written
+ * as straight-line code instead and returns to the caller at every
+ * yield; the next call jumps back to just after that yield (a switch on
+ * the source line, Duff's-device style):
+ *
+ *   static PT_THREAD(knight_rider(Pt *pt, LedFrame *f)) {
+ *       PT_BEGIN(pt);
+ *       for (;;) {
+ *           for (pt->i = 0; pt->i + 1 < f->width; pt->i++) {
+ *               draw(f, pt->i);
+ *               PT_YIELD_FOR(pt, 100);     // Back here in 100 ms
+ *           }
+ *           ...
+ *       }
+ *       PT_END(pt);
+ *   }
+ *
+ * The whole state is one Pt - 12 bytes - so dozens can run at once, each
+ * resumed from the tick with pt_due() / the scheduler's own loop.
+ *
+ * Rules of stackless coroutines:
+ *   - Locals do not survive a yield: keep loop counters in pt->i / pt->j
+ *     (or in the object the coroutine works on).
+ *   - No 'switch' around a yield inside the body (the macros are cases).
+ *   - Yield only from the coroutine function itself, not from a callee.
+ *
+ * PT_YIELD_FOR() adds to the previous wake-up time, not to "now", so a
+ * late resume does not make the animation drift.
+ ******************************************************************************
+ */
+
+#ifndef PT_H
+#define PT_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t lc;                    // Resume point (source line), 0 = start
+    uint16_t i;                     // Loop counters that survive a yield
+    uint16_t j;
+    uint32_t wake_ms;               // Resume at or after this time
+} Pt;
+
+typedef enum {
+    PT_WAITING,                     // Blocked in PT_WAIT_UNTIL
+    PT_YIELDED,                     // Yielded, resume at wake_ms
+    PT_ENDED                        // Ran off PT_END (restarts next time)
+} PtStatus;
+
+#define PT_THREAD(name_args)        PtStatus name_args
+
+#define PT_INIT(pt, now_ms) \
+    do { (pt)->lc = 0; (pt)->i = 0; (pt)->j = 0; (pt)->wake_ms = (now_ms); } while (0)
+
+#define PT_BEGIN(pt)                switch ((pt)->lc) { case 0:
+
+#define PT_END(pt) \
+    } (pt)->lc = 0; return PT_ENDED
+
+// Resume on the next call
+#define PT_YIELD(pt) \
+    do { (pt)->lc = __LINE__; return PT_YIELDED; case __LINE__:; } while (0)
+
+// Resume 'ms' after the previous wake-up
+#define PT_YIELD_FOR(pt, ms) \
+    do { (pt)->wake_ms += (ms); PT_YIELD(pt); } while (0)
+
+// Return here on every call until 'cond' holds
+#define PT_WAIT_UNTIL(pt, cond) \
+    do { (pt)->lc = __LINE__; case __LINE__: if (!(cond)) return PT_WAITING; } while (0)
+
+// Due to be resumed (signed difference: survives the ms counter wrapping)
+static inline uint8_t pt_due(const Pt *pt, uint32_t now_ms) {
+    return (int32_t)(now_ms - pt->wake_ms) >= 0;
+}
+
+#endif // PT_H
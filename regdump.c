@@ -0,0 +1,125 @@
+/**
+ ******************************************************************************
+ * @file           : regdump.c
+ * @brief          : Register block snapshot + dump over UART, with diff mode
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ */
+
+#include "regdump.h"
+#include "fmt.h"
+#include "uart.h"
+#include "stm32f303_regs.h"
+
+#define NAME_WIDTH          9
+
+// ============================================================================
+// Blocks (readable registers only - BSRR / BRR always read 0)
+// ============================================================================
+static const RegDesc rcc_regs[] = {
+    { "CR",       0x00 }, { "CFGR",     0x04 }, { "CIR",      0x08 },
+    { "APB2RSTR", 0x0C }, { "APB1RSTR", 0x10 }, { "AHBENR",   0x14 },
+    { "APB2ENR",  0x18 }, { "APB1ENR",  0x1C }, { "BDCR",     0x20 },
+    { "CSR",      0x24 }, { "AHBRSTR",  0x28 }, { "CFGR2",    0x2C },
+    { "CFGR3",    0x30 },
+};
+
+static const RegDesc gpio_regs[] = {
+    { "MODER",    0x00 }, { "OTYPER",   0x04 }, { "OSPEEDR",  0x08 },
+    { "PUPDR",    0x0C }, { "IDR",      0x10 }, { "ODR",      0x14 },
+    { "LCKR",     0x1C }, { "AFRL",     0x20 }, { "AFRH",     0x24 },
+};
+
+#define COUNT(a)            ((uint8_t)(sizeof(a) / sizeof((a)[0])))
+
+const RegBlock regdump_rcc   = { "RCC",   RCC_BASE,   rcc_regs,  COUNT(rcc_regs)  };
+const RegBlock regdump_gpioa = { "GPIOA", GPIOA_BASE, gpio_regs, COUNT(gpio_regs) };
+const RegBlock regdump_gpioe = { "GPIOE", GPIOE_BASE, gpio_regs, COUNT(gpio_regs) };
+
+// ============================================================================
+// Snapshot: reads only, back to back
+// ============================================================================
+void regdump_snapshot(const RegBlock *block, RegSnapshot *snap) {
+    for (uint8_t i = 0; i < block->count; i++) {
+        snap->values[i] = REG32(block->base + block->regs[i].offset);
+    }
+    snap->valid = 1;
+}
+
+// ============================================================================
+// Format in one pass
+// ============================================================================
+static char *put_hex(char *p, uint32_t value) {
+    p[0] = '0';
+    p[1] = 'x';
+    return p + 2 + fmt_hex(p + 2, value, 8);
+}
+
+uint32_t regdump_format(char *dst, const RegBlock *block,
+                        const RegSnapshot *now, const RegSnapshot *prev) {
+    char *p = dst;
+    uint8_t changed = 0;
+
+    for (uint8_t i = 0; i < block->count; i++) {
+        uint32_t value = now->values[i];
+
+        if (prev && prev->valid && prev->values[i] == value) {
+            continue;
+        }
+        changed++;
+
+        p += fmt_str(p, block->name, 6);
+        p += fmt_str(p, block->regs[i].name, NAME_WIDTH);
+
+        if (prev && prev->valid) {
+            p = put_hex(p, prev->values[i]);
+            p += fmt_str(p, " -> ", 0);
+            p = put_hex(p, value);
+            p += fmt_str(p, "  changed ", 0);
+            p = put_hex(p, prev->values[i] ^ value);
+        } else {
+            p = put_hex(p, value);
+            *p++ = ' ';
+            *p++ = ' ';
+            p += fmt_bin(p, value, 32, 8, ' ');
+        }
+        *p++ = '\r';
+        *p++ = '\n';
+    }
+
+    if (prev && prev->valid && !changed) {
+        p += fmt_str(p, block->name, 6);
+        p += fmt_str(p, "unchanged\r\n", 0);
+    }
+    *p = '\0';
+    return (uint32_t)(p - dst);
+}
+
+// ============================================================================
+// Dump to the UART
+// ============================================================================
+void regdump(const RegBlock *block, RegSnapshot *last, uint8_t diff_only) {
+    static char text[REGDUMP_BUF_SIZE];
+    RegSnapshot now;
+
+    regdump_snapshot(block, &now);
+    uart_write(text, regdump_format(text, block, &now, diff_only ? last : 0));
+    *last = now;
+}
+
+uint8_t regdump_command(char c) {
+    static RegSnapshot rcc_last, gpioa_last, gpioe_last;
+    static uint8_t diff_only = 0;
+
+    switch (c) {
+        case 'r': regdump(&regdump_rcc,   &rcc_last,   diff_only); return 1;
+        case 'a': regdump(&regdump_gpioa, &gpioa_last, diff_only); return 1;
+        case 'e': regdump(&regdump_gpioe, &gpioe_last, diff_only); return 1;
+        case 'd':
+            diff_only = !diff_only;
+            uart_puts(diff_only ? "regdump: diff only\r\n" : "regdump: full\r\n");
+            return 1;
+    }
+    return 0;
+}
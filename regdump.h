@@ -0,0 +1,67 @@
+/**
+ ******************************************************************************
+ * @file           : regdump.h
+ * @brief          : Register block snapshot + dump over UART, with diff mode
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * A block (RCC, GPIOA, GPIOE) is read in one tight pass into a snapshot,
+ * so all values belong to the same moment, then formatted with fmt.c
+ * into one buffer and sent with a single uart_write():
+ *
+ *   GPIOE MODER    0x55550000  01010101 01010101 00000000 00000000
+ *
+ * Diff mode prints only the registers that changed since the previous
+ * snapshot of that block, with the changed bits:
+ *
+ *   GPIOE ODR      0x00000200 -> 0x00000400  changed 0x00000600
+ *
+ * From the debug console (regdump_command(), fed from uart_getc()):
+ *   r / a / e   dump RCC / GPIOA / GPIOE
+ *   d           toggle diff-only mode
+ ******************************************************************************
+ */
+
+#ifndef REGDUMP_H
+#define REGDUMP_H
+
+#include <stdint.h>
+
+#define REGDUMP_MAX_REGS    16
+#define REGDUMP_LINE_MAX    72
+#define REGDUMP_BUF_SIZE    (REGDUMP_MAX_REGS * REGDUMP_LINE_MAX + 64)
+
+typedef struct {
+    const char *name;
+    uint8_t offset;                 // From the block base
+} RegDesc;
+
+typedef struct {
+    const char *name;
+    uint32_t base;
+    const RegDesc *regs;
+    uint8_t count;                  // <= REGDUMP_MAX_REGS
+} RegBlock;
+
+typedef struct {
+    uint32_t values[REGDUMP_MAX_REGS];
+    uint8_t valid;                  // 0 until the first snapshot
+} RegSnapshot;
+
+extern const RegBlock regdump_rcc;
+extern const RegBlock regdump_gpioa;
+extern const RegBlock regdump_gpioe;
+
+void regdump_snapshot(const RegBlock *block, RegSnapshot *snap);
+
+// Formats 'now' (diff against 'prev' if not NULL); returns the length
+uint32_t regdump_format(char *dst, const RegBlock *block,
+                        const RegSnapshot *now, const RegSnapshot *prev);
+
+// Snapshot + format + one UART write; 'last' keeps the block's previous snapshot
+void regdump(const RegBlock *block, RegSnapshot *last, uint8_t diff_only);
+
+// Console letter -> dump (see above); returns 0 for an unknown letter
+uint8_t regdump_command(char c);
+
+#endif // REGDUMP_H
@@ -0,0 +1,446 @@
+/**
+ ******************************************************************************
+ * @file           : soak_sim.c
+ * @brief          : Host tool - a simulated day of every pattern, fast-forward
+ * @author         : Aabel Jeevan Jose
+ * @date           : November 1, 2026
+ ******************************************************************************
+ * Runs the unchanged patterns, software timers and tick code on the
+ * virtual clock (systick.h, HOST_SIM): nothing waits in real time, the
+ * clock skips straight to the next frame or timer, as tickless idle
+ * would. A day of firmware time takes well under a second.
+ *
+ *   g++ -std=c++17 -O2 -c brightness_lut.cpp
+ *   gcc -DHOST_SIM -DPROFILER_ENABLED=0 -O2 -o soak_sim soak_sim.c systick.c \
+ *       timer.c patterns.c zone.c anim.c anim_demo.c compass.c host_sim.c \
+ *       brightness_lut.o
+ *   ./soak_sim [hours] [--tick]
+ *
+ * The engine is main.c's for the on-board LEDs without PWM: a SysTick
+ * hook that runs the pattern when due and writes the frame to GPIOE_BSRR.
+ * A GPIOE model applies BSRR to ODR and checks every write against the
+ * ODR timeline so far:
+ *   - only PE8-PE15 ever change
+ *   - frames come exactly on time, all day: every step period or
+ *     coroutine delay, and each animation frame as long as in its
+ *     first loop
+ *   - each pattern's own rule: the spins move one position per frame,
+ *     blink alternates, the binary counter counts up by one and wraps
+ *     255 -> 0, chaos covers all 256 frames every 256, breathing adds or
+ *     takes one LED, the animation repeats its first loop exactly, the
+ *     compass lights exactly the LED the sensor stub points it at
+ *   - no frame ever more than GAP_MAX_MS after the previous one
+ * The clock starts half the run before the 32-bit ms counter wraps, so
+ * every pattern and timer also crosses the wrap. Timers (one periodic,
+ * one-shots from 1 ms to 12 h) must fire on their exact tick.
+ *
+ * --tick runs every tick instead of skipping; the timeline hashes must
+ * be the same as without it. Exit code 1 on any failure.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "patterns.h"
+#include "clock_config.h"
+#include "systick.h"
+#include "timer.h"
+#include "board.h"
+#include "lsm303.h"
+#include "host_sim.h"
+#include "stm32f303_regs.h"
+
+#define DEFAULT_HOURS       24
+#define GAP_MAX_MS          2000
+#define TIMER_PERIOD_MS     1000
+#define ONE_SHOTS           6
+
+extern const uint8_t anim_demo[];
+
+// ============================================================================
+// Board stub: no clock tree on the host (systick.c keeps HSI timing)
+// ============================================================================
+uint8_t clock_add_listener(ClockListener listener) {
+    (void)listener;
+    return 1;
+}
+
+// ============================================================================
+// Engine: main.c's on-board path, one pattern
+// ============================================================================
+static const uint8_t ring[LED_COUNT] = LED_COMPASS_RING;
+static uint8_t led_bits[LED_FRAME_BYTES(LED_COUNT)];
+static LedFrame led_frame = { led_bits, LED_COUNT, ring };
+static const Pattern *pattern;
+static Pt pattern_pt;
+
+static void engine_tick(uint32_t now) {
+    if (pattern && pt_due(&pattern_pt, now)) {
+        pattern_run(pattern, &pattern_pt, &led_frame, now);
+        GPIOE_BSRR = LED_FRAME_BSRR(led_bits[0]);
+        host_sim_flush();               // Model sees the write on this tick
+    }
+}
+
+// ============================================================================
+// ODR timeline checks
+// ============================================================================
+typedef uint8_t (*FrameRule)(uint8_t prev, uint8_t frame, uint32_t n);
+
+static struct {
+    FrameRule rule;
+    uint32_t interval_ms;
+    uint32_t gap_ms;                    // Since the previous frame
+    uint32_t frames;
+    uint32_t last_ms;
+    uint8_t last;
+    uint32_t hash;                      // FNV-1a over (ms since start, frame)
+    uint32_t start_ms;
+    uint32_t errors;
+} tl;
+
+static uint32_t errors;
+
+static void fail(const char *what, uint32_t now) {
+    if (tl.errors++ < 5) {
+        printf("    FAIL at %.3f h (frame %u): %s\n",
+               (now - tl.start_ms) / 3600000.0, tl.frames, what);
+    }
+}
+
+static uint8_t ring_pos(uint8_t frame) {
+    for (uint8_t pos = 0; pos < LED_COUNT; pos++) {
+        if (frame == (1 << ring[pos])) {
+            return pos;
+        }
+    }
+    return 0xFF;
+}
+
+static uint8_t one_led(uint8_t frame) {
+    return frame && !(frame & (frame - 1));
+}
+
+static uint8_t rule_clockwise(uint8_t prev, uint8_t frame, uint32_t n) {
+    return ring_pos(frame) != 0xFF && (n == 0 || ring_pos(frame) == ((ring_pos(prev) + 1) & 7));
+}
+
+static uint8_t rule_counter_clockwise(uint8_t prev, uint8_t frame, uint32_t n) {
+    return ring_pos(frame) != 0xFF && (n == 0 || ring_pos(frame) == ((ring_pos(prev) + 7) & 7));
+}
+
+static uint8_t rule_blink(uint8_t prev, uint8_t frame, uint32_t n) {
+    return (frame == 0x00 || frame == 0xFF) && (n == 0 || (frame ^ prev) == 0xFF);
+}
+
+static uint8_t rule_pin_order(uint8_t prev, uint8_t frame, uint32_t n) {
+    return one_led(frame) && (n == 0 || frame == (uint8_t)((prev << 1) | (prev >> 7)));
+}
+
+static uint8_t rule_knight_rider(uint8_t prev, uint8_t frame, uint32_t n) {
+    return one_led(frame) && (n == 0 || frame == (uint8_t)(prev << 1) || frame == (prev >> 1));
+}
+
+static uint8_t rule_binary(uint8_t prev, uint8_t frame, uint32_t n) {
+    return n == 0 || frame == (uint8_t)(prev + 1);
+}
+
+static uint8_t rule_chaos(uint8_t prev, uint8_t frame, uint32_t n) {
+    static uint8_t seen[256];
+    static uint32_t window;
+
+    (void)prev;
+    if (n == 0 || n - window == 256) {
+        for (uint32_t v = 0; n && v < 256; v++) {
+            if (!seen[v]) {
+                return 0;
+            }
+        }
+        memset(seen, 0, sizeof seen);
+        window = n;
+    }
+    seen[frame] = 1;
+    return 1;
+}
+
+static uint8_t rule_breathing(uint8_t prev, uint8_t frame, uint32_t n) {
+    uint8_t lowest = (frame & (frame + 1)) == 0;    // 0, 1, 3, 7 .. 0xFF
+    return lowest && (n == 0 || frame == (uint8_t)(prev << 1 | 1) || frame == (prev >> 1));
+}
+
+// The first loop (frames and how long each stayed up) is the reference
+// for all the others
+static uint8_t rule_animation(uint8_t prev, uint8_t frame, uint32_t n) {
+    static uint8_t loop[1024];
+    static uint32_t loop_gap_ms[1024];
+    uint32_t frames = anim_demo[6] | (anim_demo[7] << 8);
+
+    (void)prev;
+    if (frames == 0 || frames > sizeof loop) {
+        return 0;
+    }
+    if (n < frames) {
+        loop[n] = frame;
+        loop_gap_ms[n] = tl.gap_ms;
+        return 1;
+    }
+    if (n == frames) {
+        loop_gap_ms[0] = tl.gap_ms;     // Frame 0 again, after the last one's duration
+    }
+    return loop[n % frames] == frame && loop_gap_ms[n % frames] == tl.gap_ms;
+}
+
+// ============================================================================
+// Sensor stub: a level board turning one octant per minute; every tenth
+// minute it is tilted instead. compass_expected() is the LED to light.
+// ============================================================================
+#define COMPASS_TURN_MS     60000
+
+static const int16_t octant_n[8] = { 400, 283, 0, -283, -400, -283, 0, 283 };
+static const int16_t octant_e[8] = { 0, 283, 400, 283, 0, -283, -400, -283 };
+
+static uint32_t compass_minute(void) {
+    return (get_time_ms() - tl.start_ms) / COMPASS_TURN_MS;
+}
+
+static uint8_t compass_tilted(uint32_t minute) {
+    return minute % 10 == 9;
+}
+
+static uint8_t compass_expected(void) {
+    uint32_t minute = compass_minute();
+    return (uint8_t)((compass_tilted(minute) ? minute / 10 : minute) & 7);
+}
+
+// Sensor axes, board.h: north = X, east = -Y, up = Z
+const Lsm303Sample *lsm303_latest(void) {
+    static Lsm303Sample s;
+    uint8_t k = compass_expected();
+
+    if (compass_tilted(compass_minute())) {
+        // Downhill towards k: the reaction to gravity leans uphill
+        s.accel[0] = (int16_t)-octant_n[k];
+        s.accel[1] = octant_e[k];
+        s.accel[2] = 917;
+        s.mag[0] = 400;
+        s.mag[1] = 0;
+    } else {
+        s.accel[0] = 0;
+        s.accel[1] = 0;
+        s.accel[2] = 1000;
+        s.mag[0] = octant_n[k];
+        s.mag[1] = (int16_t)-octant_e[k];
+    }
+    s.mag[2] = -300;                    // Dip: removed by the tilt compensation
+    s.accel_count++;
+    s.mag_count++;
+    return &s;
+}
+
+static uint8_t rule_compass(uint8_t prev, uint8_t frame, uint32_t n) {
+    (void)prev;
+    (void)n;
+    return frame == (1 << ring[compass_expected()]);
+}
+
+// Frame interval: the step period, or the coroutine's own (0 = varies)
+static const struct {
+    const char *name;
+    FrameRule rule;
+    uint32_t interval_ms;
+} soaks[PATTERN_COUNT] = {
+    { "clockwise spin",         rule_clockwise,         150 },
+    { "counter-clockwise spin", rule_counter_clockwise, 150 },
+    { "all blink",              rule_blink,             300 },
+    { "pin order",              rule_pin_order,         150 },
+    { "knight rider",           rule_knight_rider,      100 },
+    { "binary counter",         rule_binary,            200 },
+    { "random chaos",           rule_chaos,             150 },
+    { "breathing",              rule_breathing,         150 },
+    { "split zones",            0,                      0 },
+    { "animation",              rule_animation,         0 },
+    { "compass",                rule_compass,           50 },
+};
+
+static void gpioe_hook(uint32_t addr) {
+    if (addr != GPIOE_BASE + 0x18) {
+        return;
+    }
+    volatile uint32_t *bsrr = host_sim_peek(addr);
+    volatile uint32_t *odr = host_sim_peek(GPIOE_BASE + 0x14);
+    uint32_t now = get_time_ms();
+
+    *odr = (*odr | (*bsrr & 0xFFFF)) & ~(*bsrr >> 16);
+    *bsrr = 0;                          // Write-only
+
+    uint8_t frame = (uint8_t)(*odr >> LED_FIRST_PIN);
+    uint32_t since = now - tl.start_ms;
+
+    if (*odr & ~(0xFFu << LED_FIRST_PIN)) {
+        fail("ODR changed outside PE8-PE15", now);
+    }
+    if (tl.frames && (now == tl.last_ms || now - tl.last_ms > GAP_MAX_MS)) {
+        fail("frame gap out of range", now);
+    }
+    tl.gap_ms = now - tl.last_ms;
+    if (tl.frames && tl.interval_ms && tl.gap_ms != tl.interval_ms) {
+        fail("frame interval drifted", now);
+    }
+    if (!tl.rule(tl.last, frame, tl.frames)) {
+        fail("frame breaks the pattern's rule", now);
+    }
+
+    for (uint8_t i = 0; i < 5; i++) {
+        uint8_t byte = (i < 4) ? (uint8_t)(since >> (8 * i)) : frame;
+        tl.hash = (tl.hash ^ byte) * 16777619u;
+    }
+    tl.last = frame;
+    tl.last_ms = now;
+    tl.frames++;
+}
+
+// ============================================================================
+// Timers: must fire on their exact tick, across the wrap too
+// ============================================================================
+typedef struct {
+    Timer timer;
+    uint32_t due_ms;
+    uint32_t fired;
+} SoakTimer;
+
+static SoakTimer periodic;
+static SoakTimer one_shots[ONE_SHOTS];
+static const uint32_t one_shot_ms[ONE_SHOTS] = {
+    1, 37, 1000, (1u << 20) + 5, 6 * 3600000u, 12 * 3600000u
+};
+
+static void soak_timer_fired(Timer *t, uint32_t now_ms) {
+    SoakTimer *st = (SoakTimer *)t->arg;
+
+    if (now_ms != st->due_ms) {
+        fail("timer fired off its tick", now_ms);
+    }
+    st->fired++;
+    st->due_ms += t->period_ms;
+}
+
+static void timers_start(uint32_t now) {
+    timer_wheel_init(&system_timers, now);
+    timer_init(&periodic.timer, soak_timer_fired, &periodic);
+    periodic.due_ms = now + TIMER_PERIOD_MS;
+    periodic.fired = 0;
+    timer_start(&system_timers, &periodic.timer, TIMER_PERIOD_MS, TIMER_PERIOD_MS);
+
+    for (uint8_t i = 0; i < ONE_SHOTS; i++) {
+        timer_init(&one_shots[i].timer, soak_timer_fired, &one_shots[i]);
+        one_shots[i].due_ms = now + one_shot_ms[i];
+        one_shots[i].fired = 0;
+        timer_start(&system_timers, &one_shots[i].timer, one_shot_ms[i], 0);
+    }
+}
+
+static void timers_check(uint32_t run_ms) {
+    if (periodic.fired != run_ms / TIMER_PERIOD_MS) {
+        fail("periodic timer count", get_time_ms());
+    }
+    for (uint8_t i = 0; i < ONE_SHOTS; i++) {
+        if (one_shots[i].fired != (one_shot_ms[i] <= run_ms)) {
+            fail("one-shot timer count", get_time_ms());
+        }
+    }
+    timer_stop(&periodic.timer);
+}
+
+// ============================================================================
+// Fast-forward: from one due frame or timer to the next
+// ============================================================================
+static void run_for(uint32_t ms, uint8_t every_tick) {
+    uint32_t end = get_time_ms() + ms;
+
+    while (get_time_ms() != end) {
+        uint32_t now = get_time_ms();
+        uint32_t left = end - now;
+
+        if (every_tick) {
+            systick_sim_run(1);
+            continue;
+        }
+        int32_t to_frame = (int32_t)(pattern_pt.wake_ms - now);
+        uint32_t next = (to_frame > 0 && (uint32_t)to_frame < left) ? (uint32_t)to_frame : left;
+        if (to_frame <= 0) {
+            next = 1;
+        }
+        systick_sim_sleep(timer_wheel_idle_ms(&system_timers, next));
+    }
+}
+
+static uint8_t rule_any(uint8_t prev, uint8_t frame, uint32_t n) {
+    (void)prev;
+    (void)frame;
+    (void)n;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    uint32_t hours = DEFAULT_HOURS;
+    uint8_t every_tick = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tick") == 0) {
+            every_tick = 1;
+        } else {
+            hours = (uint32_t)strtoul(argv[i], 0, 10);
+        }
+    }
+    if (hours == 0 || hours > 48) {
+        fprintf(stderr, "usage: %s [hours 1-48] [--tick]\n", argv[0]);
+        return 2;
+    }
+    uint32_t run_ms = hours * 3600000u;
+
+    host_sim_reset();
+    host_sim_add_hook(gpioe_hook);
+    timer_service_init();               // Timers tick before the engine, as in main.c
+    systick_add_hook(engine_tick);
+
+    printf("Soak: %u h of firmware time per pattern on the virtual clock%s,\n"
+           "crossing the ms counter wrap at %u h\n\n",
+           hours, every_tick ? " (every tick)" : "", hours / 2);
+
+    for (uint8_t n = 0; n < PATTERN_COUNT; n++) {
+        struct timespec t0, t1;
+        uint32_t start = 0u - run_ms / 2;
+
+        memset(&tl, 0, sizeof tl);
+        tl.rule = soaks[n].rule ? soaks[n].rule : rule_any;
+        tl.interval_ms = soaks[n].interval_ms;
+        tl.start_ms = start;
+        *host_sim_peek(GPIOE_BASE + 0x14) = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        pattern = 0;
+        systick_sim_set_time(start);
+        timers_start(start);
+        pattern = &patterns[n];
+        pattern_start(&pattern_pt, start + 1);
+        run_for(run_ms, every_tick);
+        host_sim_flush();
+        timers_check(run_ms);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        if (tl.frames < run_ms / GAP_MAX_MS) {
+            fail("too few frames", get_time_ms());
+        }
+        printf("%-24s %8u frames  timeline %08X  %6.3f s host  %s\n",
+               soaks[n].name, tl.frames, tl.hash,
+               (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9,
+               tl.errors ? "FAIL" : "ok");
+        errors += tl.errors;
+    }
+
+    printf("\n%s\n", errors ? "FAILED" : "All timelines as expected");
+    return errors ? 1 : 0;
+}
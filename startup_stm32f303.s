@@ -0,0 +1,478 @@
+/**
+ ******************************************************************************
+ * @file           : startup_stm32f303.s
+ * @brief          : Vector table and Reset_Handler - STM32F303VC
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 20, 2026
+ ******************************************************************************
+ * What happens between reset and main() (see day4_memory.c):
+ *   1. Start the DWT cycle counter so boot time can be measured
+ *   2. Copy .data initial values from Flash to RAM
+ *   3. Zero .bss
+ *      .noinit is NOT touched - it keeps its contents across resets
+ *   4. Enable the FPU (CP10/CP11 full access)
+ *   5. Run C/C++ static constructors
+ *   6. Record reset-to-main cycles (boot_stats_record)
+ *   7. Call main()
+ *
+ * Steps 2 and 3 move 32 bytes per LDM/STM burst (8 registers) and only
+ * fall back to single words for the tail, instead of the usual
+ * one-word-per-iteration loop.
+ ******************************************************************************
+ */
+
+    .syntax unified
+    .cpu cortex-m4
+    .fpu softvfp
+    .thumb
+
+.global g_pfnVectors
+.global Default_Handler
+
+/* Symbols from STM32F303VCTx_FLASH.ld (all 4-byte aligned) */
+.word   _sidata
+.word   _sdata
+.word   _edata
+.word   _sbss
+.word   _ebss
+
+/* Cortex-M4 core registers used before main() */
+.equ    DEMCR,          0xE000EDFC
+.equ    DEMCR_TRCENA,   0x01000000
+.equ    DWT_CTRL,       0xE0001000
+.equ    DWT_CYCCNT,     0xE0001004
+.equ    SCB_CPACR,      0xE000ED88
+
+/* ============================================================================
+ * Reset_Handler
+ * ============================================================================ */
+    .section .text.Reset_Handler
+    .weak   Reset_Handler
+    .type   Reset_Handler, %function
+Reset_Handler:
+    /* 1. Cycle counter: TRCENA, CYCCNT = 0, CYCCNTENA */
+    ldr     r0, =DEMCR
+    ldr     r1, [r0]
+    orr     r1, r1, #DEMCR_TRCENA
+    str     r1, [r0]
+    ldr     r0, =DWT_CYCCNT
+    movs    r1, #0
+    str     r1, [r0]
+    ldr     r0, =DWT_CTRL
+    ldr     r1, [r0]
+    orr     r1, r1, #1
+    str     r1, [r0]
+
+    /* 2. Copy .data: r0 = src (Flash), r1 = dst (RAM), r2 = end */
+    ldr     r0, =_sidata
+    ldr     r1, =_sdata
+    ldr     r2, =_edata
+    sub     r12, r2, #32            /* Last address a full burst may start at */
+copy_data_burst:
+    cmp     r1, r12
+    bhi     copy_data_tail
+    ldmia   r0!, {r3-r10}
+    stmia   r1!, {r3-r10}
+    b       copy_data_burst
+copy_data_tail:
+    cmp     r1, r2
+    bhs     zero_bss
+    ldr     r3, [r0], #4
+    str     r3, [r1], #4
+    b       copy_data_tail
+
+    /* 3. Zero .bss: r1 = dst, r2 = end, r3-r10 = 0 */
+zero_bss:
+    ldr     r1, =_sbss
+    ldr     r2, =_ebss
+    sub     r12, r2, #32
+    movs    r3, #0
+    movs    r4, #0
+    movs    r5, #0
+    movs    r6, #0
+    mov     r7, #0
+    mov     r8, #0
+    mov     r9, #0
+    mov     r10, #0
+zero_bss_burst:
+    cmp     r1, r12
+    bhi     zero_bss_tail
+    stmia   r1!, {r3-r10}
+    b       zero_bss_burst
+zero_bss_tail:
+    cmp     r1, r2
+    bhs     enable_fpu
+    str     r3, [r1], #4
+    b       zero_bss_tail
+
+    /* 4. FPU: CPACR.CP10 = CP11 = full access */
+enable_fpu:
+    ldr     r0, =SCB_CPACR
+    ldr     r1, [r0]
+    orr     r1, r1, #(0xF << 20)
+    str     r1, [r0]
+    dsb
+    isb
+
+    /* 5. Static constructors (C++ objects, __attribute__((constructor))) */
+    bl      __libc_init_array
+
+    /* 6. Reset-to-main cycle count */
+    ldr     r0, =DWT_CYCCNT
+    ldr     r0, [r0]
+    bl      boot_stats_record
+
+    /* 7. Application */
+    bl      main
+
+loop_forever:
+    b       loop_forever
+
+    .size   Reset_Handler, .-Reset_Handler
+
+/* ============================================================================
+ * Default_Handler - any interrupt without its own handler ends up here.
+ * Stays in an infinite loop so the debugger shows where it went wrong.
+ * ============================================================================ */
+    .section .text.Default_Handler,"ax",%progbits
+Default_Handler:
+infinite_loop:
+    b       infinite_loop
+    .size   Default_Handler, .-Default_Handler
+
+/* ============================================================================
+ * Vector table - must sit at 0x08000000
+ * ============================================================================ */
+    .section .isr_vector,"a",%progbits
+    .type   g_pfnVectors, %object
+
+g_pfnVectors:
+    .word   _estack
+    .word   Reset_Handler
+    .word   NMI_Handler
+    .word   HardFault_Handler
+    .word   MemManage_Handler
+    .word   BusFault_Handler
+    .word   UsageFault_Handler
+    .word   0
+    .word   0
+    .word   0
+    .word   0
+    .word   SVC_Handler
+    .word   DebugMon_Handler
+    .word   0
+    .word   PendSV_Handler
+    .word   SysTick_Handler
+
+    /* External interrupts (IRQ0 - IRQ81) */
+    .word   WWDG_IRQHandler
+    .word   PVD_IRQHandler
+    .word   TAMP_STAMP_IRQHandler
+    .word   RTC_WKUP_IRQHandler
+    .word   FLASH_IRQHandler
+    .word   RCC_IRQHandler
+    .word   EXTI0_IRQHandler
+    .word   EXTI1_IRQHandler
+    .word   EXTI2_TSC_IRQHandler
+    .word   EXTI3_IRQHandler
+    .word   EXTI4_IRQHandler
+    .word   DMA1_Channel1_IRQHandler
+    .word   DMA1_Channel2_IRQHandler
+    .word   DMA1_Channel3_IRQHandler
+    .word   DMA1_Channel4_IRQHandler
+    .word   DMA1_Channel5_IRQHandler
+    .word   DMA1_Channel6_IRQHandler
+    .word   DMA1_Channel7_IRQHandler
+    .word   ADC1_2_IRQHandler
+    .word   USB_HP_CAN_TX_IRQHandler
+    .word   USB_LP_CAN_RX0_IRQHandler
+    .word   CAN_RX1_IRQHandler
+    .word   CAN_SCE_IRQHandler
+    .word   EXTI9_5_IRQHandler
+    .word   TIM1_BRK_TIM15_IRQHandler
+    .word   TIM1_UP_TIM16_IRQHandler
+    .word   TIM1_TRG_COM_TIM17_IRQHandler
+    .word   TIM1_CC_IRQHandler
+    .word   TIM2_IRQHandler
+    .word   TIM3_IRQHandler
+    .word   TIM4_IRQHandler
+    .word   I2C1_EV_IRQHandler
+    .word   I2C1_ER_IRQHandler
+    .word   I2C2_EV_IRQHandler
+    .word   I2C2_ER_IRQHandler
+    .word   SPI1_IRQHandler
+    .word   SPI2_IRQHandler
+    .word   USART1_IRQHandler
+    .word   USART2_IRQHandler
+    .word   USART3_IRQHandler
+    .word   EXTI15_10_IRQHandler
+    .word   RTC_Alarm_IRQHandler
+    .word   USBWakeUp_IRQHandler
+    .word   TIM8_BRK_IRQHandler
+    .word   TIM8_UP_IRQHandler
+    .word   TIM8_TRG_COM_IRQHandler
+    .word   TIM8_CC_IRQHandler
+    .word   ADC3_IRQHandler
+    .word   0
+    .word   0
+    .word   0
+    .word   SPI3_IRQHandler
+    .word   UART4_IRQHandler
+    .word   UART5_IRQHandler
+    .word   TIM6_DAC_IRQHandler
+    .word   TIM7_IRQHandler
+    .word   DMA2_Channel1_IRQHandler
+    .word   DMA2_Channel2_IRQHandler
+    .word   DMA2_Channel3_IRQHandler
+    .word   DMA2_Channel4_IRQHandler
+    .word   DMA2_Channel5_IRQHandler
+    .word   ADC4_IRQHandler
+    .word   0
+    .word   0
+    .word   COMP1_2_3_IRQHandler
+    .word   COMP4_5_6_IRQHandler
+    .word   COMP7_IRQHandler
+    .word   0
+    .word   0
+    .word   0
+    .word   0
+    .word   0
+    .word   0
+    .word   0
+    .word   USB_HP_IRQHandler
+    .word   USB_LP_IRQHandler
+    .word   USBWakeUp_RMP_IRQHandler
+    .word   0
+    .word   0
+    .word   0
+    .word   0
+    .word   FPU_IRQHandler
+    .size   g_pfnVectors, .-g_pfnVectors
+
+/* ============================================================================
+ * Weak aliases: define a function with the same name to override
+ * ============================================================================ */
+    .weak   NMI_Handler
+    .thumb_set NMI_Handler, Default_Handler
+
+    .weak   HardFault_Handler
+    .thumb_set HardFault_Handler, Default_Handler
+
+    .weak   MemManage_Handler
+    .thumb_set MemManage_Handler, Default_Handler
+
+    .weak   BusFault_Handler
+    .thumb_set BusFault_Handler, Default_Handler
+
+    .weak   UsageFault_Handler
+    .thumb_set UsageFault_Handler, Default_Handler
+
+    .weak   SVC_Handler
+    .thumb_set SVC_Handler, Default_Handler
+
+    .weak   DebugMon_Handler
+    .thumb_set DebugMon_Handler, Default_Handler
+
+    .weak   PendSV_Handler
+    .thumb_set PendSV_Handler, Default_Handler
+
+    .weak   SysTick_Handler
+    .thumb_set SysTick_Handler, Default_Handler
+
+    .weak   WWDG_IRQHandler
+    .thumb_set WWDG_IRQHandler, Default_Handler
+
+    .weak   PVD_IRQHandler
+    .thumb_set PVD_IRQHandler, Default_Handler
+
+    .weak   TAMP_STAMP_IRQHandler
+    .thumb_set TAMP_STAMP_IRQHandler, Default_Handler
+
+    .weak   RTC_WKUP_IRQHandler
+    .thumb_set RTC_WKUP_IRQHandler, Default_Handler
+
+    .weak   FLASH_IRQHandler
+    .thumb_set FLASH_IRQHandler, Default_Handler
+
+    .weak   RCC_IRQHandler
+    .thumb_set RCC_IRQHandler, Default_Handler
+
+    .weak   EXTI0_IRQHandler
+    .thumb_set EXTI0_IRQHandler, Default_Handler
+
+    .weak   EXTI1_IRQHandler
+    .thumb_set EXTI1_IRQHandler, Default_Handler
+
+    .weak   EXTI2_TSC_IRQHandler
+    .thumb_set EXTI2_TSC_IRQHandler, Default_Handler
+
+    .weak   EXTI3_IRQHandler
+    .thumb_set EXTI3_IRQHandler, Default_Handler
+
+    .weak   EXTI4_IRQHandler
+    .thumb_set EXTI4_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel1_IRQHandler
+    .thumb_set DMA1_Channel1_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel2_IRQHandler
+    .thumb_set DMA1_Channel2_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel3_IRQHandler
+    .thumb_set DMA1_Channel3_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel4_IRQHandler
+    .thumb_set DMA1_Channel4_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel5_IRQHandler
+    .thumb_set DMA1_Channel5_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel6_IRQHandler
+    .thumb_set DMA1_Channel6_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel7_IRQHandler
+    .thumb_set DMA1_Channel7_IRQHandler, Default_Handler
+
+    .weak   ADC1_2_IRQHandler
+    .thumb_set ADC1_2_IRQHandler, Default_Handler
+
+    .weak   USB_HP_CAN_TX_IRQHandler
+    .thumb_set USB_HP_CAN_TX_IRQHandler, Default_Handler
+
+    .weak   USB_LP_CAN_RX0_IRQHandler
+    .thumb_set USB_LP_CAN_RX0_IRQHandler, Default_Handler
+
+    .weak   CAN_RX1_IRQHandler
+    .thumb_set CAN_RX1_IRQHandler, Default_Handler
+
+    .weak   CAN_SCE_IRQHandler
+    .thumb_set CAN_SCE_IRQHandler, Default_Handler
+
+    .weak   EXTI9_5_IRQHandler
+    .thumb_set EXTI9_5_IRQHandler, Default_Handler
+
+    .weak   TIM1_BRK_TIM15_IRQHandler
+    .thumb_set TIM1_BRK_TIM15_IRQHandler, Default_Handler
+
+    .weak   TIM1_UP_TIM16_IRQHandler
+    .thumb_set TIM1_UP_TIM16_IRQHandler, Default_Handler
+
+    .weak   TIM1_TRG_COM_TIM17_IRQHandler
+    .thumb_set TIM1_TRG_COM_TIM17_IRQHandler, Default_Handler
+
+    .weak   TIM1_CC_IRQHandler
+    .thumb_set TIM1_CC_IRQHandler, Default_Handler
+
+    .weak   TIM2_IRQHandler
+    .thumb_set TIM2_IRQHandler, Default_Handler
+
+    .weak   TIM3_IRQHandler
+    .thumb_set TIM3_IRQHandler, Default_Handler
+
+    .weak   TIM4_IRQHandler
+    .thumb_set TIM4_IRQHandler, Default_Handler
+
+    .weak   I2C1_EV_IRQHandler
+    .thumb_set I2C1_EV_IRQHandler, Default_Handler
+
+    .weak   I2C1_ER_IRQHandler
+    .thumb_set I2C1_ER_IRQHandler, Default_Handler
+
+    .weak   I2C2_EV_IRQHandler
+    .thumb_set I2C2_EV_IRQHandler, Default_Handler
+
+    .weak   I2C2_ER_IRQHandler
+    .thumb_set I2C2_ER_IRQHandler, Default_Handler
+
+    .weak   SPI1_IRQHandler
+    .thumb_set SPI1_IRQHandler, Default_Handler
+
+    .weak   SPI2_IRQHandler
+    .thumb_set SPI2_IRQHandler, Default_Handler
+
+    .weak   USART1_IRQHandler
+    .thumb_set USART1_IRQHandler, Default_Handler
+
+    .weak   USART2_IRQHandler
+    .thumb_set USART2_IRQHandler, Default_Handler
+
+    .weak   USART3_IRQHandler
+    .thumb_set USART3_IRQHandler, Default_Handler
+
+    .weak   EXTI15_10_IRQHandler
+    .thumb_set EXTI15_10_IRQHandler, Default_Handler
+
+    .weak   RTC_Alarm_IRQHandler
+    .thumb_set RTC_Alarm_IRQHandler, Default_Handler
+
+    .weak   USBWakeUp_IRQHandler
+    .thumb_set USBWakeUp_IRQHandler, Default_Handler
+
+    .weak   TIM8_BRK_IRQHandler
+    .thumb_set TIM8_BRK_IRQHandler, Default_Handler
+
+    .weak   TIM8_UP_IRQHandler
+    .thumb_set TIM8_UP_IRQHandler, Default_Handler
+
+    .weak   TIM8_TRG_COM_IRQHandler
+    .thumb_set TIM8_TRG_COM_IRQHandler, Default_Handler
+
+    .weak   TIM8_CC_IRQHandler
+    .thumb_set TIM8_CC_IRQHandler, Default_Handler
+
+    .weak   ADC3_IRQHandler
+    .thumb_set ADC3_IRQHandler, Default_Handler
+
+    .weak   SPI3_IRQHandler
+    .thumb_set SPI3_IRQHandler, Default_Handler
+
+    .weak   UART4_IRQHandler
+    .thumb_set UART4_IRQHandler, Default_Handler
+
+    .weak   UART5_IRQHandler
+    .thumb_set UART5_IRQHandler, Default_Handler
+
+    .weak   TIM6_DAC_IRQHandler
+    .thumb_set TIM6_DAC_IRQHandler, Default_Handler
+
+    .weak   TIM7_IRQHandler
+    .thumb_set TIM7_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel1_IRQHandler
+    .thumb_set DMA2_Channel1_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel2_IRQHandler
+    .thumb_set DMA2_Channel2_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel3_IRQHandler
+    .thumb_set DMA2_Channel3_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel4_IRQHandler
+    .thumb_set DMA2_Channel4_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel5_IRQHandler
+    .thumb_set DMA2_Channel5_IRQHandler, Default_Handler
+
+    .weak   ADC4_IRQHandler
+    .thumb_set ADC4_IRQHandler, Default_Handler
+
+    .weak   COMP1_2_3_IRQHandler
+    .thumb_set COMP1_2_3_IRQHandler, Default_Handler
+
+    .weak   COMP4_5_6_IRQHandler
+    .thumb_set COMP4_5_6_IRQHandler, Default_Handler
+
+    .weak   COMP7_IRQHandler
+    .thumb_set COMP7_IRQHandler, Default_Handler
+
+    .weak   USB_HP_IRQHandler
+    .thumb_set USB_HP_IRQHandler, Default_Handler
+
+    .weak   USB_LP_IRQHandler
+    .thumb_set USB_LP_IRQHandler, Default_Handler
+
+    .weak   USBWakeUp_RMP_IRQHandler
+    .thumb_set USBWakeUp_RMP_IRQHandler, Default_Handler
+
+    .weak   FPU_IRQHandler
+    .thumb_set FPU_IRQHandler, Default_Handler
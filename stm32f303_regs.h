@@ -0,0 +1,429 @@
+/**
+ ******************************************************************************
+ * @file           : stm32f303_regs.h
+ * @brief          : Shared register definitions - STM32F303 Discovery
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ * One place for the register addresses that the Day 1-3 files each
+ * copied into their own source. Same naming as before:
+ *   <PERIPHERAL>_<REGISTER>   e.g. GPIOE_ODR, RCC_AHBENR
+ *
+ * All registers go through REG32() so they can be redirected later
+ * (for example to a simulated peripheral on the host).
+ ******************************************************************************
+ */
+
+#ifndef STM32F303_REGS_H
+#define STM32F303_REGS_H
+
+#include <stdint.h>
+
+#ifdef HOST_SIM
+// Host build: every register lives in a simulated peripheral (host tools)
+volatile uint32_t *host_sim_reg(uint32_t addr);
+#define REG32(addr)         (*host_sim_reg((uint32_t)(addr)))
+#define REG8(addr)          (((volatile uint8_t*)host_sim_reg((uint32_t)(addr) & ~3u))[(addr) & 3])
+#else
+#define REG32(addr)         (*((volatile uint32_t*)(addr)))
+#define REG8(addr)          (*((volatile uint8_t*)(addr)))
+#endif
+
+// ============================================================================
+// RCC (Reset and Clock Control)
+// ============================================================================
+#define RCC_BASE            0x40021000
+#define RCC_CR              REG32(RCC_BASE + 0x00)
+#define RCC_CFGR            REG32(RCC_BASE + 0x04)
+#define RCC_CIR             REG32(RCC_BASE + 0x08)
+#define RCC_AHBENR          REG32(RCC_BASE + 0x14)
+#define RCC_APB2ENR         REG32(RCC_BASE + 0x18)
+#define RCC_APB1ENR         REG32(RCC_BASE + 0x1C)
+#define RCC_CFGR2           REG32(RCC_BASE + 0x2C)
+#define RCC_CFGR3           REG32(RCC_BASE + 0x30)
+
+// RCC_CR bits
+#define RCC_CR_HSION        (1 << 0)
+#define RCC_CR_HSIRDY       (1 << 1)
+#define RCC_CR_HSEON        (1 << 16)
+#define RCC_CR_HSERDY       (1 << 17)
+#define RCC_CR_HSEBYP       (1 << 18)
+#define RCC_CR_PLLON        (1 << 24)
+#define RCC_CR_PLLRDY       (1 << 25)
+
+// RCC_CFGR fields
+#define RCC_CFGR_SW_Pos     0          // System clock switch
+#define RCC_CFGR_SW_Msk     (3 << 0)
+#define RCC_CFGR_SWS_Pos    2          // System clock switch status
+#define RCC_CFGR_SWS_Msk    (3 << 2)
+#define RCC_CFGR_HPRE_Pos   4          // AHB prescaler
+#define RCC_CFGR_HPRE_Msk   (0xF << 4)
+#define RCC_CFGR_PPRE1_Pos  8          // APB1 prescaler (max 36 MHz!)
+#define RCC_CFGR_PPRE1_Msk  (7 << 8)
+#define RCC_CFGR_PPRE2_Pos  11         // APB2 prescaler
+#define RCC_CFGR_PPRE2_Msk  (7 << 11)
+#define RCC_CFGR_PLLSRC     (1 << 16)  // 0 = HSI/2, 1 = HSE/PREDIV
+#define RCC_CFGR_PLLMUL_Pos 18
+#define RCC_CFGR_PLLMUL_Msk (0xF << 18)
+
+#define RCC_CFGR2_PREDIV_Msk (0xF << 0)
+
+// Clock enable bits
+#define RCC_AHBENR_DMA1EN   (1 << 0)   // Enable clock for DMA1
+#define RCC_AHBENR_GPIOAEN  (1 << 17)  // Enable clock for GPIOA
+#define RCC_AHBENR_GPIOCEN  (1 << 19)  // Enable clock for GPIOC
+#define RCC_AHBENR_GPIOEEN  (1 << 21)  // Enable clock for GPIOE
+#define RCC_AHBENR_GPIOxEN(port) (1 << (17 + (port)))  // port 0 = A .. 5 = F
+#define RCC_APB1ENR_TIM3EN  (1 << 1)   // Enable clock for TIM3
+#define RCC_APB1ENR_TIM7EN  (1 << 5)   // Enable clock for TIM7
+#define RCC_APB1ENR_SPI2EN  (1 << 14)  // Enable clock for SPI2
+#define RCC_APB1ENR_I2C1EN  (1 << 21)  // Enable clock for I2C1
+#define RCC_APB1ENR_CANEN   (1 << 25)  // Enable clock for bxCAN
+#define RCC_APB2ENR_SYSCFGEN (1 << 0)  // Enable clock for SYSCFG (EXTI mux)
+#define RCC_APB2ENR_SPI1EN  (1 << 12)  // Enable clock for SPI1
+#define RCC_APB2ENR_USART1EN (1 << 14) // Enable clock for USART1
+
+// ============================================================================
+// FLASH Interface
+// ============================================================================
+#define FLASH_R_BASE        0x40022000
+#define FLASH_ACR           REG32(FLASH_R_BASE + 0x00)
+
+#define FLASH_ACR_LATENCY_Msk (7 << 0) // Wait states
+#define FLASH_ACR_PRFTBE    (1 << 4)   // Prefetch buffer enable
+#define FLASH_ACR_PRFTBS    (1 << 5)   // Prefetch buffer status
+
+#define FLASH_KEYR          REG32(FLASH_R_BASE + 0x04)
+#define FLASH_SR            REG32(FLASH_R_BASE + 0x0C)
+#define FLASH_CR            REG32(FLASH_R_BASE + 0x10)
+#define FLASH_AR            REG32(FLASH_R_BASE + 0x14)
+
+#define FLASH_KEY1          0x45670123
+#define FLASH_KEY2          0xCDEF89AB
+#define FLASH_SR_BSY        (1 << 0)
+#define FLASH_SR_PGERR      (1 << 2)   // Target not erased
+#define FLASH_SR_WRPRTERR   (1 << 4)
+#define FLASH_SR_EOP        (1 << 5)
+#define FLASH_CR_PG         (1 << 0)   // Program (16-bit writes)
+#define FLASH_CR_PER        (1 << 1)   // Page erase
+#define FLASH_CR_STRT       (1 << 6)
+#define FLASH_CR_LOCK       (1 << 7)
+
+// ============================================================================
+// GPIO Ports
+// ============================================================================
+#define GPIOA_BASE          0x48000000
+#define GPIOB_BASE          0x48000400
+#define GPIOC_BASE          0x48000800
+#define GPIOE_BASE          0x48001000
+#define GPIO_PORT_BASE(port) (GPIOA_BASE + (port) * 0x400)   // port 0 = A .. 5 = F
+#define GPIO_PORT_COUNT     6
+
+#define GPIO_MODER(base)    REG32((base) + 0x00)
+#define GPIO_OTYPER(base)   REG32((base) + 0x04)
+#define GPIO_OSPEEDR(base)  REG32((base) + 0x08)
+#define GPIO_PUPDR(base)    REG32((base) + 0x0C)
+#define GPIO_IDR(base)      REG32((base) + 0x10)
+#define GPIO_ODR(base)      REG32((base) + 0x14)
+#define GPIO_BSRR(base)     REG32((base) + 0x18)
+#define GPIO_AFRL(base)     REG32((base) + 0x20)
+#define GPIO_AFRH(base)     REG32((base) + 0x24)
+
+#define GPIOA_MODER         GPIO_MODER(GPIOA_BASE)
+#define GPIOA_IDR           GPIO_IDR(GPIOA_BASE)
+
+#define GPIOC_MODER         GPIO_MODER(GPIOC_BASE)
+#define GPIOC_AFRL          GPIO_AFRL(GPIOC_BASE)
+
+#define GPIOB_BSRR          GPIO_BSRR(GPIOB_BASE)
+
+#define GPIOE_MODER         GPIO_MODER(GPIOE_BASE)
+#define GPIOE_IDR           GPIO_IDR(GPIOE_BASE)
+#define GPIOE_ODR           GPIO_ODR(GPIOE_BASE)
+#define GPIOE_BSRR          GPIO_BSRR(GPIOE_BASE)
+
+// ============================================================================
+// USART1 (PC4 = TX, PC5 = RX, AF7)
+// ============================================================================
+#define USART1_BASE         0x40013800
+#define USART1_CR1          REG32(USART1_BASE + 0x00)
+#define USART1_BRR          REG32(USART1_BASE + 0x0C)
+#define USART1_ISR          REG32(USART1_BASE + 0x1C)
+#define USART1_RDR          REG32(USART1_BASE + 0x24)
+#define USART1_TDR          REG32(USART1_BASE + 0x28)
+
+#define USART_CR1_UE        (1 << 0)
+#define USART_CR1_RE        (1 << 2)
+#define USART_CR1_TE        (1 << 3)
+#define USART_ISR_RXNE      (1 << 5)
+#define USART_ISR_TC        (1 << 6)
+#define USART_ISR_TXE       (1 << 7)
+
+// ============================================================================
+// SPI1 (PA5 = SCK, PA6 = MISO, PA7 = MOSI, AF5), SPI2 (PB13 = SCK, PB15 = MOSI, AF5)
+// ============================================================================
+#define SPI1_BASE           0x40013000
+#define SPI2_BASE           0x40003800
+#define SPI_CR1(base)       REG32((base) + 0x00)
+#define SPI_CR2(base)       REG32((base) + 0x04)
+#define SPI_SR(base)        REG32((base) + 0x08)
+#define SPI_DR(base)        REG32((base) + 0x0C)
+#define SPI_DR8(base)       REG8((base) + 0x0C)  // Byte access: one frame, no packing
+#define SPI_DR_ADDR(base)   ((base) + 0x0C)     // For DMA CPAR
+
+#define SPI_CR1_CPHA        (1 << 0)
+#define SPI_CR1_CPOL        (1 << 1)
+#define SPI_CR1_MSTR        (1 << 2)
+#define SPI_CR1_BR_Pos      3           // f_PCLK / 2^(BR + 1)
+#define SPI_CR1_BR_Msk      (7 << 3)
+#define SPI_CR1_SPE         (1 << 6)
+#define SPI_CR1_LSBFIRST    (1 << 7)
+#define SPI_CR1_SSI         (1 << 8)
+#define SPI_CR1_SSM         (1 << 9)
+#define SPI_CR1_BIDIOE      (1 << 14)
+#define SPI_CR1_BIDIMODE    (1 << 15)
+#define SPI_CR2_RXDMAEN     (1 << 0)
+#define SPI_CR2_TXDMAEN     (1 << 1)
+#define SPI_CR2_DS_8BIT     (7 << 8)
+#define SPI_CR2_FRXTH       (1 << 12)
+#define SPI_SR_RXNE         (1 << 0)
+#define SPI_SR_TXE          (1 << 1)
+#define SPI_SR_BSY          (1 << 7)
+
+// ============================================================================
+// I2C1 (PB6 = SCL, PB7 = SDA, AF4) - kernel clock HSI by default (CFGR3)
+// ============================================================================
+#define I2C1_BASE           0x40005400
+#define I2C_CR1(base)       REG32((base) + 0x00)
+#define I2C_CR2(base)       REG32((base) + 0x04)
+#define I2C_TIMINGR(base)   REG32((base) + 0x10)
+#define I2C_ISR(base)       REG32((base) + 0x18)
+#define I2C_ICR(base)       REG32((base) + 0x1C)
+#define I2C_RXDR(base)      REG32((base) + 0x24)
+#define I2C_TXDR(base)      REG32((base) + 0x28)
+#define I2C_RXDR_ADDR(base) ((base) + 0x24)     // For DMA CPAR
+#define I2C_TXDR_ADDR(base) ((base) + 0x28)
+
+#define I2C_CR1_PE          (1 << 0)
+#define I2C_CR1_NACKIE      (1 << 4)
+#define I2C_CR1_TCIE        (1 << 6)
+#define I2C_CR1_ERRIE       (1 << 7)
+#define I2C_CR1_TXDMAEN     (1 << 14)
+#define I2C_CR1_RXDMAEN     (1 << 15)
+#define I2C_CR2_SADD_Pos    1           // 7-bit address in SADD[7:1]
+#define I2C_CR2_RD_WRN      (1 << 10)
+#define I2C_CR2_START       (1 << 13)
+#define I2C_CR2_NBYTES_Pos  16
+#define I2C_CR2_AUTOEND     (1 << 25)
+#define I2C_ISR_TXE         (1 << 0)
+#define I2C_ISR_TXIS        (1 << 1)
+#define I2C_ISR_NACKF       (1 << 4)
+#define I2C_ISR_STOPF       (1 << 5)
+#define I2C_ISR_TC          (1 << 6)
+#define I2C_ISR_BERR        (1 << 8)
+#define I2C_ISR_ARLO        (1 << 9)
+#define I2C_ISR_BUSY        (1 << 15)
+#define I2C_ICR_NACKCF      (1 << 4)
+#define I2C_ICR_STOPCF      (1 << 5)
+#define I2C_ICR_BERRCF      (1 << 8)
+#define I2C_ICR_ARLOCF      (1 << 9)
+
+// ============================================================================
+// bxCAN (PB8 = RX, PB9 = TX, AF9) - 3 TX mailboxes, 2 RX FIFOs of 3,
+// 14 filter banks
+// ============================================================================
+#define CAN_BASE            0x40006400
+#define CAN_MCR             REG32(CAN_BASE + 0x000)
+#define CAN_MSR             REG32(CAN_BASE + 0x004)
+#define CAN_TSR             REG32(CAN_BASE + 0x008)
+#define CAN_RFR(fifo)       REG32(CAN_BASE + 0x00C + 4 * (fifo))        // RF0R, RF1R
+#define CAN_IER             REG32(CAN_BASE + 0x014)
+#define CAN_ESR             REG32(CAN_BASE + 0x018)
+#define CAN_BTR             REG32(CAN_BASE + 0x01C)
+#define CAN_TIR(mb)         REG32(CAN_BASE + 0x180 + 0x10 * (mb))      // TX mailbox
+#define CAN_TDTR(mb)        REG32(CAN_BASE + 0x184 + 0x10 * (mb))
+#define CAN_TDLR(mb)        REG32(CAN_BASE + 0x188 + 0x10 * (mb))
+#define CAN_TDHR(mb)        REG32(CAN_BASE + 0x18C + 0x10 * (mb))
+#define CAN_RIR(fifo)       REG32(CAN_BASE + 0x1B0 + 0x10 * (fifo))    // FIFO output mailbox
+#define CAN_RDTR(fifo)      REG32(CAN_BASE + 0x1B4 + 0x10 * (fifo))
+#define CAN_RDLR(fifo)      REG32(CAN_BASE + 0x1B8 + 0x10 * (fifo))
+#define CAN_RDHR(fifo)      REG32(CAN_BASE + 0x1BC + 0x10 * (fifo))
+#define CAN_FMR             REG32(CAN_BASE + 0x200)
+#define CAN_FM1R            REG32(CAN_BASE + 0x204)    // Bank bit: 1 = list, 0 = mask
+#define CAN_FS1R            REG32(CAN_BASE + 0x20C)    // Bank bit: 1 = 32-bit, 0 = 2 x 16-bit
+#define CAN_FFA1R           REG32(CAN_BASE + 0x214)    // Bank bit: FIFO 0 / 1
+#define CAN_FA1R            REG32(CAN_BASE + 0x21C)    // Bank bit: active
+#define CAN_FR1(bank)       REG32(CAN_BASE + 0x240 + 8 * (bank))
+#define CAN_FR2(bank)       REG32(CAN_BASE + 0x244 + 8 * (bank))
+
+#define CAN_MCR_INRQ        (1 << 0)
+#define CAN_MCR_SLEEP       (1 << 1)
+#define CAN_MCR_TXFP        (1 << 2)    // Transmit in request order, not by ID
+#define CAN_MCR_RFLM        (1 << 3)    // Full FIFO keeps its frames, drops new ones
+#define CAN_MCR_ABOM        (1 << 6)    // Leave bus-off by itself
+#define CAN_MSR_INAK        (1 << 0)
+#define CAN_MSR_SLAK        (1 << 1)
+#define CAN_TSR_CODE_Pos    24          // Next empty TX mailbox
+#define CAN_TSR_TME_ALL     (7 << 26)   // TX mailboxes 0-2 empty
+#define CAN_RFR_FMP_Msk     (3 << 0)    // Frames pending
+#define CAN_RFR_FULL        (1 << 3)
+#define CAN_RFR_FOVR        (1 << 4)
+#define CAN_RFR_RFOM        (1 << 5)    // Write 1: release the output mailbox
+#define CAN_IER_FMPIE(fifo) (1 << (1 + 3 * (fifo)))
+#define CAN_IER_FOVIE(fifo) (1 << (3 + 3 * (fifo)))
+#define CAN_ESR_BOFF        (1 << 2)
+#define CAN_ESR_TEC_Pos     16
+#define CAN_ESR_REC_Pos     24
+#define CAN_BTR_BRP_Pos     0           // Fields hold value - 1
+#define CAN_BTR_TS1_Pos     16
+#define CAN_BTR_TS2_Pos     20
+#define CAN_BTR_SJW_Pos     24
+#define CAN_BTR_LBKM        (1UL << 30)
+#define CAN_BTR_SILM        (1UL << 31)
+#define CAN_TIR_TXRQ        (1 << 0)
+#define CAN_IR_RTR          (1 << 1)    // TIR / RIR / 32-bit filter layout
+#define CAN_IR_IDE          (1 << 2)
+#define CAN_IR_EXID_Pos     3
+#define CAN_IR_STID_Pos     21
+#define CAN_RDTR_DLC_Msk    0xF
+#define CAN_RDTR_FMI_Pos    8
+#define CAN_FMR_FINIT       (1 << 0)
+#define CAN_F16_RTR         (1 << 4)    // 16-bit filter layout: STID in 15:5
+#define CAN_F16_IDE         (1 << 3)
+#define CAN_F16_STID_Pos    5
+
+// ============================================================================
+// DMA1 (channel 1..7)
+// ============================================================================
+#define DMA1_BASE           0x40020000
+#define DMA1_ISR            REG32(DMA1_BASE + 0x00)
+#define DMA1_IFCR           REG32(DMA1_BASE + 0x04)
+#define DMA1_CCR(ch)        REG32(DMA1_BASE + 0x08 + 20 * ((ch) - 1))
+#define DMA1_CNDTR(ch)      REG32(DMA1_BASE + 0x0C + 20 * ((ch) - 1))
+#define DMA1_CPAR(ch)       REG32(DMA1_BASE + 0x10 + 20 * ((ch) - 1))
+#define DMA1_CMAR(ch)       REG32(DMA1_BASE + 0x14 + 20 * ((ch) - 1))
+
+#define DMA_ISR_TCIF(ch)    (1 << (4 * ((ch) - 1) + 1))
+#define DMA_ISR_HTIF(ch)    (1 << (4 * ((ch) - 1) + 2))
+#define DMA_ISR_TEIF(ch)    (1 << (4 * ((ch) - 1) + 3))
+#define DMA_IFCR_ALL(ch)    (0xF << (4 * ((ch) - 1)))
+
+#define DMA_CCR_EN          (1 << 0)
+#define DMA_CCR_TCIE        (1 << 1)
+#define DMA_CCR_HTIE        (1 << 2)
+#define DMA_CCR_TEIE        (1 << 3)
+#define DMA_CCR_DIR         (1 << 4)    // 1 = memory -> peripheral
+#define DMA_CCR_CIRC        (1 << 5)
+#define DMA_CCR_MINC        (1 << 7)
+#define DMA_CCR_PSIZE_16    (1 << 8)
+#define DMA_CCR_PSIZE_32    (2 << 8)
+#define DMA_CCR_MSIZE_16    (1 << 10)
+#define DMA_CCR_MSIZE_32    (2 << 10)
+#define DMA_CCR_PL_HIGH     (2 << 12)
+
+#define DMA_SPI1_RX_CH      2
+#define DMA_SPI1_TX_CH      3           // Shared with TIM3_UP (WS2812)
+#define DMA_TIM3_UP_CH      3
+#define DMA_SPI2_TX_CH      5
+#define DMA_I2C1_TX_CH      6
+#define DMA_I2C1_RX_CH      7
+
+// ============================================================================
+// TIM3 (general purpose, 16-bit)
+// ============================================================================
+#define TIM3_BASE           0x40000400
+#define TIM7_BASE           0x40001400
+#define TIM_CR1(base)       REG32((base) + 0x00)
+#define TIM_DIER(base)      REG32((base) + 0x0C)
+#define TIM_SR(base)        REG32((base) + 0x10)
+#define TIM_EGR(base)       REG32((base) + 0x14)
+#define TIM_CCMR1(base)     REG32((base) + 0x18)
+#define TIM_CCER(base)      REG32((base) + 0x20)
+#define TIM_CNT(base)       REG32((base) + 0x24)
+#define TIM_PSC(base)       REG32((base) + 0x28)
+#define TIM_ARR(base)       REG32((base) + 0x2C)
+#define TIM_CCR1(base)      REG32((base) + 0x34)
+#define TIM_CCR1_ADDR(base) ((base) + 0x34)     // For DMA CPAR
+
+#define TIM_CR1_CEN         (1 << 0)
+#define TIM_CR1_ARPE        (1 << 7)
+#define TIM_DIER_UIE        (1 << 0)
+#define TIM_DIER_UDE        (1 << 8)
+#define TIM_SR_UIF          (1 << 0)
+#define TIM_EGR_UG          (1 << 0)
+#define TIM_CCMR1_OC1PE     (1 << 3)
+#define TIM_CCMR1_OC1M_PWM1 (6 << 4)
+#define TIM_CCER_CC1E       (1 << 0)
+
+// ============================================================================
+// SYSCFG / EXTI (external interrupt lines)
+// ============================================================================
+#define SYSCFG_BASE         0x40010000
+#define SYSCFG_EXTICR1      REG32(SYSCFG_BASE + 0x08)      // Lines 0-3
+#define SYSCFG_EXTICR2      REG32(SYSCFG_BASE + 0x0C)      // Lines 4-7
+
+#define EXTI_BASE           0x40010400
+#define EXTI_IMR            REG32(EXTI_BASE + 0x00)
+#define EXTI_RTSR           REG32(EXTI_BASE + 0x08)
+#define EXTI_FTSR           REG32(EXTI_BASE + 0x0C)
+#define EXTI_SWIER          REG32(EXTI_BASE + 0x10)    // Write 1: pend the line
+#define EXTI_PR             REG32(EXTI_BASE + 0x14)
+
+// ============================================================================
+// Cortex-M4 Core: NVIC
+// ============================================================================
+#define NVIC_ISER(n)        REG32(0xE000E100 + 4 * (n))
+#define NVIC_ICER(n)        REG32(0xE000E180 + 4 * (n))
+#define NVIC_IPR_BYTE(irq)  REG8(0xE000E400 + (irq))
+
+#define NVIC_ENABLE_IRQ(irq)   (NVIC_ISER((irq) >> 5) = (1UL << ((irq) & 31)))
+#define NVIC_DISABLE_IRQ(irq)  (NVIC_ICER((irq) >> 5) = (1UL << ((irq) & 31)))
+
+// Priority 0 (highest) .. 15, in the upper 4 bits of the byte
+#define NVIC_PRIO_BITS      4
+#define NVIC_SET_PRIORITY(irq, prio)  (NVIC_IPR_BYTE(irq) = (uint8_t)((prio) << (8 - NVIC_PRIO_BITS)))
+#define SCB_SHPR_SYSTICK    REG8(0xE000ED23)
+#define SCB_SHPR_PENDSV     REG8(0xE000ED22)
+
+#define SCB_ICSR            REG32(0xE000ED04)
+#define SCB_ICSR_PENDSVSET  (1UL << 28)
+#define SCB_ICSR_PENDSTSET  (1UL << 26)
+
+// FPU: automatic + lazy stacking of s0-s15 on exception entry
+#define FPU_FPCCR           REG32(0xE000EF34)
+#define FPU_FPCCR_ASPEN     (1UL << 31)
+#define FPU_FPCCR_LSPEN     (1UL << 30)
+
+#define EXTI0_IRQn          6
+#define EXTI1_IRQn          7
+#define EXTI2_TSC_IRQn      8
+#define EXTI4_IRQn          10
+#define DMA1_Channel2_IRQn  12
+#define DMA1_Channel3_IRQn  13
+#define DMA1_Channel7_IRQn  17
+#define USB_LP_CAN_RX0_IRQn 20
+#define CAN_RX1_IRQn        21
+#define I2C1_EV_IRQn        31
+#define I2C1_ER_IRQn        32
+#define TIM7_IRQn           55
+
+// ============================================================================
+// Cortex-M4 Core: SysTick and DWT cycle counter
+// ============================================================================
+#define SYST_CSR            REG32(0xE000E010)
+#define SYST_RVR            REG32(0xE000E014)
+#define SYST_CVR            REG32(0xE000E018)
+
+#define SYST_CSR_ENABLE     (1 << 0)
+#define SYST_CSR_TICKINT    (1 << 1)
+#define SYST_CSR_CLKSOURCE  (1 << 2)   // 1 = HCLK, 0 = HCLK/8
+#define SYST_CSR_COUNTFLAG  (1 << 16)  // Reached 0 since last read (read clears)
+#define SYST_RVR_MAX        0x00FFFFFF
+
+#define DEMCR               REG32(0xE000EDFC)
+#define DEMCR_TRCENA        (1 << 24)
+#define DWT_CTRL            REG32(0xE0001000)
+#define DWT_CYCCNT          REG32(0xE0001004)
+#define DWT_CTRL_CYCCNTENA  (1 << 0)
+
+#endif // STM32F303_REGS_H
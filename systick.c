@@ -0,0 +1,228 @@
+/**
+ ******************************************************************************
+ * @file           : systick.c
+ * @brief          : 1 ms system tick and calibrated delays
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ */
+
+#include "systick.h"
+#include "board.h"
+#include "clock_config.h"
+#include "stm32f303_regs.h"
+#include "profiler.h"
+
+static volatile uint32_t systick_ms = 0;
+static volatile uint32_t tick_cycles = 0;       // DWT_CYCCNT at tick entry
+static uint32_t cycles_per_us = HSI_VALUE_HZ / 1000000;
+
+static SysTickHook hooks[SYSTICK_MAX_HOOKS];
+static volatile uint8_t hook_count = 0;
+
+// ============================================================================
+// Clock listener: re-program the tick for the new HCLK
+// ============================================================================
+static void systick_on_clock_change(const ClockFreqs *freqs) {
+    SYST_CSR = 0;
+    SYST_RVR = (freqs->hclk_hz / SYSTICK_RATE_HZ) - 1;  // 24-bit, fine up to 72 MHz
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_CLKSOURCE | SYST_CSR_TICKINT | SYST_CSR_ENABLE;
+
+    cycles_per_us = freqs->hclk_hz / 1000000;
+}
+
+// ============================================================================
+// Init: start the DWT cycle counter and the 1 ms tick
+// ============================================================================
+void systick_init(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    SCB_SHPR_SYSTICK = (uint8_t)(IRQ_PRIO_ENGINE << (8 - NVIC_PRIO_BITS));
+
+    clock_add_listener(systick_on_clock_change);
+}
+
+void SysTick_Handler(void) {
+    tick_cycles = DWT_CYCCNT;
+    PROF_ENTER(PROF_SYSTICK_ISR);
+    uint32_t now = ++systick_ms;
+    for (uint8_t i = 0; i < hook_count; i++) {
+        hooks[i](now);
+    }
+    PROF_EXIT(PROF_SYSTICK_ISR);
+}
+
+uint32_t get_time_ms(void) {
+    return systick_ms;
+}
+
+uint32_t systick_cycles_per_us(void) {
+    return cycles_per_us;
+}
+
+uint32_t systick_tick_cycles(void) {
+    return tick_cycles;
+}
+
+// ============================================================================
+// Virtual clock (HOST_SIM): the DWT count and the tick move together,
+// sim_phase cycles into the current tick
+// ============================================================================
+#ifdef HOST_SIM
+static uint32_t sim_phase;
+
+static uint32_t sim_tick_cycles(void) {
+    return cycles_per_us * (1000000 / SYSTICK_RATE_HZ);
+}
+
+static void sim_tick(void) {
+    DWT_CYCCNT += sim_tick_cycles() - sim_phase;
+    sim_phase = 0;
+    SysTick_Handler();
+}
+
+void systick_sim_set_time(uint32_t now_ms) {
+    systick_ms = now_ms;
+}
+
+void systick_sim_run(uint32_t ms) {
+    while (ms--) {
+        sim_tick();
+    }
+}
+
+void systick_sim_sleep(uint32_t ms) {
+    if (ms == 0) {
+        return;
+    }
+    systick_ms += ms - 1;
+    DWT_CYCCNT += (ms - 1) * sim_tick_cycles();
+    sim_tick();
+}
+#endif
+
+// ============================================================================
+// Delays (unsigned subtraction handles counter wrap-around)
+// ============================================================================
+#ifdef HOST_SIM
+void delay_ms(uint32_t ms) {
+    systick_sim_run(ms);
+}
+
+void delay_us(uint32_t us) {
+    uint32_t cycles = us * cycles_per_us;
+
+    while (sim_phase + cycles >= sim_tick_cycles()) {
+        cycles -= sim_tick_cycles() - sim_phase;
+        sim_tick();
+    }
+    DWT_CYCCNT += cycles;
+    sim_phase += cycles;
+}
+#else
+void delay_ms(uint32_t ms) {
+    uint32_t start = systick_ms;
+    while ((systick_ms - start) < ms) {
+    }
+}
+
+void delay_us(uint32_t us) {
+    uint32_t start = DWT_CYCCNT;
+    uint32_t cycles = us * cycles_per_us;
+    while ((DWT_CYCCNT - start) < cycles) {
+    }
+}
+#endif
+
+// ============================================================================
+// Tick hooks
+// ============================================================================
+uint8_t systick_add_hook(SysTickHook hook) {
+    if (hook_count >= SYSTICK_MAX_HOOKS) {
+        return 0;
+    }
+    hooks[hook_count] = hook;
+    hook_count++;                   // Publish only once the slot is filled
+    return 1;
+}
+
+// ============================================================================
+// Tickless idle: one long tick instead of 'ms' short ones
+// ============================================================================
+#ifdef HOST_SIM
+void systick_idle(uint32_t ms) {
+    systick_sim_sleep(ms ? ms : 1);
+}
+
+void systick_credit_stall(uint32_t start_cycles, uint32_t start_cvr, uint32_t end_cycles) {
+    (void)start_cycles;                         // The virtual clock never stalls
+    (void)start_cvr;
+    (void)end_cycles;
+}
+#else
+static void systick_restart(uint32_t cycles, uint32_t reload) {
+    SYST_RVR = cycles - 1;
+    SYST_CVR = 0;                               // Loads RVR on the next clock
+    SYST_CSR |= SYST_CSR_ENABLE;
+    SYST_RVR = reload - 1;                      // ... and this one after that
+}
+
+void systick_idle(uint32_t ms) {
+    uint32_t reload = SYST_RVR + 1;             // Cycles per tick
+
+    if (ms > SYST_RVR_MAX / reload) {
+        ms = SYST_RVR_MAX / reload;             // 233 ms at 72 MHz
+    }
+    if (ms < 2) {
+        __asm volatile ("wfi");
+        return;
+    }
+
+    SYST_CSR &= ~SYST_CSR_ENABLE;
+    uint32_t left = SYST_CVR;                   // Rest of the current tick
+    uint32_t stretch = left + (ms - 1) * reload;
+    systick_restart(stretch, reload);
+
+    __asm volatile ("dsb\n wfi\n isb" ::: "memory");
+
+    uint32_t csr = SYST_CSR;                    // One read: it clears COUNTFLAG
+    if (csr & SYST_CSR_COUNTFLAG) {
+        // Slept it out: the pending SysTick interrupt counts the last tick
+        systick_ms += ms - 1;
+        return;
+    }
+
+    // Woken early: credit the whole ticks, then finish the one in progress
+    SYST_CSR = csr & ~SYST_CSR_ENABLE;
+    uint32_t passed = stretch - 1 - SYST_CVR;
+    if (passed < left) {
+        systick_restart(left - passed, reload);
+    } else {
+        passed -= left;
+        systick_ms += 1 + passed / reload;
+        systick_restart(reload - passed % reload, reload);
+    }
+}
+
+// ============================================================================
+// Ticks lost in a stall: the counter reaches 0 after start_cvr cycles, then
+// every 'reload'. The first of those pended SysTick; the rest are credited.
+// ============================================================================
+void systick_credit_stall(uint32_t start_cycles, uint32_t start_cvr, uint32_t end_cycles) {
+    uint32_t reload = SYST_RVR + 1;
+    uint32_t stalled = end_cycles - start_cycles;
+
+    if (stalled < start_cvr + reload) {
+        return;                                 // At most one: its interrupt counts it
+    }
+    uint32_t lost = (stalled - start_cvr) / reload;
+
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    systick_ms += lost;                         // SysTick_Handler writes it too
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+#endif
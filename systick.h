@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file           : systick.h
+ * @brief          : 1 ms system tick and calibrated delays
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ * Replaces the loop-count delay(500000) from the Day 1-3 code with delays
+ * that mean the same thing at 8 MHz and at 72 MHz:
+ *   get_time_ms()  - milliseconds since systick_init() (SysTick interrupt)
+ *   delay_ms(ms)   - busy wait on the tick
+ *   delay_us(us)   - busy wait on the DWT cycle counter
+ *
+ * SysTick reload and the cycles-per-microsecond factor are re-computed
+ * automatically whenever clock_set_profile() changes HCLK.
+ *
+ * Drivers that must act on tick boundaries (e.g. latching a shift
+ * register chain) register a hook; hooks run inside SysTick_Handler, so
+ * keep them short. systick_tick_cycles() is the DWT count at the entry
+ * of the current tick, so a hook can tell how long after the tick
+ * boundary it acts.
+ *
+ * systick_idle() is for a tickless idle loop (kernel.h): it stretches
+ * the running tick over several milliseconds, sleeps, and credits the
+ * ticks that went by without an interrupt. Hooks then see 'now' jump
+ * by more than 1.
+ *
+ * Host builds (HOST_SIM) have no SysTick: time is a virtual clock that
+ * only moves when the code or the tool moves it. delay_ms() / delay_us()
+ * run the ticks (and their hooks) they would have waited for and return
+ * at once, and a tool runs the firmware forward with systick_sim_run(),
+ * or skips straight to the next thing due with systick_sim_sleep() -
+ * hours of firmware time in milliseconds (soak_sim.c).
+ ******************************************************************************
+ */
+
+#ifndef SYSTICK_H
+#define SYSTICK_H
+
+#include <stdint.h>
+
+#define SYSTICK_RATE_HZ     1000
+#define SYSTICK_MAX_HOOKS   4
+
+typedef void (*SysTickHook)(uint32_t now_ms);
+
+void systick_init(void);
+uint32_t get_time_ms(void);
+uint32_t systick_cycles_per_us(void);
+uint32_t systick_tick_cycles(void);
+void delay_ms(uint32_t ms);
+void delay_us(uint32_t us);
+uint8_t systick_add_hook(SysTickHook hook);
+
+// Interrupts masked (PRIMASK): sleep until the tick 'ms' from now or any
+// interrupt, whichever is first. Loses a few cycles of tick time per call.
+void systick_idle(uint32_t ms);
+
+// The core was stalled from DWT count 'start_cycles' (SYST_CVR read just
+// before as 'start_cvr') to 'end_cycles' - a Flash erase holds every
+// fetch, SysTick_Handler's too. The counter kept wrapping but could pend
+// only one interrupt: credit the other ticks to get_time_ms(), silently
+// (hooks see 'now' jump, as after systick_idle()).
+void systick_credit_stall(uint32_t start_cycles, uint32_t start_cvr, uint32_t end_cycles);
+
+#ifdef HOST_SIM
+// Virtual clock: set the tick count (no hooks run), run 'ms' ticks, or
+// credit ms - 1 ticks silently and run the last one (as tickless idle)
+void systick_sim_set_time(uint32_t now_ms);
+void systick_sim_run(uint32_t ms);
+void systick_sim_sleep(uint32_t ms);
+#endif
+
+#endif // SYSTICK_H
@@ -0,0 +1,190 @@
+/**
+ ******************************************************************************
+ * @file           : timer.c
+ * @brief          : Software timers on a hierarchical timing wheel
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 29, 2026
+ ******************************************************************************
+ */
+
+#include "timer.h"
+#include "systick.h"
+
+#define SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+
+TimerWheel system_timers;
+
+// ============================================================================
+// Slot lists: singly linked forward, 'pprev' back, so unlinking is O(1)
+// ============================================================================
+static void slot_push(Timer **slot, Timer *t) {
+    t->next = *slot;
+    if (t->next) {
+        t->next->pprev = &t->next;
+    }
+    *slot = t;
+    t->pprev = slot;
+}
+
+static void timer_unlink(Timer *t) {
+    *t->pprev = t->next;
+    if (t->next) {
+        t->next->pprev = t->pprev;
+    }
+    t->pprev = 0;
+}
+
+// File a timer by its distance from 'base', the first tick not yet
+// expired: < 32 ms -> level 0, < 1024 ms -> level 1, ...
+static void wheel_file(TimerWheel *w, Timer *t, uint32_t base) {
+    uint32_t when = t->expires_ms;
+    uint32_t delta = when - base;
+    uint8_t level;
+
+    if ((int32_t)delta <= 0) {
+        when = base;                                    // Due: first tick not yet expired
+        level = 0;
+    } else if (delta >= TIMER_WHEEL_RANGE_MS) {
+        when = base + TIMER_WHEEL_RANGE_MS - 1;         // Park, re-filed every lap
+        level = TIMER_WHEEL_LEVELS - 1;
+    } else {
+        level = (uint8_t)((31 - __builtin_clz(delta)) / TIMER_WHEEL_BITS);
+    }
+
+    slot_push(&w->slot[level][(when >> (level * TIMER_WHEEL_BITS)) & SLOT_MASK], t);
+}
+
+// Unhook a whole slot in one step; the list head becomes a local
+static Timer *slot_take(Timer **slot, Timer **head) {
+    *head = *slot;
+    *slot = 0;
+    if (*head) {
+        (*head)->pprev = head;
+    }
+    return *head;
+}
+
+// ============================================================================
+// Wheel
+// ============================================================================
+void timer_wheel_init(TimerWheel *w, uint32_t now_ms) {
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+            w->slot[level][i] = 0;
+        }
+    }
+    w->now_ms = now_ms;
+    w->fired = 0;
+    w->cascaded = 0;
+}
+
+static uint32_t wheel_tick(TimerWheel *w, uint32_t tick) {
+    Timer *head;
+    uint32_t fired = 0;
+
+    w->now_ms = tick;
+
+    // The 1 ms hand passed slot 0: bring the next slot of each level
+    // whose hand moves too down to where it now belongs
+    for (uint8_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        uint8_t shift = (uint8_t)((level - 1) * TIMER_WHEEL_BITS);
+        if ((tick >> shift) & SLOT_MASK) {
+            break;
+        }
+        slot_take(&w->slot[level][(tick >> (shift + TIMER_WHEEL_BITS)) & SLOT_MASK], &head);
+        while (head) {
+            Timer *t = head;
+            timer_unlink(t);
+            wheel_file(w, t, tick);
+            w->cascaded++;
+        }
+    }
+
+    // Bulk expiry: the whole slot is due this tick. A callback may stop
+    // any timer, including one further down this list.
+    slot_take(&w->slot[0][tick & SLOT_MASK], &head);
+    while (head) {
+        Timer *t = head;
+        timer_unlink(t);
+        if (t->period_ms) {
+            t->expires_ms += t->period_ms;
+            if ((int32_t)(t->expires_ms - tick) <= 0) {
+                t->expires_ms = tick + t->period_ms;     // Fell behind
+            }
+            wheel_file(w, t, tick + 1);
+        }
+        t->fn(t, tick);
+        fired++;
+    }
+    return fired;
+}
+
+uint32_t timer_wheel_advance(TimerWheel *w, uint32_t now_ms) {
+    uint32_t fired = 0;
+
+    while ((int32_t)(now_ms - w->now_ms) > 0) {
+        fired += wheel_tick(w, w->now_ms + 1);
+    }
+    w->fired += fired;
+    return fired;
+}
+
+uint32_t timer_wheel_idle_ms(const TimerWheel *w, uint32_t limit_ms) {
+    uint32_t idle = limit_ms;
+
+    // First non-empty slot ahead of each level's hand. Level 0 slots
+    // expire at that tick; higher ones are only cascaded then.
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        uint8_t shift = (uint8_t)(level * TIMER_WHEEL_BITS);
+        uint32_t hand = w->now_ms >> shift;
+        for (uint32_t ahead = 1; ahead <= TIMER_WHEEL_SLOTS; ahead++) {
+            if (w->slot[level][(hand + ahead) & SLOT_MASK]) {
+                uint32_t ticks = ((hand + ahead) << shift) - w->now_ms;
+                if (ticks < idle) {
+                    idle = ticks;
+                }
+                break;
+            }
+        }
+    }
+    return idle;
+}
+
+// ============================================================================
+// Timers
+// ============================================================================
+void timer_init(Timer *t, TimerFn fn, void *arg) {
+    t->next = 0;
+    t->pprev = 0;
+    t->expires_ms = 0;
+    t->period_ms = 0;
+    t->fn = fn;
+    t->arg = arg;
+}
+
+void timer_start(TimerWheel *w, Timer *t, uint32_t delay_ms, uint32_t period_ms) {
+    if (t->pprev) {
+        timer_unlink(t);
+    }
+    t->expires_ms = w->now_ms + delay_ms;
+    t->period_ms = period_ms;
+    wheel_file(w, t, w->now_ms + 1);
+}
+
+void timer_stop(Timer *t) {
+    if (t->pprev) {
+        timer_unlink(t);
+    }
+}
+
+// ============================================================================
+// System wheel, one tick per SysTick
+// ============================================================================
+static void timer_service_tick(uint32_t now_ms) {
+    timer_wheel_advance(&system_timers, now_ms);
+}
+
+void timer_service_init(void) {
+    timer_wheel_init(&system_timers, get_time_ms());
+    systick_add_hook(timer_service_tick);
+}
@@ -0,0 +1,102 @@
+/**
+ ******************************************************************************
+ * @file           : timer.h
+ * @brief          : Software timers on a hierarchical timing wheel
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 29, 2026
+ ******************************************************************************
+ * One-shot and periodic timers with O(1) start, stop and expiry, however
+ * many are armed. The caller owns each Timer (a static or a member of
+ * the object it times) - the wheel only links them, nothing is
+ * allocated:
+ *
+ *   static Timer blink;
+ *   timer_init(&blink, blink_fn, &led);
+ *   timer_start(&system_timers, &blink, 0, 500);   // Now, then every 500 ms
+ *   ...
+ *   timer_stop(&blink);
+ *
+ * The wheel has TIMER_WHEEL_LEVELS rings of TIMER_WHEEL_SLOTS lists. A
+ * timer goes into the level whose slot width matches how far away it
+ * is: level 0 = the next 32 ms (1 ms per slot), level 1 = the next
+ * 1024 ms (32 ms per slot), ... When the 1 ms hand passes slot 0 the
+ * next slot of level 1 is cascaded - its timers are re-filed into level
+ * 0, now that they are close - and so on up. Each tick then expires
+ * one level-0 slot as a whole: the list is unhooked in one step (bulk
+ * expiry) and its callbacks run one after the other.
+ *
+ * Timers further away than the wheel reaches (TIMER_WHEEL_RANGE_MS) are
+ * parked in the top level and re-filed on each lap until they are due.
+ *
+ * Periodic timers are re-armed from their previous expiry, not from the
+ * tick that ran them, so they do not drift; a timer that fell behind
+ * (ticks missed) restarts one period from now.
+ *
+ * system_timers is advanced from the SysTick hook (timer_service_init()),
+ * so callbacks run in the SysTick interrupt: keep them short. The wheel
+ * is not locked - start and stop its timers from SysTick-priority code
+ * (hooks, the LED engine, other callbacks) or with interrupts masked.
+ *
+ * timer_wheel_idle_ms() tells a tickless idle loop how many ticks it may
+ * skip: exact for the next 32 ms, the next cascade point beyond that.
+ *
+ * timer_bench.c compares this against a sorted list and a binary heap.
+ ******************************************************************************
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+#define TIMER_WHEEL_BITS    5
+#define TIMER_WHEEL_SLOTS   (1u << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS  4
+#define TIMER_WHEEL_RANGE_MS (1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))  // 17.5 min
+
+typedef struct Timer Timer;
+typedef void (*TimerFn)(Timer *timer, uint32_t now_ms);
+
+struct Timer {
+    Timer *next;                    // Slot list
+    Timer **pprev;                  // Link that points at us; 0 = not armed
+    uint32_t expires_ms;
+    uint32_t period_ms;             // 0 = one-shot
+    TimerFn fn;
+    void *arg;                      // For the callback
+};
+
+typedef struct {
+    Timer *slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint32_t now_ms;                // Last tick processed
+    uint32_t fired;                 // Callbacks run
+    uint32_t cascaded;              // Timers re-filed to a lower level
+} TimerWheel;
+
+extern TimerWheel system_timers;
+
+void timer_wheel_init(TimerWheel *w, uint32_t now_ms);
+
+// Process every tick up to now_ms; returns the number of timers that fired
+uint32_t timer_wheel_advance(TimerWheel *w, uint32_t now_ms);
+
+// Ticks from the last one processed until the wheel next has work
+// (a timer due or a slot to cascade), at most limit_ms
+uint32_t timer_wheel_idle_ms(const TimerWheel *w, uint32_t limit_ms);
+
+void timer_init(Timer *t, TimerFn fn, void *arg);
+
+// (Re)arm: fire delay_ms after the wheel's current tick, then every
+// period_ms (0 = once). A delay of 0 fires on the next tick.
+void timer_start(TimerWheel *w, Timer *t, uint32_t delay_ms, uint32_t period_ms);
+
+void timer_stop(Timer *t);
+
+static inline uint8_t timer_armed(const Timer *t) {
+    return t->pprev != 0;
+}
+
+// system_timers from the SysTick hook
+void timer_service_init(void);
+
+#endif // TIMER_H
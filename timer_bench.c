@@ -0,0 +1,333 @@
+/**
+ ******************************************************************************
+ * @file           : timer_bench.c
+ * @brief          : Host tool - timing wheel vs sorted list vs binary heap
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 29, 2026
+ ******************************************************************************
+ * Runs the unchanged timer.c and two textbook timer queues through the
+ * same workload at 10 .. 10000 timers:
+ *
+ *   gcc -O2 -o timer_bench timer_bench.c timer.c
+ *   ./timer_bench
+ *
+ * Workload: every timer is periodic (10 .. 5000 ms), and on every 1 ms
+ * tick TIMER_CHURN of them are restarted with a new delay - what a
+ * debounce window or a UART timeout does. Reported per implementation:
+ * cost of arming all timers, of one tick (expiry + re-arm + churn) and
+ * of stopping all. All three must fire the same timers at the same
+ * ticks (count and checksum), which checks the wheel against two
+ * obviously-correct queues.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "timer.h"
+#include "systick.h"
+
+#define MAX_TIMERS      10000
+#define BENCH_TICKS     5000
+#define TIMER_CHURN     10
+
+// timer.c's SysTick service is not used on the host
+uint8_t systick_add_hook(SysTickHook hook) { (void)hook; return 0; }
+uint32_t get_time_ms(void) { return 0; }
+
+typedef struct BenchTimer BenchTimer;
+struct BenchTimer {
+    Timer timer;                    // Wheel
+    BenchTimer *next, *prev;        // Sorted list
+    uint32_t heap_index;            // Binary heap
+    uint32_t expires_ms;            // List / heap copy of the deadline
+    uint32_t period_ms;
+    uint8_t armed;
+    uint32_t id;
+};
+
+static BenchTimer timers[MAX_TIMERS];
+static uint64_t fires;
+static uint64_t checksum;
+
+static void on_fire(uint32_t id, uint32_t now_ms) {
+    fires++;
+    checksum += (uint64_t)(id + 1) * now_ms;
+}
+
+#define BEFORE(a, b)    ((int32_t)((a) - (b)) < 0)
+
+// ============================================================================
+// Implementations
+// ============================================================================
+typedef struct {
+    const char *name;
+    void (*init)(uint32_t now_ms);
+    void (*start)(BenchTimer *t, uint32_t now_ms, uint32_t delay_ms, uint32_t period_ms);
+    void (*stop)(BenchTimer *t);
+    void (*tick)(uint32_t now_ms);
+} TimerQueue;
+
+// Periodic re-arm, same rule as timer.c
+static void rearm(BenchTimer *t, uint32_t now_ms) {
+    t->expires_ms += t->period_ms;
+    if ((int32_t)(t->expires_ms - now_ms) <= 0) {
+        t->expires_ms = now_ms + t->period_ms;
+    }
+}
+
+// ---- Timing wheel (timer.c) ----
+static TimerWheel wheel;
+
+static void wheel_fn(Timer *timer, uint32_t now_ms) {
+    on_fire(((BenchTimer *)timer->arg)->id, now_ms);
+}
+
+static void wheel_init(uint32_t now_ms) {
+    timer_wheel_init(&wheel, now_ms);
+    for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+        timer_init(&timers[i].timer, wheel_fn, &timers[i]);
+    }
+}
+
+static void wheel_start(BenchTimer *t, uint32_t now_ms, uint32_t delay_ms, uint32_t period_ms) {
+    (void)now_ms;
+    timer_start(&wheel, &t->timer, delay_ms, period_ms);
+}
+
+static void wheel_stop(BenchTimer *t) {
+    timer_stop(&t->timer);
+}
+
+static void wheel_tick(uint32_t now_ms) {
+    timer_wheel_advance(&wheel, now_ms);
+}
+
+// ---- Sorted doubly linked list: O(n) start, O(1) stop and expiry ----
+static BenchTimer *list_head;
+
+static void list_init(uint32_t now_ms) {
+    (void)now_ms;
+    list_head = 0;
+    for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+        timers[i].armed = 0;
+    }
+}
+
+static void list_unlink(BenchTimer *t) {
+    if (t->prev) t->prev->next = t->next; else list_head = t->next;
+    if (t->next) t->next->prev = t->prev;
+    t->armed = 0;
+}
+
+static void list_insert(BenchTimer *t) {
+    BenchTimer *prev = 0, *cur = list_head;
+    while (cur && !BEFORE(t->expires_ms, cur->expires_ms)) {
+        prev = cur;
+        cur = cur->next;
+    }
+    t->prev = prev;
+    t->next = cur;
+    if (prev) prev->next = t; else list_head = t;
+    if (cur) cur->prev = t;
+    t->armed = 1;
+}
+
+static void list_start(BenchTimer *t, uint32_t now_ms, uint32_t delay_ms, uint32_t period_ms) {
+    if (t->armed) list_unlink(t);
+    t->expires_ms = now_ms + (delay_ms ? delay_ms : 1);
+    t->period_ms = period_ms;
+    list_insert(t);
+}
+
+static void list_stop(BenchTimer *t) {
+    if (t->armed) list_unlink(t);
+}
+
+static void list_tick(uint32_t now_ms) {
+    while (list_head && !BEFORE(now_ms, list_head->expires_ms)) {
+        BenchTimer *t = list_head;
+        list_unlink(t);
+        if (t->period_ms) {
+            rearm(t, now_ms);
+            list_insert(t);
+        }
+        on_fire(t->id, now_ms);
+    }
+}
+
+// ---- Binary min-heap: O(log n) start, stop and expiry ----
+static BenchTimer *heap[MAX_TIMERS];
+static uint32_t heap_size;
+
+static void heap_place(uint32_t i, BenchTimer *t) {
+    heap[i] = t;
+    t->heap_index = i;
+}
+
+static void heap_sift_up(uint32_t i) {
+    BenchTimer *t = heap[i];
+    while (i > 0 && BEFORE(t->expires_ms, heap[(i - 1) / 2]->expires_ms)) {
+        heap_place(i, heap[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+    heap_place(i, t);
+}
+
+static void heap_sift_down(uint32_t i) {
+    BenchTimer *t = heap[i];
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= heap_size) break;
+        if (child + 1 < heap_size && BEFORE(heap[child + 1]->expires_ms, heap[child]->expires_ms)) {
+            child++;
+        }
+        if (!BEFORE(heap[child]->expires_ms, t->expires_ms)) break;
+        heap_place(i, heap[child]);
+        i = child;
+    }
+    heap_place(i, t);
+}
+
+static void heap_remove(BenchTimer *t) {
+    uint32_t i = t->heap_index;
+    BenchTimer *last = heap[--heap_size];
+    t->armed = 0;
+    if (last != t) {
+        heap_place(i, last);
+        heap_sift_up(i);
+        heap_sift_down(last->heap_index);
+    }
+}
+
+static void heap_init(uint32_t now_ms) {
+    (void)now_ms;
+    heap_size = 0;
+    for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+        timers[i].armed = 0;
+    }
+}
+
+static void heap_start(BenchTimer *t, uint32_t now_ms, uint32_t delay_ms, uint32_t period_ms) {
+    if (t->armed) heap_remove(t);
+    t->expires_ms = now_ms + (delay_ms ? delay_ms : 1);
+    t->period_ms = period_ms;
+    t->armed = 1;
+    heap_place(heap_size++, t);
+    heap_sift_up(t->heap_index);
+}
+
+static void heap_stop(BenchTimer *t) {
+    if (t->armed) heap_remove(t);
+}
+
+static void heap_tick(uint32_t now_ms) {
+    while (heap_size && !BEFORE(now_ms, heap[0]->expires_ms)) {
+        BenchTimer *t = heap[0];
+        if (t->period_ms) {
+            rearm(t, now_ms);
+            heap_sift_down(0);              // Still in the heap, deadline moved
+        } else {
+            heap_remove(t);
+        }
+        on_fire(t->id, now_ms);
+    }
+}
+
+static const TimerQueue queues[] = {
+    { "timing wheel", wheel_init, wheel_start, wheel_stop, wheel_tick },
+    { "sorted list",  list_init,  list_start,  list_stop,  list_tick },
+    { "binary heap",  heap_init,  heap_start,  heap_stop,  heap_tick },
+};
+
+#define QUEUE_COUNT     (sizeof queues / sizeof queues[0])
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+static uint32_t rng_state;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef struct {
+    double start_ns, tick_ns, stop_ns;
+    uint64_t fires, checksum;
+} BenchResult;
+
+static BenchResult run(const TimerQueue *q, uint32_t count) {
+    BenchResult r;
+    uint32_t now = 0xFFFFF000;      // Wraps during the run
+    double t0;
+
+    fires = 0;
+    checksum = 0;
+    rng_state = 0x12345678;
+    q->init(now);
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < count; i++) {
+        timers[i].id = i;
+        uint32_t period = 10 + rng() % 4991;
+        q->start(&timers[i], now, 1 + rng() % period, period);
+    }
+    r.start_ns = (now_ns() - t0) / count;
+
+    t0 = now_ns();
+    for (uint32_t tick = 0; tick < BENCH_TICKS; tick++) {
+        now++;
+        q->tick(now);
+        for (uint32_t c = 0; c < TIMER_CHURN && c < count; c++) {
+            BenchTimer *t = &timers[rng() % count];
+            uint32_t period = 10 + rng() % 4991;
+            q->start(t, now, 1 + rng() % 8000, period);    // Some land past level 1
+        }
+    }
+    r.tick_ns = (now_ns() - t0) / BENCH_TICKS;
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < count; i++) {
+        q->stop(&timers[i]);
+    }
+    r.stop_ns = (now_ns() - t0) / count;
+
+    r.fires = fires;
+    r.checksum = checksum;
+    return r;
+}
+
+int main(void) {
+    static const uint32_t counts[] = { 10, 100, 1000, 10000 };
+    uint32_t failures = 0;
+
+    printf("Software timers: %u ticks, %u restarts per tick\n\n", BENCH_TICKS, TIMER_CHURN);
+    printf("%6s  %-14s %10s %10s %10s %9s\n", "timers", "queue", "start ns", "tick ns", "stop ns", "fired");
+
+    for (uint32_t c = 0; c < sizeof counts / sizeof counts[0]; c++) {
+        BenchResult ref = { 0 };
+        for (uint32_t q = 0; q < QUEUE_COUNT; q++) {
+            BenchResult r = run(&queues[q], counts[c]);
+            uint8_t same = (q == 0) || (r.fires == ref.fires && r.checksum == ref.checksum);
+            if (q == 0) ref = r;
+            failures += !same;
+            printf("%6u  %-14s %10.1f %10.1f %10.1f %9llu %s\n", counts[c], queues[q].name,
+                   r.start_ns, r.tick_ns, r.stop_ns, (unsigned long long)r.fires,
+                   same ? "" : "MISMATCH");
+        }
+        printf("\n");
+    }
+
+    printf("%s\n", failures ? "FAIL: queues disagree" : "All queues fired the same timers at the same ticks");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/**
+ ******************************************************************************
+ * @file           : transition.c
+ * @brief          : Pattern switch transitions: crossfade, wipe, dissolve
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ */
+
+#include "transition.h"
+
+#define FULL                256         // Q8 "all incoming"
+#define DISSOLVE_FADE_DIV   4           // Each LED fades over 1/4 of the window
+
+void transition_init(Transition *t, LedFrame from_frame, LedFrame to_frame,
+                     LedLevels from_levels, LedLevels to_levels) {
+    t->from_frame = from_frame;
+    t->to_frame = to_frame;
+    t->from_levels = from_levels;
+    t->to_levels = to_levels;
+    t->active = 0;
+}
+
+static uint8_t frame_bit(const LedFrame *f, uint16_t output) {
+    return (f->bits[output >> 3] >> (output & 7)) & 1;
+}
+
+static void copy_frame(LedFrame *dst, const LedFrame *src) {
+    for (uint16_t i = 0; i < LED_FRAME_BYTES(dst->width); i++) {
+        dst->bits[i] = src->bits[i];
+    }
+}
+
+static void levels_from_frame(LedLevels *lv, const LedFrame *f) {
+    for (uint16_t i = 0; i < lv->width; i++) {
+        lv->level[i] = frame_bit(f, i) ? 255 : 0;
+    }
+}
+
+// ============================================================================
+// Start
+// ============================================================================
+void transition_start(Transition *t, const LedFrame *shown, const uint8_t *shown_levels,
+                      const Pattern *from, const Pt *from_pt,
+                      const Pattern *to, TransitionKind kind, uint16_t window_ms,
+                      uint32_t now) {
+    t->kind = (window_ms == 0) ? TRANSITION_CUT : kind;
+    t->window_ms = window_ms;
+    t->start_ms = now;
+    t->from = from;
+    t->to = to;
+    t->from_pt = *from_pt;
+    pattern_start(&t->to_pt, now);      // Incoming pattern: first frame now
+    t->seed = (uint8_t)(now * 29);
+    t->active = 1;
+
+    copy_frame(&t->from_frame, shown);
+    if (t->from_levels.level) {
+        for (uint16_t i = 0; i < t->from_levels.width; i++) {
+            t->from_levels.level[i] = shown_levels ? shown_levels[i] : (frame_bit(shown, i) ? 255 : 0);
+        }
+    }
+}
+
+// ============================================================================
+// Run one pattern: shade if it can and levels are wanted, else step when due
+// ============================================================================
+static void run_pattern(const Pattern *p, Pt *pt, LedFrame *frame,
+                        LedLevels *levels, uint32_t now) {
+    if (levels && p->shade) {
+        p->shade(levels, now);
+        return;
+    }
+    if (pattern_run(p, pt, frame, now) && levels) {
+        levels_from_frame(levels, frame);
+    }
+}
+
+// ============================================================================
+// Share of the incoming pattern (0..256) at ring position 'pos'
+// ============================================================================
+static uint16_t weight(const Transition *t, TransitionKind kind, uint16_t progress,
+                       uint16_t pos, uint16_t width) {
+    int32_t w;
+
+    switch (kind) {
+        case TRANSITION_CROSSFADE:
+            return progress;
+
+        case TRANSITION_WIPE:
+            // Edge runs width + 1 positions, one LED wide
+            w = (int32_t)progress * (width + 1) - (int32_t)pos * FULL;
+            break;
+
+        case TRANSITION_DISSOLVE: {
+            uint8_t order = (uint8_t)(pos * 167 + t->seed);     // Scattered, distinct for <= 256
+            int32_t begin = (int32_t)order * (FULL - FULL / DISSOLVE_FADE_DIV) / FULL;
+            w = ((int32_t)progress - begin) * DISSOLVE_FADE_DIV;
+            break;
+        }
+
+        default:
+            return FULL;
+    }
+    if (w < 0) return 0;
+    if (w > FULL) return FULL;
+    return (uint16_t)w;
+}
+
+// ============================================================================
+// Update: step both, compose one output
+// ============================================================================
+uint8_t transition_update(Transition *t, uint32_t now, LedFrame *out_frame, LedLevels *out_levels) {
+    if (!t->active) {
+        return 0;
+    }
+
+    uint32_t elapsed = now - t->start_ms;
+    uint16_t progress = (elapsed >= t->window_ms) ? FULL : (uint16_t)(elapsed * FULL / t->window_ms);
+    uint8_t use_levels = (out_levels && t->from_levels.level && t->to_levels.level);
+    TransitionKind kind = t->kind;
+
+    if (!use_levels && kind == TRANSITION_CROSSFADE) {
+        kind = TRANSITION_DISSOLVE;     // No brightness: masked hand-over instead
+    }
+
+    if (progress < FULL) {
+        run_pattern(t->from, &t->from_pt, &t->from_frame,
+                    use_levels ? &t->from_levels : 0, now);
+    }
+    run_pattern(t->to, &t->to_pt, &t->to_frame,
+                use_levels ? &t->to_levels : 0, now);
+
+    if (use_levels) {
+        uint16_t width = out_levels->width;
+        for (uint16_t pos = 0; pos < width; pos++) {
+            uint16_t o = out_levels->ring ? out_levels->ring[pos] : pos;
+            uint16_t w = weight(t, kind, progress, pos, width);
+            out_levels->level[o] = (uint8_t)((t->from_levels.level[o] * (FULL - w) +
+                                              t->to_levels.level[o] * w) >> 8);
+        }
+    } else {
+        uint16_t width = out_frame->width;
+        for (uint16_t i = 0; i < LED_FRAME_BYTES(width); i++) {
+            out_frame->bits[i] = 0;
+        }
+        for (uint16_t pos = 0; pos < width; pos++) {
+            uint16_t o = out_frame->ring ? out_frame->ring[pos] : pos;
+            const LedFrame *src = (weight(t, kind, progress, pos, width) >= FULL / 2) ?
+                                  &t->to_frame : &t->from_frame;
+            if (frame_bit(src, o)) {
+                led_frame_set(out_frame, o);
+            }
+        }
+    }
+
+    if (progress >= FULL) {
+        t->active = 0;
+    }
+    return t->active;
+}
+
+uint8_t transition_active(const Transition *t) {
+    return t->active;
+}
+
+const Pt *transition_incoming(const Transition *t) {
+    return &t->to_pt;
+}
@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ * @file           : transition.h
+ * @brief          : Pattern switch transitions: crossfade, wipe, dissolve
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * Day3_Final_7_Patterns.c switched patterns with all_leds_off() and
+ * delay(100000): LEDs dark, loop stalled. Here the outgoing and the
+ * incoming pattern keep running side by side, each at its own period,
+ * for window_ms while the output blends from one to the other:
+ *
+ *   TRANSITION_CROSSFADE  every LED fades old -> new         (levels)
+ *   TRANSITION_WIPE       a soft edge sweeps around the ring (levels)
+ *   TRANSITION_DISSOLVE   LEDs fade over in scattered order  (levels)
+ *   TRANSITION_CUT        switch at once
+ *
+ * Without brightness (on/off frames) WIPE and DISSOLVE become a masked
+ * hand-over - each LED takes the new pattern's bit once its turn comes -
+ * and CROSSFADE falls back to DISSOLVE.
+ *
+ *   transition_start(&t, &shown, shown_levels, from, &from_pt, to, kind, ms, now);
+ *   while (transition_update(&t, now, &frame, &levels)) { show ... }
+ *   pt = *transition_incoming(&t);          // incoming pattern carries on
+ *
+ * Nothing blocks: transition_update() steps what is due and composes one
+ * output, then returns.
+ ******************************************************************************
+ */
+
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include <stdint.h>
+#include "led_frame.h"
+#include "patterns.h"
+
+typedef enum {
+    TRANSITION_CUT,
+    TRANSITION_CROSSFADE,
+    TRANSITION_WIPE,
+    TRANSITION_DISSOLVE
+} TransitionKind;
+
+typedef struct {
+    TransitionKind kind;
+    uint16_t window_ms;
+    uint32_t start_ms;
+    const Pattern *from;
+    const Pattern *to;
+    Pt from_pt;                     // Each pattern's instance (patterns.h)
+    Pt to_pt;
+    LedFrame from_frame;            // Latest frame of each pattern
+    LedFrame to_frame;
+    LedLevels from_levels;          // Latest levels (level == 0: on/off only)
+    LedLevels to_levels;
+    uint8_t seed;                   // Dissolve order
+    uint8_t active;
+} Transition;
+
+// Storage for the two patterns' frames (and levels, or level = 0)
+void transition_init(Transition *t, LedFrame from_frame, LedFrame to_frame,
+                     LedLevels from_levels, LedLevels to_levels);
+
+// 'shown' / 'shown_levels' (may be 0): what the outputs show right now
+void transition_start(Transition *t, const LedFrame *shown, const uint8_t *shown_levels,
+                      const Pattern *from, const Pt *from_pt,
+                      const Pattern *to, TransitionKind kind, uint16_t window_ms,
+                      uint32_t now);
+
+// Composes into out_levels if given, else into out_frame.
+// Returns 1 while running; the call that returns 0 composed the final frame.
+uint8_t transition_update(Transition *t, uint32_t now, LedFrame *out_frame, LedLevels *out_levels);
+
+uint8_t transition_active(const Transition *t);
+const Pt *transition_incoming(const Transition *t);
+
+#endif // TRANSITION_H
@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ * @file           : uart.c
+ * @brief          : Polled USART1 driver (PC4 = TX, PC5 = RX)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ */
+
+#include "uart.h"
+#include "clock_config.h"
+#include "stm32f303_regs.h"
+#include "pin_config.h"
+
+#define UART_TX_PIN         4          // PC4
+#define UART_RX_PIN         5          // PC5
+#define UART_AF             7          // AF7 = USART1
+
+static uint32_t uart_baud = 115200;
+
+// PC4/PC5 -> Alternate Function, AF7
+static const PinConfig uart_pins[] = {
+    PIN_ALT(GPIO_PORT_C, UART_TX_PIN, UART_AF, PIN_SPEED_LOW),
+    PIN_ALT(GPIO_PORT_C, UART_RX_PIN, UART_AF, PIN_SPEED_LOW),
+};
+
+// ============================================================================
+// Clock listener: new PCLK2 -> new BRR
+// ============================================================================
+static void uart_on_clock_change(const ClockFreqs *freqs) {
+    // Let the last byte leave at the old baud rate
+    if (USART1_CR1 & USART_CR1_UE) {
+        while (!(USART1_ISR & USART_ISR_TC)) {
+        }
+    }
+
+    USART1_CR1 &= ~USART_CR1_UE;
+    USART1_BRR = (freqs->pclk2_hz + uart_baud / 2) / uart_baud;  // Rounded, OVER8 = 0
+    USART1_CR1 |= USART_CR1_TE | USART_CR1_RE | USART_CR1_UE;
+}
+
+// ============================================================================
+// Init
+// ============================================================================
+void uart_init(uint32_t baud) {
+    uart_baud = baud;
+
+    RCC_APB2ENR |= RCC_APB2ENR_USART1EN;
+    pin_config_apply(uart_pins, PIN_TABLE_SIZE(uart_pins));
+
+    clock_add_listener(uart_on_clock_change);
+}
+
+// ============================================================================
+// Transmit / Receive
+// ============================================================================
+void uart_putc(char c) {
+    while (!(USART1_ISR & USART_ISR_TXE)) {
+    }
+    USART1_TDR = (uint8_t)c;
+}
+
+void uart_write(const char *data, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        uart_putc(data[i]);
+    }
+}
+
+void uart_puts(const char *str) {
+    while (*str) {
+        uart_putc(*str++);
+    }
+}
+
+int uart_getc(void) {
+    if (USART1_ISR & USART_ISR_RXNE) {
+        return (int)(USART1_RDR & 0xFF);
+    }
+    return -1;
+}
@@ -0,0 +1,25 @@
+/**
+ ******************************************************************************
+ * @file           : uart.h
+ * @brief          : Polled USART1 driver (PC4 = TX, PC5 = RX)
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 19, 2026
+ ******************************************************************************
+ * The baud rate divider is derived from PCLK2 and re-computed whenever
+ * the system clock changes, so the link keeps working after
+ * clock_set_profile().
+ ******************************************************************************
+ */
+
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+
+void uart_init(uint32_t baud);
+void uart_putc(char c);
+void uart_write(const char *data, uint32_t len);
+void uart_puts(const char *str);
+int uart_getc(void);                    // -1 if nothing received
+
+#endif // UART_H
@@ -0,0 +1,206 @@
+/**
+ ******************************************************************************
+ * @file           : ws2812.c
+ * @brief          : WS2812 RGB strip output: TIM3 PWM fed by circular DMA
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ */
+
+#include "ws2812.h"
+#include "clock_config.h"
+#include "pin_config.h"
+#include "stm32f303_regs.h"
+#ifdef HOST_SIM
+#include "host_sim.h"
+#endif
+
+#define WS2812_TIM          TIM3_BASE
+#define WS2812_DMA_CH       DMA_TIM3_UP_CH
+#define WS2812_PIN          4           // PB4 = TIM3_CH1
+#define WS2812_AF           2           // AF2 = TIM3
+
+#define RESET_HALVES        ((WS2812_RESET_US * 4 / 5 + WS2812_HALF_SLOTS - 1) / WS2812_HALF_SLOTS)
+
+static const PinConfig ws2812_pins[] = {
+    PIN_ALT(GPIO_PORT_B, WS2812_PIN, WS2812_AF, PIN_SPEED_HIGH),
+};
+
+// Two halves of compare values; word-aligned for the encoder's stores
+static uint32_t dma_buf[2 * WS2812_HALF_SLOTS / 4];
+
+static Ws2812Timing timing;
+static uint32_t nibble_lut[16];         // 4 bits -> 4 compare values, first bit in byte 0
+
+static struct {
+    const uint8_t *grb;
+    uint32_t bytes;                     // Pixel bytes still to encode
+    volatile uint8_t busy;
+    uint8_t zero[2];                    // Half holds only reset (low) slots
+    uint8_t zero_played;                // Zero halves sent after the last pixel
+} strip;
+
+// ============================================================================
+// Clock listener: bit period and high times from the timer clock
+// ============================================================================
+static void ws2812_on_clock_change(const ClockFreqs *freqs) {
+    // APB1 timers run at 2 x PCLK1 whenever APB1 is divided
+    uint32_t tim_hz = (freqs->pclk1_hz == freqs->hclk_hz) ? freqs->pclk1_hz : 2 * freqs->pclk1_hz;
+
+    while (strip.busy) {                // Never change the bit time mid-strip
+    }
+
+    timing.period = (uint16_t)((tim_hz + 400000) / 800000);          // 1.25 us
+    timing.t0h = (uint8_t)((tim_hz / 100000 * 4 + 50) / 100);        // 0.40 us
+    timing.t1h = (uint8_t)((tim_hz / 100000 * 8 + 50) / 100);        // 0.80 us
+
+    for (uint32_t n = 0; n < 16; n++) {
+        uint32_t word = 0;
+        for (uint32_t bit = 0; bit < 4; bit++) {
+            uint32_t value = (n & (8 >> bit)) ? timing.t1h : timing.t0h;
+            word |= value << (8 * bit);
+        }
+        nibble_lut[n] = word;
+    }
+
+    TIM_ARR(WS2812_TIM) = timing.period - 1;
+}
+
+// ============================================================================
+// Encoding kernel
+// ============================================================================
+void ws2812_encode(uint32_t *dst, const uint8_t *src, uint32_t bytes) {
+    const uint32_t *lut = nibble_lut;
+
+    while (bytes--) {
+        uint8_t b = *src++;
+        dst[0] = lut[b >> 4];
+        dst[1] = lut[b & 0x0F];
+        dst += 2;
+    }
+}
+
+// Next pixels (or reset time) into one half of the DMA buffer
+static void refill(uint8_t half) {
+    uint32_t *dst = &dma_buf[half * (WS2812_HALF_SLOTS / 4)];
+    uint32_t n = strip.bytes;
+
+    if (n > WS2812_HALF_PIXELS * 3) {
+        n = WS2812_HALF_PIXELS * 3;
+    }
+    if (n) {
+        ws2812_encode(dst, strip.grb, n);
+        strip.grb += n;
+        strip.bytes -= n;
+        dst += 2 * n;
+    } else if (strip.zero[half]) {
+        return;                         // Still zero from last time
+    }
+
+    for (uint32_t i = 2 * n; i < WS2812_HALF_SLOTS / 4; i++) {
+        *dst++ = 0;                     // Line low: tail of the strip / reset
+    }
+    strip.zero[half] = (n == 0);
+}
+
+static void stop(void) {
+    DMA1_CCR(WS2812_DMA_CH) &= ~DMA_CCR_EN;
+    TIM_DIER(WS2812_TIM) &= ~TIM_DIER_UDE;
+    TIM_CR1(WS2812_TIM) &= ~TIM_CR1_CEN;
+    TIM_CCR1(WS2812_TIM) = 0;
+    strip.busy = 0;
+}
+
+// ============================================================================
+// DMA interrupt: half 0 sent (HT) or half 1 sent (TC) -> refill it
+// ============================================================================
+void DMA1_Channel3_IRQHandler(void) {
+    uint32_t isr = DMA1_ISR;
+    uint8_t half = (isr & DMA_ISR_TCIF(WS2812_DMA_CH)) ? 1 : 0;
+
+    DMA1_IFCR = DMA_IFCR_ALL(WS2812_DMA_CH);
+
+    if (strip.zero[half] && ++strip.zero_played >= RESET_HALVES) {
+        stop();                         // Reset time sent - strip has latched
+        return;
+    }
+    refill(half);
+}
+
+// ============================================================================
+// Init / start
+// ============================================================================
+void ws2812_init(void) {
+    RCC_AHBENR  |= RCC_AHBENR_DMA1EN;
+    RCC_APB1ENR |= RCC_APB1ENR_TIM3EN;
+    pin_config_apply(ws2812_pins, PIN_TABLE_SIZE(ws2812_pins));
+
+    // TIM3 CH1: PWM mode 1, preloaded CCR1, so a DMA write applies next bit
+    TIM_CR1(WS2812_TIM) = TIM_CR1_ARPE;
+    TIM_PSC(WS2812_TIM) = 0;
+    TIM_CCMR1(WS2812_TIM) = TIM_CCMR1_OC1M_PWM1 | TIM_CCMR1_OC1PE;
+    TIM_CCER(WS2812_TIM) = TIM_CCER_CC1E;
+    TIM_CCR1(WS2812_TIM) = 0;
+
+    // DMA: buffer (bytes) -> CCR1 (half-words), circular, HT + TC interrupts
+    DMA1_CCR(WS2812_DMA_CH) = 0;
+    DMA1_CPAR(WS2812_DMA_CH) = TIM_CCR1_ADDR(WS2812_TIM);
+    DMA1_CMAR(WS2812_DMA_CH) = (uint32_t)(uintptr_t)dma_buf;
+#ifdef HOST_SIM
+    host_sim_map(dma_buf, sizeof(dma_buf));
+#endif
+    DMA1_CCR(WS2812_DMA_CH) = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_CIRC |
+                              DMA_CCR_PSIZE_16 | DMA_CCR_PL_HIGH |
+                              DMA_CCR_HTIE | DMA_CCR_TCIE;
+
+    clock_add_listener(ws2812_on_clock_change);
+    NVIC_ENABLE_IRQ(DMA1_Channel3_IRQn);
+}
+
+uint8_t ws2812_busy(void) {
+    return strip.busy;
+}
+
+const Ws2812Timing *ws2812_timing(void) {
+    return &timing;
+}
+
+uint8_t ws2812_show(const uint8_t *grb, uint16_t pixels) {
+    if (strip.busy) {
+        return 0;
+    }
+    strip.grb = grb;
+    strip.bytes = (uint32_t)pixels * 3;
+    strip.zero[0] = strip.zero[1] = 0;
+    strip.zero_played = 0;
+    strip.busy = 1;
+
+    refill(0);
+    refill(1);
+
+    TIM_CR1(WS2812_TIM) &= ~TIM_CR1_CEN;
+    TIM_CCR1(WS2812_TIM) = 0;
+    TIM_EGR(WS2812_TIM) = TIM_EGR_UG;           // Load ARR, output low
+    DMA1_IFCR = DMA_IFCR_ALL(WS2812_DMA_CH);
+    DMA1_CCR(WS2812_DMA_CH) &= ~DMA_CCR_EN;
+    DMA1_CNDTR(WS2812_DMA_CH) = 2 * WS2812_HALF_SLOTS;
+    DMA1_CCR(WS2812_DMA_CH) |= DMA_CCR_EN;
+    TIM_DIER(WS2812_TIM) |= TIM_DIER_UDE;
+    TIM_CR1(WS2812_TIM) |= TIM_CR1_CEN;
+    return 1;
+}
+
+// ============================================================================
+// Pattern frame -> GRB pixels
+// ============================================================================
+void ws2812_from_frame(uint8_t *grb, const LedFrame *frame, uint32_t on_rgb) {
+    uint8_t r = (uint8_t)(on_rgb >> 16), g = (uint8_t)(on_rgb >> 8), b = (uint8_t)on_rgb;
+
+    for (uint16_t i = 0; i < frame->width; i++) {
+        uint8_t on = (frame->bits[i >> 3] >> (i & 7)) & 1;
+        grb[0] = on ? g : 0;
+        grb[1] = on ? r : 0;
+        grb[2] = on ? b : 0;
+        grb += 3;
+    }
+}
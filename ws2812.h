@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file           : ws2812.h
+ * @brief          : WS2812 RGB strip output: TIM3 PWM fed by circular DMA
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 26, 2026
+ ******************************************************************************
+ * Every WS2812 bit is one 1.25 us PWM period of TIM3 CH1 (PB4); its high
+ * time (T0H ~0.4 us / T1H ~0.8 us) is the CCR1 value that DMA1 channel 3
+ * writes on each update event.
+ *
+ * Expanding a whole strip to compare values would cost 24 bytes per
+ * pixel. Instead the DMA runs circularly over a small buffer of two
+ * halves (WS2812_HALF_PIXELS pixels each): while one half is being sent,
+ * the half-transfer / transfer-complete interrupt encodes the next
+ * pixels into the other. RAM stays at 2 * 24 * WS2812_HALF_PIXELS bytes
+ * for any strip length; the latch (reset) time is sent from zero halves.
+ *
+ *   ws2812_from_frame(grb, &frame, WS2812_RGB(0, 40, 80));
+ *   ws2812_show(grb, pixels);          // returns at once, 0 if still busy
+ *
+ * ws2812_encode() is the encoding kernel: one 16-entry nibble table,
+ * two 32-bit stores per colour byte. ws2812_bench.c benchmarks it and
+ * checks the full DMA stream with a bit-exact reference decoder.
+ ******************************************************************************
+ */
+
+#ifndef WS2812_H
+#define WS2812_H
+
+#include <stdint.h>
+#include "led_frame.h"
+
+#define WS2812_HALF_PIXELS  4           // Pixels encoded per DMA interrupt
+#define WS2812_SLOTS_PER_PIXEL 24
+#define WS2812_HALF_SLOTS   (WS2812_HALF_PIXELS * WS2812_SLOTS_PER_PIXEL)
+#define WS2812_RESET_US     300         // Latch: >= 280 us low (WS2812B-V5)
+
+#define WS2812_RGB(r, g, b) (((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b))
+
+// Compare values for the current timer clock (kept up to date by a clock listener)
+typedef struct {
+    uint16_t period;                // ARR + 1, timer ticks per bit
+    uint8_t t0h;                    // CCR1 for a 0 bit
+    uint8_t t1h;                    // CCR1 for a 1 bit
+} Ws2812Timing;
+
+void ws2812_init(void);
+uint8_t ws2812_busy(void);
+uint8_t ws2812_show(const uint8_t *grb, uint16_t pixels);
+const Ws2812Timing *ws2812_timing(void);
+
+// Pixel bytes (G, R, B per pixel) -> 8 compare values per byte, MSB first
+void ws2812_encode(uint32_t *dst, const uint8_t *src, uint32_t bytes);
+
+// Pattern frame -> pixels: output i on = 'on_rgb', off = dark
+void ws2812_from_frame(uint8_t *grb, const LedFrame *frame, uint32_t on_rgb);
+
+#endif // WS2812_H
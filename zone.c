@@ -0,0 +1,95 @@
+/**
+ ******************************************************************************
+ * @file           : zone.c
+ * @brief          : Zones - several patterns side by side in one frame
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 28, 2026
+ ******************************************************************************
+ */
+
+#include "zone.h"
+
+// Ring positions [*start, *start + length) covered by a zone; positions
+// past the end of the ring wrap round to 0
+static uint16_t zone_arc(const Zone *z, uint16_t width, uint16_t *start) {
+    uint16_t first = (uint16_t)((uint32_t)z->first * width / 8);
+    uint16_t end = (uint16_t)((uint32_t)(z->first + z->octants) * width / 8);
+    uint16_t length = end - first;
+
+    *start = first;
+    return length > ZONE_MAX_OUTPUTS ? ZONE_MAX_OUTPUTS : length;
+}
+
+void zones_start(Zone *zones, uint8_t count, uint32_t now_ms) {
+    for (uint8_t n = 0; n < count; n++) {
+        pattern_start(&zones[n].pt, now_ms);
+        for (uint16_t i = 0; i < sizeof zones[n].bits; i++) {
+            zones[n].bits[i] = 0;
+        }
+    }
+}
+
+uint32_t zones_run(Zone *zones, uint8_t count, LedFrame *out, uint32_t now_ms) {
+    uint32_t next = now_ms + ZONE_IDLE_MS;
+
+    led_frame_fill(out, 0);
+
+    for (uint8_t n = 0; n < count; n++) {
+        Zone *z = &zones[n];
+        uint16_t start;
+        uint16_t length = zone_arc(z, out->width, &start);
+        if (length == 0) {
+            continue;
+        }
+
+        LedFrame local = { z->bits, length, 0 };
+        pattern_run(z->pattern, &z->pt, &local, now_ms);
+
+        // Merge: zone position i -> ring position start + i
+        for (uint16_t i = 0; i < length; i++) {
+            uint16_t output = led_frame_ring(out, (uint16_t)((start + i) % out->width));
+            uint8_t mask = (uint8_t)(1 << (output & 7));
+            if (z->bits[i >> 3] & (1 << (i & 7))) {
+                out->bits[output >> 3] |= mask;
+            } else {
+                out->bits[output >> 3] &= (uint8_t)~mask;
+            }
+        }
+
+        if ((int32_t)(z->pt.wake_ms - next) < 0) {
+            next = z->pt.wake_ms;
+        }
+    }
+    return next;
+}
+
+void zones_shade(Zone *zones, uint8_t count, LedLevels *out, uint32_t now_ms) {
+    for (uint16_t o = 0; o < out->width; o++) {
+        out->level[o] = 0;
+    }
+
+    for (uint8_t n = 0; n < count; n++) {
+        Zone *z = &zones[n];
+        uint16_t start;
+        uint16_t length = zone_arc(z, out->width, &start);
+        if (length == 0) {
+            continue;
+        }
+
+        if (z->pattern->shade) {
+            LedLevels local = { z->level, length, 0 };
+            z->pattern->shade(&local, now_ms);
+        } else {
+            LedFrame local = { z->bits, length, 0 };
+            pattern_run(z->pattern, &z->pt, &local, now_ms);
+            for (uint16_t i = 0; i < length; i++) {
+                z->level[i] = (z->bits[i >> 3] & (1 << (i & 7))) ? 255 : 0;
+            }
+        }
+
+        for (uint16_t i = 0; i < length; i++) {
+            uint16_t output = out->ring ? out->ring[(start + i) % out->width] : (start + i) % out->width;
+            out->level[output] = z->level[i];
+        }
+    }
+}
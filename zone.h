@@ -0,0 +1,67 @@
+/**
+ ******************************************************************************
+ * @file           : zone.h
+ * @brief          : Zones - several patterns side by side in one frame
+ * @author         : Aabel Jeevan Jose
+ * @date           : October 28, 2026
+ ******************************************************************************
+ * A zone is an arc of the ring with its own pattern instance (Pt) and
+ * its own small frame. Arcs are counted in compass octants, so "the
+ * north half" is the same zone on the eight on-board LEDs and on a
+ * 64-output panel. The pattern only sees its zone: a spin in a 4-LED
+ * zone goes round those four.
+ *
+ *   static Zone split[] = {
+ *       ZONE(&patterns[0], 6, 4),          // W, NW, N, NE: spin
+ *       ZONE(&patterns[7], 2, 4),          // E, SE, S, SW: breathe
+ *   };
+ *
+ *   next = zones_run(split, 2, &frame, now);   // Step due zones, compose
+ *   ... show frame once ...
+ *
+ * zones_run() steps the zones that are due, merges every zone frame into
+ * the output over its arc (later zones win where arcs overlap, LEDs in
+ * no zone are dark) and returns when the next zone is due. It never
+ * touches a pin: the caller shows the composed frame once, so another
+ * zone costs its pattern's work and a few bit copies - not another
+ * GPIO write or SPI transfer.
+ *
+ * A step pattern keeps its state in statics, so it can only be in one
+ * zone (and not also the current pattern). Coroutine and shade patterns
+ * can be in any number of zones.
+ ******************************************************************************
+ */
+
+#ifndef ZONE_H
+#define ZONE_H
+
+#include <stdint.h>
+#include "led_frame.h"
+#include "patterns.h"
+
+#define ZONE_MAX_OUTPUTS    128     // Longest arc; outputs past it stay dark
+#define ZONE_IDLE_MS        1000    // Next wake-up when no zone is due sooner
+
+typedef struct {
+    const Pattern *pattern;
+    uint8_t first;                  // First octant: 0 = North, clockwise
+    uint8_t octants;                // Arc length, 1..8
+    Pt pt;                          // The zone's pattern instance
+    uint8_t bits[LED_FRAME_BYTES(ZONE_MAX_OUTPUTS)];    // Zone frame, arc order
+    uint8_t level[ZONE_MAX_OUTPUTS];                    // Zone levels, arc order
+} Zone;
+
+#define ZONE(pattern, first, octants) \
+    { (pattern), (first), (octants), { 0, 0, 0, 0 }, { 0 }, { 0 } }
+
+// (Re)start every zone's pattern at now_ms
+void zones_start(Zone *zones, uint8_t count, uint32_t now_ms);
+
+// Step the zones that are due and compose all of them into 'out';
+// returns the time the next zone is due
+uint32_t zones_run(Zone *zones, uint8_t count, LedFrame *out, uint32_t now_ms);
+
+// Brightness version: shade zones that can, step the others (on = 255)
+void zones_shade(Zone *zones, uint8_t count, LedLevels *out, uint32_t now_ms);
+
+#endif // ZONE_H